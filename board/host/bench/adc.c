@@ -0,0 +1,89 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "adc_decimator.h"
+
+/*
+   ADC decimator benchmark
+   Interleaves constant values per input, as the round robin dma leaves them, for several input masks and checks each
+   input gets its own value back. Then feeds a fractional input with about 1 LSB of noise and compares the rms error of
+   single samples with the decimated value, as effective bits
+*/
+
+#define BENCH_BLOCKS 20000
+#define BENCH_NOISE_LSB 1.0
+
+static bool interleave(uint8_t mask);
+static void noise(double lsb);
+static double gaussian(void);
+
+static const uint8_t masks[] = {0x01, 0x0C, 0x0D, 0x1F, 0x10, 0x15};
+static uint32_t seed = 1;
+
+int main(void) {
+    bool is_ok = true;
+    for (unsigned i = 0; i < sizeof(masks) / sizeof(masks[0]); i++) is_ok &= interleave(masks[i]);
+    printf("\n%10s %14s %14s %12s %12s\n", "noise lsb", "sample rms", "decimated rms", "sample bits", "decimated");
+    noise(0.3);
+    noise(BENCH_NOISE_LSB);
+    noise(3);
+    return is_ok ? 0 : 1;
+}
+
+static bool interleave(uint8_t mask) {
+    adc_decimator_t decimator = {0};
+    uint16_t samples[ADC_DECIMATOR_INPUTS * ADC_DECIMATOR_SAMPLES];
+    uint16_t expected[ADC_DECIMATOR_INPUTS];
+    bool is_ok = true;
+    adc_decimator_init(&decimator, mask);
+    for (uint8_t i = 0; i < decimator.count; i++) expected[decimator.inputs[i]] = 800 * (decimator.inputs[i] + 1) + 7;
+    for (unsigned i = 0; i < ADC_DECIMATOR_SAMPLES; i++)
+        for (uint8_t j = 0; j < decimator.count; j++)
+            samples[i * decimator.count + j] = expected[decimator.inputs[j]] | 0x8000;  // error flag is masked
+    adc_decimator_block(&decimator, samples);
+    printf("mask 0x%02X:", mask);
+    for (uint8_t input = 0; input < ADC_DECIMATOR_INPUTS; input++) {
+        uint16_t value = adc_decimator_value(&decimator, input);
+        uint16_t want = mask & (1 << input) ? expected[input] << ADC_DECIMATOR_EXTRA_BITS : 0;
+        printf(" %5u", value);
+        if (value != want) {
+            printf(" (expected %u)", want);
+            is_ok = false;
+        }
+    }
+    printf(" %s\n", is_ok ? "ok" : "FAIL");
+    return is_ok;
+}
+
+static void noise(double lsb) {
+    adc_decimator_t decimator = {0};
+    uint16_t samples[ADC_DECIMATOR_SAMPLES];
+    double sample_error = 0, decimated_error = 0;
+    adc_decimator_init(&decimator, 0x01);
+    for (unsigned i = 0; i < BENCH_BLOCKS; i++) {
+        double real = 2000 + (i % 97) / 97.0;
+        for (unsigned j = 0; j < ADC_DECIMATOR_SAMPLES; j++) {
+            long sample = lround(real + gaussian() * lsb);
+            samples[j] = sample < 0 ? 0 : sample > 4095 ? 4095 : sample;
+        }
+        sample_error += pow(samples[0] - real, 2);
+        adc_decimator_block(&decimator, samples);
+        double decimated = adc_decimator_value(&decimator, 0) / (double)(1 << ADC_DECIMATOR_EXTRA_BITS);
+        decimated_error += pow(decimated - real, 2);
+    }
+    sample_error = sqrt(sample_error / BENCH_BLOCKS);
+    decimated_error = sqrt(decimated_error / BENCH_BLOCKS);
+    // bits of a 12 bit converter with the same rms error, quantization alone is 1 / sqrt(12) lsb
+    printf("%10.1f %14.3f %14.3f %12.2f %12.2f\n", lsb, sample_error, decimated_error,
+           12 - log2(sample_error * sqrt(12)), 12 - log2(decimated_error * sqrt(12)));
+}
+
+static double gaussian(void) {
+    double sum = 0;
+    for (unsigned i = 0; i < 12; i++) {
+        seed = seed * 1103515245 + 12345;
+        sum += ((seed >> 8) & 0xFFFF) / 65536.0;
+    }
+    return sum - 6;
+}
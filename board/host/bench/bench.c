@@ -0,0 +1,354 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "crc.h"
+#include "crsf.h"
+#include "frsky_d.h"
+#include "hal_host.h"
+#include "hott.h"
+#include "ibus.h"
+#include "jetiex.h"
+#include "jr_dmss.h"
+#include "multiplex.h"
+#include "pool.h"
+#include "sanwa.h"
+#include "sbus.h"
+#include "sensor_registry.h"
+#include "smartport.h"
+#include "srxl.h"
+#include "srxl2.h"
+#include "uart.h"
+#include "xbus.h"
+
+/*
+   Telemetry frame benchmark
+   Replays the receiver poll streams of sim_rx.c into each protocol task and reports the host cost per frame: the
+   time spent in every task the protocol started (receiver task and sensor tasks, some protocols answer from them)
+   plus the irq context (uart idle timeout, slot alarms). The baseline row is the same frame path with an empty task,
+   so it is the fixed cost of the host scheduler and uart emulation. Xbus polls are i2c requests: the request handler
+   is timed as irq context and a poll is answered when the write buffer holds the polled device frame. The pool column
+   is the static pool taken by the configuration once started (receiver task, sensor tasks and slots), the RAM to
+   budget in POOL_SIZE. Each case runs in its own process, so the static state of a protocol starts clean, and fails
+   if it crashes or if a mix with sensors is not answered. These are host numbers, to compare the protocols and the
+   changes to them. The only target probe is SMARTPORT_POLL_LATENCY (common.h)
+*/
+
+#define BENCH_FRAMES 2000
+#define BENCH_WARMUP_FRAMES 50
+#define BENCH_STARTUP_US 3000000
+#define BENCH_MAX_FRAME 64
+#define BENCH_UNANSWERED 2  // exit status of a case that printed its FAIL row
+
+typedef uint (*bench_stream_t)(uint frame, uint8_t *data);
+typedef uint64_t (*bench_poll_t)(const uint8_t *data, uint length);
+
+typedef struct bench_protocol_t {
+    const char *name;
+    rx_protocol_t rx_protocol;
+    TaskFunction_t task;
+    bench_stream_t stream;
+    bench_poll_t poll;
+    uint period_us;
+    uint stack;
+} bench_protocol_t;
+
+typedef struct bench_mix_t {
+    const char *name;
+    void (*apply)(config_t *config);
+} bench_mix_t;
+
+typedef struct bench_result_t {
+    uint frames, answered;
+    size_t pool;
+    uint64_t p50_ns, p99_ns, max_ns;
+} bench_result_t;
+
+static void baseline_task(void *parameters);
+static uint stream_smartport(uint frame, uint8_t *data);
+static uint stream_sbus(uint frame, uint8_t *data);
+static uint stream_ibus(uint frame, uint8_t *data);
+static uint stream_multiplex(uint frame, uint8_t *data);
+static uint stream_jetiex(uint frame, uint8_t *data);
+static uint stream_hott(uint frame, uint8_t *data);
+static uint stream_sanwa(uint frame, uint8_t *data);
+static uint stream_jr_dmss(uint frame, uint8_t *data);
+static uint stream_srxl(uint frame, uint8_t *data);
+static uint stream_srxl2(uint frame, uint8_t *data);
+static uint stream_xbus(uint frame, uint8_t *data);
+static uint stream_none(uint frame, uint8_t *data);
+static uint64_t poll_uart(const uint8_t *data, uint length);
+static uint64_t poll_i2c(const uint8_t *data, uint length);
+static bool is_answered(const bench_protocol_t *protocol, const uint8_t *data, uint8_t *tx, uint size);
+static void mix_none(config_t *config);
+static void mix_esc(config_t *config);
+static void mix_full(config_t *config);
+static void mix_all(config_t *config);
+static void fill_values(sensor_values_t *values);
+static bool run_case(const bench_protocol_t *protocol, const bench_mix_t *mix);
+static bench_result_t run(const bench_protocol_t *protocol, const bench_mix_t *mix);
+static int compare(const void *a, const void *b);
+
+static const bench_protocol_t protocols[] = {
+    {"baseline", RX_SMARTPORT, baseline_task, stream_smartport, poll_uart, 12000, STACK_RX_SMARTPORT},
+    {"smartport", RX_SMARTPORT, smartport_task, stream_smartport, poll_uart, 12000, STACK_RX_SMARTPORT},
+    {"sbus2", RX_SBUS, sbus_task, stream_sbus, poll_uart, 14000, STACK_RX_SBUS},
+    {"jetiex", RX_JETIEX, jetiex_task, stream_jetiex, poll_uart, 20000, STACK_RX_JETIEX},
+    {"ibus", RX_IBUS, ibus_task, stream_ibus, poll_uart, 7000, STACK_RX_IBUS},
+    {"multiplex", RX_MULTIPLEX, multiplex_task, stream_multiplex, poll_uart, 10000, STACK_RX_MULTIPLEX},
+    {"hott", RX_HOTT, hott_task, stream_hott, poll_uart, 40000, STACK_RX_HOTT},
+    {"sanwa", RX_SANWA, sanwa_task, stream_sanwa, poll_uart, 10000, STACK_RX_SANWA},
+    {"jr_dmss", RX_JR_PROPO, jr_dmss_task, stream_jr_dmss, poll_uart, 10000, STACK_RX_JR_PROPO},
+    {"srxl", RX_SRXL, srxl_task, stream_srxl, poll_uart, 11000, STACK_RX_SRXL},
+    {"srxl2", RX_SRXL2, srxl2_task, stream_srxl2, poll_uart, 11000, STACK_RX_SRXL2},
+    {"crsf", RX_CRSF, crsf_task, stream_none, poll_uart, 10000, STACK_RX_CRSF},
+    {"frsky_d", RX_FRSKY_D, frsky_d_task, stream_none, poll_uart, 10000, STACK_RX_FRSKY_D},
+    {"xbus", RX_XBUS, xbus_task, stream_xbus, poll_i2c, 5000, STACK_RX_XBUS},
+};
+
+static const bench_mix_t mixes[] = {
+    {"none", mix_none},
+    {"esc", mix_esc},
+    {"esc+gps+analog+baro", mix_full},
+    {"all", mix_all},
+};
+
+int main(int argc, char **argv) {
+    const char *filter = argc > 1 ? argv[1] : NULL;
+    bool is_ok = true;
+    printf("%-10s %-20s %7s %8s %9s %9s %9s %7s\n", "protocol", "sensors", "frames", "answered", "p50 ns", "p99 ns",
+           "max ns", "pool B");
+    for (uint i = 0; i < count_of(protocols); i++) {
+        if (filter && i && strcmp(filter, protocols[i].name)) continue;
+        for (uint j = 0; j < count_of(mixes); j++) {
+            if (!i && j) break;
+            is_ok &= run_case(&protocols[i], &mixes[j]);
+        }
+    }
+    return is_ok ? 0 : 1;
+}
+
+/* One process per case, the protocols keep static state across runs */
+static bool run_case(const bench_protocol_t *protocol, const bench_mix_t *mix) {
+    int status;
+    fflush(stdout);
+    pid_t pid = fork();
+    if (!pid) {
+        bench_result_t result = run(protocol, mix);
+        bool is_ok = result.answered || mix->apply == mix_none;
+        printf("%-10s %-20s %7u %8u %9llu %9llu %9llu %7zu %s\n", protocol->name, mix->name, result.frames,
+               result.answered, (unsigned long long)result.p50_ns, (unsigned long long)result.p99_ns,
+               (unsigned long long)result.max_ns, result.pool, is_ok ? "ok" : "FAIL");
+        fflush(stdout);
+        _exit(is_ok ? 0 : BENCH_UNANSWERED);
+    }
+    if (pid < 0 || waitpid(pid, &status, 0) != pid) return false;
+    bool is_ok = WIFEXITED(status) && !WEXITSTATUS(status);
+    if (!is_ok && !(WIFEXITED(status) && WEXITSTATUS(status) == BENCH_UNANSWERED))
+        printf("%-10s %-20s aborted FAIL\n", protocol->name, mix->name);
+    return is_ok;
+}
+
+static bench_result_t run(const bench_protocol_t *protocol, const bench_mix_t *mix) {
+    static uint64_t sample[BENCH_FRAMES];
+    bench_result_t result = {0};
+    config_t config;
+    uint8_t data[BENCH_MAX_FRAME], tx[1024];
+
+    hal_host_reset();
+    config_forze_write();
+    config_get(&config);
+    config.rx_protocol = protocol->rx_protocol;
+    config.debug = 0;
+    mix->apply(&config);
+    config_write(&config);
+    for (uint i = 0; i < 5; i++) hal_host_adc_set(i, 1500);
+
+    context.tasks_queue_handle = pool_queue_create(64, sizeof(QueueHandle_t));
+    pool_task_create(protocol->task, protocol->name, protocol->stack, NULL, 3, &context.receiver_task_handle);
+    context.uart0_notify_task_handle = context.receiver_task_handle;
+    hal_host_start_scheduler();
+    hal_host_advance_us(BENCH_STARTUP_US);
+    fill_values(sensor_registry_values());
+    result.pool = pool_used() + pool_heap_used();
+
+    for (uint frame = 0; frame < BENCH_WARMUP_FRAMES + BENCH_FRAMES; frame++) {
+        uint length = protocol->stream(frame, data);
+        while (hal_host_uart_tx(HAL_HOST_UART0, tx, sizeof(tx)))
+            ;
+        uint64_t start_ns = hal_host_tasks_run_ns() + hal_host_isr_run_ns();
+        uint64_t poll_ns = protocol->poll(data, length);
+        hal_host_advance_us(protocol->period_us);
+        uint64_t cost_ns = hal_host_tasks_run_ns() + hal_host_isr_run_ns() - start_ns + poll_ns;
+        if (frame < BENCH_WARMUP_FRAMES) continue;
+        sample[result.frames++] = cost_ns;
+        if (is_answered(protocol, data, tx, sizeof(tx))) result.answered++;
+    }
+    qsort(sample, result.frames, sizeof(sample[0]), compare);
+    result.p50_ns = sample[result.frames / 2];
+    result.p99_ns = sample[result.frames * 99 / 100];
+    result.max_ns = sample[result.frames - 1];
+    return result;
+}
+
+static uint64_t poll_uart(const uint8_t *data, uint length) {
+    hal_host_uart_rx(HAL_HOST_UART0, data, length);
+    return 0;
+}
+
+static uint64_t poll_i2c(const uint8_t *data, uint length) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    hal_host_i2c_multi_request(data[0]);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) * 1000000000ULL + end.tv_nsec - start.tv_nsec;
+}
+
+static bool is_answered(const bench_protocol_t *protocol, const uint8_t *data, uint8_t *tx, uint size) {
+    if (protocol->poll == poll_i2c) return hal_host_i2c_multi_buffer()[0] == data[0];
+    return hal_host_uart_tx(HAL_HOST_UART0, tx, size);
+}
+
+static void baseline_task(void *parameters) {
+    uart0_begin(57600, UART_RECEIVER_TX, UART_RECEIVER_RX, 500, 8, 1, UART_PARITY_NONE, true, true);
+    while (1) {
+        ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        uart0_consume(uart0_available());
+    }
+}
+
+static void mix_none(config_t *config) {}
+
+static void mix_esc(config_t *config) { config->esc_protocol = ESC_HW4; }
+
+static void mix_full(config_t *config) {
+    config->esc_protocol = ESC_HW4;
+    config->enable_gps = true;
+    config->enable_analog_voltage = true;
+    config->enable_analog_current = true;
+    config->enable_analog_ntc = true;
+    config->i2c_module = I2C_BMP280;
+}
+
+/* Every sensor task at once, the largest pool a protocol can take */
+static void mix_all(config_t *config) {
+    mix_full(config);
+    config->enable_analog_airspeed = true;
+    config->enable_fuel_flow = true;
+    config->enable_fuel_pressure = true;
+    config->enable_pwm_out = true;
+    config->gpio_mask = 0x3F;
+}
+
+/* Plausible non zero values so the formatters take their normal paths */
+static void fill_values(sensor_values_t *values) {
+    values->esc = (sensor_esc_t){.rpm = 12000, .voltage = 22.2, .current = 35.5, .consumption = 1234,
+                                 .cell_voltage = 3.7, .temperature_fet = 45, .temperature_bec = 40,
+                                 .voltage_bec = 5.1, .current_bec = 1.2, .cell_count = 6};
+    for (uint i = 0; i < SENSOR_ESC_MAX_CELLS; i++) values->esc.cell[i] = 3.7;
+    values->gps = (sensor_gps_t){.lat = 2389.123, .lon = -412.456, .alt = 123.4, .spd = 12.3, .cog = 270.5,
+                                 .hdop = 0.9, .sat = 12, .time = 123456, .date = 10124, .vspeed = 1.5,
+                                 .dist = 456, .fix = 3};
+    values->baro = (sensor_baro_t){.temperature = 25, .pressure = 101325, .altitude = 120.5, .vspeed = 1.2};
+    values->analog = (sensor_analog_t){.voltage = 12.6, .current = 10.2, .consumption = 850, .ntc = 30};
+}
+
+static int compare(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Poll streams, as sent by sim_rx.c */
+
+static uint stream_smartport(uint frame, uint8_t *data) {
+    data[0] = 0x7E;
+    data[1] = 0x71;  // sensor id 18
+    return 2;
+}
+
+static uint stream_sbus(uint frame, uint8_t *data) {
+    data[0] = 0x0F;
+    for (uint i = 1; i < 24; i++) data[i] = 0x01;
+    data[1] = 0x0F;
+    data[24] = 0x04 | (frame % 4) << 4;
+    return 25;
+}
+
+static uint stream_ibus(uint frame, uint8_t *data) {
+    uint8_t address = frame % 16;
+    data[0] = 4;
+    data[1] = 0xA << 4 | address;  // measure
+    uint16_t crc = 0xFFFF - data[0] - data[1];
+    data[2] = crc;
+    data[3] = crc >> 8;
+    return 4;
+}
+
+static uint stream_multiplex(uint frame, uint8_t *data) {
+    data[0] = frame % 16;
+    return 1;
+}
+
+static uint stream_jetiex(uint frame, uint8_t *data) {
+    static const uint8_t poll[] = {0x3E, 0x3,  0x28, 0x2,  0x31, 0x20, 0x80, 0x3E, 0xDD, 0x2E, 0xEB, 0x2E,
+                                   0xEC, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E,
+                                   0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E,
+                                   0xE0, 0x2E, 0xC5, 0xFE, 0x3D, 0x1,  0x8,  0x2,  0x3A, 0x0,  0xF9, 0xE2};
+    memcpy(data, poll, sizeof(poll));
+    return sizeof(poll);
+}
+
+static uint stream_hott(uint frame, uint8_t *data) {
+    static const uint8_t address[] = {0x89, 0x8A, 0x8C, 0x8D, 0x8E};
+    data[0] = 0x80;  // binary mode
+    data[1] = address[frame % count_of(address)];
+    return 2;
+}
+
+static uint stream_sanwa(uint frame, uint8_t *data) {
+    static const uint8_t poll[5][10] = {{0x1, 0x4, 0x82, 0x2, 0xFF, 0x0, 0x3, 0x3, 0xFF, 0x8D},
+                                        {0x1, 0x1, 0x30, 0x4, 0xA7, 0x3, 0xFF, 0x3, 0xFF, 0xE1},
+                                        {0x1, 0x1, 0x31, 0x4, 0xA7, 0x0, 0x3, 0x3, 0xFF, 0xE3},
+                                        {0x1, 0x1, 0x30, 0x4, 0xA7, 0x3, 0xFF, 0x3, 0xFF, 0xE1},
+                                        {0x1, 0x1, 0x31, 0x4, 0xA8, 0x0, 0x3, 0x3, 0xFF, 0xE4}};
+    memcpy(data, poll[frame % 5], sizeof(poll[0]));
+    return sizeof(poll[0]);
+}
+
+static uint stream_jr_dmss(uint frame, uint8_t *data) {
+    data[0] = frame % 11;
+    return 1;
+}
+
+static uint stream_srxl(uint frame, uint8_t *data) {
+    memset(data, 0, 18);
+    data[0] = 0xA5;
+    data[1] = 0x12;
+    return 18;
+}
+
+/* Handshake to the device id, then channel data polling the device. Crc is recomputed as the frames are edited */
+static uint stream_srxl2(uint frame, uint8_t *data) {
+    static const uint8_t handshake[] = {0xA6, 0x21, 0xE, 0x10, 0x31, 0xA, 0x1, 0x1, 0xFC, 0x96, 0x8C, 0x4B, 0, 0};
+    static const uint8_t control[] = {0xA6, 0xCD, 0x14, 0x0, 0x31, 0xEC, 0x0, 0x0, 0x91, 0x0,
+                                      0x0,  0x0,  0x60, 0x80, 0x0, 0x80, 0x0, 0x80, 0,   0};
+    uint length = frame < 10 ? sizeof(handshake) : sizeof(control);
+    memcpy(data, frame < 10 ? handshake : control, length);
+    uint16_t crc = crc16_srxl(0, data, length - 2);
+    data[length - 2] = crc >> 8;
+    data[length - 1] = crc;
+    return length;
+}
+
+static uint stream_xbus(uint frame, uint8_t *data) {
+    static const uint8_t address[] = {XBUS_ESC_ID, XBUS_GPS_LOC_ID, XBUS_GPS_STAT_ID, XBUS_BATTERY_ID,
+                                      XBUS_VARIO_ID, XBUS_RPMVOLTTEMP_ID};
+    data[0] = address[frame % count_of(address)];
+    return 1;
+}
+
+static uint stream_none(uint frame, uint8_t *data) { return 0; }
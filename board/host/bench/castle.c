@@ -0,0 +1,206 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "castle_decoder.h"
+
+/*
+   Castle link decoder benchmark
+   Generates a pulse width trace as the pio counter reports it (0.2 us per count, sync gaps above 50000, 1 count of
+   jitter), frames it like the castle_link.c irq and decodes it with castle_decoder.c. Compares every field with the
+   generated telemetry and with the float decoder it replaced, which ran in the pio irq. Frames alternate ntc and linear
+   temperature. Then times both decoders per frame (the host has an fpu, the M0+ does not, so only the ratio carries
+   over)
+*/
+
+#define BENCH_FRAMES 20000
+#define BENCH_RUNS 200
+#define BENCH_COUNTS_US 5  // pio counter, 25 cycles at 125 MHz
+#define BENCH_SYNC 60000
+#define BENCH_FIELDS 9
+#define BENCH_NTC_MAX 0.3  // table error and the 298 K of the old formula
+
+typedef struct bench_trace_t {
+    uint16_t *width;
+    unsigned length;
+    castle_link_telemetry_t *expected;
+} bench_trace_t;
+
+static void generate(bench_trace_t *trace);
+static unsigned encode(float value, float scaler);
+static float ntc_raw(float temperature);
+static void old_decode(const uint16_t *value, castle_link_telemetry_t *packet);
+static float field(const castle_link_telemetry_t *packet, unsigned index);
+static double elapsed_ns(struct timespec *start);
+static int jitter(void);
+
+static const char *names[BENCH_FIELDS] = {"voltage", "ripple",  "current", "thr",        "output",
+                                          "rpm",     "bec volt", "bec curr", "temperature"};
+static const float scaler[CASTLE_LINK_PULSES] = {0, 20, 4, 50, 1, 0.2502, 20416.7, 4, 4, 30, 63.8125};
+static uint32_t seed = 1;
+
+int main(void) {
+    bench_trace_t trace;
+    castle_decoder_t decoder;
+    castle_link_frame_t frame, *frames = malloc(BENCH_FRAMES * sizeof(castle_link_frame_t));
+    double error[BENCH_FIELDS] = {0}, difference[BENCH_FIELDS] = {0};
+    unsigned index = CASTLE_LINK_PULSES, count = 0, decoded = 0;
+    generate(&trace);
+    castle_decoder_init(&decoder);
+    // castle_link.c irq
+    for (unsigned i = 0; i < trace.length; i++) {
+        if (trace.width[i] > 50000) {
+            index = 0;
+            continue;
+        }
+        if (index >= CASTLE_LINK_PULSES) continue;
+        frame.value[index++] = trace.width[i];
+        if (index == CASTLE_LINK_PULSES) frames[count++] = frame;
+    }
+    for (unsigned i = 0; i < count; i++) {
+        castle_link_telemetry_t packet, old;
+        if (!castle_decoder_decode(&decoder, &frames[i], &packet)) continue;
+        old_decode(frames[i].value, &old);
+        decoded += packet.is_temp_ntc == trace.expected[i].is_temp_ntc;
+        for (unsigned j = 0; j < BENCH_FIELDS; j++) {
+            double e = fabs(field(&packet, j) - field(&trace.expected[i], j));
+            double d = fabs(field(&packet, j) - field(&old, j));
+            if (e > error[j]) error[j] = e;
+            if (d > difference[j]) difference[j] = d;
+        }
+    }
+    printf("frames %u framed %u decoded %u\n\n%-12s %12s %12s %12s\n", BENCH_FRAMES, count, decoded, "field",
+           "max error", "vs old", "1 count");
+    bool is_ok = count == BENCH_FRAMES && decoded == BENCH_FRAMES;
+    for (unsigned j = 0; j < BENCH_FIELDS; j++) {
+        // one count of the 1000 us calibration, the resolution of the capture. The ntc is the thermistor table
+        double resolution = scaler[j + 1] / (1000 * BENCH_COUNTS_US);
+        bool is_field_ok = difference[j] <= (j == BENCH_FIELDS - 1 ? BENCH_NTC_MAX : resolution / 8);
+        printf("%-12s %12.4f %12.4f %12.4f %s\n", names[j], error[j], difference[j], resolution,
+               is_field_ok ? "ok" : "FAIL");
+        is_ok &= is_field_ok;
+    }
+
+    castle_link_frame_t zero = {0};
+    castle_link_telemetry_t packet;
+    if (castle_decoder_decode(&decoder, &zero, &packet)) is_ok = false;
+    volatile float sink = 0;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned run = 0; run < BENCH_RUNS; run++)
+        for (unsigned i = 0; i < count; i++) {
+            castle_decoder_decode(&decoder, &frames[i], &packet);
+            sink += packet.rpm;
+        }
+    double new_ns = elapsed_ns(&start) / BENCH_RUNS / count;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned run = 0; run < BENCH_RUNS; run++)
+        for (unsigned i = 0; i < count; i++) {
+            old_decode(frames[i].value, &packet);
+            sink += packet.rpm;
+        }
+    double old_ns = elapsed_ns(&start) / BENCH_RUNS / count;
+    printf("\nns/frame new %.1f old %.1f\n", new_ns, old_ns);
+    free(trace.width);
+    free(trace.expected);
+    free(frames);
+    return is_ok ? 0 : 1;
+}
+
+/* A sync and 11 pulses per frame, starting mid frame as a capture would */
+static void generate(bench_trace_t *trace) {
+    trace->width = malloc((BENCH_FRAMES + 1) * (CASTLE_LINK_PULSES + 1) * sizeof(uint16_t));
+    trace->expected = malloc(BENCH_FRAMES * sizeof(castle_link_telemetry_t));
+    trace->length = 0;
+    for (unsigned i = 0; i < 5; i++) trace->width[trace->length++] = 3000 + i;
+    for (unsigned i = 0; i < BENCH_FRAMES; i++) {
+        castle_link_telemetry_t *packet = &trace->expected[i];
+        float t = i / 50.0;
+        packet->voltage = 22.2 + 2 * sinf(t);
+        packet->ripple_voltage = 0.3 + 0.2 * sinf(t * 3);
+        packet->current = 40 + 35 * sinf(t / 2);
+        packet->thr = 1.5 + 0.4 * sinf(t);
+        packet->output = 0.25 + 0.2 * sinf(t / 3);
+        packet->rpm = 30000 + 25000 * sinf(t / 2);
+        packet->voltage_bec = 5.5 + 0.5 * sinf(t * 2);
+        packet->current_bec = 1.5 + sinf(t);
+        packet->temperature = 50 + 40 * sinf(t / 7);
+        packet->is_temp_ntc = i % 2;
+        trace->width[trace->length++] = BENCH_SYNC;
+        uint16_t *width = &trace->width[trace->length];
+        width[0] = 1000 * BENCH_COUNTS_US + jitter();
+        width[1] = encode(packet->voltage, scaler[1]);
+        width[2] = encode(packet->ripple_voltage, scaler[2]);
+        width[3] = encode(packet->current, scaler[3]);
+        width[4] = encode(packet->thr, scaler[4]);
+        width[5] = encode(packet->output, scaler[5]);
+        width[6] = encode(packet->rpm, scaler[6]);
+        width[7] = encode(packet->voltage_bec, scaler[7]);
+        width[8] = encode(packet->current_bec, scaler[8]);
+        if (packet->is_temp_ntc) {
+            width[9] = 500 * BENCH_COUNTS_US + jitter();
+            width[10] = encode(ntc_raw(packet->temperature), scaler[10]);
+        } else {
+            width[9] = encode(packet->temperature, scaler[9]);
+            width[10] = 500 * BENCH_COUNTS_US + jitter();
+        }
+        trace->length += CASTLE_LINK_PULSES;
+    }
+}
+
+/* calibration / 2 + value / scaler * calibration, calibration 1000 us */
+static unsigned encode(float value, float scaler) {
+    return lroundf(1000 * BENCH_COUNTS_US * (0.5 + value / scaler)) + jitter();
+}
+
+/* 0 to 255, ntc 10k beta 3455 with 10k2 in series */
+static float ntc_raw(float temperature) {
+    float r = 10000 * expf(3455 * (1 / (temperature + 273.15F) - 1 / 298.15F));
+    return 255 * r / (r + 10200);
+}
+
+/* castle_link.c handler_pio() it replaced */
+static void old_decode(const uint16_t *value, castle_link_telemetry_t *packet) {
+    uint calibration;
+    if (value[9] < value[10]) {
+        calibration = value[0] / 2 + value[9];
+        packet->is_temp_ntc = true;
+        float temp_raw = ((float)value[10] - calibration / 2) * scaler[10] / calibration;
+        packet->temperature =
+            1 / (log(temp_raw * 10200.0 / (255.0 - temp_raw) / 10000.0) / 3455.0 + 1.0 / 298.0) - 273.0;
+    } else {
+        calibration = value[0] / 2 + value[10];
+        packet->is_temp_ntc = false;
+        packet->temperature = ((float)value[9] - calibration / 2) * scaler[9] / calibration;
+    }
+    packet->voltage = ((float)value[1] - calibration / 2) * scaler[1] / calibration;
+    packet->ripple_voltage = ((float)value[2] - calibration / 2) * scaler[2] / calibration;
+    packet->current = ((float)value[3] - calibration / 2) * scaler[3] / calibration;
+    packet->thr = ((float)value[4] - calibration / 2) * scaler[4] / calibration;
+    packet->output = ((float)value[5] - calibration / 2) * scaler[5] / calibration;
+    packet->rpm = ((float)value[6] - calibration / 2) * scaler[6] / calibration;
+    packet->voltage_bec = ((float)value[7] - calibration / 2) * scaler[7] / calibration;
+    packet->current_bec = ((float)value[8] - calibration / 2) * scaler[8] / calibration;
+    if (packet->temperature < 0) packet->temperature = 0;
+}
+
+static float field(const castle_link_telemetry_t *packet, unsigned index) {
+    const float values[BENCH_FIELDS] = {packet->voltage, packet->ripple_voltage, packet->current,
+                                        packet->thr,     packet->output,         packet->rpm,
+                                        packet->voltage_bec, packet->current_bec, packet->temperature};
+    return values[index];
+}
+
+static double elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+/* -1 to 1 */
+static int jitter(void) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 16) % 3) - 1;
+}
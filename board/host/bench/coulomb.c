@@ -0,0 +1,189 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "coulomb.h"
+#include "hal_host.h"
+#include "hardware/regs/addressmap.h"
+
+/*
+   Coulomb counter benchmark
+   Integrates one hour of current with coulomb.c and with the float get_consumption() it replaced, and compares both
+   with the analytic integral. Esc streams are instant samples every 20 ms with jitter (coulomb_sample()), the analog
+   stream is the exact mean since the previous read every 100 ms, as the adc totals give it (coulomb_mean()). Then
+   writes the flash log (coulomb_log.c) through several sector erases, restoring it after every write, after a torn
+   record and after a torn erase. Then a flight without reset: the writes must only program, until the log is full,
+   and the next start must restore the last write and erase again
+*/
+
+#define BENCH_S 3600
+#define BENCH_LOG_WRITES 2000
+#define BENCH_PI 3.14159265358979323846
+
+typedef struct bench_case_t {
+    const char *name;
+    double (*current)(double t);  // A
+    double (*charge)(double t);   // mAh since 0
+    double period, jitter;        // s
+    bool is_mean;
+    double error_max;  // %
+} bench_case_t;
+
+static bool run(const bench_case_t *bench);
+static bool run_log(void);
+static float old_consumption(float current, uint32_t now, uint32_t *timestamp);
+static double constant(double t);
+static double constant_charge(double t);
+static double sine(double t);
+static double sine_charge(double t);
+static double ramp(double t);
+static double ramp_charge(double t);
+static double pulse(double t);
+static double pulse_charge(double t);
+static double uniform(void);
+
+static const bench_case_t cases[] = {
+    {"esc constant", constant, constant_charge, 0.02, 0.002, false, 0.001},
+    {"esc sine", sine, sine_charge, 0.02, 0.002, false, 0.001},
+    {"esc ramp", ramp, ramp_charge, 0.02, 0.002, false, 0.001},
+    {"esc pulse", pulse, pulse_charge, 0.02, 0.002, false, 0.5},
+    {"analog constant", constant, constant_charge, 0.1, 0.005, true, 0.001},
+    {"analog sine", sine, sine_charge, 0.1, 0.005, true, 0.001},
+    {"analog pulse", pulse, pulse_charge, 0.1, 0.005, true, 0.001},
+};
+static uint32_t seed = 1;
+
+int main(void) {
+    bool is_ok = true;
+    printf("%-16s %12s %12s %10s %12s %10s\n", "stream", "analytic", "new", "new %", "old", "old %");
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) is_ok &= run(&cases[i]);
+    is_ok &= run_log();
+    return is_ok ? 0 : 1;
+}
+
+/* The counter starts near the wrap of time_us_32() */
+static bool run(const bench_case_t *bench) {
+    coulomb_t coulomb;
+    uint32_t start = 0xFFFFFFFF - 5000000, timestamp = 0;
+    double t = 0, previous = 0;
+    float old = 0;
+    coulomb_init(&coulomb, 0, COULOMB_SOURCE_ESC);
+    while (t < BENCH_S) {
+        uint32_t now = start + lround(t * 1e6);
+        double current = bench->current(t);
+        // mean since the previous read, mAh to A s
+        if (bench->is_mean && t > 0) current = (bench->charge(t) - bench->charge(previous)) * 3.6 / (t - previous);
+        if (bench->is_mean) {
+            coulomb_mean(&coulomb, current, now);
+        } else {
+            coulomb_sample(&coulomb, current, now);
+        }
+        old += old_consumption(current, now, &timestamp);
+        previous = t;
+        t += bench->period + (uniform() - 0.5) * 2 * bench->jitter;
+    }
+    double analytic = bench->charge(previous);
+    double new_error = fabs(coulomb_get(&coulomb) / analytic - 1) * 100, old_error = fabs(old / analytic - 1) * 100;
+    bool is_ok = new_error <= bench->error_max && new_error <= old_error;
+    printf("%-16s %12.3f %12.3f %10.4f %12.3f %10.4f %s\n", bench->name, analytic, coulomb_get(&coulomb), new_error,
+           old, old_error, is_ok ? "ok" : "FAIL");
+    return is_ok;
+}
+
+static bool run_log(void) {
+    coulomb_log_t log;
+    int64_t charge = -1, restored;
+    unsigned restore_errors = 0, flight_writes = 0, flight_erases;
+    hal_host_reset();  // erased flash
+    bool is_ok = !coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored);
+    for (unsigned i = 0; i < BENCH_LOG_WRITES; i++) {
+        charge = (int64_t)i * COULOMB_UA_US_PER_MAH + 12345;
+        is_ok &= coulomb_log_write(&log, charge);
+        // reset after each write
+        if (!coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored) || restored != charge) restore_errors++;
+    }
+    // the other source is independent
+    is_ok &= !coulomb_log_init(&log, COULOMB_SOURCE_ESC, &restored);
+    coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored);
+    // torn record: reset while programming, it falls back to the previous one and the next write skips it
+    coulomb_log_record_t torn = {.charge = 1, .sequence = log.sequence, .source = COULOMB_SOURCE_CURRENT, .crc = 0};
+    flash_range_program(log.offset + log.index * sizeof(torn), (const uint8_t *)&torn, 12);
+    if (!coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored) || restored != charge) restore_errors++;
+    charge += COULOMB_UA_US_PER_MAH;
+    coulomb_log_write(&log, charge);
+    if (!coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored) || restored != charge) restore_errors++;
+    // torn erase: the sector the log moves into next is half erased and half garbage
+    uint16_t next_sector = (log.index / COULOMB_LOG_RECORDS + 1) % 2;
+    uint8_t *sector = (uint8_t *)XIP_BASE + log.offset + next_sector * FLASH_SECTOR_SIZE;
+    memset(sector, 0xFF, FLASH_SECTOR_SIZE / 2);
+    for (unsigned i = FLASH_SECTOR_SIZE / 2; i < FLASH_SECTOR_SIZE; i++) sector[i] = uniform() * 256;
+    if (!coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored) || restored != charge) restore_errors++;
+    for (unsigned i = 0; i < 2 * COULOMB_LOG_RECORDS; i++) {
+        charge += COULOMB_UA_US_PER_MAH;
+        coulomb_log_write(&log, charge);
+        if (!coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored) || restored != charge) restore_errors++;
+    }
+    // flight: the rest of the sector and the one erased at start, then full
+    coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored);
+    uint32_t erases = hal_host_flash_erase_count();
+    unsigned capacity = (log.index % COULOMB_LOG_RECORDS ? COULOMB_LOG_RECORDS - log.index % COULOMB_LOG_RECORDS : 0) +
+                        COULOMB_LOG_RECORDS;
+    for (unsigned i = 0; i <= capacity; i++) {
+        if (!coulomb_log_write(&log, charge + COULOMB_UA_US_PER_MAH)) continue;
+        charge += COULOMB_UA_US_PER_MAH;
+        flight_writes++;
+    }
+    flight_erases = hal_host_flash_erase_count() - erases;
+    if (!coulomb_log_init(&log, COULOMB_SOURCE_CURRENT, &restored) || restored != charge) restore_errors++;
+    charge += COULOMB_UA_US_PER_MAH;
+    is_ok &= coulomb_log_write(&log, charge) && hal_host_flash_erase_count() - erases == 1;
+    is_ok &= !restore_errors && flight_writes == capacity && !flight_erases;
+    printf("\nlog writes %u records per sector %u restore errors %u flight writes %u/%u erases %u %s\n",
+           BENCH_LOG_WRITES + 2 * (unsigned)COULOMB_LOG_RECORDS + 1, (unsigned)COULOMB_LOG_RECORDS, restore_errors,
+           flight_writes, capacity, flight_erases, is_ok ? "ok" : "FAIL");
+    return is_ok;
+}
+
+/* common.c get_consumption() it replaced, with the time as a parameter */
+static float old_consumption(float current, uint32_t now, uint32_t *timestamp) {
+    if (!*timestamp) {
+        *timestamp = now;
+        return 0;
+    }
+    uint32_t interval = (now - *timestamp) / 1000;  // ms
+    float mah = current * interval / 3600.0;
+    *timestamp = now;
+    if (interval > 2000) return 0;
+    return mah;
+}
+
+static double constant(double t) { return 20; }
+
+static double constant_charge(double t) { return 20 * t / 3.6; }
+
+/* 40 +- 35 A, 10 s period */
+static double sine(double t) { return 40 + 35 * sin(2 * BENCH_PI * t / 10); }
+
+static double sine_charge(double t) {
+    return (40 * t - 35 * 10 / (2 * BENCH_PI) * (cos(2 * BENCH_PI * t / 10) - 1)) / 3.6;
+}
+
+/* 0 to 100 A over the hour */
+static double ramp(double t) { return 100 * t / BENCH_S; }
+
+static double ramp_charge(double t) { return 50 * t * t / BENCH_S / 3.6; }
+
+/* 80 A for 0.3 s every second, 5 A otherwise */
+static double pulse(double t) { return t - floor(t) < 0.3 ? 80 : 5; }
+
+static double pulse_charge(double t) {
+    double part = t - floor(t);
+    return (floor(t) * (80 * 0.3 + 5 * 0.7) + (part < 0.3 ? 80 * part : 80 * 0.3 + 5 * (part - 0.3))) / 3.6;
+}
+
+/* 0 to 1 */
+static double uniform(void) {
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) & 0xFFFF) / 65536.0;
+}
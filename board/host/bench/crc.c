@@ -0,0 +1,171 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "crc.h"
+
+/*
+   Crc benchmark
+   Compares each table function of crc.c with the bitwise code it replaced in the protocols, kept here as the
+   reference, over random buffers from a zero or a random running crc: once in one call and once chained over two
+   parts split at a random point, as srxl sends its header and payload. Then times both versions per byte
+*/
+
+#define BENCH_BUFFERS 100000
+#define BENCH_LENGTH_MAX 300
+#define BENCH_TIMING_BYTES 20000000
+
+typedef uint32_t (*bench_crc_t)(uint32_t crc, const uint8_t *data, uint32_t length);
+
+typedef struct bench_case_t {
+    const char *name;
+    bench_crc_t table, bitwise;
+    uint32_t mask;  // of a running crc
+} bench_case_t;
+
+static uint32_t table_dvb_s2(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t table_jeti8(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t table_maxim(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t table_jeti16(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t table_srxl(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t table_smartport(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t bitwise_dvb_s2(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t bitwise_jeti8(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t bitwise_maxim(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t bitwise_jeti16(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t bitwise_srxl(uint32_t crc, const uint8_t *data, uint32_t length);
+static uint32_t bitwise_smartport(uint32_t crc, const uint8_t *data, uint32_t length);
+static double time_ns(bench_crc_t crc, const uint8_t *data, uint32_t length);
+static uint32_t next(void);
+
+static const bench_case_t cases[] = {
+    {"crc8_dvb_s2", table_dvb_s2, bitwise_dvb_s2, 0xFF}, {"crc8_jeti", table_jeti8, bitwise_jeti8, 0xFF},
+    {"crc8_maxim", table_maxim, bitwise_maxim, 0xFF},    {"crc16_jeti", table_jeti16, bitwise_jeti16, 0xFFFF},
+    {"crc16_srxl", table_srxl, bitwise_srxl, 0xFFFF},    {"crc_smartport", table_smartport, bitwise_smartport, 0xFF},
+};
+static uint32_t seed = 1;
+
+int main(void) {
+    static uint8_t data[BENCH_LENGTH_MAX];
+    bool is_ok = true;
+    printf("%-14s %10s %10s %12s %12s\n", "crc", "whole", "chained", "table ns/B", "bitwise ns/B");
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const bench_case_t *bench = &cases[i];
+        unsigned whole = 0, chained = 0;
+        for (unsigned j = 0; j < BENCH_BUFFERS; j++) {
+            uint32_t length = next() % (BENCH_LENGTH_MAX + 1), split = length ? next() % (length + 1) : 0;
+            // half of the buffers continue a running crc
+            uint32_t init = j % 2 ? next() & bench->mask : 0;
+            for (uint32_t k = 0; k < length; k++) data[k] = next();
+            uint32_t expected = bench->bitwise(init, data, length);
+            whole += bench->table(init, data, length) != expected;
+            chained += bench->table(bench->table(init, data, split), data + split, length - split) != expected;
+        }
+        static uint8_t timing[4096];
+        for (uint32_t k = 0; k < sizeof(timing); k++) timing[k] = next();
+        double table_ns = time_ns(bench->table, timing, sizeof(timing));
+        double bitwise_ns = time_ns(bench->bitwise, timing, sizeof(timing));
+        bool is_case_ok = !whole && !chained;
+        printf("%-14s %10u %10u %12.2f %12.2f %s\n", bench->name, whole, chained, table_ns, bitwise_ns,
+               is_case_ok ? "ok" : "FAIL");
+        is_ok &= is_case_ok;
+    }
+    return is_ok ? 0 : 1;
+}
+
+static uint32_t table_dvb_s2(uint32_t crc, const uint8_t *data, uint32_t length) {
+    return crc8_dvb_s2(crc, data, length);
+}
+
+static uint32_t table_jeti8(uint32_t crc, const uint8_t *data, uint32_t length) { return crc8_jeti(crc, data, length); }
+
+static uint32_t table_maxim(uint32_t crc, const uint8_t *data, uint32_t length) {
+    return crc8_maxim(crc, data, length);
+}
+
+static uint32_t table_jeti16(uint32_t crc, const uint8_t *data, uint32_t length) {
+    return crc16_jeti(crc, data, length);
+}
+
+static uint32_t table_srxl(uint32_t crc, const uint8_t *data, uint32_t length) { return crc16_srxl(crc, data, length); }
+
+static uint32_t table_smartport(uint32_t crc, const uint8_t *data, uint32_t length) {
+    return crc_smartport(crc, data, length);
+}
+
+/* crsf.c crc8() */
+static uint32_t bitwise_dvb_s2(uint32_t crc, const uint8_t *data, uint32_t length) {
+    uint8_t crc8 = crc;
+    while (length--) {
+        crc8 ^= *data++;
+        for (int i = 0; i < 8; i++) crc8 = crc8 & 0x80 ? (crc8 << 1) ^ 0xD5 : crc8 << 1;
+    }
+    return crc8;
+}
+
+/* jetiex.c and esc_apd_f.c update_crc8() */
+static uint32_t bitwise_jeti8(uint32_t crc, const uint8_t *data, uint32_t length) {
+    uint8_t crc8 = crc;
+    while (length--) {
+        crc8 ^= *data++;
+        for (int i = 0; i < 8; i++) crc8 = crc8 & 0x80 ? 0x07 ^ (crc8 << 1) : crc8 << 1;
+    }
+    return crc8;
+}
+
+/* jr_dmss.c used a table, this is the reflected 0x31 polynomial it was generated from */
+static uint32_t bitwise_maxim(uint32_t crc, const uint8_t *data, uint32_t length) {
+    uint8_t crc8 = crc;
+    while (length--) {
+        crc8 ^= *data++;
+        for (int i = 0; i < 8; i++) crc8 = crc8 & 1 ? (crc8 >> 1) ^ 0x8C : crc8 >> 1;
+    }
+    return crc8;
+}
+
+/* jetiex.c update_crc16() */
+static uint32_t bitwise_jeti16(uint32_t crc, const uint8_t *data, uint32_t length) {
+    uint16_t crc16 = crc;
+    while (length--) {
+        uint8_t byte = *data++;
+        byte ^= (uint8_t)crc16;
+        byte ^= byte << 4;
+        crc16 = (((uint16_t)byte << 8) | (crc16 >> 8)) ^ (uint8_t)(byte >> 4) ^ ((uint16_t)byte << 3);
+    }
+    return crc16;
+}
+
+/* srxl.c srxl_crc16() */
+static uint32_t bitwise_srxl(uint32_t crc, const uint8_t *data, uint32_t length) {
+    uint16_t crc16 = crc;
+    while (length--) {
+        crc16 ^= (uint16_t)*data++ << 8;
+        for (int i = 0; i < 8; i++) crc16 = crc16 & 0x8000 ? (crc16 << 1) ^ 0x1021 : crc16 << 1;
+    }
+    return crc16;
+}
+
+/* smartport.c send_byte(), folded per byte */
+static uint32_t bitwise_smartport(uint32_t crc, const uint8_t *data, uint32_t length) {
+    uint16_t sum = crc;
+    while (length--) {
+        sum += *data++;
+        sum += sum >> 8;
+        sum &= 0xFF;
+    }
+    return sum;
+}
+
+static double time_ns(bench_crc_t crc, const uint8_t *data, uint32_t length) {
+    struct timespec start, end;
+    volatile uint32_t sink = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t done = 0; done < BENCH_TIMING_BYTES; done += length) sink += crc(sink & 0xFF, data, length);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / BENCH_TIMING_BYTES;
+}
+
+static uint32_t next(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
@@ -0,0 +1,152 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "crc.h"
+#include "crsf.h"
+#include "hal_host.h"
+#include "pool.h"
+#include "sensor_registry.h"
+
+/*
+   CRSF telemetry rate benchmark
+   Runs crsf_task with every sensor enabled for 60 s of simulated time, once without a receiver stream and once per
+   rc frame rate, and reports the achieved rate of each telemetry frame type against its target. The rc frame rate is
+   the link packet rate the telemetry budget follows, so the lower rates show which frame types are slowed down first.
+   No frame type may starve: each one must reach at least BENCH_SHARE_MIN of its target scaled by the share of the
+   unpaced bytes/s the link carries
+*/
+
+#define BENCH_STARTUP_US 3000000
+#define BENCH_REPLAY_US 60000000
+#define BENCH_STEP_US 1000
+#define BENCH_SHARE_MIN 0.5
+
+typedef struct bench_frame_t {
+    uint8_t type;
+    const char *name;
+    float target_hz;
+    uint count;
+} bench_frame_t;
+
+static bool replay(const char *name, uint rc_hz);
+static void mix_all(config_t *config);
+static void fill_values(sensor_values_t *values);
+static uint rc_frame(uint8_t *data);
+static uint count_frames(bench_frame_t *frames, uint count, const uint8_t *data, uint length);
+
+static const bench_frame_t frame_types[] = {
+    {0x02, "gps", 5},   {0x07, "vario", 20},  {0x08, "battery", 5},  {0x09, "baro alt", 10}, {0x0A, "airspeed", 10},
+    {0x0C, "rpm", 5},   {0x0D, "temp", 1},    {0x0E, "cells", 2},    {0x03, "gps time", 1},  {0x06, "gps ext", 2},
+};
+
+int main(void) {
+    bool is_ok = true;
+    printf("%-10s %-10s %10s %12s %12s\n", "rc frames", "frame", "target Hz", "achieved Hz", "minimum Hz");
+    is_ok &= replay("none", 0);
+    is_ok &= replay("150 Hz", 150);
+    is_ok &= replay("50 Hz", 50);
+    is_ok &= replay("10 Hz", 10);
+    return is_ok ? 0 : 1;
+}
+
+/* The first call has no receiver stream, its bytes/s is the unpaced one the others are scaled by */
+static bool replay(const char *name, uint rc_hz) {
+    static uint unpaced_bytes;
+    bool is_ok = true;
+    bench_frame_t frames[count_of(frame_types)];
+    config_t config;
+    uint8_t data[64], tx[1024];
+    uint bytes = 0;
+
+    memcpy(frames, frame_types, sizeof(frames));
+    hal_host_reset();
+    config_forze_write();
+    config_get(&config);
+    config.rx_protocol = RX_CRSF;
+    config.debug = 0;
+    mix_all(&config);
+    config_write(&config);
+    for (uint i = 0; i < 5; i++) hal_host_adc_set(i, 1500);
+
+    context.tasks_queue_handle = pool_queue_create(64, sizeof(QueueHandle_t));
+    pool_task_create(crsf_task, "crsf", STACK_RX_CRSF, NULL, 3, &context.receiver_task_handle);
+    context.uart0_notify_task_handle = context.receiver_task_handle;
+    hal_host_start_scheduler();
+    hal_host_advance_us(BENCH_STARTUP_US);
+    fill_values(sensor_registry_values());
+    while (hal_host_uart_tx(HAL_HOST_UART0, tx, sizeof(tx)))
+        ;
+
+    uint64_t next_rc_us = 0;
+    for (uint64_t now_us = 0; now_us < BENCH_REPLAY_US; now_us += BENCH_STEP_US) {
+        if (rc_hz && now_us >= next_rc_us) {
+            hal_host_uart_rx(HAL_HOST_UART0, data, rc_frame(data));
+            next_rc_us += 1000000 / rc_hz;
+        }
+        hal_host_advance_us(BENCH_STEP_US);
+        uint length;
+        while ((length = hal_host_uart_tx(HAL_HOST_UART0, tx, sizeof(tx))))
+            bytes += count_frames(frames, count_of(frames), tx, length);
+    }
+    if (!unpaced_bytes) unpaced_bytes = bytes;
+    float share = (float)bytes / unpaced_bytes;
+    if (share > 1) share = 1;
+    for (uint i = 0; i < count_of(frames); i++) {
+        if (!frames[i].count) continue;
+        float achieved_hz = frames[i].count * 1e6 / BENCH_REPLAY_US;
+        float min_hz = BENCH_SHARE_MIN * share * frames[i].target_hz;
+        printf("%-10s %-10s %10.1f %12.2f %12.2f %s\n", name, frames[i].name, frames[i].target_hz, achieved_hz, min_hz,
+               achieved_hz >= min_hz ? "ok" : "FAIL");
+        is_ok &= achieved_hz >= min_hz;
+    }
+    printf("%-10s %-10s %10s %12.0f\n", name, "bytes/s", "", bytes * 1e6 / BENCH_REPLAY_US);
+    return is_ok;
+}
+
+/* Every sensor task at once, as the all mix of bench.c */
+static void mix_all(config_t *config) {
+    config->esc_protocol = ESC_HW4;
+    config->enable_gps = true;
+    config->enable_analog_voltage = true;
+    config->enable_analog_current = true;
+    config->enable_analog_ntc = true;
+    config->i2c_module = I2C_BMP280;
+    config->enable_analog_airspeed = true;
+    config->enable_fuel_flow = true;
+    config->enable_fuel_pressure = true;
+    config->enable_pwm_out = true;
+    config->gpio_mask = 0x3F;
+}
+
+static void fill_values(sensor_values_t *values) {
+    values->esc = (sensor_esc_t){.rpm = 12000, .voltage = 22.2, .current = 35.5, .consumption = 1234,
+                                 .cell_voltage = 3.7, .temperature_fet = 45, .temperature_bec = 40,
+                                 .voltage_bec = 5.1, .current_bec = 1.2, .cell_count = 6};
+    values->gps = (sensor_gps_t){.lat = 2389.123, .lon = -412.456, .alt = 123.4, .spd = 12.3, .cog = 270.5,
+                                 .hdop = 0.9, .sat = 12, .time = 123456, .date = 10124, .vspeed = 1.5,
+                                 .dist = 456, .fix = 3};
+    values->baro = (sensor_baro_t){.temperature = 25, .pressure = 101325, .altitude = 120.5, .vspeed = 1.2};
+    values->analog = (sensor_analog_t){.voltage = 12.6, .current = 10.2, .consumption = 850, .ntc = 30};
+}
+
+/* RC channels packed, 16 channels at center */
+static uint rc_frame(uint8_t *data) {
+    data[0] = 0xC8;
+    data[1] = 24;
+    data[2] = 0x16;
+    for (uint i = 3; i < 25; i++) data[i] = 0x55;
+    data[25] = crc8_dvb_s2(0, &data[2], 23);
+    return 26;
+}
+
+/* Transmitted bytes are whole bursts of frames: [sync] [len] [type] [payload] [crc] */
+static uint count_frames(bench_frame_t *frames, uint count, const uint8_t *data, uint length) {
+    uint i = 0;
+    for (; i + 2 < length && data[i] == 0xC8; i += data[i + 1] + 2) {
+        for (uint j = 0; j < count; j++)
+            if (frames[j].type == data[i + 2]) frames[j].count++;
+    }
+    return i;
+}
@@ -0,0 +1,160 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "distance.h"
+
+/*
+   Distance benchmark
+   Accuracy of distance.c against a double precision haversine, for home latitudes from 0 to 75 deg and points every
+   15 deg of bearing at each range, with the coordinates rounded to the deg * 1e7 of the gps. The old column is the
+   float haversine it replaced, with pi as 3.1416 and the float coordinates of the sensor values. Times both per call
+   (the host has an fpu, the M0+ does not, so only the ratio carries over). Then flies a 500 m circle at 20 m/s and
+   stands still for 10 minutes with 1 m of position noise at 10 Hz, and compares the odometer with the real track
+*/
+
+#define BENCH_RUNS 2000000
+#define BENCH_TRACK_S 600
+#define BENCH_TRACK_HZ 10
+#define EARTH_RADIUS_M 6371000.0
+
+static void accuracy(double range);
+static void speed(void);
+static void track(const char *name, double speed_ms, double radius_m);
+static void destination(double lat, double lon, double bearing, double range, double *lat_to, double *lon_to);
+static double reference(double lat, double lon, double lat_home, double lon_home, double *bearing);
+static float old_distance(float lat, float lon, float lat_init, float lon_init);
+static double noise(void);
+static double elapsed_ns(struct timespec *start);
+
+static const double ranges[] = {10, 100, 1000, 5000, 20000, 50000, 200000};
+static const double latitudes[] = {0, 45, 60, 75};
+static uint32_t seed = 1;
+
+int main(void) {
+    printf("%9s %12s %12s %12s %12s %12s\n", "range m", "new max m", "new max %", "bearing deg", "old max m",
+           "old max %");
+    for (unsigned i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) accuracy(ranges[i]);
+    printf("\n");
+    speed();
+    printf("\n%-9s %10s %12s %12s\n", "track", "real m", "odometer m", "per epoch m");
+    track("circle", 20, 500);
+    track("stopped", 0, 0);
+    return 0;
+}
+
+static void accuracy(double range) {
+    double new_max = 0, new_relative = 0, bearing_max = 0, old_max = 0, old_relative = 0;
+    for (unsigned i = 0; i < sizeof(latitudes) / sizeof(latitudes[0]); i++) {
+        distance_t distance;
+        gps_fix_t home = {.lat = latitudes[i] * 1e7, .lon = -1225000000, .sat = 10};
+        distance_init(&distance);
+        distance_update(&distance, &home);
+        for (unsigned bearing = 0; bearing < 360; bearing += 15) {
+            double lat, lon, real_bearing;
+            destination(home.lat / 1e7, home.lon / 1e7, bearing, range, &lat, &lon);
+            int32_t lat_e7 = lround(lat * 1e7), lon_e7 = lround(lon * 1e7);
+            double real = reference(lat_e7 / 1e7, lon_e7 / 1e7, home.lat / 1e7, home.lon / 1e7, &real_bearing);
+            float new_bearing;
+            double error = fabs(distance_to_home(&distance, lat_e7, lon_e7, &new_bearing) - real);
+            double bearing_error = fabs(fmod(new_bearing - real_bearing + 540, 360) - 180);
+            double old_error =
+                fabs(old_distance(lat_e7 * 1e-7, lon_e7 * 1e-7, home.lat * 1e-7, home.lon * 1e-7) - real);
+            if (error > new_max) new_max = error;
+            if (error / real > new_relative) new_relative = error / real;
+            if (bearing_error > bearing_max) bearing_max = bearing_error;
+            if (old_error > old_max) old_max = old_error;
+            if (old_error / real > old_relative) old_relative = old_error / real;
+        }
+    }
+    printf("%9.0f %12.2f %12.3f %12.3f %12.2f %12.3f\n", range, new_max, new_relative * 100, bearing_max, old_max,
+           old_relative * 100);
+}
+
+static void speed(void) {
+    distance_t distance;
+    gps_fix_t home = {.lat = 475000000, .lon = -1225000000, .sat = 10};
+    struct timespec start;
+    volatile float sink = 0;
+    distance_init(&distance);
+    distance_update(&distance, &home);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned i = 0; i < BENCH_RUNS; i++) {
+        float bearing;
+        sink += distance_to_home(&distance, home.lat + (i & 0xFFFF), home.lon - (i & 0x3FFF), &bearing);
+    }
+    double new_ns = elapsed_ns(&start) / BENCH_RUNS;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned i = 0; i < BENCH_RUNS; i++)
+        sink += old_distance(47.5F + (i & 0xFFFF) * 1e-7F, -122.5F - (i & 0x3FFF) * 1e-7F, 47.5F, -122.5F);
+    double old_ns = elapsed_ns(&start) / BENCH_RUNS;
+    printf("ns/call new %.1f (with bearing) old %.1f\n", new_ns, old_ns);
+}
+
+/* Real track against the odometer and against adding up the distance between consecutive epochs */
+static void track(const char *name, double speed_ms, double radius_m) {
+    distance_t distance;
+    double real = 0, per_epoch = 0, last_lat = 0, last_lon = 0;
+    distance_init(&distance);
+    for (unsigned i = 0; i < BENCH_TRACK_S * BENCH_TRACK_HZ; i++) {
+        double angle = radius_m ? speed_ms * i / BENCH_TRACK_HZ / radius_m : 0;
+        double lat, lon, noisy_lat, noisy_lon;
+        destination(47.5, -122.5, angle * 180 / M_PI, radius_m, &lat, &lon);
+        destination(lat, lon, noise() * 180 + 180, fabs(noise()), &noisy_lat, &noisy_lon);
+        gps_fix_t fix = {.lat = lround(noisy_lat * 1e7), .lon = lround(noisy_lon * 1e7), .sat = 10};
+        distance_update(&distance, &fix);
+        if (i) {
+            real += speed_ms / BENCH_TRACK_HZ;
+            per_epoch += reference(noisy_lat, noisy_lon, last_lat, last_lon, NULL);
+        }
+        last_lat = noisy_lat;
+        last_lon = noisy_lon;
+    }
+    printf("%-9s %10.0f %12.0f %12.0f\n", name, real, distance.odometer, per_epoch);
+}
+
+static void destination(double lat, double lon, double bearing, double range, double *lat_to, double *lon_to) {
+    double phi = lat * M_PI / 180, theta = bearing * M_PI / 180, delta = range / EARTH_RADIUS_M;
+    double phi_to = asin(sin(phi) * cos(delta) + cos(phi) * sin(delta) * cos(theta));
+    double lambda = atan2(sin(theta) * sin(delta) * cos(phi), cos(delta) - sin(phi) * sin(phi_to));
+    *lat_to = phi_to * 180 / M_PI;
+    *lon_to = lon + lambda * 180 / M_PI;
+}
+
+/* Haversine distance and bearing from lat, lon to home */
+static double reference(double lat, double lon, double lat_home, double lon_home, double *bearing) {
+    double phi = lat * M_PI / 180, phi_home = lat_home * M_PI / 180, lambda = (lon_home - lon) * M_PI / 180;
+    double a = pow(sin((phi_home - phi) / 2), 2) + cos(phi) * cos(phi_home) * pow(sin(lambda / 2), 2);
+    if (bearing) {
+        double y = sin(lambda) * cos(phi_home);
+        double x = cos(phi) * sin(phi_home) - sin(phi) * cos(phi_home) * cos(lambda);
+        *bearing = fmod(atan2(y, x) * 180 / M_PI + 360, 360);
+    }
+    return 2 * EARTH_RADIUS_M * asin(sqrt(a));
+}
+
+/* distance.c get_distance_to_home() it replaced, on the ground */
+static float old_distance(float lat, float lon, float lat_init, float lon_init) {
+    uint16_t earth_radius_km = 6371;
+    float rad_lat_init = lat_init * 3.1416 / 180;
+    float rad_lat_delta = (lat_init - lat) * 3.1416 / 180;
+    float rad_lon_delta = (lon_init - lon) * 3.1416 / 180;
+    float rad_lat = lat * 3.1416 / 180;
+    float a = sin(rad_lat_delta / 2) * sin(rad_lat_delta / 2) +
+              sin(rad_lon_delta / 2) * sin(rad_lon_delta / 2) * cos(rad_lat) * cos(rad_lat_init);
+    float c = 2 * atan2(sqrt(a), sqrt(1 - a));
+    return earth_radius_km * c * 1000;
+}
+
+/* -1 to 1 */
+static double noise(void) {
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) & 0xFFFF) / 32768.0 - 1;
+}
+
+static double elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
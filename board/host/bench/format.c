@@ -0,0 +1,196 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "format.h"
+
+/*
+   Formatting kernel benchmark
+   Compares format.c with the float and printf code it replaced in the xbus, hitec and multiplex encoders. Every kernel
+   is checked for identical output (bcd over all 8 and 16 bit values and a sweep of 32 bit values, rounding over a
+   stride of all float bit patterns), then timed on the same inputs.
+   The gps coordinate kernels are checked against the exact value (in double) instead: the float code they replaced in
+   the frsky_d, smartport, jeti and hott encoders was off by up to 4/10000 minutes, and the frsky_d sprintf("%d%d")
+   dropped the leading zero of the minutes. Minutes is checked over every float bit pattern from 0 to 180 degrees
+*/
+
+#define BENCH_STRIDE_BCD32 997
+#define BENCH_STRIDE_FLOAT 61
+#define BENCH_TIMED 1000000
+#define BENCH_COORDINATE_MAX 180.0F
+
+typedef struct bench_row_t {
+    const char *name;
+    uint64_t checked, mismatches;
+    double old_ns, new_ns;
+} bench_row_t;
+
+static uint32_t old_bcd(uint32_t value, unsigned digits);
+static int32_t old_round(float value, int32_t min, int32_t max);
+static uint32_t old_minutes(float value);
+static uint16_t old_ddmm(float value);
+static bench_row_t check_bcd(const char *name, unsigned digits, uint64_t last, uint64_t stride);
+static bench_row_t check_round(void);
+static bench_row_t check_minutes(void);
+static bench_row_t check_ddmm(void);
+static double elapsed_ns(struct timespec *start);
+static void print(bench_row_t row);
+
+static volatile uint32_t sink;
+
+int main(void) {
+    printf("%-10s %12s %10s %9s %9s\n", "kernel", "checked", "mismatch", "old ns", "new ns");
+    print(check_bcd("bcd8", 2, UINT8_MAX, 1));
+    print(check_bcd("bcd16", 4, UINT16_MAX, 1));
+    print(check_bcd("bcd32", 8, UINT32_MAX, BENCH_STRIDE_BCD32));
+    print(check_round());
+    print(check_minutes());
+    print(check_ddmm());
+    return 0;
+}
+
+/* xbus.c bcd8/16/32 after scaling */
+static uint32_t old_bcd(uint32_t value, unsigned digits) {
+    char buf[16] = {0};
+    char format[8];
+    uint32_t output = 0;
+    snprintf(format, sizeof(format), "%%0%ulu", digits);
+    snprintf(buf, sizeof(buf), format, (unsigned long)value);
+    for (unsigned i = 0; i < digits; i++) output |= (uint32_t)(buf[i] - 48) << ((digits - 1 - i) * 4);
+    return output;
+}
+
+/* multiplex.c format(), hitec.c rounding. Only defined for values in range */
+static int32_t old_round(float value, int32_t min, int32_t max) {
+    int32_t formatted = round(value);
+    if (formatted > max) formatted = max;
+    if (formatted < min) formatted = min;
+    return formatted;
+}
+
+/* smartport.c format_coordinate() */
+static uint32_t old_minutes(float value) {
+    if (value < 0) value *= -1;
+    return (uint32_t)(value * 60 * 10000);
+}
+
+/* frsky_d.c format() for GPS_LAT_BP_ID and GPS_LONG_BP_ID */
+static uint16_t old_ddmm(float value) {
+    float coord = fabs(value);
+    uint8_t deg = coord;
+    uint8_t min = (coord - deg) * 60;
+    char buf[7];
+    sprintf(buf, "%d%d", deg, min);
+    return atoi(buf);
+}
+
+static bench_row_t check_bcd(const char *name, unsigned digits, uint64_t last, uint64_t stride) {
+    bench_row_t row = {name};
+    for (uint64_t value = 0; value <= last; value += stride) {
+        row.checked++;
+        if (old_bcd(value, digits) != format_bcd(value, digits)) row.mismatches++;
+    }
+    for (uint64_t power = 10; power <= last; power *= 10) {
+        for (uint64_t value = power - 2; value <= power + 1 && value <= last; value++) {
+            row.checked++;
+            if (old_bcd(value, digits) != format_bcd(value, digits)) row.mismatches++;
+        }
+    }
+    struct timespec start;
+    uint32_t mask = last > 99999999 ? 99999999 : last;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = old_bcd((i * 7919) % (mask + 1), digits);
+    row.old_ns = elapsed_ns(&start) / BENCH_TIMED;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = format_bcd((i * 7919) % (mask + 1), digits);
+    row.new_ns = elapsed_ns(&start) / BENCH_TIMED;
+    return row;
+}
+
+static bench_row_t check_round(void) {
+    bench_row_t row = {"round"};
+    for (uint64_t bits = 0; bits <= UINT32_MAX; bits += BENCH_STRIDE_FLOAT) {
+        uint32_t word = bits;
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        if (isnan(value)) continue;
+        float rounded = roundf(value);
+        int32_t expected;
+        if (rounded <= -16383)
+            expected = -16383;
+        else if (rounded >= 16383)
+            expected = 16383;
+        else
+            expected = old_round(value, -16383, 16383);
+        row.checked++;
+        if (format_round(value, -16383, 16383) != expected) row.mismatches++;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = old_round(i * 0.37F - 5000, -16383, 16383);
+    row.old_ns = elapsed_ns(&start) / BENCH_TIMED;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = format_round(i * 0.37F - 5000, -16383, 16383);
+    row.new_ns = elapsed_ns(&start) / BENCH_TIMED;
+    return row;
+}
+
+static bench_row_t check_minutes(void) {
+    bench_row_t row = {"minutes"};
+    uint32_t last;
+    float max = BENCH_COORDINATE_MAX;
+    memcpy(&last, &max, sizeof(last));
+    for (uint64_t bits = 0; bits <= last; bits++) {
+        uint32_t word = bits;
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        row.checked++;
+        if (format_minutes(value) != (uint32_t)floor((double)value * 600000)) row.mismatches++;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = old_minutes(i * 0.00037F - 180);
+    row.old_ns = elapsed_ns(&start) / BENCH_TIMED;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = format_minutes(i * 0.00037F - 180);
+    row.new_ns = elapsed_ns(&start) / BENCH_TIMED;
+    return row;
+}
+
+static bench_row_t check_ddmm(void) {
+    bench_row_t row = {"ddmm"};
+    uint32_t last;
+    float max = BENCH_COORDINATE_MAX;
+    memcpy(&last, &max, sizeof(last));
+    for (uint64_t bits = 0; bits <= last; bits += BENCH_STRIDE_FLOAT) {
+        uint32_t word = bits;
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        uint32_t degrees = value;
+        uint32_t expected = degrees * 100 + (uint32_t)floor(((double)value - degrees) * 60);
+        row.checked++;
+        if (format_ddmm(format_minutes(value)) != expected) row.mismatches++;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = old_ddmm(i * 0.00037F - 180);
+    row.old_ns = elapsed_ns(&start) / BENCH_TIMED;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = format_ddmm(format_minutes(i * 0.00037F - 180));
+    row.new_ns = elapsed_ns(&start) / BENCH_TIMED;
+    return row;
+}
+
+static double elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+static void print(bench_row_t row) {
+    printf("%-10s %12llu %10llu %9.1f %9.1f\n", row.name, (unsigned long long)row.checked,
+           (unsigned long long)row.mismatches, row.old_ns, row.new_ns);
+}
@@ -0,0 +1,151 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "crc.h"
+#include "frame_builder.h"
+
+/*
+   Frame builder benchmark
+   Checks frame_builder.c against golden FrSky D and Smartport frames, covering the escape of the flag and escape
+   bytes (0x5D/0x5E, 0x7D/0x7E) in every field and in the crc, then times it against the byte per write code it
+   replaced. The old code is timed with a counting write in place of uart0_write, so it is the cost before the uart
+*/
+
+#define BENCH_TIMED 1000000
+
+typedef struct bench_golden_t {
+    uint8_t id;
+    uint16_t data_id;
+    uint32_t value;
+    uint8_t length;
+    uint8_t frame[FRAME_BUILDER_SMARTPORT_MAX];
+} bench_golden_t;
+
+typedef struct bench_row_t {
+    const char *name;
+    unsigned checked, mismatches;
+    double old_ns, new_ns, old_writes;
+} bench_row_t;
+
+static void old_write(uint8_t c);
+static void old_frsky_d(uint8_t data_id, uint16_t value);
+static void old_smartport(uint8_t frame_id, uint16_t data_id, uint32_t value);
+static bench_row_t check_frsky_d(void);
+static bench_row_t check_smartport(void);
+static double elapsed_ns(struct timespec *start);
+static void print(bench_row_t row);
+
+// frsky_d: id is the data id. smartport: id is the frame id
+static const bench_golden_t golden_frsky_d[] = {
+    {0x10, 0, 0x1234, 5, {0x5E, 0x10, 0x34, 0x12, 0x5E}},
+    {0x10, 0, 0x5D5E, 7, {0x5E, 0x10, 0x5D, 0x3E, 0x5D, 0x3D, 0x5E}},
+    {0x5E, 0, 0x005D, 7, {0x5E, 0x5D, 0x3E, 0x5D, 0x3D, 0x00, 0x5E}},
+    {0x5D, 0, 0x5E5E, 8, {0x5E, 0x5D, 0x3D, 0x5D, 0x3E, 0x5D, 0x3E, 0x5E}},
+};
+static const bench_golden_t golden_smartport[] = {
+    {0x10, 0x0110, 1234, 8, {0x10, 0x10, 0x01, 0xD2, 0x04, 0x00, 0x00, 0x08}},
+    {0x10, 0x0500, 0x7E, 9, {0x10, 0x00, 0x05, 0x7D, 0x5E, 0x00, 0x00, 0x00, 0x6C}},
+    {0x10, 0x0500, 0x7D7E, 10, {0x10, 0x00, 0x05, 0x7D, 0x5E, 0x7D, 0x5D, 0x00, 0x00, 0xEE}},
+    {0x10, 0x0500, 0x6C, 9, {0x10, 0x00, 0x05, 0x6C, 0x00, 0x00, 0x00, 0x7D, 0x5E}},  // crc 0x7E
+    {0x7E, 0x7D7E, 0x7E7D, 13, {0x7D, 0x5E, 0x7D, 0x5E, 0x7D, 0x5D, 0x7D, 0x5D, 0x7D, 0x5E, 0x00, 0x00, 0x89}},
+};
+
+static volatile uint8_t sink;
+static unsigned writes;
+
+int main(void) {
+    printf("%-10s %8s %10s %10s %9s %9s\n", "frame", "checked", "mismatch", "old writes", "old ns", "new ns");
+    print(check_frsky_d());
+    print(check_smartport());
+    return 0;
+}
+
+/* Stands for uart0_write */
+static void __attribute__((noinline)) old_write(uint8_t c) {
+    sink = c;
+    writes++;
+}
+
+/* frsky_d.c send_byte() and send_packet() */
+static void old_frsky_d(uint8_t data_id, uint16_t value) {
+    uint8_t bytes[3] = {data_id, value, value >> 8};
+    old_write(0x5E);
+    for (unsigned i = 0; i < sizeof(bytes); i++) {
+        uint8_t c = bytes[i];
+        if (c == 0x5D || c == 0x5E) {
+            old_write(0x5D);
+            c ^= 0x60;
+        }
+        old_write(c);
+    }
+    old_write(0x5E);
+}
+
+/* smartport.c send_byte() and send_packet() */
+static void old_smartport(uint8_t frame_id, uint16_t data_id, uint32_t value) {
+    uint8_t buffer[8] = {frame_id, data_id, data_id >> 8, value, value >> 8, value >> 16, value >> 24};
+    buffer[7] = 0xFF - crc_smartport(0, buffer, 7);
+    for (unsigned i = 0; i < sizeof(buffer); i++) {
+        uint8_t c = buffer[i];
+        if (c == 0x7D || c == 0x7E) {
+            old_write(c);
+            c ^= 0x20;
+        }
+        old_write(c);
+    }
+}
+
+static bench_row_t check_frsky_d(void) {
+    bench_row_t row = {"frsky_d"};
+    uint8_t buffer[FRAME_BUILDER_FRSKY_D_MAX];
+    for (unsigned i = 0; i < sizeof(golden_frsky_d) / sizeof(golden_frsky_d[0]); i++) {
+        const bench_golden_t *golden = &golden_frsky_d[i];
+        uint32_t length = frame_builder_frsky_d(buffer, golden->id, golden->value);
+        row.checked++;
+        if (length != golden->length || memcmp(buffer, golden->frame, length)) row.mismatches++;
+    }
+    struct timespec start;
+    writes = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) old_frsky_d(i & 0x0F, i * 7919);
+    row.old_ns = elapsed_ns(&start) / BENCH_TIMED;
+    row.old_writes = (double)writes / BENCH_TIMED;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = frame_builder_frsky_d(buffer, i & 0x0F, i * 7919);
+    row.new_ns = elapsed_ns(&start) / BENCH_TIMED;
+    return row;
+}
+
+static bench_row_t check_smartport(void) {
+    bench_row_t row = {"smartport"};
+    uint8_t buffer[FRAME_BUILDER_SMARTPORT_MAX];
+    for (unsigned i = 0; i < sizeof(golden_smartport) / sizeof(golden_smartport[0]); i++) {
+        const bench_golden_t *golden = &golden_smartport[i];
+        uint32_t length = frame_builder_smartport(buffer, golden->id, golden->data_id, golden->value);
+        row.checked++;
+        if (length != golden->length || memcmp(buffer, golden->frame, length)) row.mismatches++;
+    }
+    struct timespec start;
+    writes = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) old_smartport(0x10, 0x0110, i * 7919);
+    row.old_ns = elapsed_ns(&start) / BENCH_TIMED;
+    row.old_writes = (double)writes / BENCH_TIMED;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_TIMED; i++) sink = frame_builder_smartport(buffer, 0x10, 0x0110, i * 7919);
+    row.new_ns = elapsed_ns(&start) / BENCH_TIMED;
+    return row;
+}
+
+static double elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+static void print(bench_row_t row) {
+    printf("%-10s %8u %10u %10.2f %9.1f %9.1f\n", row.name, row.checked, row.mismatches, row.old_writes, row.old_ns,
+           row.new_ns);
+}
@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "gps_parser.h"
+
+/*
+   GPS parser benchmark
+   Generates 60 s logs of a u-blox module at 10 Hz and 25 Hz, UBX (NAV-DOP and NAV-PVT per epoch) and NMEA (GGA and
+   RMC per epoch), as recorded from the uart, feeds them to gps_parser.c and checks every published epoch against the
+   generated one. The clean logs must publish every epoch, exact. The corrupt rows flip a bit every 2000 bytes: corrupt
+   messages fail the checksum, a UBX epoch that lost its NAV-DOP keeps the previous DOP (old dop) and an NMEA epoch
+   that lost GGA or RMC is not published (incomplete). No published epoch may mix other fields of two epochs (mixed).
+   Times the parser per byte and as cpu share at the log rate, for NMEA also the atof parser it replaced
+*/
+
+#define BENCH_LOG_S 60
+#define BENCH_RUNS 20
+#define BENCH_CORRUPT_BYTES 2000
+
+typedef struct bench_log_t {
+    uint8_t *data;
+    size_t length;
+    gps_fix_t *expected;
+    unsigned epochs;
+} bench_log_t;
+
+typedef struct bench_row_t {
+    const char *name;
+    unsigned rate, epochs, published, exact, old_dop, mixed, incomplete, errors;
+    bool is_corrupt;
+    double bytes_s, new_ns, old_ns;
+} bench_row_t;
+
+typedef struct old_fix_t {
+    float lat, lon, alt, spd, spd_kmh, cog, date, time, sat, hdop;
+} old_fix_t;
+
+static void flight(unsigned epoch, unsigned rate, bool is_ubx, gps_fix_t *fix);
+static void log_ubx(bench_log_t *log, unsigned rate);
+static void log_nmea(bench_log_t *log, unsigned rate);
+static void put_ubx(bench_log_t *log, uint8_t id, const uint8_t *payload, uint16_t length);
+static void put_nmea(bench_log_t *log, const char *body);
+static void put_coordinate(char *buffer, int32_t value, bool is_lon);
+static void put_u16(uint8_t *data, uint16_t value);
+static void put_i32(uint8_t *data, int32_t value);
+static void corrupt(bench_log_t *log);
+static bench_row_t run(const char *name, bench_log_t *log, unsigned rate, bool is_nmea, bool is_corrupt);
+static void old_nmea(const uint8_t *data, size_t length, old_fix_t *fix);
+static void old_parser(uint8_t nmea_cmd, uint8_t cmd_field, char *buffer, old_fix_t *fix);
+static double elapsed_ns(struct timespec *start);
+static bool print(bench_row_t row);
+
+static const unsigned rates[] = {10, 25};
+static uint32_t seed = 1;
+
+int main(void) {
+    bool is_ok = true;
+    printf("%-13s %4s %7s %9s %7s %7s %6s %10s %6s %8s %8s %8s %7s\n", "log", "Hz", "epochs", "published", "exact",
+           "old dop", "mixed", "incomplete", "errors", "bytes/s", "new ns/B", "old ns/B", "cpu %");
+    for (unsigned i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        bench_log_t log;
+        log_ubx(&log, rates[i]);
+        is_ok &= print(run("ubx", &log, rates[i], false, false));
+        corrupt(&log);
+        is_ok &= print(run("ubx corrupt", &log, rates[i], false, true));
+        free(log.data);
+        free(log.expected);
+        log_nmea(&log, rates[i]);
+        is_ok &= print(run("nmea", &log, rates[i], true, false));
+        corrupt(&log);
+        is_ok &= print(run("nmea corrupt", &log, rates[i], true, true));
+        free(log.data);
+        free(log.expected);
+    }
+    return is_ok ? 0 : 1;
+}
+
+/* A climbing circle west of Greenwich, in the units each protocol can carry exactly */
+static void flight(unsigned epoch, unsigned rate, bool is_ubx, gps_fix_t *fix) {
+    unsigned seconds = 12 * 3600 + 30 * 60 + epoch / rate;
+    uint32_t knots = 25000 + epoch % 1000;  // kts * 1000
+    memset(fix, 0, sizeof(gps_fix_t));
+    fix->lat = 475000000 + epoch * 37;
+    fix->lon = -1225000000 + epoch * 23;
+    fix->alt = 120000 + epoch * 100;
+    fix->speed = knots * 1852 / 3600;
+    fix->cog = epoch * 1000 % 36000000;
+    fix->time = seconds / 3600 * 10000 + seconds / 60 % 60 * 100 + seconds % 60;
+    fix->date = 171026;
+    fix->hdop = 90 + epoch % 10;
+    fix->sat = 12 + epoch % 4;
+    fix->fix = 3;
+    if (!is_ubx) return;
+    fix->alt_elipsiod = fix->alt + 48000;
+    fix->vel_n = 1000 + epoch % 50;
+    fix->vel_e = -2000 + epoch % 70;
+    fix->vel_d = -500 + epoch % 30;
+    fix->h_acc = 1500;
+    fix->v_acc = 2500;
+    fix->speed_acc = 300;
+    fix->track_acc = 50000;
+    fix->vdop = 120;
+    fix->pdop = 150;
+    fix->is_ubx = true;
+}
+
+static void log_ubx(bench_log_t *log, unsigned rate) {
+    log->epochs = BENCH_LOG_S * rate;
+    log->length = 0;
+    log->data = malloc(log->epochs * 128);
+    log->expected = malloc(log->epochs * sizeof(gps_fix_t));
+    for (unsigned i = 0; i < log->epochs; i++) {
+        gps_fix_t *fix = &log->expected[i];
+        uint8_t dop[18] = {0}, pvt[92] = {0};
+        flight(i, rate, true, fix);
+        put_i32(dop, i * 1000 / rate);
+        put_u16(dop + 6, fix->pdop);
+        put_u16(dop + 10, fix->vdop);
+        put_u16(dop + 12, fix->hdop);
+        put_ubx(log, 0x04, dop, sizeof(dop));
+        put_i32(pvt, i * 1000 / rate);
+        put_u16(pvt + 4, 2026);
+        pvt[6] = 10;
+        pvt[7] = 17;
+        pvt[8] = fix->time / 10000;
+        pvt[9] = fix->time / 100 % 100;
+        pvt[10] = fix->time % 100;
+        pvt[20] = fix->fix;
+        pvt[23] = fix->sat;
+        put_i32(pvt + 24, fix->lon);
+        put_i32(pvt + 28, fix->lat);
+        put_i32(pvt + 32, fix->alt_elipsiod);
+        put_i32(pvt + 36, fix->alt);
+        put_i32(pvt + 40, fix->h_acc);
+        put_i32(pvt + 44, fix->v_acc);
+        put_i32(pvt + 48, fix->vel_n);
+        put_i32(pvt + 52, fix->vel_e);
+        put_i32(pvt + 56, fix->vel_d);
+        put_i32(pvt + 60, fix->speed);
+        put_i32(pvt + 64, fix->cog);
+        put_i32(pvt + 68, fix->speed_acc);
+        put_i32(pvt + 72, fix->track_acc);
+        put_u16(pvt + 76, fix->pdop);
+        put_ubx(log, 0x07, pvt, sizeof(pvt));
+    }
+}
+
+static void log_nmea(bench_log_t *log, unsigned rate) {
+    log->epochs = BENCH_LOG_S * rate;
+    log->length = 0;
+    log->data = malloc(log->epochs * 192);
+    log->expected = malloc(log->epochs * sizeof(gps_fix_t));
+    for (unsigned i = 0; i < log->epochs; i++) {
+        gps_fix_t *fix = &log->expected[i];
+        char body[96], lat[16], lon[16];
+        flight(i, rate, false, fix);
+        uint32_t knots = 25000 + i % 1000;
+        unsigned hundredths = i % rate * 100 / rate;
+        put_coordinate(lat, fix->lat, false);
+        put_coordinate(lon, fix->lon, true);
+        sprintf(body, "GPGGA,%06u.%02u,%s,N,%s,W,1,%02u,%u.%02u,%d.%d,M,48.0,M,,", fix->time, hundredths, lat, lon,
+                fix->sat, fix->hdop / 100, fix->hdop % 100, fix->alt / 1000, fix->alt / 100 % 10);
+        put_nmea(log, body);
+        sprintf(body, "GPRMC,%06u.%02u,A,%s,N,%s,W,%u.%03u,%d.%02d,%06u,,,A", fix->time, hundredths, lat, lon,
+                knots / 1000, knots % 1000, fix->cog / 100000, fix->cog / 1000 % 100, fix->date);
+        put_nmea(log, body);
+    }
+}
+
+static void put_ubx(bench_log_t *log, uint8_t id, const uint8_t *payload, uint16_t length) {
+    uint8_t *start = log->data + log->length + 2;
+    uint8_t a = 0, b = 0;
+    log->data[log->length++] = 0xB5;
+    log->data[log->length++] = 0x62;
+    log->data[log->length++] = 0x01;
+    log->data[log->length++] = id;
+    put_u16(log->data + log->length, length);
+    log->length += 2;
+    memcpy(log->data + log->length, payload, length);
+    log->length += length;
+    for (uint8_t *c = start; c < log->data + log->length; c++) {
+        a += *c;
+        b += a;
+    }
+    log->data[log->length++] = a;
+    log->data[log->length++] = b;
+}
+
+static void put_nmea(bench_log_t *log, const char *body) {
+    uint8_t checksum = 0;
+    for (const char *c = body; *c; c++) checksum ^= *c;
+    log->length += sprintf((char *)log->data + log->length, "$%s*%02X\r\n", body, checksum);
+}
+
+/* deg * 1e7 to [d]ddmm.mmmmmmm, the sign goes in the N/S E/W field */
+static void put_coordinate(char *buffer, int32_t value, bool is_lon) {
+    if (value < 0) value = -value;
+    uint64_t minutes = (uint64_t)(value % 10000000) * 60;  // min * 1e7
+    sprintf(buffer, is_lon ? "%03d%02u.%07u" : "%02d%02u.%07u", value / 10000000, (unsigned)(minutes / 10000000),
+            (unsigned)(minutes % 10000000));
+}
+
+static void put_u16(uint8_t *data, uint16_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static void put_i32(uint8_t *data, int32_t value) {
+    for (unsigned i = 0; i < 4; i++) data[i] = (uint32_t)value >> (8 * i);
+}
+
+static void corrupt(bench_log_t *log) {
+    for (size_t i = 0; i < log->length; i += BENCH_CORRUPT_BYTES) {
+        seed = seed * 1103515245 + 12345;
+        log->data[i + (seed >> 8) % BENCH_CORRUPT_BYTES % (log->length - i)] ^= 1 << (seed >> 4) % 8;
+    }
+}
+
+static bench_row_t run(const char *name, bench_log_t *log, unsigned rate, bool is_nmea, bool is_corrupt) {
+    bench_row_t row = {name, rate, log->epochs};
+    gps_parser_t parser;
+    struct timespec start;
+    unsigned next = 0;
+    row.is_corrupt = is_corrupt;
+    gps_parser_init(&parser);
+    // published epochs must come out in order
+    for (size_t i = 0; i < log->length; i++) {
+        if (!gps_parser_feed(&parser, log->data[i])) continue;
+        row.published++;
+        row.mixed++;
+        for (unsigned j = next; j < log->epochs; j++) {
+            gps_fix_t old_dop = log->expected[j];
+            old_dop.hdop = parser.fix.hdop;
+            old_dop.vdop = parser.fix.vdop;
+            if (!memcmp(&parser.fix, &log->expected[j], sizeof(gps_fix_t))) {
+                row.exact++;
+            } else if (!is_nmea && !memcmp(&parser.fix, &old_dop, sizeof(gps_fix_t))) {
+                row.old_dop++;
+            } else {
+                continue;
+            }
+            row.mixed--;
+            next = j + 1;
+            break;
+        }
+    }
+    row.incomplete = parser.incomplete_epochs;
+    row.errors = parser.checksum_errors;
+    row.bytes_s = (double)log->length / BENCH_LOG_S;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (unsigned run = 0; run < BENCH_RUNS; run++) {
+        gps_parser_init(&parser);
+        for (size_t i = 0; i < log->length; i++) gps_parser_feed(&parser, log->data[i]);
+    }
+    row.new_ns = elapsed_ns(&start) / BENCH_RUNS / log->length;
+    if (is_nmea) {
+        old_fix_t old_fix = {0};
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (unsigned run = 0; run < BENCH_RUNS; run++) old_nmea(log->data, log->length, &old_fix);
+        row.old_ns = elapsed_ns(&start) / BENCH_RUNS / log->length;
+    }
+    return row;
+}
+
+/* gps.c process() NMEA branch, reading the log in place of uart_pio_read() */
+static void old_nmea(const uint8_t *data, size_t length, old_fix_t *fix) {
+    static char buffer[20] = {0};
+    static uint8_t nmea_cmd = 0;
+    static uint8_t cmd_field = 0;
+    static uint8_t data_pos = 0;
+    for (size_t i = 0; i < length; i++) {
+        switch (data[i]) {
+            case '$':
+                cmd_field = 0;
+                data_pos = 0;
+                nmea_cmd = 2;
+                break;
+            case '\r':
+            case ',':
+                if (cmd_field == 0) {
+                    if (memcmp(buffer + 2, "GGA", 3) == 0)
+                        nmea_cmd = 0;
+                    else if (memcmp(buffer + 2, "RMC", 3) == 0)
+                        nmea_cmd = 1;
+                } else if (nmea_cmd != 2) {
+                    old_parser(nmea_cmd, cmd_field, buffer, fix);
+                }
+                cmd_field++;
+                data_pos = 0;
+                buffer[0] = 0;
+                break;
+            case '\n':
+                break;
+            default:
+                if (data_pos < 19) {
+                    buffer[data_pos] = data[i];
+                    data_pos++;
+                    buffer[data_pos] = 0;
+                }
+        }
+    }
+}
+
+/* gps.c parser() */
+static void old_parser(uint8_t nmea_cmd, uint8_t cmd_field, char *buffer, old_fix_t *fix) {
+    enum { TIME = 1, LAT, LAT_SIGN, LON, LON_SIGN, ALT, SPD, COG, DATE, SAT, HDOP };
+    uint8_t nmea_field[2][17] = {{0, 0, 0, 0, 0, 0, 0, SAT, HDOP, ALT, 0, 0, 0, 0, 0, 0, 0},
+                                 {0, TIME, 0, LAT, LAT_SIGN, LON, LON_SIGN, SPD, COG, DATE, 0, 0, 0, 0, 0, 0, 0}};
+    static int8_t lat_dir = 1, lon_dir = 1;
+    if (cmd_field >= 17 || !strlen(buffer)) return;
+    switch (nmea_field[nmea_cmd][cmd_field]) {
+        case TIME:
+            fix->time = atof(buffer);
+            break;
+        case LAT: {
+            char degrees[3] = {0};
+            strncpy(degrees, buffer, 2);
+            fix->lat = lat_dir * (atoi(degrees) + atof(buffer + 2) / 60);
+            break;
+        }
+        case LON: {
+            char degrees[4] = {0};
+            strncpy(degrees, buffer, 3);
+            fix->lon = lon_dir * (atoi(degrees) + atof(buffer + 3) / 60);
+            break;
+        }
+        case ALT:
+            fix->alt = atof(buffer);
+            break;
+        case SPD:
+            fix->spd = atof(buffer);
+            fix->spd_kmh = fix->spd * 1.852;
+            break;
+        case COG:
+            fix->cog = atof(buffer);
+            break;
+        case DATE:
+            fix->date = atof(buffer);
+            break;
+        case SAT:
+            fix->sat = atof(buffer);
+            break;
+        case LAT_SIGN:
+            lat_dir = (buffer[0] == 'N') ? 1 : -1;
+            break;
+        case LON_SIGN:
+            lon_dir = (buffer[0] == 'E') ? 1 : -1;
+            break;
+        case HDOP:
+            fix->hdop = atof(buffer);
+            break;
+    }
+}
+
+static double elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+/* Clean logs publish every epoch exact, corrupt logs never a mixed one */
+static bool print(bench_row_t row) {
+    char old_ns[16] = "-";
+    bool is_ok = row.is_corrupt ? row.errors && !row.mixed
+                                : row.published == row.epochs && row.exact == row.published && !row.errors;
+    if (row.old_ns) sprintf(old_ns, "%.1f", row.old_ns);
+    printf("%-13s %4u %7u %9u %7u %7u %6u %10u %6u %8.0f %8.1f %8s %7.3f %s\n", row.name, row.rate, row.epochs,
+           row.published, row.exact, row.old_dop, row.mixed, row.incomplete, row.errors, row.bytes_s, row.new_ns,
+           old_ns, row.bytes_s * row.new_ns / 1e7, is_ok ? "ok" : "FAIL");
+    return is_ok;
+}
@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "crsf.h"
+#include "hal_host.h"
+#include "pool.h"
+#include "sensor_registry.h"
+#include "uart_pio.h"
+
+/*
+   GPS high rate benchmark
+   Starts the gps through crsf_task with a simulated u-blox module on the pio uart. The module starts at 9600 with its
+   default 1 Hz NMEA output and only understands and answers at its own baudrate. It follows $PUBX,41 up to the
+   highest baudrate it supports, $PUBX,40, UBX-CFG-MSG, UBX-CFG-RATE and NAV-PVT polls, and sends its output at the
+   byte rate of the baudrate. Reports the baudrate gps.c ends at, the time to the first published epoch and, over the
+   next 30 s, the epochs published per second, the bytes per second on the line and the bytes dropped by uart_pio.c
+*/
+
+#define BENCH_MEASURE_US 30000000
+#define BENCH_START_TIMEOUT_US 30000000
+#define BENCH_STEP_US 1000
+#define MODULE_BAUDRATE 9600
+#define MODULE_OUT_SIZE 4096
+
+typedef enum module_nmea_t { GGA, RMC, GSV, GSA, VTG, GLL, ZDA, NMEA_COUNT } module_nmea_t;
+
+typedef struct module_t {
+    uint baudrate, baudrate_max, period_ms, pvt_rate, dop_rate, epoch, nmea[NMEA_COUNT];
+    uint64_t next_epoch_us;
+    uint8_t out[MODULE_OUT_SIZE];
+    uint out_length;
+    double out_credit;
+    uint64_t line_bytes;
+} module_t;
+
+typedef struct bench_row_t {
+    uint baudrate_max, rate;
+} bench_row_t;
+
+static void replay(const bench_row_t *row);
+static void module_step(module_t *module, uint64_t now_us);
+static void module_command(module_t *module, const uint8_t *data, uint length);
+static void module_epoch(module_t *module);
+static void put_ubx(module_t *module, uint8_t class, uint8_t id, const uint8_t *payload, uint16_t length);
+static void put_nmea(module_t *module, const char *body);
+static void put_pvt(module_t *module);
+static void put_u16(uint8_t *data, uint16_t value);
+static void put_i32(uint8_t *data, int32_t value);
+
+static const char *nmea_names[NMEA_COUNT] = {"GGA", "RMC", "GSV", "GSA", "VTG", "GLL", "ZDA"};
+static const bench_row_t rows[] = {{921600, 5},  {921600, 10}, {921600, 18}, {921600, 25}, {115200, 10},
+                                   {115200, 25}, {38400, 10},  {38400, 25},  {9600, 25}};
+static module_t module;
+
+int main(void) {
+    printf("%11s %4s %8s %11s %8s %8s %8s\n", "module baud", "Hz", "baudrate", "first fix s", "epochs/s", "bytes/s",
+           "dropped");
+    for (unsigned i = 0; i < count_of(rows); i++) replay(&rows[i]);
+    return 0;
+}
+
+static void replay(const bench_row_t *row) {
+    config_t config;
+    uint8_t tx[1024];
+    uint64_t now_us = 0, first_us = 0, line_bytes = 0;
+    uint epochs = 0;
+    float lat = 0;
+
+    hal_host_reset();
+    config_forze_write();
+    config_get(&config);
+    config.rx_protocol = RX_CRSF;
+    config.debug = 0;
+    config.enable_gps = true;
+    config.gps_protocol = UBLOX;
+    config.gps_baudrate = MODULE_BAUDRATE;
+    config.gps_rate = row->rate;
+    config_write(&config);
+
+    memset(&module, 0, sizeof(module));
+    module.baudrate = MODULE_BAUDRATE;
+    module.baudrate_max = row->baudrate_max;
+    module.period_ms = 1000;
+    for (uint i = 0; i < NMEA_COUNT; i++) module.nmea[i] = i != ZDA;
+
+    context.tasks_queue_handle = pool_queue_create(64, sizeof(QueueHandle_t));
+    pool_task_create(crsf_task, "crsf", STACK_RX_CRSF, NULL, 3, &context.receiver_task_handle);
+    context.uart0_notify_task_handle = context.receiver_task_handle;
+    hal_host_start_scheduler();
+    while (first_us ? now_us < first_us + BENCH_MEASURE_US : now_us < BENCH_START_TIMEOUT_US) {
+        now_us += BENCH_STEP_US;
+        hal_host_advance_us(BENCH_STEP_US);
+        while (hal_host_uart_tx(HAL_HOST_UART0, tx, sizeof(tx)))
+            ;
+        module_step(&module, now_us);
+        float value = sensor_registry_values()->gps.lat;
+        if (value == lat) continue;
+        lat = value;
+        if (!first_us) {
+            first_us = now_us;
+            line_bytes = module.line_bytes;
+        } else {
+            epochs++;
+        }
+    }
+    if (!first_us) {
+        printf("%11u %4u %8s\n", row->baudrate_max, row->rate, "no fix");
+        return;
+    }
+    printf("%11u %4u %8u %11.2f %8.2f %8.0f %8u\n", row->baudrate_max, row->rate, module.baudrate, first_us / 1e6,
+           epochs * 1e6 / BENCH_MEASURE_US, (module.line_bytes - line_bytes) * 1e6 / BENCH_MEASURE_US,
+           uart_pio_dropped());
+}
+
+/* Reads the commands sent at the module baudrate and sends the output due, a byte every 10 bits */
+static void module_step(module_t *module, uint64_t now_us) {
+    uint8_t data[1024];
+    uint length;
+    while ((length = hal_host_uart_tx(HAL_HOST_UART_PIO, data, sizeof(data))))
+        if (hal_host_uart_pio_tx_baudrate() == module->baudrate) module_command(module, data, length);
+    if (now_us >= module->next_epoch_us) {
+        module_epoch(module);
+        module->next_epoch_us = now_us + module->period_ms * 1000ULL;
+    }
+    module->out_credit += module->baudrate / 10.0 * BENCH_STEP_US / 1e6;
+    length = module->out_credit < module->out_length ? (uint)module->out_credit : module->out_length;
+    if (!length) return;
+    module->out_credit -= length;
+    module->line_bytes += length;
+    // at another baudrate the receiver only gets framing errors
+    if (hal_host_uart_baudrate(HAL_HOST_UART_PIO) == module->baudrate)
+        hal_host_uart_rx(HAL_HOST_UART_PIO, module->out, length);
+    memmove(module->out, module->out + length, module->out_length - length);
+    module->out_length -= length;
+}
+
+static void module_command(module_t *module, const uint8_t *data, uint length) {
+    for (uint i = 0; i < length; i++) {
+        if (data[i] == '$') {
+            char line[64] = {0}, name[4] = {0};
+            uint a, b, c, baudrate, rate;
+            for (uint j = 0; j < sizeof(line) - 1 && i + j < length && data[i + j] != '\r'; j++) line[j] = data[i + j];
+            if (sscanf(line, "$PUBX,41,%u,%u,%u,%u", &a, &b, &c, &baudrate) == 4 && baudrate <= module->baudrate_max) {
+                module->baudrate = baudrate;
+                module->out_length = 0;
+                module->out_credit = 0;
+            } else if (sscanf(line, "$PUBX,40,%3[A-Z],%u,%u", name, &a, &rate) == 3) {
+                for (uint j = 0; j < NMEA_COUNT; j++)
+                    if (!strcmp(name, nmea_names[j])) module->nmea[j] = rate;
+            }
+            continue;
+        }
+        if (data[i] != 0xB5 || i + 7 >= length || data[i + 1] != 0x62) continue;
+        const uint8_t *payload = data + i + 6;
+        uint16_t payload_length = data[i + 4] | data[i + 5] << 8;
+        if (i + 8 + payload_length > length) break;
+        if (data[i + 2] == 0x06 && data[i + 3] == 0x01 && payload[0] == 0x01) {
+            if (payload[1] == 0x07) module->pvt_rate = payload[2];
+            if (payload[1] == 0x04) module->dop_rate = payload[2];
+        } else if (data[i + 2] == 0x06 && data[i + 3] == 0x08) {
+            module->period_ms = payload[0] | payload[1] << 8;
+        } else if (data[i + 2] == 0x01 && data[i + 3] == 0x07 && !payload_length) {
+            put_pvt(module);
+        }
+        i += 7 + payload_length;
+    }
+}
+
+/* Moves 100 * 1e-7 deg north each epoch, enough for the float latitude to change */
+static void module_epoch(module_t *module) {
+    char body[96];
+    uint seconds = 12 * 3600 + module->epoch * module->period_ms / 1000;
+    uint time = seconds / 3600 * 10000 + seconds / 60 % 60 * 100 + seconds % 60;
+    uint hundredths = module->epoch * module->period_ms / 10 % 100;
+    module->epoch++;
+    if (module->dop_rate && module->epoch % module->dop_rate == 0) {
+        uint8_t dop[18] = {0};
+        put_u16(dop + 10, 120);
+        put_u16(dop + 12, 90);
+        put_ubx(module, 0x01, 0x04, dop, sizeof(dop));
+    }
+    if (module->pvt_rate && module->epoch % module->pvt_rate == 0) put_pvt(module);
+    if (module->nmea[GGA]) {
+        sprintf(body, "GPGGA,%06u.%02u,4730.%07u,N,12230.0000000,W,1,12,0.90,120.0,M,48.0,M,,", time, hundredths,
+                module->epoch * 6000 % 10000000);
+        put_nmea(module, body);
+    }
+    if (module->nmea[RMC]) {
+        sprintf(body, "GPRMC,%06u.%02u,A,4730.%07u,N,12230.0000000,W,25.000,90.00,171026,,,A", time, hundredths,
+                module->epoch * 6000 % 10000000);
+        put_nmea(module, body);
+    }
+    for (uint i = 0; i < 3 && module->nmea[GSV]; i++) {
+        sprintf(body, "GPGSV,3,%u,12,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45", i + 1);
+        put_nmea(module, body);
+    }
+    if (module->nmea[GSA]) put_nmea(module, "GPGSA,A,3,01,02,12,14,15,17,19,24,25,32,,,1.50,0.90,1.20");
+    if (module->nmea[VTG]) put_nmea(module, "GPVTG,90.00,T,,M,25.000,N,46.300,K,A");
+    if (module->nmea[GLL]) put_nmea(module, "GPGLL,4730.0000000,N,12230.0000000,W,123000.00,A,A");
+    if (module->nmea[ZDA]) put_nmea(module, "GPZDA,123000.00,17,10,2026,00,00");
+}
+
+static void put_ubx(module_t *module, uint8_t class, uint8_t id, const uint8_t *payload, uint16_t length) {
+    if (module->out_length + length + 8 > MODULE_OUT_SIZE) return;
+    uint8_t *message = module->out + module->out_length;
+    uint8_t a = 0, b = 0;
+    message[0] = 0xB5;
+    message[1] = 0x62;
+    message[2] = class;
+    message[3] = id;
+    put_u16(message + 4, length);
+    memcpy(message + 6, payload, length);
+    for (uint i = 2; i < length + 6u; i++) {
+        a += message[i];
+        b += a;
+    }
+    message[length + 6] = a;
+    message[length + 7] = b;
+    module->out_length += length + 8;
+}
+
+static void put_nmea(module_t *module, const char *body) {
+    char message[128];
+    uint8_t checksum = 0;
+    for (const char *c = body; *c; c++) checksum ^= *c;
+    uint length = sprintf(message, "$%s*%02X\r\n", body, checksum);
+    if (module->out_length + length > MODULE_OUT_SIZE) return;
+    memcpy(module->out + module->out_length, message, length);
+    module->out_length += length;
+}
+
+static void put_pvt(module_t *module) {
+    uint8_t pvt[92] = {0};
+    uint seconds = 12 * 3600 + module->epoch * module->period_ms / 1000;
+    put_i32(pvt, module->epoch * module->period_ms);
+    put_u16(pvt + 4, 2026);
+    pvt[6] = 10;
+    pvt[7] = 17;
+    pvt[8] = seconds / 3600;
+    pvt[9] = seconds / 60 % 60;
+    pvt[10] = seconds % 60;
+    pvt[20] = 3;
+    pvt[23] = 12;
+    put_i32(pvt + 24, -1225000000);
+    put_i32(pvt + 28, 475000000 + module->epoch * 100);
+    put_i32(pvt + 36, 120000);
+    put_i32(pvt + 60, 12861);
+    put_u16(pvt + 76, 150);
+    put_ubx(module, 0x01, 0x07, pvt, sizeof(pvt));
+}
+
+static void put_u16(uint8_t *data, uint16_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static void put_i32(uint8_t *data, int32_t value) {
+    for (unsigned i = 0; i < 4; i++) data[i] = (uint32_t)value >> (8 * i);
+}
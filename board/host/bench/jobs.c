@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "crsf.h"
+#include "hal_host.h"
+#include "pool.h"
+#include "sensor_registry.h"
+
+/*
+   Light jobs benchmark
+   Starts crsf_task with sensor mixes that spawn the light periodic jobs (cell count, esc and analog current auto
+   offsets) and reports the static pool taken after 60 s of simulated time and the task switches in that
+   time. Built twice: msrc_bench_jobs with a task per job and msrc_bench_jobs_run_loop with RUN_LOOP, so the two rows
+   of each mix compare the task per job model and the run loop. Host switches count every time a task is resumed by
+   the scheduler, the firmware adds the idle task and the tick on top
+*/
+
+#define BENCH_REPLAY_US 60000000
+#define BENCH_STEP_US 1000
+
+#ifdef RUN_LOOP
+#define BENCH_MODE "run loop"
+#else
+#define BENCH_MODE "tasks"
+#endif
+
+typedef struct bench_mix_t {
+    const char *name;
+    void (*apply)(config_t *config);
+} bench_mix_t;
+
+static void replay(const bench_mix_t *mix);
+static void mix_none(config_t *config);
+static void mix_esc(config_t *config);
+static void mix_gps(config_t *config);
+static void mix_current(config_t *config);
+static void mix_all(config_t *config);
+
+static const bench_mix_t mixes[] = {
+    {"none", mix_none}, {"esc", mix_esc}, {"gps", mix_gps}, {"current", mix_current}, {"all", mix_all},
+};
+
+int main(void) {
+    printf("%-9s %-8s %7s %9s %10s\n", "mode", "sensors", "pool B", "switches", "switches/s");
+    for (unsigned i = 0; i < count_of(mixes); i++) replay(&mixes[i]);
+    return 0;
+}
+
+static void replay(const bench_mix_t *mix) {
+    config_t config;
+    uint8_t tx[1024];
+
+    hal_host_reset();
+    config_forze_write();
+    config_get(&config);
+    config.rx_protocol = RX_CRSF;
+    config.debug = 0;
+    config.enable_esc_hw4_init_delay = false;
+    config.esc_hw4_is_manual_offset = false;
+    config.analog_current_autoffset = true;
+    mix->apply(&config);
+    config_write(&config);
+    for (unsigned i = 0; i < 5; i++) hal_host_adc_set(i, 1500);
+
+    context.tasks_queue_handle = pool_queue_create(64, sizeof(QueueHandle_t));
+    pool_task_create(crsf_task, "crsf", STACK_RX_CRSF, NULL, 3, &context.receiver_task_handle);
+    context.uart0_notify_task_handle = context.receiver_task_handle;
+    hal_host_start_scheduler();
+    sensor_registry_values()->gps.sat = 8;
+    for (uint64_t now_us = 0; now_us < BENCH_REPLAY_US; now_us += BENCH_STEP_US) {
+        hal_host_advance_us(BENCH_STEP_US);
+        while (hal_host_uart_tx(HAL_HOST_UART0, tx, sizeof(tx)))
+            ;
+    }
+    printf("%-9s %-8s %7zu %9llu %10.1f\n", BENCH_MODE, mix->name, pool_used(),
+           (unsigned long long)hal_host_switch_count(), hal_host_switch_count() * 1e6 / BENCH_REPLAY_US);
+}
+
+static void mix_none(config_t *config) {}
+
+static void mix_esc(config_t *config) { config->esc_protocol = ESC_HW4; }
+
+static void mix_gps(config_t *config) { config->enable_gps = true; }
+
+static void mix_current(config_t *config) {
+    config->enable_analog_voltage = true;
+    config->enable_analog_current = true;
+}
+
+static void mix_all(config_t *config) {
+    mix_esc(config);
+    mix_gps(config);
+    mix_current(config);
+}
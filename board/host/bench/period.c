@@ -0,0 +1,117 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "hal_host.h"
+#include "period_filter.h"
+
+/*
+   Period filter benchmark
+   Feeds 10 s jittered edge streams through the batch capture (hal_pio.c, same ring size as the dma ring) and drains
+   them every 5 ms as esc_pwm.c does. Every 100 ms compares the rpm of the last period (the per edge irq it replaced)
+   and of period_filter.c against the real frequency. Jitter is gaussian on each edge, missed rows drop a rising edge,
+   glitch rows add a short pulse. The counter starts near the wrap. Edges/s is the irq rate of the old capture, the
+   batch capture has 200 drains/s
+*/
+
+#define BENCH_S 10
+#define BENCH_COUNTER_HZ 25000000  // 125 MHz / COUNTER_CYCLES
+#define BENCH_DRAIN_MS 5
+#define BENCH_READ_MS 100
+#define BENCH_PULSE 0.3  // duty
+
+typedef struct bench_case_t {
+    const char *name;
+    double hz, jitter, missed, glitch;  // jitter: fraction of the period (sigma), missed and glitch: per pulse
+    double rms_max;                     // filter rms error limit, %
+} bench_case_t;
+
+static bool run(const bench_case_t *bench);
+static void capture_handler(uint counter, edge_type_t edge);
+static double gaussian(void);
+static double uniform(void);
+
+static const bench_case_t cases[] = {
+    {"clean 1 kHz", 1000, 0, 0, 0, 0.01},         {"jitter 1 kHz", 1000, 0.02, 0, 0, 1},
+    {"jitter 50 Hz", 50, 0.02, 0, 0, 1},          {"missed 1 kHz", 1000, 0.005, 0.01, 0, 0.5},
+    {"glitch 1 kHz", 1000, 0.005, 0, 0.01, 0.5},  {"jitter 10 kHz", 10000, 0.02, 0, 0, 1},
+    {"overrun 40 kHz", 40000, 0.02, 0, 0, 1},
+};
+static period_filter_t filter;
+static uint32_t last_rise, last_period;
+static uint32_t seed = 1;
+
+int main(void) {
+    bool is_ok = true;
+    printf("%-16s %9s %10s %10s %10s %10s\n", "stream", "edges/s", "old rms %", "old max %", "new rms %", "new max %");
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) is_ok &= run(&cases[i]);
+    return is_ok ? 0 : 1;
+}
+
+static bool run(const bench_case_t *bench) {
+    double period_s = 1 / bench->hz, next_rise = 0, time = 0;
+    double old_sum = 0, old_max = 0, new_sum = 0, new_max = 0;
+    uint32_t counter_start = 0xFFFFFFFF - BENCH_COUNTER_HZ / 2;
+    unsigned edges = 0, reads = 0, next_drain = 1, next_read = 1;
+    capture_edge_init_batch(NULL, 0, 1, 1);
+    capture_edge_set_handler(0, capture_handler);
+    period_filter_reset(&filter);
+    last_period = 0;
+    while (time < BENCH_S) {
+        double rise = next_rise + gaussian() * bench->jitter * period_s;
+        double fall = rise + BENCH_PULSE * period_s;
+        next_rise += period_s;
+        // drain and read up to this pulse
+        while (next_drain * BENCH_DRAIN_MS / 1000.0 < rise) {
+            capture_edge_drain();
+            if (next_drain * BENCH_DRAIN_MS >= next_read * BENCH_READ_MS) {
+                next_read++;
+                if (!last_period) continue;
+                double old_error = fabs((double)BENCH_COUNTER_HZ / last_period / bench->hz - 1) * 100;
+                double new_error = fabs(BENCH_COUNTER_HZ / period_filter_get(&filter) / bench->hz - 1) * 100;
+                old_sum += old_error * old_error;
+                new_sum += new_error * new_error;
+                if (old_error > old_max) old_max = old_error;
+                if (new_error > new_max) new_max = new_error;
+                reads++;
+            }
+            next_drain++;
+        }
+        time = rise;
+        if (uniform() < bench->missed) continue;
+        hal_host_capture_edge(0, counter_start + lround(rise * BENCH_COUNTER_HZ), EDGE_RISE);
+        hal_host_capture_edge(0, counter_start + lround(fall * BENCH_COUNTER_HZ), EDGE_FALL);
+        edges += 2;
+        if (uniform() < bench->glitch) {
+            double glitch = fall + uniform() * (1 - BENCH_PULSE) * period_s * 0.9;
+            hal_host_capture_edge(0, counter_start + lround(glitch * BENCH_COUNTER_HZ), EDGE_RISE);
+            hal_host_capture_edge(0, counter_start + lround((glitch + 2e-6) * BENCH_COUNTER_HZ), EDGE_FALL);
+            edges += 2;
+        }
+    }
+    double old_rms = sqrt(old_sum / reads), new_rms = sqrt(new_sum / reads);
+    bool is_ok = reads && new_rms <= bench->rms_max && new_rms <= old_rms + 0.001;
+    printf("%-16s %9.0f %10.3f %10.3f %10.3f %10.3f %s\n", bench->name, edges / time, old_rms, old_max, new_rms,
+           new_max, is_ok ? "ok" : "FAIL");
+    return is_ok;
+}
+
+/* esc_pwm.c capture_pin_0_handler(), and the single period it replaced */
+static void capture_handler(uint counter, edge_type_t edge) {
+    if (edge != EDGE_RISE) return;
+    if (filter.is_last_set) last_period = counter - last_rise;
+    last_rise = counter;
+    period_filter_rise(&filter, counter);
+}
+
+static double gaussian(void) {
+    double sum = 0;
+    for (unsigned i = 0; i < 12; i++) sum += uniform();
+    return sum - 6;
+}
+
+/* 0 to 1 */
+static double uniform(void) {
+    seed = seed * 1103515245 + 12345;
+    return ((seed >> 8) & 0xFFFF) / 65536.0;
+}
@@ -0,0 +1,167 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "ring_buffer.h"
+
+/*
+   Ring buffer stress benchmark
+   A producer thread plays the uart irq: it writes 5 byte words (a 32 bit count and a check byte) with
+   ring_buffer_put() or chunks of up to 3 words with ring_buffer_put_bytes(), waiting while the ring is full, so the
+   words straddle the end of the buffer at every offset. In the second run it calls
+   ring_buffer_reset() between words as the frame start of a burst does. The consumer thread plays the task, reading
+   with ring_buffer_get(), ring_buffer_get_bytes() or ring_buffer_peek() and ring_buffer_consume() in random sizes.
+   Words must arrive in order, not torn, and without a gap unless a reset was applied, in which case the stream must
+   restart at one of the reset heads. The ring is small and its indexes start near the 32 bit wrap, so both the buffer
+   and the indexes wrap many times. Full and empty waits and random points yield, so it also runs on one cpu, where
+   the threads would otherwise fill and drain the whole ring in lockstep
+*/
+
+#define BENCH_WORDS 1000000
+#define BENCH_SIZE 64
+#define BENCH_START 0xFFFFF000u  // indexes wrap after 4096 bytes
+#define BENCH_RESET_WORDS 997    // mean words between resets
+#define BENCH_WORD 5
+
+typedef struct bench_row_t {
+    const char *name;
+    unsigned long long words, resets, applied, errors;
+} bench_row_t;
+
+static bench_row_t stress(const char *name, bool is_reset);
+static void *producer(void *parameters);
+static void check_word(bench_row_t *row, const uint8_t *word);
+static uint32_t next(uint32_t *seed);
+
+static ring_buffer_t ring;
+static uint8_t buffer[BENCH_SIZE];
+static uint32_t reset_word[BENCH_WORDS];  // word count at each reset, by reset number
+static volatile uint32_t resets;
+static volatile bool is_producing, is_reset_run;
+static uint32_t expected;  // next word, consumer
+static bool is_reset_seen;
+static uint32_t reset_from;
+
+int main(void) {
+    printf("%-8s %10s %10s %10s %10s\n", "run", "words", "resets", "applied", "errors");
+    bench_row_t rows[] = {stress("plain", false), stress("reset", true)};
+    bool is_ok = true;
+    for (unsigned i = 0; i < sizeof(rows) / sizeof(rows[0]); i++) {
+        printf("%-8s %10llu %10llu %10llu %10llu\n", rows[i].name, rows[i].words, rows[i].resets, rows[i].applied,
+               rows[i].errors);
+        is_ok &= !rows[i].errors && rows[i].words;
+    }
+    is_ok &= rows[0].words == BENCH_WORDS && rows[1].applied;
+    return is_ok ? 0 : 1;
+}
+
+static bench_row_t stress(const char *name, bool is_reset) {
+    bench_row_t row = {name};
+    pthread_t thread;
+    uint8_t word[BENCH_WORD], data[BENCH_SIZE];
+    uint32_t seed = 7, filled = 0;
+    ring_buffer_init(&ring, buffer, BENCH_SIZE);
+    ring.head = ring.tail = ring.reset_head = BENCH_START;
+    resets = 0;
+    expected = 0;
+    is_reset_seen = false;
+    is_reset_run = is_reset;
+    is_producing = true;
+    pthread_create(&thread, NULL, producer, NULL);
+    while (true) {
+        bool is_done = !is_producing;
+        uint32_t reset_ack = ring.reset_ack, length = 0;
+        switch (next(&seed) % 3) {
+            case 0:
+                length = ring_buffer_get(&ring, data);
+                break;
+            case 1:
+                length = ring_buffer_get_bytes(&ring, data, 1 + next(&seed) % BENCH_SIZE);
+                break;
+            case 2: {
+                uint8_t *span;
+                uint32_t limit = 1 + next(&seed) % 8;
+                length = ring_buffer_peek(&ring, &span);
+                if (length > limit) length = limit;
+                for (uint32_t i = 0; i < length; i++) data[i] = span[i];
+                ring_buffer_consume(&ring, length);
+                break;
+            }
+        }
+        // an applied reset drops the part of a word already read, the stream restarts at a word
+        if (ring.reset_ack != reset_ack) {
+            row.applied++;
+            filled = 0;
+            if (!is_reset_seen) reset_from = reset_ack;
+            is_reset_seen = true;
+        }
+        for (uint32_t i = 0; i < length; i++) {
+            word[filled++] = data[i];
+            if (filled < BENCH_WORD) continue;
+            check_word(&row, word);
+            filled = 0;
+        }
+        if (!length && is_done) break;
+        if (!length || !(next(&seed) % 8)) sched_yield();
+    }
+    pthread_join(thread, NULL);
+    row.resets = resets;
+    return row;
+}
+
+static void *producer(void *parameters) {
+    uint32_t seed = 3;
+    uint32_t count = 0;
+    while (count < BENCH_WORDS) {
+        uint8_t chunk[3 * BENCH_WORD];
+        uint32_t words = 1 + next(&seed) % 3, length = 0;
+        for (uint32_t i = 0; i < words && count + i < BENCH_WORDS; i++, length += BENCH_WORD) {
+            uint32_t value = count + i;
+            uint8_t *word = chunk + length;
+            word[0] = value, word[1] = value >> 8, word[2] = value >> 16, word[3] = value >> 24;
+            word[4] = word[0] ^ word[1] ^ word[2] ^ word[3] ^ 0x5A;
+        }
+        if (is_reset_run && !(next(&seed) % (BENCH_RESET_WORDS / 2))) {
+            reset_word[resets] = count;
+            __atomic_store_n(&resets, resets + 1, __ATOMIC_RELEASE);
+            ring_buffer_reset(&ring);
+        }
+        if (next(&seed) % 2) {
+            for (uint32_t i = 0; i < length; i++)
+                while (!ring_buffer_put(&ring, chunk[i])) sched_yield();
+        } else {
+            uint32_t sent = 0;
+            while ((sent += ring_buffer_put_bytes(&ring, chunk + sent, length - sent)) < length) sched_yield();
+        }
+        count += length / BENCH_WORD;
+        if (!(next(&seed) % 8)) sched_yield();
+    }
+    is_producing = false;
+    return NULL;
+}
+
+static void check_word(bench_row_t *row, const uint8_t *word) {
+    uint32_t count = word[0] | word[1] << 8 | word[2] << 16 | (uint32_t)word[3] << 24;
+    row->words++;
+    if (word[4] != (word[0] ^ word[1] ^ word[2] ^ word[3] ^ 0x5A)) {
+        row->errors++;
+        return;
+    }
+    if (is_reset_seen) {
+        // the first word after a reset is the one written right after one of the resets since
+        bool is_reset_word = false;
+        uint32_t reset_count = __atomic_load_n(&resets, __ATOMIC_ACQUIRE);
+        for (uint32_t i = reset_from; i < reset_count; i++) is_reset_word |= reset_word[i] == count;
+        if (!is_reset_word || count < expected) row->errors++;
+        is_reset_seen = false;
+    } else if (count != expected) {
+        row->errors++;
+    }
+    expected = count + 1;
+}
+
+static uint32_t next(uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
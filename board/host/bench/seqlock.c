@@ -0,0 +1,78 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "seqlock.h"
+#include "sensor_registry.h"
+
+/*
+   Seqlock stress benchmark
+   A writer thread updates a gps group, setting every field to the update count, while a reader thread copies the
+   group as fast as it can, once with a plain copy and once with seqlock_read(). A copy is torn when its fields differ.
+   Plain copies tear while the writer runs on another core, seqlock copies must not tear, they fail and are retried
+*/
+
+#define BENCH_UPDATES 2000000
+
+typedef struct bench_row_t {
+    const char *name;
+    unsigned long long reads, torn, retries;
+} bench_row_t;
+
+static void *writer(void *parameters);
+static bench_row_t stress(const char *name, bool is_locked);
+static bool is_torn(const sensor_gps_t *gps);
+
+static sensor_gps_t gps;
+static seqlock_t lock;
+static volatile bool is_writing;
+
+int main(void) {
+    printf("%-8s %12s %10s %10s\n", "read", "reads", "torn", "retries");
+    bench_row_t rows[] = {stress("plain", false), stress("seqlock", true)};
+    for (unsigned i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+        printf("%-8s %12llu %10llu %10llu\n", rows[i].name, rows[i].reads, rows[i].torn, rows[i].retries);
+    return rows[1].torn ? 1 : 0;
+}
+
+static void *writer(void *parameters) {
+    volatile float *field = (volatile float *)&gps;
+    for (unsigned update = 1; update <= BENCH_UPDATES; update++) {
+        seqlock_write_begin(&lock);
+        for (unsigned i = 0; i < sizeof(gps) / sizeof(float); i++) field[i] = update;
+        seqlock_write_end(&lock);
+    }
+    is_writing = false;
+    return NULL;
+}
+
+static bench_row_t stress(const char *name, bool is_locked) {
+    bench_row_t row = {name};
+    pthread_t thread;
+    sensor_gps_t copy;
+    memset(&gps, 0, sizeof(gps));
+    lock = (seqlock_t){0};
+    is_writing = true;
+    pthread_create(&thread, NULL, writer, NULL);
+    while (is_writing) {
+        if (is_locked) {
+            if (!seqlock_read(&lock, &copy, &gps, sizeof(copy))) {
+                row.retries++;
+                continue;
+            }
+        } else {
+            memcpy(&copy, (const void *)&gps, sizeof(copy));
+        }
+        row.reads++;
+        if (is_torn(&copy)) row.torn++;
+    }
+    pthread_join(thread, NULL);
+    return row;
+}
+
+static bool is_torn(const sensor_gps_t *gps) {
+    const float *field = (const float *)gps;
+    for (unsigned i = 1; i < sizeof(*gps) / sizeof(float); i++)
+        if (field[i] != field[0]) return true;
+    return false;
+}
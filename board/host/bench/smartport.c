@@ -0,0 +1,112 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "config.h"
+#include "hal_host.h"
+#include "smartport_scheduler.h"
+
+/*
+   Smartport poll scheduler benchmark
+   Builds the slots set_config() of smartport.c adds for an esc (HW4), gps, analog voltage and current and a BMP280,
+   with their intervals from the refresh_rate_* of the config, then replays 10 min poll traces through
+   smartport_scheduler_next() and reports the achieved rate of each slot. The receiver polls one physical id every
+   12 ms (+-1 ms), so with other sensors on the bus this one gets every nth poll, and some polls are lost. When the
+   polls can not carry every target rate, each slot is due a share of them in proportion to its target, otherwise its
+   target. Each slot must reach at least BENCH_SHARE_MIN of that and never go over its target. The time starts near
+   the wrap of time_us_32()
+*/
+
+#define BENCH_S 600
+#define BENCH_POLL_US 12000
+#define BENCH_POLL_JITTER_US 1000
+#define BENCH_SHARE_MIN 0.9
+#define BENCH_TARGET_MAX 1.01
+
+typedef struct bench_slot_t {
+    const char *name;
+    uint16_t config_offset;  // refresh rate in config_t, ms
+} bench_slot_t;
+
+typedef struct bench_trace_t {
+    const char *name;
+    uint nth;    // this sensor id gets every nth poll
+    float lost;  // polls lost
+} bench_trace_t;
+
+static bool replay(const char *rates, const config_t *config, const bench_trace_t *trace);
+static uint32_t next(void);
+
+#define SLOT(name, rate) {name, offsetof(config_t, rate)}
+
+/* Same order and rates as set_config(). Datetime is fixed at 1000 ms */
+static const bench_slot_t slots[] = {
+    SLOT("esc rpm", refresh_rate_rpm),              SLOT("esc power", refresh_rate_voltage),
+    SLOT("esc temp fet", refresh_rate_temperature), SLOT("esc temp bec", refresh_rate_temperature),
+    SLOT("esc cells", refresh_rate_voltage),        SLOT("gps coord", refresh_rate_gps),
+    {"gps datetime", 0},                            SLOT("gps alt", refresh_rate_gps),
+    SLOT("gps speed", refresh_rate_gps),            SLOT("gps course", refresh_rate_gps),
+    SLOT("gps vspeed", refresh_rate_gps),           SLOT("gps sat", refresh_rate_gps),
+    SLOT("gps fix", refresh_rate_gps),              SLOT("gps dist", refresh_rate_gps),
+    SLOT("voltage", refresh_rate_voltage),          SLOT("current", refresh_rate_current),
+    SLOT("consumption", refresh_rate_current),      SLOT("baro alt", refresh_rate_vario),
+    SLOT("vario", refresh_rate_vario),
+};
+static const bench_trace_t traces[] = {{"alone", 1, 0.01}, {"3 ids", 3, 0.02}, {"8 ids", 8, 0.02}};
+static uint32_t seed = 1;
+
+int main(void) {
+    config_t config;
+    bool is_ok = true;
+    hal_host_reset();
+    config_forze_write();
+    config_get(&config);
+    printf("%-8s %-8s %-14s %10s %10s %12s\n", "rates", "polls", "slot", "target Hz", "share Hz", "achieved Hz");
+    for (uint i = 0; i < count_of(traces); i++) is_ok &= replay("default", &config, &traces[i]);
+    // fast rates, more than the polls can carry
+    config.refresh_rate_rpm = 100;
+    config.refresh_rate_voltage = 200;
+    config.refresh_rate_current = 300;
+    config.refresh_rate_gps = 200;
+    config.refresh_rate_vario = 100;
+    for (uint i = 0; i < count_of(traces); i++) is_ok &= replay("fast", &config, &traces[i]);
+    return is_ok ? 0 : 1;
+}
+
+static bool replay(const char *rates, const config_t *config, const bench_trace_t *trace) {
+    smartport_scheduler_t scheduler;
+    float target_hz[count_of(slots)], total_hz = 0;
+    uint answers[count_of(slots)] = {0}, polls = 0, id = 0;
+    uint32_t start = 0xFFFFFFFF - 5000000;
+    bool is_ok = true;
+    smartport_scheduler_init(&scheduler);
+    for (uint i = 0; i < count_of(slots); i++) {
+        uint16_t rate = slots[i].config_offset ? *(uint16_t *)((uint8_t *)config + slots[i].config_offset) : 1000;
+        smartport_scheduler_add(&scheduler, rate, start);
+        target_hz[i] = 1000.0 / rate;
+        total_hz += target_hz[i];
+    }
+    for (uint64_t t = 0; t < (uint64_t)BENCH_S * 1000000; t += BENCH_POLL_US) {
+        // the receiver polls the ids in turn, this one every nth poll
+        if (id++ % trace->nth) continue;
+        if (next() % 10000 < trace->lost * 10000) continue;
+        uint32_t now = start + t + next() % (2 * BENCH_POLL_JITTER_US + 1) - BENCH_POLL_JITTER_US;
+        polls++;
+        int slot = smartport_scheduler_next(&scheduler, now);
+        if (slot >= 0) answers[slot]++;
+    }
+    float load = (float)polls / BENCH_S / total_hz;
+    for (uint i = 0; i < count_of(slots); i++) {
+        float achieved_hz = (float)answers[i] / BENCH_S, share_hz = load < 1 ? load * target_hz[i] : target_hz[i];
+        bool is_slot_ok = achieved_hz >= BENCH_SHARE_MIN * share_hz && achieved_hz <= BENCH_TARGET_MAX * target_hz[i];
+        printf("%-8s %-8s %-14s %10.2f %10.2f %12.2f %s\n", rates, trace->name, slots[i].name, target_hz[i], share_hz,
+               achieved_hz, is_slot_ok ? "ok" : "FAIL");
+        is_ok &= is_slot_ok;
+    }
+    return is_ok;
+}
+
+static uint32_t next(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
@@ -0,0 +1,107 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "thermistor.h"
+
+/*
+   Thermistor benchmark
+   For the thermistors of the ntc sensor, hw4, apd hv and castle, compares the table against the exact beta or
+   Steinhart-Hart equation in double at every 12 bit adc code between BENCH_MIN and BENCH_MAX deg C. The lsb column is
+   the largest temperature step of one adc code in that range, the resolution the adc gives anyway. Fails if the table
+   error at a code exceeds both BENCH_ERROR_MAX and the step to the next code. Then times the table against the float
+   log() it replaces (the host has an fpu, the M0+ does not, so only the ratio carries over)
+*/
+
+#define BENCH_MIN -20
+#define BENCH_MAX 125
+#define BENCH_ERROR_MAX 0.25
+#define BENCH_RUNS 2000000
+#define BENCH_KELVIN 273.15
+
+typedef struct bench_thermistor_t {
+    const char *name;
+    double coefficients[4];  // beta: 1/T0, 1/beta, 0, 0
+    double r0, r1;
+} bench_thermistor_t;
+
+static bool accuracy(const bench_thermistor_t *bench);
+static void speed(void);
+static double exact(const bench_thermistor_t *bench, double ratio);
+static double elapsed_ns(struct timespec *start);
+
+static const bench_thermistor_t thermistors[] = {
+    {"ntc", {1 / (25 + BENCH_KELVIN), 1 / 4190.0}, 100000, 10000},
+    {"ntc sh", {3.35E-03, 2.46E-04, 3.41E-06, 1.03E-07}, 100000, 10000},
+    {"hw4", {1 / (25 + BENCH_KELVIN), 1 / 3950.0}, 47000, 10000},
+    {"apd hv", {1 / (25 + BENCH_KELVIN), 1 / 3455.0}, 10000, 10000},
+    {"castle", {1 / (25 + BENCH_KELVIN), 1 / 3455.0}, 10000, 10200},
+};
+
+int main(void) {
+    bool is_ok = true;
+    printf("%-8s %10s %10s %12s %10s\n", "ntc", "max err C", "at C", "rms err C", "lsb C");
+    for (unsigned i = 0; i < sizeof(thermistors) / sizeof(thermistors[0]); i++) is_ok &= accuracy(&thermistors[i]);
+    printf("\n");
+    speed();
+    return is_ok ? 0 : 1;
+}
+
+static bool accuracy(const bench_thermistor_t *bench) {
+    thermistor_t thermistor;
+    double error_max = 0, error_at = 0, error_sum = 0, lsb = 0;
+    unsigned count = 0;
+    bool is_ok = true;
+    thermistor_init_steinhart(&thermistor, bench->coefficients[0], bench->coefficients[1], bench->coefficients[2],
+                              bench->coefficients[3], bench->r0, bench->r1);
+    for (uint32_t code = 1; code < 4096; code++) {
+        double real = exact(bench, code / 4096.0);
+        if (real < BENCH_MIN || real > BENCH_MAX) continue;
+        double step = fabs(exact(bench, (code + 1) / 4096.0) - real);
+        double error = fabs(thermistor_temperature(&thermistor, code << 4) - real);
+        if (error > error_max) {
+            error_max = error;
+            error_at = real;
+        }
+        if (step > lsb) lsb = step;
+        if (error > BENCH_ERROR_MAX && error > step) is_ok = false;
+        error_sum += error * error;
+        count++;
+    }
+    printf("%-8s %10.3f %10.1f %12.3f %10.3f %s\n", bench->name, error_max, error_at, sqrt(error_sum / count), lsb,
+           is_ok ? "ok" : "FAIL");
+    return is_ok;
+}
+
+static void speed(void) {
+    thermistor_t thermistor;
+    struct timespec start;
+    volatile float sink = 0;
+    thermistor_init_beta(&thermistor, 3950, 47000, 25, 10000);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) sink += thermistor_temperature(&thermistor, (i & 0xFFF) << 4);
+    double table_ns = elapsed_ns(&start) / BENCH_RUNS;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_RUNS; i++) {
+        // esc_hw4.c get_temperature() it replaced
+        float voltage = (i & 0xFFF) * 3.3 / 4096.0;
+        float ntcR_Rref = (voltage * 10000.0 / (3.3 - voltage)) / 47000.0;
+        if (ntcR_Rref < 0.001) continue;
+        sink += 1 / (log(ntcR_Rref) / 3950.0 + 1 / 298.15) - 273.15;
+    }
+    double log_ns = elapsed_ns(&start) / BENCH_RUNS;
+    printf("ns/call table %.1f log %.1f\n", table_ns, log_ns);
+}
+
+static double exact(const bench_thermistor_t *bench, double ratio) {
+    double ln = log(ratio * bench->r1 / (1 - ratio) / bench->r0);
+    const double *c = bench->coefficients;
+    return 1 / (c[0] + c[1] * ln + c[2] * ln * ln + c[3] * ln * ln * ln) - BENCH_KELVIN;
+}
+
+static double elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
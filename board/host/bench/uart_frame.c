@@ -0,0 +1,157 @@
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "uart_frame.h"
+
+/*
+   Idle line frame benchmark
+   Feeds 20 s byte streams through a model of the rp2040 uart (32 byte fifo, level irq, receive timeout irq 32 bit
+   periods after the last byte while the fifo is not empty, held until it is emptied), with 1 us steps and a random irq
+   latency. The irq and the alarm act on the uart_frame_irq(), uart_frame_irq_end() and uart_frame_alarm() results as
+   uart.c does in UART0_RX_IDLE_FRAME mode. Frames have random lengths and some gaps inside them, shorter than the
+   protocol timeout, and are separated by gaps longer than the idle and protocol timeouts together. Every frame must be
+   delivered once, complete and alone, and the fifo must not overrun. Inner gaps longer than the idle timeout, irqs and
+   alarms are per frame: each frame costs one level irq per fifo level, one receive timeout irq and one alarm, and each
+   inner gap up to one more of both. The byte irq costs an irq and an alarm per byte
+*/
+
+#define BENCH_US 20000000
+#define BENCH_FRAMES 100000
+#define BENCH_LATENCY_US 20
+#define BENCH_FRAME_MAX 64
+#define BENCH_FIFO_LEVEL 3  // UART0_RX_FIFO_LEVEL
+#define BENCH_INNER_GAP 0.7    // of the protocol timeout, max
+#define BENCH_INNER_GAPS 0.05  // per byte
+
+typedef struct bench_case_t {
+    const char *name;
+    uint32_t baudrate, char_bits, timeout_us;
+} bench_case_t;
+
+typedef struct bench_row_t {
+    unsigned frames, delivered, errors, overruns, gaps, irqs, alarms;
+} bench_row_t;
+
+static bench_row_t run(const bench_case_t *bench, uint8_t fifo_level);
+static void deliver(bench_row_t *row);
+static uint32_t next(void);
+
+static const bench_case_t cases[] = {
+    {"smartport", 57600, 10, 500}, {"sbus", 100000, 12, 500}, {"crsf", 416666, 10, 1000},
+    {"jr dmss", 250000, 11, 300},  {"hott", 19200, 10, 5000},
+};
+static const uint8_t level_bytes[] = {4, 8, 16, 24, 28};  // UARTIFLS RXIFLSEL
+static uint32_t seed = 1;
+static uint32_t line_start[BENCH_FRAMES], line_length[BENCH_FRAMES];  // sent frames, first byte and length
+static uint32_t frame_start, frame_length;                              // frame being received
+
+int main(void) {
+    bool is_ok = true;
+    printf("%-10s %8s %10s %8s %9s %10s %10s %10s\n", "stream", "frames", "delivered", "errors", "overruns",
+           "gap/frame", "irq/frame", "alarm/frame");
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        bench_row_t row = run(&cases[i], BENCH_FIFO_LEVEL);
+        bool is_case_ok = row.frames && row.delivered == row.frames && !row.errors && !row.overruns;
+        printf("%-10s %8u %10u %8u %9u %10.2f %10.2f %10.2f %s\n", cases[i].name, row.frames, row.delivered,
+               row.errors, row.overruns, (float)row.gaps / row.frames, (float)row.irqs / row.frames,
+               (float)row.alarms / row.frames, is_case_ok ? "ok" : "FAIL");
+        is_ok &= is_case_ok;
+    }
+    return is_ok ? 0 : 1;
+}
+
+/* Bytes are a running count, so a delivered frame is checked by its first byte and its length */
+static bench_row_t run(const bench_case_t *bench, uint8_t fifo_level) {
+    bench_row_t row = {0};
+    uart_frame_t frame;
+    uint32_t char_us = (bench->char_bits * 1000000 + bench->baudrate - 1) / bench->baudrate;
+    uint32_t idle_us = (UART_FRAME_IDLE_BITS * 1000000 + bench->baudrate - 1) / bench->baudrate;
+    uint32_t gap_min = idle_us + BENCH_LATENCY_US + bench->timeout_us + char_us;
+    uint32_t fifo[UART_FRAME_FIFO_SIZE], fifo_count = 0, fifo_tail = 0;
+    uint32_t value = 0, frame_left = 0, last_byte_us = 0, irq_us = 0, alarm_us = 0;
+    bool is_irq = false, is_alarm = false, is_timeout = false;
+    uart_frame_init(&frame, bench->timeout_us, fifo_level);
+    frame_length = 0;
+    // the time starts near the wrap of time_us_32()
+    uint32_t start = 0xFFFFFFFF - BENCH_US / 2, next_byte_us = start + 1000;
+    for (uint32_t now = start; now != start + BENCH_US; now++) {
+        // line: a byte ends at next_byte_us
+        if (now == next_byte_us && row.frames < BENCH_FRAMES) {
+            if (!frame_left) {
+                frame_left = 1 + next() % BENCH_FRAME_MAX;
+                line_start[row.frames] = value;
+                line_length[row.frames++] = frame_left;
+            }
+            if (fifo_count == UART_FRAME_FIFO_SIZE)
+                row.overruns++;
+            else
+                fifo[(fifo_tail + fifo_count++) % UART_FRAME_FIFO_SIZE] = value;
+            value++;
+            last_byte_us = now;
+            uint32_t gap = 0;
+            if (!--frame_left)
+                gap = gap_min + next() % (4 * bench->timeout_us);
+            else if (next() % 1000 < BENCH_INNER_GAPS * 1000) {
+                gap = next() % (uint32_t)(BENCH_INNER_GAP * bench->timeout_us);
+                if (char_us + gap >= idle_us) row.gaps++;
+            }
+            next_byte_us += char_us + gap;
+        }
+        // uart irq: level or receive timeout, served after a latency. The timeout stays until the fifo is emptied
+        bool is_level = fifo_count >= level_bytes[fifo_level];
+        if (fifo_count && now - last_byte_us >= idle_us) is_timeout = true;
+        if (!is_irq && (is_level || is_timeout)) {
+            is_irq = true;
+            irq_us = now + 1 + next() % BENCH_LATENCY_US;
+        }
+        if (is_irq && now == irq_us) {
+            // uart0_rx_frame_handler()
+            uint32_t remaining;
+            bool is_new_frame;
+            uint32_t reads = uart_frame_irq(&frame, now, is_timeout, &is_new_frame);
+            is_irq = false;
+            row.irqs++;
+            if (is_new_frame) {
+                frame_start = fifo_count ? fifo[fifo_tail] : value;
+                frame_length = 0;
+            }
+            while (reads-- && fifo_count) {
+                if (fifo[fifo_tail] != frame_start + frame_length) row.errors++;
+                frame_length++;
+                fifo_tail = (fifo_tail + 1) % UART_FRAME_FIFO_SIZE;
+                fifo_count--;
+            }
+            uart_frame_event_t event = uart_frame_irq_end(&frame, now, is_timeout, &remaining);
+            if (is_timeout) is_timeout = fifo_count;
+            if (event != UART_FRAME_NONE) is_alarm = false;
+            if (event == UART_FRAME_COMPLETE) deliver(&row);
+            if (event == UART_FRAME_WAIT) {
+                is_alarm = true;
+                alarm_us = now + remaining;
+            }
+        }
+        if (is_alarm && now == alarm_us) {
+            // uart0_frame_callback(), a negative return reschedules from the previous alarm time
+            uint32_t remaining;
+            row.alarms++;
+            uart_frame_event_t event = uart_frame_alarm(&frame, now, fifo_count, &remaining);
+            if (event == UART_FRAME_COMPLETE) deliver(&row);
+            is_alarm = event == UART_FRAME_WAIT;
+            alarm_us = now + remaining;
+        }
+    }
+    // the last frame may still be in progress
+    if (frame_left || frame.is_receiving) row.frames--;
+    return row;
+}
+
+/* The task reads the frame: it must be the next one sent, whole */
+static void deliver(bench_row_t *row) {
+    uint32_t index = row->delivered++;
+    if (frame_start != line_start[index] || frame_length != line_length[index]) row->errors++;
+}
+
+static uint32_t next(void) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
@@ -0,0 +1,89 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gps_parser.h"
+
+/*
+   GPS parser fuzz target
+   Feeds arbitrary bytes to gps_parser_feed() and aborts if the parser state leaves its bounds. With clang it links
+   libFuzzer (msrc_fuzz_gps_parser corpus_dir). Other compilers build the standalone driver below: it runs the files
+   given as arguments and then a fixed number of inputs mixing random bytes with spliced UBX and NMEA messages, so the
+   target still runs under the sanitizers without libFuzzer
+*/
+
+#define FUZZ_RUNS 200000
+#define FUZZ_INPUT_MAX 512
+
+static gps_parser_t parser;
+static uint32_t epochs, checksum_errors;
+
+static void check(const gps_parser_t *parser);
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    gps_parser_init(&parser);
+    for (size_t i = 0; i < size; i++) {
+        gps_parser_feed(&parser, data[i]);
+        check(&parser);
+    }
+    epochs += parser.epochs;
+    checksum_errors += parser.checksum_errors;
+    return 0;
+}
+
+static void check(const gps_parser_t *parser) {
+    if (parser->field_length >= GPS_PARSER_FIELD_MAX || parser->ubx_index > GPS_PARSER_PAYLOAD_MAX) {
+        fprintf(stderr, "gps parser out of bounds: state %u field %u ubx %u/%u\n", parser->state,
+                parser->field_length, parser->ubx_index, parser->ubx_length);
+        abort();
+    }
+}
+
+#ifndef LIBFUZZER
+static const char *seeds[] = {
+    "$GPGGA,123519.20,4807.0380000,N,01131.0000000,E,1,08,0.9,545.4,M,46.9,M,,*",
+    "$GPRMC,123519.20,A,4807.0380000,N,01131.0000000,E,022.4,084.4,230394,003.1,W*",
+    "$GNGGA,,,,,,0,00,99.99,,,,,,*56\r\n",
+    "\xB5\x62\x01\x04\x12\x00",
+    "\xB5\x62\x01\x07\x5C\x00",
+};
+
+static void run_file(const char *path);
+
+int main(int argc, char **argv) {
+    uint8_t input[FUZZ_INPUT_MAX];
+    for (int i = 1; i < argc; i++) run_file(argv[i]);
+    srand(1);
+    for (unsigned run = 0; run < FUZZ_RUNS; run++) {
+        size_t size = rand() % FUZZ_INPUT_MAX;
+        for (size_t i = 0; i < size;) {
+            if (rand() % 4) {
+                input[i++] = rand();
+                continue;
+            }
+            const char *seed = seeds[rand() % (sizeof(seeds) / sizeof(seeds[0]))];
+            size_t length = strlen(seed);
+            // UBX seeds are headers only, the payload and checksum come from the random bytes
+            if (seed[0] == '\xB5') length = 6;
+            for (size_t j = 0; j < length && i < size; j++) input[i++] = seed[j];
+        }
+        LLVMFuzzerTestOneInput(input, size);
+    }
+    printf("gps parser: %u runs, %u epochs, %u checksum errors\n", FUZZ_RUNS, epochs, checksum_errors);
+    return 0;
+}
+
+static void run_file(const char *path) {
+    static uint8_t data[1 << 16];
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "gps parser: can't open %s\n", path);
+        exit(1);
+    }
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+    LLVMFuzzerTestOneInput(data, size);
+    printf("gps parser: %s, %zu bytes, %u epochs\n", path, size, parser.epochs);
+}
+#endif
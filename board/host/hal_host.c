@@ -0,0 +1,643 @@
+#include "hal_host.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+
+#include "adc_sampler.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/flash.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "pool.h"
+#include "run_loop.h"
+#include "semphr.h"
+#include "sensor_registry.h"
+
+#define HAL_HOST_MAX_TASKS 64
+#define HAL_HOST_MAX_ALARMS 32
+#define HAL_HOST_ADC_INPUTS 5
+#define HAL_HOST_CLOCK_SYS_HZ 125000000
+#define HAL_HOST_TASK_STACK_SIZE (256 * 1024)
+#define HAL_HOST_WAIT_FOREVER UINT64_MAX
+
+typedef enum host_task_state_t { TASK_READY, TASK_BLOCKED, TASK_SUSPENDED, TASK_DELETED } host_task_state_t;
+
+typedef struct host_task_t {
+    TaskFunction_t function;
+    void *parameters;
+    const char *name;
+    UBaseType_t priority;
+    uint32_t notify[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+    host_task_state_t state;
+    int wait_notify;
+    QueueHandle_t wait_queue;
+    uint64_t wake_us, run_ns;
+    ucontext_t context;
+    uint8_t *stack;
+    bool is_used;
+} host_task_t;
+
+typedef struct host_alarm_t {
+    alarm_id_t id;
+    uint64_t due_us;
+    alarm_callback_t callback;
+    void *user_data;
+    bool is_active;
+} host_alarm_t;
+
+struct host_queue_t {
+    uint8_t *storage;
+    UBaseType_t length, item_size, head, count;
+    struct host_queue_t *next;
+};
+
+struct uart_inst {
+    uint index;
+};
+
+struct i2c_inst {
+    uint index;
+};
+
+struct pio_hw {
+    uint index;
+};
+
+context_t context;
+uint8_t host_flash[HOST_FLASH_SIZE_BYTES];
+uint8_t host_ppb[HOST_PPB_SIZE_BYTES];
+
+static struct uart_inst uart_inst[2] = {{0}, {1}};
+static struct i2c_inst i2c_inst[2] = {{0}, {1}};
+static struct pio_hw pio_inst[2] = {{0}, {1}};
+uart_inst_t *const host_uart0 = &uart_inst[0], *const host_uart1 = &uart_inst[1];
+i2c_inst_t *const host_i2c0 = &i2c_inst[0], *const host_i2c1 = &i2c_inst[1];
+pio_hw_t *const host_pio0 = &pio_inst[0], *const host_pio1 = &pio_inst[1];
+
+static uint64_t now_us, isr_ns, tasks_ns, switch_count;
+static uint32_t flash_erase_count;
+static host_task_t tasks[HAL_HOST_MAX_TASKS];
+static host_task_t *current_task;
+static uint last_task;
+static ucontext_t scheduler_context;
+static bool is_scheduler_started;
+static host_alarm_t alarms[HAL_HOST_MAX_ALARMS];
+static QueueHandle_t queues;
+static alarm_id_t alarm_id_counter;
+static bool gpio_level[NUM_BANK0_GPIOS];
+static uint16_t adc_value[HAL_HOST_ADC_INPUTS];
+static uint adc_input;
+
+static host_alarm_t *alarm_next(uint64_t until_us);
+static alarm_id_t alarm_add(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+static void alarm_fire(host_alarm_t *alarm);
+static void scheduler_run(void);
+static host_task_t *task_next_ready(void);
+static host_task_t *task_next_wake(uint64_t until_us);
+static uint64_t task_wake_us(TickType_t ticks);
+static void task_block(uint64_t wake_us, int wait_notify, QueueHandle_t wait_queue);
+static void task_unblock(host_task_t *task);
+static void task_entry(void);
+static uint64_t elapsed_ns(struct timespec *start);
+
+void hal_host_reset(void) {
+    for (uint i = 0; i < HAL_HOST_MAX_TASKS; i++) free(tasks[i].stack);
+    while (queues) vQueueDelete(queues);
+    pool_reset();
+    sensor_registry_reset();
+    run_loop_reset();
+    now_us = 0;
+    isr_ns = 0;
+    tasks_ns = 0;
+    switch_count = 0;
+    current_task = NULL;
+    last_task = 0;
+    is_scheduler_started = false;
+    alarm_id_counter = 0;
+    adc_input = 0;
+    memset(tasks, 0, sizeof(tasks));
+    memset(alarms, 0, sizeof(alarms));
+    memset(gpio_level, 0, sizeof(gpio_level));
+    memset(adc_value, 0, sizeof(adc_value));
+    memset(&context, 0, sizeof(context));
+    memset(host_flash, 0xFF, sizeof(host_flash));
+    flash_erase_count = 0;
+}
+
+void hal_host_start_scheduler(void) {
+    is_scheduler_started = true;
+    scheduler_run();
+}
+
+void hal_host_set_time_us(uint64_t time_us) { now_us = time_us; }
+
+/* Discrete event loop: alarms and task timeouts are processed in time order, ready tasks run after each event */
+void hal_host_advance_us(uint64_t us) {
+    uint64_t until_us = now_us + us;
+    scheduler_run();
+    while (true) {
+        host_alarm_t *alarm = alarm_next(until_us);
+        host_task_t *task = task_next_wake(until_us);
+        if (!alarm && !task) break;
+        if (alarm && (!task || alarm->due_us <= task->wake_us)) {
+            alarm_fire(alarm);
+        } else {
+            now_us = task->wake_us;
+            task_unblock(task);
+        }
+        scheduler_run();
+    }
+    now_us = until_us;
+}
+
+uint32_t hal_host_notify_count(TaskHandle_t task, UBaseType_t index) {
+    if (!task || index >= configTASK_NOTIFICATION_ARRAY_ENTRIES) return 0;
+    return ((host_task_t *)task)->notify[index];
+}
+
+TaskFunction_t hal_host_task_function(TaskHandle_t task) { return task ? ((host_task_t *)task)->function : NULL; }
+
+bool hal_host_task_is_suspended(TaskHandle_t task) {
+    return task ? ((host_task_t *)task)->state == TASK_SUSPENDED : false;
+}
+
+uint64_t hal_host_task_run_ns(TaskHandle_t task) { return task ? ((host_task_t *)task)->run_ns : 0; }
+
+uint64_t hal_host_tasks_run_ns(void) { return tasks_ns; }
+
+uint64_t hal_host_isr_run_ns(void) { return isr_ns; }
+
+uint64_t hal_host_switch_count(void) { return switch_count; }
+
+uint32_t hal_host_flash_erase_count(void) { return flash_erase_count; }
+
+void hal_host_gpio_set(uint gpio, bool value) {
+    if (gpio < NUM_BANK0_GPIOS) gpio_level[gpio] = value;
+}
+
+void hal_host_adc_set(uint input, uint16_t value) {
+    if (input < HAL_HOST_ADC_INPUTS) adc_value[input] = value;
+}
+
+/* FreeRTOS */
+
+BaseType_t xTaskCreate(TaskFunction_t task_code, const char *const name, const configSTACK_DEPTH_TYPE stack_depth,
+                       void *const parameters, UBaseType_t priority, TaskHandle_t *const created_task) {
+    for (uint i = 0; i < HAL_HOST_MAX_TASKS; i++) {
+        host_task_t *task = &tasks[i];
+        if (task->is_used) continue;
+        free(task->stack);
+        memset(task, 0, sizeof(host_task_t));
+        task->stack = malloc(HAL_HOST_TASK_STACK_SIZE);
+        if (!task->stack) return pdFAIL;
+        task->function = task_code;
+        task->parameters = parameters;
+        task->name = name;
+        task->priority = priority;
+        task->state = TASK_READY;
+        task->wait_notify = -1;
+        task->is_used = true;
+        getcontext(&task->context);
+        task->context.uc_stack.ss_sp = task->stack;
+        task->context.uc_stack.ss_size = HAL_HOST_TASK_STACK_SIZE;
+        task->context.uc_link = &scheduler_context;
+        makecontext(&task->context, task_entry, 0);
+        if (created_task) *created_task = task;
+        return pdPASS;
+    }
+    return pdFAIL;
+}
+
+/* The buffers are only accounted for: host tasks need the larger ucontext stacks */
+TaskHandle_t xTaskCreateStatic(TaskFunction_t task_code, const char *const name, const uint32_t stack_depth,
+                               void *const parameters, UBaseType_t priority, StackType_t *const stack_buffer,
+                               StaticTask_t *const task_buffer) {
+    TaskHandle_t task = NULL;
+    xTaskCreate(task_code, name, stack_depth, parameters, priority, &task);
+    return task;
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+    host_task_t *task = handle ? handle : current_task;
+    if (!task) return;
+    task->state = TASK_DELETED;
+    task->is_used = false;
+    if (task == current_task) swapcontext(&task->context, &scheduler_context);
+}
+
+void vTaskSuspend(TaskHandle_t handle) {
+    host_task_t *task = handle ? handle : current_task;
+    if (!task) return;
+    task->state = TASK_SUSPENDED;
+    if (task == current_task) swapcontext(&task->context, &scheduler_context);
+}
+
+void vTaskResume(TaskHandle_t handle) {
+    host_task_t *task = handle;
+    if (task && task->state == TASK_SUSPENDED) task_unblock(task);
+}
+
+void vTaskDelay(const TickType_t ticks) {
+    if (!current_task) {
+        hal_host_advance_us((uint64_t)ticks * portTICK_PERIOD_MS * 1000);
+    } else if (!ticks) {
+        swapcontext(&current_task->context, &scheduler_context);
+    } else {
+        task_block(task_wake_us(ticks), -1, NULL);
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return current_task; }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) { return configMINIMAL_STACK_SIZE; }
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t handle, UBaseType_t index) {
+    host_task_t *task = handle;
+    if (!task || index >= configTASK_NOTIFICATION_ARRAY_ENTRIES) return pdPASS;
+    task->notify[index]++;
+    if (task->state == TASK_BLOCKED && task->wait_notify == (int)index) task_unblock(task);
+    return pdPASS;
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *higher_priority_task_woken) {
+    xTaskNotifyGiveIndexed(task, index);
+    if (higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+    host_task_t *task = current_task;
+    if (!task || index >= configTASK_NOTIFICATION_ARRAY_ENTRIES) return 0;
+    if (!task->notify[index] && ticks_to_wait) task_block(task_wake_us(ticks_to_wait), index, NULL);
+    uint32_t value = task->notify[index];
+    if (value) task->notify[index] = clear_on_exit ? 0 : value - 1;
+    return value;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    QueueHandle_t queue = calloc(1, sizeof(struct host_queue_t));
+    if (!queue) return NULL;
+    queue->length = length;
+    queue->item_size = item_size;
+    if (item_size) {
+        queue->storage = malloc(length * item_size);
+        if (!queue->storage) {
+            free(queue);
+            return NULL;
+        }
+    }
+    queue->next = queues;
+    queues = queue;
+    return queue;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t item_size, uint8_t *storage,
+                                 StaticQueue_t *queue_buffer) {
+    return xQueueCreate(length, item_size);
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    if (!queue) return;
+    for (QueueHandle_t *link = &queues; *link; link = &(*link)->next) {
+        if (*link == queue) {
+            *link = queue->next;
+            break;
+        }
+    }
+    free(queue->storage);
+    free(queue);
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticks_to_wait) {
+    if (!queue || queue->count == queue->length) return pdFAIL;
+    if (queue->item_size)
+        memcpy(queue->storage + ((queue->head + queue->count) % queue->length) * queue->item_size, item,
+               queue->item_size);
+    queue->count++;
+    for (uint i = 0; i < HAL_HOST_MAX_TASKS; i++) {
+        if (tasks[i].state == TASK_BLOCKED && tasks[i].wait_queue == queue) {
+            task_unblock(&tasks[i]);
+            break;
+        }
+    }
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_task_woken) {
+    if (higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xQueueSendToBack(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *buffer, TickType_t ticks_to_wait) {
+    if (!queue) return pdFAIL;
+    if (current_task && ticks_to_wait) {
+        uint64_t wake_us = task_wake_us(ticks_to_wait);
+        while (!queue->count && now_us < wake_us) task_block(wake_us, -1, queue);
+    }
+    if (!queue->count) return pdFAIL;
+    if (queue->item_size) memcpy(buffer, queue->storage + queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdPASS;
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void *buffer, BaseType_t *higher_priority_task_woken) {
+    if (higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xQueueReceive(queue, buffer, 0);
+}
+
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t queue) { return queue ? queue->count : 0; }
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+    if (queue) queue->head = queue->count = 0;
+    return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return xQueueCreate(1, 0); }
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *mutex_buffer) { return xSemaphoreCreateMutex(); }
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+    xSemaphoreGive(mutex);
+    return mutex;
+}
+
+/* Time */
+
+uint32_t time_us_32(void) { return (uint32_t)now_us; }
+
+uint64_t time_us_64(void) { return now_us; }
+
+absolute_time_t get_absolute_time(void) { return now_us; }
+
+uint32_t to_ms_since_boot(absolute_time_t t) { return t / 1000; }
+
+void sleep_us(uint64_t us) {
+    if (current_task)
+        task_block(now_us + us, -1, NULL);
+    else
+        hal_host_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) { sleep_us((uint64_t)ms * 1000); }
+
+void busy_wait_us(uint64_t us) { sleep_us(us); }
+
+alarm_pool_t *alarm_pool_create(uint hardware_alarm_num, uint max_timers) { return (alarm_pool_t *)alarms; }
+
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us, alarm_callback_t callback, void *user_data,
+                                      bool fire_if_past) {
+    return alarm_add(us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t alarm_pool_add_alarm_in_ms(alarm_pool_t *pool, uint32_t ms, alarm_callback_t callback, void *user_data,
+                                      bool fire_if_past) {
+    return alarm_add((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool alarm_pool_cancel_alarm(alarm_pool_t *pool, alarm_id_t alarm_id) { return cancel_alarm(alarm_id); }
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return alarm_add(us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return alarm_add((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    for (uint i = 0; i < HAL_HOST_MAX_ALARMS; i++) {
+        if (alarms[i].is_active && alarms[i].id == alarm_id) {
+            alarms[i].is_active = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+static alarm_id_t alarm_add(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    if (!us) {
+        if (!fire_if_past) return 0;
+        int64_t reschedule = callback(0, user_data);
+        if (!reschedule) return 0;
+        us = reschedule > 0 ? reschedule : -reschedule;
+    }
+    for (uint i = 0; i < HAL_HOST_MAX_ALARMS; i++) {
+        if (alarms[i].is_active) continue;
+        if (++alarm_id_counter <= 0) alarm_id_counter = 1;
+        alarms[i].id = alarm_id_counter;
+        alarms[i].due_us = now_us + us;
+        alarms[i].callback = callback;
+        alarms[i].user_data = user_data;
+        alarms[i].is_active = true;
+        return alarms[i].id;
+    }
+    return -1;
+}
+
+static host_alarm_t *alarm_next(uint64_t until_us) {
+    host_alarm_t *next = NULL;
+    for (uint i = 0; i < HAL_HOST_MAX_ALARMS; i++) {
+        if (!alarms[i].is_active || alarms[i].due_us > until_us) continue;
+        if (!next || alarms[i].due_us < next->due_us) next = &alarms[i];
+    }
+    return next;
+}
+
+static void alarm_fire(host_alarm_t *alarm) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    now_us = alarm->due_us;
+    alarm->is_active = false;
+    int64_t reschedule = alarm->callback(alarm->id, alarm->user_data);
+    if (reschedule > 0) {
+        alarm->due_us += reschedule;
+        alarm->is_active = true;
+    } else if (reschedule < 0) {
+        alarm->due_us = now_us - reschedule;
+        alarm->is_active = true;
+    }
+    isr_ns += elapsed_ns(&start);
+}
+
+/* Scheduler */
+
+static void scheduler_run(void) {
+    host_task_t *task;
+    if (!is_scheduler_started || current_task) return;
+    while ((task = task_next_ready())) {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        current_task = task;
+        switch_count++;
+        swapcontext(&scheduler_context, &task->context);
+        current_task = NULL;
+        uint64_t run_ns = elapsed_ns(&start);
+        task->run_ns += run_ns;
+        tasks_ns += run_ns;
+    }
+}
+
+/* Highest priority ready task, round robin among equals */
+static host_task_t *task_next_ready(void) {
+    host_task_t *next = NULL;
+    for (uint i = 1; i <= HAL_HOST_MAX_TASKS; i++) {
+        uint index = (last_task + i) % HAL_HOST_MAX_TASKS;
+        if (!tasks[index].is_used || tasks[index].state != TASK_READY) continue;
+        if (!next || tasks[index].priority > next->priority) next = &tasks[index];
+    }
+    if (next) last_task = next - tasks;
+    return next;
+}
+
+static host_task_t *task_next_wake(uint64_t until_us) {
+    host_task_t *next = NULL;
+    for (uint i = 0; i < HAL_HOST_MAX_TASKS; i++) {
+        if (tasks[i].state != TASK_BLOCKED || tasks[i].wake_us > until_us) continue;
+        if (!next || tasks[i].wake_us < next->wake_us) next = &tasks[i];
+    }
+    return next;
+}
+
+static uint64_t task_wake_us(TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return HAL_HOST_WAIT_FOREVER;
+    return now_us + (uint64_t)ticks * portTICK_PERIOD_MS * 1000;
+}
+
+static void task_block(uint64_t wake_us, int wait_notify, QueueHandle_t wait_queue) {
+    host_task_t *task = current_task;
+    task->state = TASK_BLOCKED;
+    task->wake_us = wake_us;
+    task->wait_notify = wait_notify;
+    task->wait_queue = wait_queue;
+    swapcontext(&task->context, &scheduler_context);
+}
+
+static void task_unblock(host_task_t *task) {
+    task->state = TASK_READY;
+    task->wait_notify = -1;
+    task->wait_queue = NULL;
+}
+
+/* A task function that returns is deleted, the context then resumes the scheduler */
+static void task_entry(void) {
+    current_task->function(current_task->parameters);
+    current_task->state = TASK_DELETED;
+    current_task->is_used = false;
+}
+
+static uint64_t elapsed_ns(struct timespec *start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (uint64_t)(end.tv_sec - start->tv_sec) * 1000000000 + end.tv_nsec - start->tv_nsec;
+}
+
+/* Peripherals */
+
+void gpio_init(uint gpio) {}
+
+void gpio_init_mask(uint gpio_mask) {}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {}
+
+void gpio_set_dir(uint gpio, bool out) {}
+
+void gpio_set_dir_in_masked(uint32_t mask) {}
+
+void gpio_pull_up(uint gpio) {}
+
+void gpio_pull_down(uint gpio) {}
+
+void gpio_set_outover(uint gpio, uint value) {}
+
+void gpio_set_inover(uint gpio, uint value) {}
+
+void gpio_set_input_enabled(uint gpio, bool enabled) {}
+
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive) {}
+
+void gpio_put(uint gpio, bool value) { hal_host_gpio_set(gpio, value); }
+
+bool gpio_get(uint gpio) { return gpio < NUM_BANK0_GPIOS ? gpio_level[gpio] : false; }
+
+void adc_init(void) {}
+
+void adc_gpio_init(uint gpio) {}
+
+void adc_select_input(uint input) { adc_input = input; }
+
+uint16_t adc_read(void) { return adc_input < HAL_HOST_ADC_INPUTS ? adc_value[adc_input] : 0; }
+
+void adc_sampler_add(uint8_t input) {}
+
+/* One block of the input through the decimator, instead of the dma round robin */
+uint16_t adc_sampler_read(uint8_t input) {
+    adc_decimator_t decimator = {0};
+    uint16_t samples[ADC_DECIMATOR_SAMPLES];
+    if (input >= ADC_DECIMATOR_INPUTS) return 0;
+    adc_decimator_init(&decimator, 1 << input);
+    adc_select_input(input);
+    for (uint i = 0; i < ADC_DECIMATOR_SAMPLES; i++) samples[i] = adc_read();
+    adc_decimator_block(&decimator, samples);
+    return adc_decimator_value(&decimator, input);
+}
+
+/* One block of the input per call */
+adc_decimator_total_t adc_sampler_total(uint8_t input) {
+    static adc_decimator_total_t total[ADC_DECIMATOR_INPUTS];
+    if (input >= ADC_DECIMATOR_INPUTS) return (adc_decimator_total_t){0};
+    adc_select_input(input);
+    total[input].sum += adc_read() * ADC_DECIMATOR_SAMPLES;
+    total[input].samples += ADC_DECIMATOR_SAMPLES;
+    return total[input];
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) { return baudrate; }
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) { return len; }
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    memset(dst, 0, len);
+    return len;
+}
+
+pwm_config pwm_get_default_config(void) {
+    pwm_config c = {0, 1 << 4, 0xffff};
+    return c;
+}
+
+void pwm_config_set_clkdiv(pwm_config *c, float div) { c->div = (uint32_t)(div * (1 << 4)); }
+
+void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) { c->top = wrap; }
+
+uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) & 7; }
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {}
+
+uint32_t clock_get_hz(enum clock_index clk_index) { return HAL_HOST_CLOCK_SYS_HZ; }
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {}
+
+void irq_set_enabled(uint num, bool enabled) {}
+
+uint uart_get_index(uart_inst_t *uart) { return uart->index; }
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    memset(host_flash + flash_offs, 0xFF, count);
+    flash_erase_count++;
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; i++) host_flash[flash_offs + i] &= data[i];
+}
@@ -0,0 +1,50 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include "capture_edge.h"
+#include "castle_link.h"
+#include "common.h"
+
+/*
+   Host hardware abstraction
+   Runs the protocol and sensor code on a PC. Time only moves with hal_host_advance_us(), which processes the due
+   alarms and task timeouts in order. Tasks are registered and, once hal_host_start_scheduler() is called, run
+   cooperatively on their own stacks until they block. Alarm callbacks run as the irq context. Received bytes follow
+   the uart idle timeout rules of the firmware, transmitted bytes are captured. Call hal_host_reset() before each run
+*/
+
+typedef enum hal_host_uart_t { HAL_HOST_UART0, HAL_HOST_UART1, HAL_HOST_UART_PIO } hal_host_uart_t;
+
+extern context_t context;
+
+void hal_host_reset(void);
+void hal_host_start_scheduler(void);
+
+void hal_host_set_time_us(uint64_t now_us);
+void hal_host_advance_us(uint64_t us);
+
+uint32_t hal_host_notify_count(TaskHandle_t task, UBaseType_t index);
+TaskFunction_t hal_host_task_function(TaskHandle_t task);
+bool hal_host_task_is_suspended(TaskHandle_t task);
+uint64_t hal_host_task_run_ns(TaskHandle_t task);
+uint64_t hal_host_tasks_run_ns(void);
+uint64_t hal_host_isr_run_ns(void);
+uint64_t hal_host_switch_count(void);
+uint32_t hal_host_flash_erase_count(void);
+
+void hal_host_gpio_set(uint gpio, bool value);
+void hal_host_adc_set(uint input, uint16_t value);
+
+void hal_host_uart_rx(hal_host_uart_t uart, const uint8_t *data, uint length);
+uint hal_host_uart_tx(hal_host_uart_t uart, uint8_t *data, uint size);
+uint hal_host_uart_baudrate(hal_host_uart_t uart);
+uint hal_host_uart_pio_tx_baudrate(void);
+
+void hal_host_capture_edge(uint pin, uint counter, edge_type_t edge);
+void hal_host_castle_link(const castle_link_frame_t *frame);
+void hal_host_i2c_multi_receive(uint8_t data, bool is_address);
+void hal_host_i2c_multi_request(uint8_t address);
+void hal_host_i2c_multi_stop(uint8_t length);
+uint8_t *hal_host_i2c_multi_buffer(void);
+
+#endif
@@ -0,0 +1,136 @@
+#include "hal_host.h"
+#include "i2c_multi.h"
+
+#define HAL_PIO_CAPTURE_PINS 32
+#define HAL_PIO_I2C_BUFFER_SIZE 64
+
+typedef struct hal_pio_edge_t {
+    uint pin, counter;
+    edge_type_t edge;
+} hal_pio_edge_t;
+
+static capture_handler_t capture_handler[HAL_PIO_CAPTURE_PINS];
+static bool capture_is_batch;
+static hal_pio_edge_t capture_ring[CAPTURE_EDGE_RING];
+static uint capture_head, capture_tail;
+static castle_link_handler_t castle_handler;
+static castle_link_frame_t castle_frame;
+static i2c_multi_receive_handler_t i2c_receive_handler;
+static i2c_multi_request_handler_t i2c_request_handler;
+static i2c_multi_stop_handler_t i2c_stop_handler;
+static uint8_t i2c_default_buffer[HAL_PIO_I2C_BUFFER_SIZE];
+static uint8_t *i2c_buffer = i2c_default_buffer;
+static bool i2c_address[128];
+
+/* Batch mode stores the edge for capture_edge_drain(), overwriting the oldest as the dma ring does */
+void hal_host_capture_edge(uint pin, uint counter, edge_type_t edge) {
+    if (capture_is_batch) {
+        capture_ring[capture_head++ % CAPTURE_EDGE_RING] = (hal_pio_edge_t){pin, counter, edge};
+        if (capture_head - capture_tail > CAPTURE_EDGE_RING) capture_tail = capture_head - CAPTURE_EDGE_RING;
+        return;
+    }
+    if (pin < HAL_PIO_CAPTURE_PINS && capture_handler[pin]) capture_handler[pin](counter, edge);
+}
+
+void hal_host_castle_link(const castle_link_frame_t *frame) {
+    castle_frame = *frame;
+    if (castle_handler) castle_handler();
+}
+
+void hal_host_i2c_multi_receive(uint8_t data, bool is_address) {
+    if (i2c_receive_handler) i2c_receive_handler(data, is_address);
+}
+
+void hal_host_i2c_multi_request(uint8_t address) {
+    if (i2c_request_handler && i2c_multi_is_address_enabled(address)) i2c_request_handler(address);
+}
+
+void hal_host_i2c_multi_stop(uint8_t length) {
+    if (i2c_stop_handler) i2c_stop_handler(length);
+}
+
+uint8_t *hal_host_i2c_multi_buffer(void) { return i2c_buffer; }
+
+/* capture_edge */
+
+void capture_edge_init(PIO pio, uint pin_base, uint pin_count, float clk_div, uint irq) { capture_is_batch = false; }
+
+void capture_edge_init_batch(PIO pio, uint pin_base, uint pin_count, float clk_div) {
+    capture_is_batch = true;
+    capture_head = capture_tail = 0;
+}
+
+void capture_edge_set_handler(uint pin, capture_handler_t handler) {
+    if (pin < HAL_PIO_CAPTURE_PINS) capture_handler[pin] = handler;
+}
+
+uint capture_edge_drain(void) {
+    uint count = 0;
+    for (; capture_tail != capture_head; capture_tail++, count++) {
+        hal_pio_edge_t *edge = &capture_ring[capture_tail % CAPTURE_EDGE_RING];
+        if (edge->pin < HAL_PIO_CAPTURE_PINS && capture_handler[edge->pin])
+            capture_handler[edge->pin](edge->counter, edge->edge);
+    }
+    return count;
+}
+
+void capture_edge_remove(void) {
+    for (uint i = 0; i < HAL_PIO_CAPTURE_PINS; i++) capture_handler[i] = NULL;
+}
+
+/* castle_link */
+
+void castle_link_init(PIO pio, uint pin_base, uint irq) {}
+
+void castle_link_set_handler(castle_link_handler_t handler) { castle_handler = handler; }
+
+bool castle_link_read(castle_link_frame_t *frame) {
+    *frame = castle_frame;
+    return true;
+}
+
+void castle_link_remove() { castle_handler = NULL; }
+
+/* i2c_multi */
+
+void i2c_multi_init(PIO pio, uint pin) { i2c_multi_disable_all_addresses(); }
+
+void i2c_multi_set_write_buffer(uint8_t *buffer) { i2c_buffer = buffer; }
+
+void i2c_multi_set_receive_handler(i2c_multi_receive_handler_t handler) { i2c_receive_handler = handler; }
+
+void i2c_multi_set_request_handler(i2c_multi_request_handler_t handler) { i2c_request_handler = handler; }
+
+void i2c_multi_set_stop_handler(i2c_multi_stop_handler_t handler) { i2c_stop_handler = handler; }
+
+void i2c_multi_enable_address(uint8_t address) {
+    if (address < 128) i2c_address[address] = true;
+}
+
+void i2c_multi_disable_address(uint8_t address) {
+    if (address < 128) i2c_address[address] = false;
+}
+
+void i2c_multi_enable_all_addresses() {
+    for (uint i = 0; i < 128; i++) i2c_address[i] = true;
+}
+
+void i2c_multi_disable_all_addresses() {
+    for (uint i = 0; i < 128; i++) i2c_address[i] = false;
+}
+
+bool i2c_multi_is_address_enabled(uint8_t address) { return address < 128 && i2c_address[address]; }
+
+void i2c_multi_disable() {}
+
+void i2c_multi_restart() {}
+
+void i2c_multi_remove() {
+    i2c_receive_handler = NULL;
+    i2c_request_handler = NULL;
+    i2c_stop_handler = NULL;
+    i2c_buffer = i2c_default_buffer;
+}
+
+void i2c_multi_fixed_length(int16_t length) {}
+
@@ -0,0 +1,192 @@
+#include <string.h>
+
+#include "hal_host.h"
+#include "uart.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+
+#define HAL_UART_RX_BUFFER_SIZE 512
+#define HAL_UART_TX_BUFFER_SIZE 1024
+
+typedef struct host_uart_t {
+    uint8_t rx_buffer[HAL_UART_RX_BUFFER_SIZE];
+    ring_buffer_t rx_ring;
+    uint8_t tx_buffer[HAL_UART_TX_BUFFER_SIZE];
+    uint tx_count;
+    uint baudrate, timeout, timestamp;
+    bool is_timedout;
+    alarm_id_t timeout_alarm_id;
+} host_uart_t;
+
+static host_uart_t uart[2];
+static TaskHandle_t *const notify_task[2] = {&context.uart0_notify_task_handle, &context.uart1_notify_task_handle};
+static uint8_t pio_tx_buffer[HAL_UART_TX_BUFFER_SIZE];
+static uint pio_tx_count, pio_rx_baudrate, pio_tx_baudrate;
+static uart_rx_handler_t pio_rx_handler;
+
+static void begin(uint index, uint baudrate, uint timeout);
+static int64_t timeout_callback(alarm_id_t id, void *user_data);
+static void rx(uint index, const uint8_t *data, uint length);
+static void tx(uint8_t *buffer, uint *count, const uint8_t *data, uint length);
+static uint tx_drain(uint8_t *buffer, uint *count, uint8_t *data, uint size);
+
+void hal_host_uart_rx(hal_host_uart_t port, const uint8_t *data, uint length) {
+    if (port == HAL_HOST_UART_PIO) {
+        for (uint i = 0; i < length && pio_rx_handler; i++) pio_rx_handler(data[i]);
+        return;
+    }
+    rx(port, data, length);
+}
+
+uint hal_host_uart_tx(hal_host_uart_t port, uint8_t *data, uint size) {
+    if (port == HAL_HOST_UART_PIO) return tx_drain(pio_tx_buffer, &pio_tx_count, data, size);
+    return tx_drain(uart[port].tx_buffer, &uart[port].tx_count, data, size);
+}
+
+/* For the pio uart the rx baudrate, the tx one is hal_host_uart_pio_tx_baudrate() */
+uint hal_host_uart_baudrate(hal_host_uart_t port) {
+    if (port == HAL_HOST_UART_PIO) return pio_rx_handler ? pio_rx_baudrate : 0;
+    return uart[port].baudrate;
+}
+
+uint hal_host_uart_pio_tx_baudrate(void) { return pio_tx_baudrate; }
+
+void uart0_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint databits, uint stopbits,
+                 uart_parity_t parity, bool inverted, bool half_duplex) {
+    begin(0, baudrate, timeout);
+}
+
+void uart1_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint databits, uint stopbits,
+                 uart_parity_t parity, bool inverted, bool half_duplex) {
+    begin(1, baudrate, timeout);
+}
+
+uint8_t uart0_read() {
+    uint8_t value = 0;
+    ring_buffer_get(&uart[0].rx_ring, &value);
+    return value;
+}
+
+uint8_t uart1_read() {
+    uint8_t value = 0;
+    ring_buffer_get(&uart[1].rx_ring, &value);
+    return value;
+}
+
+void uart0_read_bytes(uint8_t *data, uint8_t lenght) { ring_buffer_get_bytes(&uart[0].rx_ring, data, lenght); }
+
+void uart1_read_bytes(uint8_t *data, uint8_t lenght) { ring_buffer_get_bytes(&uart[1].rx_ring, data, lenght); }
+
+uint uart0_peek(uint8_t **data) { return ring_buffer_peek(&uart[0].rx_ring, data); }
+
+uint uart1_peek(uint8_t **data) { return ring_buffer_peek(&uart[1].rx_ring, data); }
+
+void uart0_consume(uint lenght) { ring_buffer_consume(&uart[0].rx_ring, lenght); }
+
+void uart1_consume(uint lenght) { ring_buffer_consume(&uart[1].rx_ring, lenght); }
+
+/* Saturated instead of truncated, the buffer holds more than 255 bytes */
+uint8_t uart0_available() {
+    uint32_t available = ring_buffer_available(&uart[0].rx_ring);
+    return available > UINT8_MAX ? UINT8_MAX : available;
+}
+
+uint8_t uart1_available() {
+    uint32_t available = ring_buffer_available(&uart[1].rx_ring);
+    return available > UINT8_MAX ? UINT8_MAX : available;
+}
+
+uint uart0_get_time_elapsed() { return time_us_32() - uart[0].timestamp; }
+
+uint uart1_get_time_elapsed() { return time_us_32() - uart[1].timestamp; }
+
+void uart0_write(uint8_t data) { tx(uart[0].tx_buffer, &uart[0].tx_count, &data, 1); }
+
+void uart1_write(uint8_t data) { tx(uart[1].tx_buffer, &uart[1].tx_count, &data, 1); }
+
+void uart0_write_bytes(uint8_t *data, uint8_t lenght) { tx(uart[0].tx_buffer, &uart[0].tx_count, data, lenght); }
+
+void uart1_write_bytes(uint8_t *data, uint8_t lenght) { tx(uart[1].tx_buffer, &uart[1].tx_count, data, lenght); }
+
+void uart0_set_timestamp() { uart[0].timestamp = time_us_32(); }
+
+void uart1_set_timestamp() { uart[1].timestamp = time_us_32(); }
+
+/* PIO uart drivers under uart_pio.c */
+
+uint uart_rx_init(PIO pio, uint pin, uint baudrate, uint irq) {
+    pio_rx_baudrate = baudrate;
+    return 0;
+}
+
+void uart_rx_set_handler(uart_rx_handler_t handler) { pio_rx_handler = handler; }
+
+void uart_rx_remove() { pio_rx_handler = NULL; }
+
+uint uart_tx_init(PIO pio, uint pin, uint baudrate) {
+    pio_tx_count = 0;
+    pio_tx_baudrate = baudrate;
+    return 1;
+}
+
+void uart_tx_write(uint8_t c) { tx(pio_tx_buffer, &pio_tx_count, &c, 1); }
+
+void uart_tx_write_bytes(uint8_t *data, uint8_t length) { tx(pio_tx_buffer, &pio_tx_count, data, length); }
+
+void uart_tx_remove(void) {
+    pio_tx_count = 0;
+    pio_tx_baudrate = 0;
+}
+
+static void begin(uint index, uint baudrate, uint timeout) {
+    uart[index].baudrate = baudrate;
+    uart[index].timeout = timeout;
+    uart[index].timestamp = time_us_32();
+    uart[index].is_timedout = true;
+    uart[index].timeout_alarm_id = 0;
+    uart[index].tx_count = 0;
+    ring_buffer_init(&uart[index].rx_ring, uart[index].rx_buffer, HAL_UART_RX_BUFFER_SIZE);
+    if (index == 0)
+        context.uart0_rx_ring = &uart[0].rx_ring;
+    else
+        context.uart1_rx_ring = &uart[1].rx_ring;
+}
+
+static int64_t timeout_callback(alarm_id_t id, void *user_data) {
+    uint index = (uintptr_t)user_data;
+    uart[index].is_timedout = true;
+    uart[index].timeout_alarm_id = 0;
+    vTaskNotifyGiveIndexedFromISR(*notify_task[index], 1, NULL);
+    return 0;
+}
+
+/* Same rules as the uart rx irq: a byte after the idle timeout starts a new frame */
+static void rx(uint index, const uint8_t *data, uint length) {
+    host_uart_t *port = &uart[index];
+    if (port->timeout_alarm_id) cancel_alarm(port->timeout_alarm_id);
+    if (port->is_timedout) {
+        ring_buffer_reset(&port->rx_ring);
+        port->is_timedout = false;
+    }
+    for (uint i = 0; i < length; i++) {
+        ring_buffer_put(&port->rx_ring, data[i]);
+        if (port->timeout == 0) vTaskNotifyGiveIndexedFromISR(*notify_task[index], 1, NULL);
+    }
+    if (port->timeout)
+        port->timeout_alarm_id = add_alarm_in_us(port->timeout, timeout_callback, (void *)(uintptr_t)index, true);
+    port->timestamp = time_us_32();
+}
+
+static void tx(uint8_t *buffer, uint *count, const uint8_t *data, uint length) {
+    if (length > HAL_UART_TX_BUFFER_SIZE - *count) length = HAL_UART_TX_BUFFER_SIZE - *count;
+    memcpy(buffer + *count, data, length);
+    *count += length;
+}
+
+static uint tx_drain(uint8_t *buffer, uint *count, uint8_t *data, uint size) {
+    if (size > *count) size = *count;
+    memcpy(data, buffer, size);
+    memmove(buffer, buffer + size, *count - size);
+    *count -= size;
+    return size;
+}
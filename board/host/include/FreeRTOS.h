@@ -0,0 +1,51 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+   Host FreeRTOS
+   Types and the kernel calls used by the project. Tasks run on the cooperative scheduler of hal_host.c: blocking
+   calls switch to the next ready task and time only moves with hal_host_advance_us(). See hal_host.h
+*/
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+typedef uint32_t StackType_t;
+
+/* Static buffers have the size of the firmware ones (Cortex M0), so the pool usage matches the board */
+typedef struct StaticTask_t {
+    uint32_t dummy[23];
+} StaticTask_t;
+typedef struct StaticQueue_t {
+    uint32_t dummy[20];
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 5
+#define configNUMBER_OF_CORES 1
+#define configMINIMAL_STACK_SIZE 256
+#define configSTACK_DEPTH_TYPE uint32_t
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2
+#define configSUPPORT_STATIC_ALLOCATION 1
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms) * configTICK_RATE_HZ / 1000)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+
+#define tskIDLE_PRIORITY ((UBaseType_t)0)
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef HOST_CAPTURE_EDGE_PIO_H
+#define HOST_CAPTURE_EDGE_PIO_H
+
+/*
+   Stands in for the header generated by pioasm. The driver is implemented by the host hal
+   Keep the public defines in sync with capture_edge.pio
+*/
+
+#include "hardware/pio.h"
+
+#define CAPTURE_EDGE_IRQ_NUM 3
+#define COUNTER_CYCLES 5
+
+#endif
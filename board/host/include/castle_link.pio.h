@@ -0,0 +1,13 @@
+#ifndef HOST_CASTLE_LINK_PIO_H
+#define HOST_CASTLE_LINK_PIO_H
+
+/*
+   Stands in for the header generated by pioasm. The driver is implemented by the host hal
+   Keep the public defines in sync with castle_link.pio
+*/
+
+#include "hardware/pio.h"
+
+#define CASTLE_LINK_IRQ_NUM 0
+
+#endif
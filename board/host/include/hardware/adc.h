@@ -0,0 +1,13 @@
+#ifndef HOST_HARDWARE_ADC_H
+#define HOST_HARDWARE_ADC_H
+
+#include "pico/types.h"
+
+/* adc_read() returns the raw value set with hal_host_adc_set() for the selected input */
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint16_t adc_read(void);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include "hardware/regs/addressmap.h"
+#include "pico/types.h"
+
+/* Flash is a RAM image mapped at XIP_BASE. It starts erased */
+
+#define PICO_FLASH_SIZE_BYTES HOST_FLASH_SIZE_BYTES
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+
+#include "pico/types.h"
+
+/* Pin levels live in a host table: gpio_get() reads hal_host_gpio_set() inputs, gpio_put() is read back */
+
+enum gpio_function {
+    GPIO_FUNC_XIP = 0,
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4,
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8,
+    GPIO_FUNC_USB = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+enum gpio_override { GPIO_OVERRIDE_NORMAL, GPIO_OVERRIDE_INVERT, GPIO_OVERRIDE_LOW, GPIO_OVERRIDE_HIGH };
+
+enum gpio_drive_strength {
+    GPIO_DRIVE_STRENGTH_2MA,
+    GPIO_DRIVE_STRENGTH_4MA,
+    GPIO_DRIVE_STRENGTH_8MA,
+    GPIO_DRIVE_STRENGTH_12MA
+};
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+#define NUM_BANK0_GPIOS 30
+
+void gpio_init(uint gpio);
+void gpio_init_mask(uint gpio_mask);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_set_dir_in_masked(uint32_t mask);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+void gpio_set_outover(uint gpio, uint value);
+void gpio_set_inover(uint gpio, uint value);
+void gpio_set_input_enabled(uint gpio, bool enabled);
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+
+#endif
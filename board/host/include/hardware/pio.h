@@ -0,0 +1,17 @@
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+/* PIO instances are opaque handles. The pio drivers used by the project are implemented by hal_pio.c */
+
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t *const host_pio0, *const host_pio1;
+
+#define pio0 host_pio0
+#define pio1 host_pio1
+
+#endif
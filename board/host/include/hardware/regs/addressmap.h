@@ -0,0 +1,17 @@
+#ifndef HOST_HARDWARE_REGS_ADDRESSMAP_H
+#define HOST_HARDWARE_REGS_ADDRESSMAP_H
+
+#include <stdint.h>
+
+/* Memory mapped regions backed by host RAM. Writes to the Cortex-M0+ private peripherals are ignored */
+
+#define HOST_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+#define HOST_PPB_SIZE_BYTES 0x10000
+
+extern uint8_t host_flash[HOST_FLASH_SIZE_BYTES];
+extern uint8_t host_ppb[HOST_PPB_SIZE_BYTES];
+
+#define XIP_BASE ((uintptr_t)host_flash)
+#define PPB_BASE ((uintptr_t)host_ppb)
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include "pico/types.h"
+
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+
+/* Host tasks run on one thread, so the spin locks are never contended */
+typedef volatile uint32_t spin_lock_t;
+
+static inline int spin_lock_claim_unused(bool required) { return 0; }
+static inline spin_lock_t *spin_lock_init(uint lock_num) {
+    static spin_lock_t lock;
+    return &lock;
+}
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) { return 0; }
+static inline void spin_unlock(spin_lock_t *lock, uint32_t status) { (void)status; }
+
+#endif
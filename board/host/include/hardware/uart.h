@@ -0,0 +1,18 @@
+#ifndef HOST_HARDWARE_UART_H
+#define HOST_HARDWARE_UART_H
+
+#include "pico/types.h"
+
+/* Only the instance handles. The project uart.h API is implemented by hal_uart.c */
+
+typedef struct uart_inst uart_inst_t;
+typedef enum { UART_PARITY_NONE, UART_PARITY_EVEN, UART_PARITY_ODD } uart_parity_t;
+
+extern uart_inst_t *const host_uart0, *const host_uart1;
+
+#define uart0 host_uart0
+#define uart1 host_uart1
+
+uint uart_get_index(uart_inst_t *uart);
+
+#endif
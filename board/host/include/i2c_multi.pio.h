@@ -0,0 +1,8 @@
+#ifndef HOST_I2C_MULTI_PIO_H
+#define HOST_I2C_MULTI_PIO_H
+
+/* Stands in for the header generated by pioasm. The driver is implemented by the host hal */
+
+#include "hardware/pio.h"
+
+#endif
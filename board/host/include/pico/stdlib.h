@@ -0,0 +1,12 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include "hardware/gpio.h"
+#include "hardware/regs/addressmap.h"
+#include "hardware/uart.h"
+#include "pico/time.h"
+#include "pico/types.h"
+
+#define PICO_DEFAULT_LED_PIN 25
+
+#endif
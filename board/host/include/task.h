@@ -0,0 +1,29 @@
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+#define taskYIELD()
+
+BaseType_t xTaskCreate(TaskFunction_t task_code, const char *const name, const configSTACK_DEPTH_TYPE stack_depth,
+                       void *const parameters, UBaseType_t priority, TaskHandle_t *const created_task);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t task_code, const char *const name, const uint32_t stack_depth,
+                               void *const parameters, UBaseType_t priority, StackType_t *const stack_buffer,
+                               StaticTask_t *const task_buffer);
+void vTaskDelete(TaskHandle_t task);
+void vTaskSuspend(TaskHandle_t task);
+void vTaskResume(TaskHandle_t task);
+void vTaskDelay(const TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index);
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t *higher_priority_task_woken);
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+
+#define xTaskNotifyGive(task) xTaskNotifyGiveIndexed((task), 0)
+#define vTaskNotifyGiveFromISR(task, woken) vTaskNotifyGiveIndexedFromISR((task), 0, (woken))
+#define ulTaskNotifyTake(clear_on_exit, ticks_to_wait) ulTaskNotifyTakeIndexed(0, (clear_on_exit), (ticks_to_wait))
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef HOST_UART_RX_PIO_H
+#define HOST_UART_RX_PIO_H
+
+/*
+   Stands in for the header generated by pioasm. The driver is implemented by the host hal
+   Keep the public defines in sync with uart_rx.pio
+*/
+
+#include "hardware/pio.h"
+
+#define UART_RX_IRQ_NUM 2
+#define UART_RX_CYCLES_PER_BIT 16
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef HOST_UART_TX_PIO_H
+#define HOST_UART_TX_PIO_H
+
+/*
+   Stands in for the header generated by pioasm. The driver is implemented by the host hal
+   Keep the public defines in sync with uart_tx.pio
+*/
+
+#include "hardware/pio.h"
+
+#define UART_TX_CYCLES_PER_BIT 16
+
+#endif
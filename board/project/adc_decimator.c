@@ -0,0 +1,40 @@
+#include "adc_decimator.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/* Totals and lock are kept, zero them before the first init */
+void adc_decimator_init(adc_decimator_t *decimator, uint8_t mask) {
+    memset(decimator, 0, offsetof(adc_decimator_t, lock));
+    decimator->mask = mask;
+    for (uint8_t i = 0; i < ADC_DECIMATOR_INPUTS; i++)
+        if (mask & (1 << i)) decimator->inputs[decimator->count++] = i;
+}
+
+/* samples: ADC_DECIMATOR_SAMPLES * count, the first one from the lowest enabled input */
+void adc_decimator_block(adc_decimator_t *decimator, const uint16_t *samples) {
+    uint32_t sum[ADC_DECIMATOR_INPUTS] = {0};
+    uint8_t count = decimator->count;
+    for (uint32_t i = 0; i < ADC_DECIMATOR_SAMPLES; i++, samples += count)
+        for (uint8_t j = 0; j < count; j++) sum[j] += samples[j] & 0xFFF;
+    for (uint8_t j = 0; j < count; j++) decimator->sum[decimator->inputs[j]] = sum[j];
+    decimator->blocks++;
+    seqlock_write_begin(&decimator->lock);
+    for (uint8_t j = 0; j < count; j++) {
+        decimator->total[decimator->inputs[j]].sum += sum[j];
+        decimator->total[decimator->inputs[j]].samples += ADC_DECIMATOR_SAMPLES;
+    }
+    seqlock_write_end(&decimator->lock);
+}
+
+/* 0 to 2^(12 + ADC_DECIMATOR_EXTRA_BITS) - 1 */
+uint16_t adc_decimator_value(const adc_decimator_t *decimator, uint8_t input) {
+    if (input >= ADC_DECIMATOR_INPUTS) return 0;
+    return decimator->sum[input] >> (ADC_DECIMATOR_SAMPLES_LOG2 - ADC_DECIMATOR_EXTRA_BITS);
+}
+
+/* False if a block was completed during the read, retry */
+bool adc_decimator_total(adc_decimator_t *decimator, uint8_t input, adc_decimator_total_t *total) {
+    if (input >= ADC_DECIMATOR_INPUTS) return false;
+    return seqlock_read(&decimator->lock, total, &decimator->total[input], sizeof(adc_decimator_total_t));
+}
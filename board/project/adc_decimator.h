@@ -0,0 +1,43 @@
+#ifndef ADC_DECIMATOR_H
+#define ADC_DECIMATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "seqlock.h"
+
+/*
+   ADC decimator
+   Boxcar (first order CIC) decimation of the interleaved round robin samples of the adc sampler. A block holds
+   ADC_DECIMATOR_SAMPLES samples of each enabled input, in input order. Each input sum is one 32 bit word, stored once
+   per block, so readers on any core get a consistent value without locks. 64 samples of 12 bits add 3 effective bits
+   when the input noise is around 1 LSB, the sum is returned as a 15 bit value. The total of each input counts every
+   sample since the first block (wrapping, kept by adc_decimator_init()), the difference of two reads is the mean over
+   the time between them
+*/
+
+#define ADC_DECIMATOR_INPUTS 5  // gpio 26 to 29 and the temperature sensor
+#define ADC_DECIMATOR_SAMPLES_LOG2 6
+#define ADC_DECIMATOR_SAMPLES (1 << ADC_DECIMATOR_SAMPLES_LOG2)
+#define ADC_DECIMATOR_EXTRA_BITS (ADC_DECIMATOR_SAMPLES_LOG2 / 2)  // 4^n samples for n bits
+
+typedef struct adc_decimator_total_t {
+    uint32_t sum;      // 12 bit samples
+    uint32_t samples;
+} adc_decimator_total_t;
+
+typedef struct adc_decimator_t {
+    uint8_t mask, count;  // enabled inputs
+    uint8_t inputs[ADC_DECIMATOR_INPUTS];
+    volatile uint32_t sum[ADC_DECIMATOR_INPUTS];
+    volatile uint32_t blocks;
+    seqlock_t lock;
+    adc_decimator_total_t total[ADC_DECIMATOR_INPUTS];
+} adc_decimator_t;
+
+void adc_decimator_init(adc_decimator_t *decimator, uint8_t mask);
+void adc_decimator_block(adc_decimator_t *decimator, const uint16_t *samples);
+uint16_t adc_decimator_value(const adc_decimator_t *decimator, uint8_t input);
+bool adc_decimator_total(adc_decimator_t *decimator, uint8_t input, adc_decimator_total_t *total);
+
+#endif
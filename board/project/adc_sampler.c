@@ -0,0 +1,88 @@
+#include "adc_sampler.h"
+
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+#define ADC_CLOCK 48000000
+
+static uint16_t buffer[2][ADC_DECIMATOR_INPUTS * ADC_DECIMATOR_SAMPLES];
+static adc_decimator_t decimator;
+static int dma_channel[2] = {-1, -1};
+static uint8_t mask;
+
+static void start(void);
+static void dma_handler(void);
+
+void adc_sampler_add(uint8_t input) {
+    if (input >= ADC_DECIMATOR_INPUTS) return;
+    taskENTER_CRITICAL();
+    if (!(mask & (1 << input))) {
+        if (dma_channel[0] < 0) {
+            adc_init();
+            dma_channel[0] = dma_claim_unused_channel(true);
+            dma_channel[1] = dma_claim_unused_channel(true);
+            irq_add_shared_handler(DMA_IRQ_1, dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(DMA_IRQ_1, true);
+        }
+        if (input < 4) adc_gpio_init(26 + input);
+        if (input == 4) adc_set_temp_sensor_enabled(true);
+        mask |= 1 << input;
+        start();
+    }
+    taskEXIT_CRITICAL();
+}
+
+uint16_t adc_sampler_read(uint8_t input) { return adc_decimator_value(&decimator, input); }
+
+adc_decimator_total_t adc_sampler_total(uint8_t input) {
+    adc_decimator_total_t total = {0};
+    if (input >= ADC_DECIMATOR_INPUTS) return total;
+    while (!adc_decimator_total(&decimator, input, &total)) tight_loop_contents();
+    return total;
+}
+
+/* Restarts with the new inputs, the first sample of each block is from the lowest one */
+static void start(void) {
+    adc_run(false);
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) tight_loop_contents();
+    for (uint i = 0; i < 2; i++) {
+        // an aborted channel still triggers the one it is chained to, chain it to itself first
+        dma_channel_config config = dma_get_channel_config(dma_channel[i]);
+        channel_config_set_chain_to(&config, dma_channel[i]);
+        dma_channel_set_config(dma_channel[i], &config, false);
+        dma_channel_set_irq1_enabled(dma_channel[i], false);
+        dma_channel_abort(dma_channel[i]);
+    }
+    dma_hw->ints1 = (1u << dma_channel[0]) | (1u << dma_channel[1]);
+    adc_fifo_drain();
+    adc_decimator_init(&decimator, mask);
+    for (uint i = 0; i < 2; i++) {
+        dma_channel_config config = dma_channel_get_default_config(dma_channel[i]);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, false);
+        channel_config_set_write_increment(&config, true);
+        channel_config_set_dreq(&config, DREQ_ADC);
+        channel_config_set_chain_to(&config, dma_channel[!i]);
+        dma_channel_configure(dma_channel[i], &config, buffer[i], &adc_hw->fifo,
+                              decimator.count * ADC_DECIMATOR_SAMPLES, false);
+        dma_channel_set_irq1_enabled(dma_channel[i], true);
+    }
+    adc_select_input(decimator.inputs[0]);
+    adc_set_round_robin(mask);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(ADC_CLOCK / ADC_SAMPLER_RATE - 1);
+    dma_channel_start(dma_channel[0]);
+    adc_run(true);
+}
+
+/* The completed block is decimated and rearmed while the other channel fills */
+static void dma_handler(void) {
+    for (uint i = 0; i < 2; i++) {
+        uint32_t bit = 1u << dma_channel[i];
+        if (!(dma_hw->ints1 & bit)) continue;
+        dma_hw->ints1 = bit;
+        adc_decimator_block(&decimator, buffer[i]);
+        dma_channel_set_write_addr(dma_channel[i], buffer[i], false);
+    }
+}
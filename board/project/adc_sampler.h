@@ -0,0 +1,25 @@
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include "adc_decimator.h"
+#include "common.h"
+
+/*
+   ADC sampler
+   One owner for the adc, so analog tasks no longer switch the mux under each other. The enabled inputs are converted
+   continuously in round robin mode at ADC_SAMPLER_RATE samples per second in total. Two dma channels chained to each
+   other fill two blocks in turn and the dma irq decimates the completed block (adc_decimator.h) while the other one
+   fills. adc_sampler_add() enables an input, restarting the conversions. adc_sampler_read() returns the last
+   decimated value (ADC_DECIMATOR_EXTRA_BITS more than the adc), lock free. adc_sampler_total() returns the running
+   total of all the samples of an input, for integrals at the full sample rate
+*/
+
+#define ADC_SAMPLER_RATE 25600  // a block of 64 samples each 2.5 ms (one input) to 12.5 ms (five)
+
+extern context_t context;
+
+void adc_sampler_add(uint8_t input);
+uint16_t adc_sampler_read(uint8_t input);
+adc_decimator_total_t adc_sampler_total(uint8_t input);
+
+#endif
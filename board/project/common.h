@@ -8,7 +8,9 @@
 #include "constants.h"
 #include "pico/stdlib.h"
 #include "pico/types.h"
+#include "ring_buffer.h"
 #include "shared.h"
+#include "trace.h"
 
 /*
    Debug
@@ -21,6 +23,34 @@
 // #define SIM_RX
 // #define SIM_SENSORS
 
+/*
+   Run loop
+   Light periodic jobs (cell count, auto offsets, vspeed) run as callbacks of one task instead of a task
+   each. Saves their stacks and task switches, see run_loop.h
+*/
+
+// #define RUN_LOOP
+
+/*
+   Consumption log
+   The consumption of the esc and of the analog current sensor is checkpointed to flash and restored at start, so a
+   reset or a brownout does not lose it. There is no reset command, erase the flash to start from 0. See coulomb.h
+   Flash writes stall both cores and the irqs, so bytes from the receiver may be lost meanwhile: a 45-50 ms sector
+   erase per source at start, before the receiver is answered, and about 1 ms per checkpoint, at most every 10 s and
+   only with the current below 1 A (motor stopped). A poll arriving during a checkpoint may go unanswered
+*/
+
+// #define CONSUMPTION_LOG
+
+/*
+   Smartport poll latency
+   Time from the last byte of a poll to the start of its answer, the frame timeout included, printed with debug every
+   SMARTPORT_POLL_LATENCY polls as min, mean, max and jitter (max - min) in us. To compare configNUMBER_OF_CORES 1 and
+   2 (FreeRTOSConfig.h) with gps bursts arriving at the polls
+*/
+
+// #define SMARTPORT_POLL_LATENCY 1000
+
 // #define SIM_SMARTPORT_SEND_CONFIG_LUA
 // #define SIM_SMARTPORT_RECEIVE_CONFIG_LUA
 // #define SIM_SMARTPORT_SEND_SENSOR_ID
@@ -31,29 +61,27 @@
 #define swap_32(value) \
     (((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value & 0xFF0000) >> 8) | ((value & 0xFF000000) >> 24))
     
+/* Recorded by trace.c and printed later by trace_task, so they can be used in irq handlers */
 #define debug(...) \
-    if (context.debug == 1) printf(__VA_ARGS__)
+    if (context.debug == 1) trace_printf(__VA_ARGS__)
 #define debug_buffer(buffer, length, format) \
-    if (context.debug)                       \
-        for (int i = 0; i < (length); i++) printf((format), (buffer)[i])
+    if (context.debug) trace_buffer((format), (buffer), (length), sizeof((buffer)[0]))
 #define debug2(...) \
-    if (context.debug == 2) printf(__VA_ARGS__)
+    if (context.debug == 2) trace_printf(__VA_ARGS__)
 #define debug_buffer2(buffer, length, format) \
-    if (context.debug == 2)                   \
-        for (int i = 0; i < (length); i++) printf((format), (buffer)[i])
+    if (context.debug == 2) trace_buffer((format), (buffer), (length), sizeof((buffer)[0]))
 
 typedef struct context_t {
     TaskHandle_t pwm_out_task_handle, uart0_notify_task_handle, uart1_notify_task_handle, uart_pio_notify_task_handle,
-        receiver_task_handle, led_task_handle, usb_task_handle;
-    QueueHandle_t uart0_queue_handle, uart1_queue_handle, uart_rx_pio_queue_handle, uart_tx_pio_queue_handle, tasks_queue_handle,
-        sensors_queue_handle;
+        receiver_task_handle, led_task_handle, usb_task_handle, run_loop_task_handle;
+    ring_buffer_t *uart0_rx_ring, *uart1_rx_ring, *uart_pio_rx_ring;
+    QueueHandle_t uart_tx_pio_queue_handle, tasks_queue_handle, sensors_queue_handle;
     alarm_pool_t *uart_alarm_pool;
     uint8_t debug, led_cycles;
     uint16_t led_cycle_duration;
 } context_t;
 
 float get_average(float alpha, float prev_value, float new_value);
-float get_consumption(float current, uint16_t current_max, uint32_t *timestamp);
 float voltage_read(uint8_t adc_num);
 float get_altitude(float pressure, float temperature, float P0);
 void get_vspeed(float *vspeed, float altitude, uint interval);
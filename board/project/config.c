@@ -1,10 +1,10 @@
 #include "config.h"
 
 #include <hardware/flash.h>
-#include <hardware/sync.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "pico/flash.h"
 #include "pico/stdlib.h"
 
 #define CONFIG_FLASH_TARGET_OFFSET (512 * 1024)
@@ -119,6 +119,8 @@
 /* GPS */
 #define GPS_RATE 1
 
+static void write_flash(void *data);
+
 config_t *config_read() {
     uint16_t *version = (uint16_t *)(XIP_BASE + CONFIG_FLASH_TARGET_OFFSET);
     if (*version != CONFIG_VERSION) {
@@ -130,10 +132,13 @@ config_t *config_read() {
 void config_write(config_t *config) {
     uint8_t flash[FLASH_PAGE_SIZE] = {0};
     memcpy(flash, (uint8_t *)config, sizeof(config_t));
-    uint32_t ints = save_and_disable_interrupts();
+    // interrupts off on this core and the other core parked, as neither can run from flash while it is written
+    flash_safe_execute(write_flash, flash, UINT32_MAX);
+}
+
+static void write_flash(void *data) {
     flash_range_erase(CONFIG_FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
-    flash_range_program(CONFIG_FLASH_TARGET_OFFSET, flash, FLASH_PAGE_SIZE);
-    restore_interrupts(ints);
+    flash_range_program(CONFIG_FLASH_TARGET_OFFSET, data, FLASH_PAGE_SIZE);
 }
 
 void config_get(config_t *config) {
@@ -142,7 +147,7 @@ void config_get(config_t *config) {
 }
 
 void config_forze_write() {
-    config_t config;
+    config_t config = {0};
     config.version = CONFIG_VERSION;
     config.rx_protocol = RX_PROTOCOL;
     config.esc_protocol = ESC_PROTOCOL;
@@ -173,6 +178,7 @@ void config_forze_write() {
     config.analog_current_multiplier = ANALOG_CURRENT_MULTIPLIER;
     config.analog_current_offset = ANALOG_CURRENT_OFFSET;
     config.analog_current_autoffset = ANALOG_CURRENT_AUTO_OFFSET;
+    config.analog_rate = ANALOG_RATE;
     config.pairOfPoles = RPM_PAIR_OF_POLES;
     config.mainTeeth = RPM_MAIN_TEETH;
     config.pinionTeeth = RPM_PINION_TEETH;
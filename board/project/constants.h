@@ -33,6 +33,14 @@
 #define UART_ESC_RX UART1_RX_GPIO
 #define UART_ESC_TX UART1_TX_GPIO
 
+// receiver uart frame end from the rx timeout irq instead of an alarm re-armed per byte (uart0 only)
+// #define UART0_RX_IDLE_FRAME
+// rx irq fifo level: 0 = 1/8, 1 = 1/4, 2 = 1/2, 3 = 3/4, 4 = 7/8. 3/4 leaves 8 bytes (192 us at 416666 baud) for
+// the irq latency. Measured by msrc_bench_uart_frame, frames of 1-64 bytes with 0-1.5 inner gaps: 2.0-2.9 irqs and
+// 1.0-1.8 alarms per frame, one wake of the task. Each inner gap longer than the idle timeout costs up to one irq and
+// one alarm more, so one irq and one alarm per frame is only reached by frames up to 23 bytes without inner gaps
+#define UART0_RX_FIFO_LEVEL 3
+
 // set receiver to uart1 when debugging with probe
 // #define UART_RECEIVER uart1
 // #define UART_RECEIVER_RX UART1_RX_GPIO
@@ -43,6 +51,11 @@
 #define BOARD_VCC 3.3
 #define ADC_RESOLUTION 4096
 
+/* Cores (FreeRTOSConfig.h configNUMBER_OF_CORES). Receiver tasks and the uart alarm pool run on core 0, sensor tasks
+   and the irqs they enable on core 1 */
+#define CORE_RECEIVER 0
+#define CORE_SENSOR 1
+
 /* Stack */
 #define STACK_EXTRA 100
 
@@ -68,13 +81,7 @@
 
 #define STACK_SENSOR_FRSKY_D (164 + STACK_EXTRA)
 #define STACK_SENSOR_FRSKY_D_CELL (158 + STACK_EXTRA)
-#define STACK_SENSOR_SMARTPORT (180 + STACK_EXTRA)
-#define STACK_SENSOR_SMARTPORT_DOUBLE (166 + STACK_EXTRA)
-#define STACK_SENSOR_SMARTPORT_COORDINATE (164 + STACK_EXTRA)
-#define STACK_SENSOR_SMARTPORT_DATETIME (164 + STACK_EXTRA)
-#define STACK_SENSOR_SMARTPORT_CELL (166 + STACK_EXTRA)
 #define STACK_SMARTPORT_PACKET_TASK (160 + STACK_EXTRA)
-#define STACK_SMARTPORT_SENSOR_VOID_TASK (166 + STACK_EXTRA)
 
 #define STACK_ESC_HW3 (168 + STACK_EXTRA)
 #define STACK_ESC_HW4 (250 + STACK_EXTRA)
@@ -102,13 +109,18 @@
 #define STACK_BMP180 (174 + STACK_EXTRA)
 
 #define STACK_VSPEED (152 + STACK_EXTRA)
-#define STACK_DISTANCE (152 + STACK_EXTRA)
 #define STACK_CELL_COUNT (180 + STACK_EXTRA)
 #define STACK_AUTO_OFFSET (140 + STACK_EXTRA)
+#define STACK_RUN_LOOP (180 + STACK_EXTRA)
 #define STACK_PWM_OUT (200 + STACK_EXTRA)
 
 #define STACK_USB (196 + STACK_EXTRA)
 #define STACK_LED (186 + STACK_EXTRA)
+#define STACK_TRACE (300 + STACK_EXTRA)
+
+/* Static pool (bytes): stacks, task control blocks, queues and sensor slots of the largest configuration. Frsky D with
+   every sensor takes 63 kB plus led and usb tasks (host/bench: msrc_bench frsky_d) */
+#define POOL_SIZE (72 * 1024)
 
 /* RPM multiplier */
 #define RPM_MULTIPLIER (RPM_PINION_TEETH / (1.0 * RPM_MAIN_TEETH * RPM_PAIR_OF_POLES))
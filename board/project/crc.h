@@ -0,0 +1,18 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+
+/*
+   Table driven crc and checksums shared by the protocols and sensors
+   Each function continues from crc, so a frame can be computed in several parts. Start with 0
+*/
+
+uint8_t crc8_dvb_s2(uint8_t crc, const uint8_t *data, uint32_t length);
+uint8_t crc8_jeti(uint8_t crc, const uint8_t *data, uint32_t length);
+uint8_t crc8_maxim(uint8_t crc, const uint8_t *data, uint32_t length);
+uint16_t crc16_jeti(uint16_t crc, const uint8_t *data, uint32_t length);
+uint16_t crc16_srxl(uint16_t crc, const uint8_t *data, uint32_t length);
+uint8_t crc_smartport(uint8_t crc, const uint8_t *data, uint32_t length);
+
+#endif
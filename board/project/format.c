@@ -0,0 +1,49 @@
+#include "format.h"
+
+#include <math.h>
+#include <string.h>
+
+static const uint32_t power_10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+/*
+   Packed bcd of value, up to 8 digits. Values with more digits keep the leading ones, as printf into a field of the
+   same width read back digit by digit did. Double dabble, adding 3 to every nibble above 4 at once
+*/
+uint32_t format_bcd(uint32_t value, uint32_t digits) {
+    uint32_t bcd = 0;
+    if (digits > 8) digits = 8;
+    while (value >= power_10[digits]) value /= 10;
+    for (int bit = 31 - __builtin_clz(value | 1); bit >= 0; bit--) {
+        uint32_t carry = (bcd + 0x33333333) & 0x88888888;
+        bcd += (carry >> 2) | (carry >> 3);
+        bcd = bcd << 1 | ((value >> bit) & 1);
+    }
+    return bcd;
+}
+
+/* Round half away from zero, as round(). Nan returns min */
+int32_t format_round(float value, int32_t min, int32_t max) {
+    value = roundf(value);
+    if (!(value > (float)min)) return min;
+    if (value >= (float)max) return max;
+    return (int32_t)value;
+}
+
+/*
+   GPS coordinate to 1/10000 minutes, unsigned and truncated. Exact and integer only: the float is
+   mantissa * 2^exponent, so the count is mantissa * 600000 shifted. Degrees, minutes and fraction for the protocol
+   fields are then divisions of this count. Nan, infinite and out of range return 0
+*/
+uint32_t format_minutes(float degrees) {
+    uint32_t bits;
+    memcpy(&bits, &degrees, sizeof(bits));
+    int32_t exponent = (bits >> 23 & 0xFF) - 150;
+    uint64_t mantissa = bits & 0x7FFFFF;
+    if (exponent == -150)
+        exponent = -149;  // subnormal
+    else
+        mantissa |= 0x800000;
+    if (exponent >= 0) return 0;
+    uint64_t minutes = exponent < -63 ? 0 : mantissa * 600000 >> -exponent;
+    return minutes > UINT32_MAX ? 0 : minutes;
+}
@@ -0,0 +1,22 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stdint.h>
+
+/*
+   Integer formatting kernels for the protocol encoders
+   Sensor values are rounded once from float, the rest is integer math. Conversions saturate to the target range
+*/
+
+uint32_t format_bcd(uint32_t value, uint32_t digits);
+int32_t format_round(float value, int32_t min, int32_t max);
+uint32_t format_minutes(float degrees);
+
+static inline int32_t format_clamp(int32_t value, int32_t min, int32_t max) {
+    return value < min ? min : value > max ? max : value;
+}
+
+/* Degrees and minutes as the decimal digits DDDMM, from 1/10000 minutes */
+static inline uint32_t format_ddmm(uint32_t minutes) { return minutes / 600000 * 100 + minutes / 10000 % 60; }
+
+#endif
@@ -0,0 +1,33 @@
+#include "frame_builder.h"
+
+#include "crc.h"
+
+static inline uint32_t stuff(uint8_t *buffer, uint32_t length, uint8_t c, uint8_t flag, uint8_t escape, uint8_t mask);
+
+/* [0x5E] [data_id] [value lsb] [value msb] [0x5E]. 0x5D and 0x5E are sent as 0x5D, byte ^ 0x60 */
+uint32_t frame_builder_frsky_d(uint8_t *buffer, uint8_t data_id, uint16_t value) {
+    uint32_t length = 0;
+    buffer[length++] = 0x5E;
+    length = stuff(buffer, length, data_id, 0x5E, 0x5D, 0x60);
+    length = stuff(buffer, length, value, 0x5E, 0x5D, 0x60);
+    length = stuff(buffer, length, value >> 8, 0x5E, 0x5D, 0x60);
+    buffer[length++] = 0x5E;
+    return length;
+}
+
+/* [frame_id] [data_id lsb, msb] [value lsb...msb] [crc]. 0x7D and 0x7E are sent as 0x7D, byte ^ 0x20 */
+uint32_t frame_builder_smartport(uint8_t *buffer, uint8_t frame_id, uint16_t data_id, uint32_t value) {
+    const uint8_t data[7] = {frame_id, data_id, data_id >> 8, value, value >> 8, value >> 16, value >> 24};
+    uint32_t length = 0;
+    for (uint32_t i = 0; i < sizeof(data); i++) length = stuff(buffer, length, data[i], 0x7E, 0x7D, 0x20);
+    return stuff(buffer, length, 0xFF - crc_smartport(0, data, sizeof(data)), 0x7E, 0x7D, 0x20);
+}
+
+static inline uint32_t stuff(uint8_t *buffer, uint32_t length, uint8_t c, uint8_t flag, uint8_t escape, uint8_t mask) {
+    if (c == flag || c == escape) {
+        buffer[length++] = escape;
+        c ^= mask;
+    }
+    buffer[length++] = c;
+    return length;
+}
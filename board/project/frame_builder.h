@@ -0,0 +1,19 @@
+#ifndef FRAME_BUILDER_H
+#define FRAME_BUILDER_H
+
+#include <stdint.h>
+
+/*
+   Byte stuffed frame builder
+   Builds a whole FrSky D or Smartport frame, escaped and checksummed in one pass, into a caller buffer, so it is sent
+   with one uart write instead of one write per byte. The buffer must hold the escaped worst case (_MAX). Hardware
+   independent
+*/
+
+#define FRAME_BUILDER_FRSKY_D_MAX 8
+#define FRAME_BUILDER_SMARTPORT_MAX 16
+
+uint32_t frame_builder_frsky_d(uint8_t *buffer, uint8_t data_id, uint16_t value);
+uint32_t frame_builder_smartport(uint8_t *buffer, uint8_t frame_id, uint16_t data_id, uint32_t value);
+
+#endif
@@ -7,6 +7,7 @@
 #include "jetiex.h"
 #include "led.h"
 #include "multiplex.h"
+#include "pool.h"
 #include "sbus.h"
 #include "serial_monitor.h"
 #include "sim_rx.h"
@@ -22,14 +23,44 @@
 
 context_t context;
 
+static StaticTask_t idle_task_buffer, timer_task_buffer;
+static StackType_t idle_task_stack[configMINIMAL_STACK_SIZE], timer_task_stack[configTIMER_TASK_STACK_DEPTH];
+#if configNUMBER_OF_CORES > 1
+static StaticTask_t passive_idle_task_buffer[configNUMBER_OF_CORES - 1];
+static StackType_t passive_idle_task_stack[configNUMBER_OF_CORES - 1][configMINIMAL_STACK_SIZE];
+#endif
+
 void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
     debug("stack overflow %x %s\r\n", xTask, (portCHAR *)pcTaskName);
+    trace_flush();
     while (1)
         ;
 }
 
+void vApplicationGetIdleTaskMemory(StaticTask_t **task_buffer, StackType_t **stack_buffer, uint32_t *stack_size) {
+    *task_buffer = &idle_task_buffer;
+    *stack_buffer = idle_task_stack;
+    *stack_size = configMINIMAL_STACK_SIZE;
+}
+
+#if configNUMBER_OF_CORES > 1
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t **task_buffer, StackType_t **stack_buffer, uint32_t *stack_size,
+                                          BaseType_t index) {
+    *task_buffer = &passive_idle_task_buffer[index];
+    *stack_buffer = passive_idle_task_stack[index];
+    *stack_size = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **task_buffer, StackType_t **stack_buffer, uint32_t *stack_size) {
+    *task_buffer = &timer_task_buffer;
+    *stack_buffer = timer_task_stack;
+    *stack_size = configTIMER_TASK_STACK_DEPTH;
+}
+
 int main() {
     stdio_init_all();
+    trace_init();
 
     gpio_init(RESTORE_GPIO);
     gpio_pull_up(RESTORE_GPIO);
@@ -40,88 +71,107 @@ int main() {
     if (context.debug) sleep_ms(1000);
     debug("\n\nMSRC init");
 
-    context.tasks_queue_handle = xQueueCreate(64, sizeof(QueueHandle_t));
+    context.tasks_queue_handle = pool_queue_create(64, sizeof(QueueHandle_t));
+
+    // alarm irqs are on the core that creates the pool: core 0, with the receiver
+    context.uart_alarm_pool = alarm_pool_create(2, 10);
 
     context.led_cycle_duration = 200;
     context.led_cycles = 3;
-    xTaskCreate(led_task, "led_task", STACK_LED, NULL, 1, &context.led_task_handle);
+    pool_task_create(led_task, "led_task", STACK_LED, NULL, 1, &context.led_task_handle);
+
+    pool_task_create(usb_task, "usb_task", STACK_USB, NULL, 1, &context.usb_task_handle);
 
-    xTaskCreate(usb_task, "usb_task", STACK_USB, NULL, 1, &context.usb_task_handle);
+    pool_task_create(trace_task, "trace_task", STACK_TRACE, NULL, 1, NULL);
 
     switch (config->rx_protocol) {
         case RX_XBUS:
-            xTaskCreate(xbus_task, "xbus_task", STACK_RX_XBUS, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(xbus_task, "xbus_task", STACK_RX_XBUS, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_IBUS:
-            xTaskCreate(ibus_task, "ibus_task", STACK_RX_IBUS, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(ibus_task, "ibus_task", STACK_RX_IBUS, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_FRSKY_D:
-            xTaskCreate(frsky_d_task, "frsky_d_task", STACK_RX_FRSKY_D, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(frsky_d_task, "frsky_d_task", STACK_RX_FRSKY_D, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_MULTIPLEX:
-            xTaskCreate(multiplex_task, "multiplex_task", STACK_RX_MULTIPLEX, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(multiplex_task, "multiplex_task", STACK_RX_MULTIPLEX, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_SMARTPORT:
-            xTaskCreate(smartport_task, "smartport_task", STACK_RX_SMARTPORT, NULL, 4, &context.receiver_task_handle);
+            pool_task_create_on_core(smartport_task, "smartport_task", STACK_RX_SMARTPORT, NULL, 4, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_JETIEX:
-            xTaskCreate(jetiex_task, "jetiex_task", STACK_RX_JETIEX, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(jetiex_task, "jetiex_task", STACK_RX_JETIEX, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_SBUS:
-            xTaskCreate(sbus_task, "sbus_task", STACK_RX_SBUS, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(sbus_task, "sbus_task", STACK_RX_SBUS, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_HITEC:
-            xTaskCreate(hitec_task, "hitec_task", STACK_RX_HITEC, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(hitec_task, "hitec_task", STACK_RX_HITEC, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_SRXL:
-            xTaskCreate(srxl_task, "srxl_task", STACK_RX_SRXL, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(srxl_task, "srxl_task", STACK_RX_SRXL, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_SRXL2:
-            xTaskCreate(srxl2_task, "srxl2_task", STACK_RX_SRXL2, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(srxl2_task, "srxl2_task", STACK_RX_SRXL2, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case SERIAL_MONITOR:
-            xTaskCreate(serial_monitor_task, "serial_monitor", STACK_SERIAL_MONITOR, NULL, 3,
-                        &context.receiver_task_handle);
+            pool_task_create_on_core(serial_monitor_task, "serial_monitor", STACK_SERIAL_MONITOR, NULL, 3,
+                                     CORE_RECEIVER, &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             context.uart1_notify_task_handle = context.receiver_task_handle;
             context.uart_pio_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_CRSF:
-            xTaskCreate(crsf_task, "crfs_task", STACK_RX_CRSF, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(crsf_task, "crfs_task", STACK_RX_CRSF, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_HOTT:
-            xTaskCreate(hott_task, "hott_task", STACK_RX_HOTT, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(hott_task, "hott_task", STACK_RX_HOTT, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_SANWA:
-            xTaskCreate(sanwa_task, "sanwa_task", STACK_RX_SANWA, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(sanwa_task, "sanwa_task", STACK_RX_SANWA, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
         case RX_JR_PROPO:
-            xTaskCreate(jr_dmss_task, "jr_dmss_task", STACK_RX_JR_PROPO, NULL, 3, &context.receiver_task_handle);
+            pool_task_create_on_core(jr_dmss_task, "jr_dmss_task", STACK_RX_JR_PROPO, NULL, 3, CORE_RECEIVER,
+                                     &context.receiver_task_handle);
             context.uart0_notify_task_handle = context.receiver_task_handle;
             xQueueSendToBack(context.tasks_queue_handle, context.receiver_task_handle, 0);
             break;
@@ -129,7 +179,7 @@ int main() {
 
 #ifdef SIM_RX
     sim_rx_parameters_t parameter = {config->rx_protocol};
-    xTaskCreate(sim_rx_task, "sim_rx_task", STACK_SIM_RX, &parameter, 3, NULL);
+    pool_task_create_on_core(sim_rx_task, "sim_rx_task", STACK_SIM_RX, &parameter, 3, CORE_RECEIVER, NULL);
 #endif
 
     vTaskStartScheduler();
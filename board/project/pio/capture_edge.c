@@ -23,7 +23,13 @@ static uint sm_, offset_, dma_channel_write_pins_, dma_channel_write_counter_, d
     dma_channel_reload_counter_, dma_channel_reload_pins_, dma_channel_reload_write_counter_, pin_count_;
 static PIO pio_;
 static void (*handler_[MAX_PIN_COUNT])(uint counter, edge_type_t edge) = {NULL};
+static bool is_batch_ = false;
+static uint ring_index_, ring_prev_pins_;
+static uint ring_pins_[CAPTURE_EDGE_RING] __attribute__((aligned(CAPTURE_EDGE_RING * sizeof(uint))));
+static uint ring_counter_[CAPTURE_EDGE_RING] __attribute__((aligned(CAPTURE_EDGE_RING * sizeof(uint))));
 
+static void init_sm(uint pin_base, uint pin_count, float clk_div);
+static void init_counter(void);
 static inline void handler_pio(void);
 static inline edge_type_t get_captured_edge(uint pin, uint pins, uint prev);
 static inline uint bit_value(uint pos);
@@ -31,33 +37,24 @@ static inline uint bit_value(uint pos);
 void capture_edge_init(PIO pio, uint pin_base, uint pin_count, float clk_div, uint irq) {
     pio_ = pio;
     pin_count_ = pin_count;
+    is_batch_ = false;
 
     // pio capture
-    sm_ = pio_claim_unused_sm(pio_, true);
-    offset_ = pio_add_program(pio_, &capture_edge_program);
-    pio_sm_set_consecutive_pindirs(pio_, sm_, pin_base, pin_count, false);
-    pio_sm_config c = capture_edge_program_get_default_config(offset_);
-    sm_config_set_clkdiv(&c, clk_div);
-    sm_config_set_in_pins(&c, pin_base);
-    pio->instr_mem[offset_ + 3] = pio_encode_in(pio_pins, pin_count);
-    pio->instr_mem[offset_ + 4] = pio_encode_in(pio_null, 32 - pin_count);
-    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    init_sm(pin_base, pin_count, clk_div);
     if (irq == PIO0_IRQ_0 || irq == PIO1_IRQ_0)
         pio_set_irq0_source_enabled(pio_, (enum pio_interrupt_source)(pis_interrupt0 + CAPTURE_EDGE_IRQ_NUM), true);
     else
         pio_set_irq1_source_enabled(pio_, (enum pio_interrupt_source)(pis_interrupt0 + CAPTURE_EDGE_IRQ_NUM), true);
     pio_interrupt_clear(pio_, CAPTURE_EDGE_IRQ_NUM);
-    pio_sm_init(pio_, sm_, offset_ + capture_edge_offset_start, &c);
     irq_set_exclusive_handler(irq, handler_pio);
     irq_set_enabled(irq, true);
 
     // get dma channels
     dma_channel_write_pins_ = dma_claim_unused_channel(true);
     dma_channel_write_counter_ = dma_claim_unused_channel(true);
-    dma_channel_counter_ = dma_claim_unused_channel(true);
-    dma_channel_reload_counter_ = dma_claim_unused_channel(true);
     dma_channel_reload_pins_ = dma_claim_unused_channel(true);
     dma_channel_reload_write_counter_ = dma_claim_unused_channel(true);
+    init_counter();
 
     // dma channel write pins
     dma_channel_config config_dma_channel_write_pins = dma_channel_get_default_config(dma_channel_write_pins_);
@@ -83,29 +80,6 @@ void capture_edge_init(PIO pio, uint pin_base, uint pin_count, float clk_div, ui
                           &dma_hw->ch[dma_channel_counter_].transfer_count,  // read address
                           1, false);
 
-    // dma channel counter
-    dma_channel_config config_dma_channel_counter = dma_channel_get_default_config(dma_channel_counter_);
-    channel_config_set_write_increment(&config_dma_channel_counter, false);
-    channel_config_set_read_increment(&config_dma_channel_counter, false);
-    uint dma_timer = dma_claim_unused_timer(true);
-    dma_timer_set_fraction(dma_timer, 1, COUNTER_CYCLES);
-    channel_config_set_dreq(&config_dma_channel_counter, dma_get_timer_dreq(dma_timer));
-    channel_config_set_chain_to(&config_dma_channel_counter, dma_channel_reload_counter_);
-    dma_channel_configure(dma_channel_counter_, &config_dma_channel_counter,
-                          NULL,  // write address
-                          NULL,  // read address
-                          0xffffffff, false);
-
-    // dma channel reload counter
-    dma_channel_config config_dma_channel_reload_counter = dma_channel_get_default_config(dma_channel_reload_counter_);
-    channel_config_set_transfer_data_size(&config_dma_channel_reload_counter, DMA_SIZE_32);
-    channel_config_set_write_increment(&config_dma_channel_reload_counter, false);
-    channel_config_set_read_increment(&config_dma_channel_reload_counter, false);
-    dma_channel_configure(dma_channel_reload_counter_, &config_dma_channel_reload_counter,
-                          &dma_hw->ch[dma_channel_counter_].al1_transfer_count_trig,  // write address
-                          &reload_counter_,                                           // read address
-                          1, false);
-
     // dma channel reload pins
     dma_channel_config config_dma_channel_reload_pins = dma_channel_get_default_config(dma_channel_reload_pins_);
     channel_config_set_transfer_data_size(&config_dma_channel_reload_pins, DMA_SIZE_32);
@@ -132,12 +106,86 @@ void capture_edge_init(PIO pio, uint pin_base, uint pin_count, float clk_div, ui
     pio_sm_set_enabled(pio_, sm_, true);
 }
 
+void capture_edge_init_batch(PIO pio, uint pin_base, uint pin_count, float clk_div) {
+    pio_ = pio;
+    pin_count_ = pin_count;
+    is_batch_ = true;
+    ring_index_ = 0;
+    ring_prev_pins_ = 0;
+
+    // pio capture, the irq flag is set but not enabled
+    init_sm(pin_base, pin_count, clk_div);
+
+    // get dma channels
+    dma_channel_write_pins_ = dma_claim_unused_channel(true);
+    dma_channel_write_counter_ = dma_claim_unused_channel(true);
+    dma_channel_reload_pins_ = dma_claim_unused_channel(true);
+    init_counter();
+
+    // dma channel write pins: rx fifo to the pins ring, then the counter
+    dma_channel_config config_dma_channel_write_pins = dma_channel_get_default_config(dma_channel_write_pins_);
+    channel_config_set_transfer_data_size(&config_dma_channel_write_pins, DMA_SIZE_32);
+    channel_config_set_write_increment(&config_dma_channel_write_pins, true);
+    channel_config_set_read_increment(&config_dma_channel_write_pins, false);
+    channel_config_set_ring(&config_dma_channel_write_pins, true, CAPTURE_EDGE_RING_LOG2 + 2);
+    channel_config_set_dreq(&config_dma_channel_write_pins, pio_get_dreq(pio_, sm_, false));
+    channel_config_set_chain_to(&config_dma_channel_write_pins, dma_channel_write_counter_);
+    dma_channel_configure(dma_channel_write_pins_, &config_dma_channel_write_pins,
+                          ring_pins_,       // write address
+                          &pio_->rxf[sm_],  // read address
+                          1, false);
+
+    // dma channel write counter: counter to the counter ring, right after the pins
+    dma_channel_config config_dma_channel_write_counter = dma_channel_get_default_config(dma_channel_write_counter_);
+    channel_config_set_transfer_data_size(&config_dma_channel_write_counter, DMA_SIZE_32);
+    channel_config_set_write_increment(&config_dma_channel_write_counter, true);
+    channel_config_set_read_increment(&config_dma_channel_write_counter, false);
+    channel_config_set_ring(&config_dma_channel_write_counter, true, CAPTURE_EDGE_RING_LOG2 + 2);
+    channel_config_set_chain_to(&config_dma_channel_write_counter, dma_channel_reload_pins_);
+    dma_channel_configure(dma_channel_write_counter_, &config_dma_channel_write_counter,
+                          ring_counter_,                                     // write address
+                          &dma_hw->ch[dma_channel_counter_].transfer_count,  // read address
+                          1, false);
+
+    // dma channel reload pins: wait for the next edge
+    dma_channel_config config_dma_channel_reload_pins = dma_channel_get_default_config(dma_channel_reload_pins_);
+    channel_config_set_transfer_data_size(&config_dma_channel_reload_pins, DMA_SIZE_32);
+    channel_config_set_write_increment(&config_dma_channel_reload_pins, false);
+    channel_config_set_read_increment(&config_dma_channel_reload_pins, false);
+    dma_channel_configure(dma_channel_reload_pins_, &config_dma_channel_reload_pins,
+                          &dma_hw->ch[dma_channel_write_pins_].al1_transfer_count_trig,  // write address
+                          &reload_pins_,                                                 // read address
+                          1, false);
+
+    dma_start_channel_mask((1 << dma_channel_write_pins_) | (1 << dma_channel_counter_));
+    pio_sm_set_enabled(pio_, sm_, true);
+}
+
 void capture_edge_set_handler(uint pin, capture_handler_t handler) {
     if (pin < pin_count_) {
         handler_[pin] = handler;
     }
 }
 
+/* Batch mode. The counter is written after the pins, so its write address marks the complete edges */
+uint capture_edge_drain(void) {
+    if (!is_batch_) return 0;
+    uint head = (dma_hw->ch[dma_channel_write_counter_].write_addr - (uint)ring_counter_) / sizeof(uint);
+    uint count = 0;
+    while (ring_index_ != head) {
+        uint counter = ~ring_counter_[ring_index_];
+        uint pins = ring_pins_[ring_index_];
+        for (uint pin = 0; pin < pin_count_; pin++) {
+            edge_type_t edge = get_captured_edge(pin, pins, ring_prev_pins_);
+            if (edge && *handler_[pin]) handler_[pin](counter, edge);
+        }
+        ring_prev_pins_ = pins;
+        ring_index_ = (ring_index_ + 1) & (CAPTURE_EDGE_RING - 1);
+        count++;
+    }
+    return count;
+}
+
 void capture_edge_remove(void) {
     for (uint pin = 0; pin < pin_count_; pin++) capture_edge_set_handler(pin, NULL);
     pio_remove_program(pio_, &capture_edge_program, offset_);
@@ -147,7 +195,49 @@ void capture_edge_remove(void) {
     dma_channel_unclaim(dma_channel_counter_);
     dma_channel_unclaim(dma_channel_reload_counter_);
     dma_channel_unclaim(dma_channel_reload_pins_);
-    dma_channel_unclaim(dma_channel_reload_write_counter_);
+    if (!is_batch_) dma_channel_unclaim(dma_channel_reload_write_counter_);
+}
+
+static void init_sm(uint pin_base, uint pin_count, float clk_div) {
+    sm_ = pio_claim_unused_sm(pio_, true);
+    offset_ = pio_add_program(pio_, &capture_edge_program);
+    pio_sm_set_consecutive_pindirs(pio_, sm_, pin_base, pin_count, false);
+    pio_sm_config c = capture_edge_program_get_default_config(offset_);
+    sm_config_set_clkdiv(&c, clk_div);
+    sm_config_set_in_pins(&c, pin_base);
+    pio_->instr_mem[offset_ + 3] = pio_encode_in(pio_pins, pin_count);
+    pio_->instr_mem[offset_ + 4] = pio_encode_in(pio_null, 32 - pin_count);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    pio_sm_init(pio_, sm_, offset_ + capture_edge_offset_start, &c);
+}
+
+/* Free running counter: the transfer count of a dma channel paced by a dma timer every COUNTER_CYCLES */
+static void init_counter(void) {
+    dma_channel_counter_ = dma_claim_unused_channel(true);
+    dma_channel_reload_counter_ = dma_claim_unused_channel(true);
+
+    // dma channel counter
+    dma_channel_config config_dma_channel_counter = dma_channel_get_default_config(dma_channel_counter_);
+    channel_config_set_write_increment(&config_dma_channel_counter, false);
+    channel_config_set_read_increment(&config_dma_channel_counter, false);
+    uint dma_timer = dma_claim_unused_timer(true);
+    dma_timer_set_fraction(dma_timer, 1, COUNTER_CYCLES);
+    channel_config_set_dreq(&config_dma_channel_counter, dma_get_timer_dreq(dma_timer));
+    channel_config_set_chain_to(&config_dma_channel_counter, dma_channel_reload_counter_);
+    dma_channel_configure(dma_channel_counter_, &config_dma_channel_counter,
+                          NULL,  // write address
+                          NULL,  // read address
+                          0xffffffff, false);
+
+    // dma channel reload counter
+    dma_channel_config config_dma_channel_reload_counter = dma_channel_get_default_config(dma_channel_reload_counter_);
+    channel_config_set_transfer_data_size(&config_dma_channel_reload_counter, DMA_SIZE_32);
+    channel_config_set_write_increment(&config_dma_channel_reload_counter, false);
+    channel_config_set_read_increment(&config_dma_channel_reload_counter, false);
+    dma_channel_configure(dma_channel_reload_counter_, &config_dma_channel_reload_counter,
+                          &dma_hw->ch[dma_channel_counter_].al1_transfer_count_trig,  // write address
+                          &reload_counter_,                                           // read address
+                          1, false);
 }
 
 static inline void handler_pio(void) {
@@ -18,12 +18,24 @@ extern "C" {
 #include "capture_edge.pio.h"
 #include "hardware/pio.h"
 
+/*
+   capture_edge_init() calls the pin handlers from the pio irq at every edge. capture_edge_init_batch() has no irq: dma
+   stores the pins and the counter of each edge in a ring of CAPTURE_EDGE_RING edges and capture_edge_drain() calls
+   the handlers from the task for the edges stored since the previous drain. Drain before the ring fills, edges older
+   than CAPTURE_EDGE_RING are overwritten
+*/
+
+#define CAPTURE_EDGE_RING_LOG2 8
+#define CAPTURE_EDGE_RING (1 << CAPTURE_EDGE_RING_LOG2)
+
 typedef enum edge_type_t { EDGE_NONE, EDGE_FALL, EDGE_RISE } edge_type_t;
 
 typedef void (*capture_handler_t)(uint counter, edge_type_t edge);
 
 void capture_edge_init(PIO pio, uint pin_base, uint pin_count, float clk_div, uint irq);
+void capture_edge_init_batch(PIO pio, uint pin_base, uint pin_count, float clk_div);
 void capture_edge_set_handler(uint pin, capture_handler_t handler);
+uint capture_edge_drain(void);
 void capture_edge_remove(void);
 
 #ifdef __cplusplus
@@ -1,14 +1,17 @@
 #include "castle_link.h"
 
-#include <math.h>
+#include <string.h>
 
 #include "hardware/irq.h"
 #include "hardware/pio.h"
 #include "pico/stdlib.h"
+#include "seqlock.h"
 
 static uint sm_pulse_, sm_counter_, offset_pulse_, offset_counter_;
 static PIO pio_;
-static void (*handler_)(castle_link_telemetry_t packet) = {NULL};
+static void (*handler_)(void) = {NULL};
+static castle_link_frame_t frame_;
+static seqlock_t lock_;
 
 static inline void handler_pio();
 
@@ -47,6 +50,8 @@ void castle_link_init(PIO pio, uint pin, uint irq) {
 
 void castle_link_set_handler(castle_link_handler_t handler) { handler_ = handler; }
 
+bool castle_link_read(castle_link_frame_t *frame) { return seqlock_read(&lock_, frame, &frame_, sizeof(frame_)); }
+
 void castle_link_remove() {
     castle_link_set_handler(NULL);
     pio_remove_program(pio_, &pulse_program, offset_pulse_);
@@ -57,8 +62,7 @@ void castle_link_remove() {
 
 static inline void handler_pio() {
     static uint index = 0;
-    static const float scaler[11] = {0, 20, 4, 50, 1, 0.2502, 20416.7, 4, 4, 30, 63.8125};
-    static uint value[12];
+    static uint16_t value[CASTLE_LINK_PULSES];
 
     pio_interrupt_clear(pio_, CASTLE_LINK_IRQ_NUM);
     if (pio_sm_is_rx_fifo_full(pio_, sm_counter_)) {
@@ -68,44 +72,14 @@ static inline void handler_pio() {
     uint data = pio_sm_get_blocking(pio_, sm_counter_);
     if (data > 50000) {
         index = 0;
-        // printf("%i \n", data);
         return;
     }
-    if (index > 10) return;
-    value[index] = data;
-    // printf("(%u)%u ", index, value[index]);
-    if (index == 10) {
-        uint calibration;
-        castle_link_telemetry_t packet;
-        if (value[9] < value[10]) {
-            calibration = value[0] / 2 + value[9];
-            packet.is_temp_ntc = true;
-            float temp_raw = ((float)value[10] - calibration / 2) * scaler[10] / calibration;
-            packet.temperature =
-                1 / (log(temp_raw * 10200.0 / (255.0 - temp_raw) / 10000.0) / 3455.0 + 1.0 / 298.0) - 273.0;
-        } else {
-            calibration = value[0] / 2 + value[10];
-            packet.is_temp_ntc = false;
-            packet.temperature = ((float)value[9] - calibration / 2) * scaler[9] / calibration;
-        }
-        packet.voltage = ((float)value[1] - calibration / 2) * scaler[1] / calibration;
-        packet.ripple_voltage = ((float)value[2] - calibration / 2) * scaler[2] / calibration;
-        packet.current = ((float)value[3] - calibration / 2) * scaler[3] / calibration;
-        packet.thr = ((float)value[4] - calibration / 2) * scaler[4] / calibration;
-        packet.output = ((float)value[5] - calibration / 2) * scaler[5] / calibration;
-        packet.rpm = ((float)value[6] - calibration / 2) * scaler[6] / calibration;
-        packet.voltage_bec = ((float)value[7] - calibration / 2) * scaler[7] / calibration;
-        packet.current_bec = ((float)value[8] - calibration / 2) * scaler[8] / calibration;
-        if (packet.voltage < 0) packet.voltage = 0;
-        if (packet.ripple_voltage < 0) packet.ripple_voltage = 0;
-        if (packet.current < 0) packet.current = 0;
-        if (packet.thr < 0) packet.thr = 0;
-        if (packet.output < 0) packet.output = 0;
-        if (packet.rpm < 0) packet.rpm = 0;
-        if (packet.voltage_bec < 0) packet.voltage_bec = 0;
-        if (packet.current_bec < 0) packet.current_bec = 0;
-        if (packet.temperature < 0) packet.temperature = 0;
-        handler_(packet);
+    if (index >= CASTLE_LINK_PULSES) return;
+    value[index++] = data;
+    if (index == CASTLE_LINK_PULSES) {
+        seqlock_write_begin(&lock_);
+        memcpy(frame_.value, value, sizeof(value));
+        seqlock_write_end(&lock_);
+        if (handler_) handler_();
     }
-    index++;
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #ifndef PIO_CASTLE
 #define PIO_CASTLE
 
+#include "castle_decoder.h"
 #include "castle_link.pio.h"
 
 /*                 castle telemetry
@@ -20,23 +21,16 @@
     11      temp ntc (C) or calib 2 (500us)  63.8125
 */
 
-typedef struct castle_link_telemetry_t {
-    float voltage;
-    float ripple_voltage;
-    float current;
-    float thr;
-    float output;
-    float rpm;
-    float voltage_bec;
-    float current_bec;
-    float temperature;
-    bool is_temp_ntc;
-} castle_link_telemetry_t;
+/*
+   The pio irq only stores the pulse widths. A complete frame is published lock free for castle_link_read() and the
+   handler is called, still in the irq, to wake the task that decodes it (castle_decoder.h)
+*/
 
-typedef void (*castle_link_handler_t)(castle_link_telemetry_t packet);
+typedef void (*castle_link_handler_t)(void);
 
 void castle_link_init(PIO pio, uint pin_base, uint irq);
 void castle_link_set_handler(castle_link_handler_t handler);
+bool castle_link_read(castle_link_frame_t *frame);
 void castle_link_remove();
 
 #endif
@@ -7,6 +7,7 @@
 #include "hardware/pio.h"
 #include "i2c_multi.pio.h"
 #include "pico/stdlib.h"
+#include "pool.h"
 
 #define CLK_DIV 16
 
@@ -25,7 +26,7 @@ static inline void stop_handler_pio();
 static inline uint8_t transpond_byte(uint8_t byte);
 
 void i2c_multi_init(PIO pio, uint pin) {
-    i2c_multi = (i2c_multi_t *)malloc(sizeof(i2c_multi_t));
+    i2c_multi = (i2c_multi_t *)pool_alloc(sizeof(i2c_multi_t));
     i2c_multi->pio = pio;
     i2c_multi->status = I2C_IDLE;
     i2c_multi->pin = pin;
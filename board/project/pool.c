@@ -0,0 +1,70 @@
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_ALIGN 8
+
+static uint8_t arena[POOL_SIZE] __attribute__((aligned(POOL_ALIGN)));
+static size_t used, heap_used;
+
+void *pool_alloc(size_t size) {
+    void *block = NULL;
+    size = (size + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+    taskENTER_CRITICAL();
+    if (size <= POOL_SIZE - used) {
+        block = arena + used;
+        used += size;
+    }
+    taskEXIT_CRITICAL();
+    if (block) return block;
+    debug("\nPool. Full (%u + %u > %u). Using heap", (uint)used, (uint)size, POOL_SIZE);
+    heap_used += size;
+    return calloc(1, size);
+}
+
+BaseType_t pool_task_create(TaskFunction_t task, const char *const name, const configSTACK_DEPTH_TYPE stack_depth,
+                            void *const parameters, UBaseType_t priority, TaskHandle_t *const created_task) {
+    StaticTask_t *task_buffer = pool_alloc(sizeof(StaticTask_t));
+    StackType_t *stack = pool_alloc(stack_depth * sizeof(StackType_t));
+    TaskHandle_t task_handle = xTaskCreateStatic(task, name, stack_depth, parameters, priority, stack, task_buffer);
+    if (created_task) *created_task = task_handle;
+    return task_handle ? pdPASS : pdFAIL;
+}
+
+/* Pinned from creation, so the irqs the task enables on start are on that core. Single core kernels ignore core */
+BaseType_t pool_task_create_on_core(TaskFunction_t task, const char *const name,
+                                    const configSTACK_DEPTH_TYPE stack_depth, void *const parameters,
+                                    UBaseType_t priority, UBaseType_t core, TaskHandle_t *const created_task) {
+#if configNUMBER_OF_CORES > 1
+    StaticTask_t *task_buffer = pool_alloc(sizeof(StaticTask_t));
+    StackType_t *stack = pool_alloc(stack_depth * sizeof(StackType_t));
+    TaskHandle_t task_handle = xTaskCreateStaticAffinitySet(task, name, stack_depth, parameters, priority, stack,
+                                                            task_buffer, 1 << core);
+    if (created_task) *created_task = task_handle;
+    return task_handle ? pdPASS : pdFAIL;
+#else
+    return pool_task_create(task, name, stack_depth, parameters, priority, created_task);
+#endif
+}
+
+QueueHandle_t pool_queue_create(UBaseType_t length, UBaseType_t item_size) {
+    StaticQueue_t *queue_buffer = pool_alloc(sizeof(StaticQueue_t));
+    uint8_t *storage = item_size ? pool_alloc(length * item_size) : NULL;
+    return xQueueCreateStatic(length, item_size, storage, queue_buffer);
+}
+
+SemaphoreHandle_t pool_mutex_create(void) { return xSemaphoreCreateMutexStatic(pool_alloc(sizeof(StaticSemaphore_t))); }
+
+size_t pool_used(void) { return used; }
+
+size_t pool_heap_used(void) { return heap_used; }
+
+void pool_report(void) { debug("\nPool. Used %u/%u, heap %u", (uint)used, POOL_SIZE, (uint)heap_used); }
+
+void pool_reset(void) {
+    memset(arena, 0, used);
+    used = 0;
+    heap_used = 0;
+}
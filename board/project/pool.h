@@ -0,0 +1,32 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include "common.h"
+
+/*
+   Static pool
+   Sensor values, protocol state, task control blocks, stacks and queues are taken at startup from one static arena
+   instead of the heap. Nothing is freed. Protocol and sensors are selected at run time from the flash config, so the
+   arena (POOL_SIZE) is sized at build time for the largest configuration. If a configuration does not fit, the
+   allocation falls back to the heap and pool_report() shows it
+*/
+
+extern context_t context;
+
+void *pool_alloc(size_t size);
+BaseType_t pool_task_create(TaskFunction_t task, const char *const name, const configSTACK_DEPTH_TYPE stack_depth,
+                            void *const parameters, UBaseType_t priority, TaskHandle_t *const created_task);
+BaseType_t pool_task_create_on_core(TaskFunction_t task, const char *const name,
+                                    const configSTACK_DEPTH_TYPE stack_depth, void *const parameters,
+                                    UBaseType_t priority, UBaseType_t core, TaskHandle_t *const created_task);
+QueueHandle_t pool_queue_create(UBaseType_t length, UBaseType_t item_size);
+SemaphoreHandle_t pool_mutex_create(void);
+size_t pool_used(void);
+size_t pool_heap_used(void);
+void pool_report(void);
+void pool_reset(void);
+
+#endif
@@ -5,30 +5,14 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
-#include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_omp_m4.h"
-#include "esc_pwm.h"
-#include "esc_ztw.h"
+#include "crc.h"
+#include "crsf_scheduler.h"
 #include "gps.h"
 #include "ibus.h"
-#include "ms5611.h"
-#include "ntc.h"
-#include "pwm_out.h"
-#include "smart_esc.h"
+#include "sensor_registry.h"
 #include "uart.h"
 #include "uart_pio.h"
-#include "voltage.h"
 
 #define CRSF_FRAMETYPE_GPS 0x02
 #define CRSF_FRAMETYPE_VARIO 0x07
@@ -50,6 +34,10 @@
 #define CRSF_FRAMETYPE_GPS_EXTENDED 0x06
 
 #define CRSF_TIMEOUT_US 1000
+#define CRSF_FRAME_MAX 64
+#define CRSF_LINK_BYTES_PER_S 1500  // no rc frames received. A 15 bytes frame every 10 ms
+#define CRSF_BYTES_PER_RC_FRAME 15  // telemetry bytes per received rc frame, the link packet rate
+#define CRSF_LINK_WINDOW_MS 1000
 
 #define TYPE_GPS 0
 #define TYPE_VARIO 1
@@ -209,12 +197,47 @@ typedef struct crsf_sensors_t {
     crsf_sensor_gps_extended_t gps_extended;
 } crsf_sensors_t;
 
+typedef struct crsf_link_t {
+    uint rc_frames;
+    uint32_t first_us, last_us, window_us;
+} crsf_link_t;
+
+// target interval and priority per frame type. Vario and baro change fastest, gps time is for the log only
+static const uint16_t frame_interval_ms[MAX_SENSORS] = {
+    [TYPE_GPS] = 200,
+    [TYPE_VARIO] = 50,
+    [TYPE_BATERY] = 200,
+    [TYPE_BARO] = 100,
+    [TYPE_AIRSPEED] = 100,
+    [TYPE_RPM] = 200,
+    [TYPE_TEMP] = 1000,
+    [TYPE_CELLS] = 500,
+    [TYPE_GPS_TIME] = 1000,
+    [TYPE_GPS_EXTENDED] = 500,
+};
+static const uint8_t frame_priority[MAX_SENSORS] = {
+    [TYPE_GPS] = 2,
+    [TYPE_VARIO] = 3,
+    [TYPE_BATERY] = 2,
+    [TYPE_BARO] = 3,
+    [TYPE_AIRSPEED] = 2,
+    [TYPE_RPM] = 2,
+    [TYPE_TEMP] = 1,
+    [TYPE_CELLS] = 1,
+    [TYPE_GPS_TIME] = 0,
+    [TYPE_GPS_EXTENDED] = 1,
+};
+
+static crsf_scheduler_t scheduler;
+static uint8_t slot_type[MAX_SENSORS];
+static crsf_link_t rx_link;
+
 static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buffer);
-static void send_packet(crsf_sensors_t *sensors);
-static uint8_t get_crc(const uint8_t *ptr, uint32_t len);
-static uint8_t crc8(uint8_t crc, unsigned char a);
+static void add_slots(crsf_sensors_t *sensors);
+static void read_frames(void);
+static void update_link_rate(void);
+static void send_frames(crsf_sensors_t *sensors);
 static void set_config(crsf_sensors_t *sensors);
-static inline uint sensor_count(crsf_sensors_t *sensors);
 
 void crsf_task(void *parameters) {
     crsf_sensors_t sensors = {0};
@@ -222,10 +245,16 @@ void crsf_task(void *parameters) {
     context.led_cycle_duration = 6;
     context.led_cycles = 1;
     uart0_begin(416666L, UART_RECEIVER_TX, UART_RECEIVER_RX, CRSF_TIMEOUT_US, 8, 1, UART_PARITY_NONE, false, false);
+    add_slots(&sensors);
     debug("\nCRSF init");
     while (1) {
-        vTaskDelay(10 / portTICK_PERIOD_MS);
-        send_packet(&sensors);
+        // wake on a received frame or when the next frame is due
+        uint32_t wait_us = crsf_scheduler_wait_us(&scheduler, time_us_32());
+        TickType_t ticks =
+            wait_us == UINT32_MAX ? portMAX_DELAY : (wait_us / 1000 + portTICK_PERIOD_MS) / portTICK_PERIOD_MS;
+        if (ulTaskNotifyTakeIndexed(1, pdTRUE, ticks)) read_frames();
+        update_link_rate();
+        send_frames(&sensors);
     }
 }
 
@@ -252,7 +281,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             }
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_gps_formatted_t));
             buffer[3 + sizeof(crsf_sensor_gps_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_gps_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_gps_formatted_t) + 1);
             len = sizeof(crsf_sensor_gps_formatted_t) + 4;
             break;
         }
@@ -263,7 +292,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             if (sensors->vario.vspeed) sensor.vspeed = swap_16((int16_t)(*sensors->vario.vspeed * 100));
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_vario_formatted_t));
             buffer[3 + sizeof(crsf_sensor_vario_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_vario_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_vario_formatted_t) + 1);
             len = sizeof(crsf_sensor_vario_formatted_t) + 4;
             break;
         }
@@ -276,7 +305,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             if (sensors->battery.capacity) sensor.capacity = swap_24((uint32_t)*sensors->battery.capacity);
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_battery_formatted_t));
             buffer[3 + sizeof(crsf_sensor_battery_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_battery_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_battery_formatted_t) + 1);
             len = sizeof(crsf_sensor_battery_formatted_t) + 4;
             break;
         }
@@ -293,7 +322,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             }
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_baro_formatted_t));
             buffer[3 + sizeof(crsf_sensor_baro_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_baro_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_baro_formatted_t) + 1);
             len = sizeof(crsf_sensor_baro_formatted_t) + 4;
             break;
         }
@@ -304,7 +333,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             if (sensors->airspeed.speed) sensor.speed = swap_16((int16_t)(*sensors->airspeed.speed * 10));
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_airspeed_formatted_t));
             buffer[3 + sizeof(crsf_sensor_airspeed_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_airspeed_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_airspeed_formatted_t) + 1);
             len = sizeof(crsf_sensor_airspeed_formatted_t) + 4;
             break;
         }
@@ -315,7 +344,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             if (sensors->rpm.rpm) sensor.rpm = swap_24((int32_t)(*sensors->rpm.rpm));
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_rpm_formatted_t));
             buffer[3 + sizeof(crsf_sensor_rpm_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_rpm_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_rpm_formatted_t) + 1);
             len = sizeof(crsf_sensor_rpm_formatted_t) + 4;
             break;
         }
@@ -333,7 +362,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
                 sensor.temp[3] = swap_16((int16_t)(*sensors->temperature.temperature[3] * 10));
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_temp_formatted_t));
             buffer[3 + sizeof(crsf_sensor_temp_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_temp_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_temp_formatted_t) + 1);
             len = sizeof(crsf_sensor_temp_formatted_t) + 4;
             break;
         }
@@ -349,7 +378,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             }
             uint8_t size = sizeof(sensor.source) + sizeof(sensor.cells[0]) * *sensors->cells.cell_count;
             memcpy(&buffer[3], &sensor, size);
-            buffer[3 + size] = get_crc(&buffer[2], size + 1);
+            buffer[3 + size] = crc8_dvb_s2(0, &buffer[2], size + 1);
             len = size + 4;
             buffer[1] = size + 2;
             break;
@@ -367,7 +396,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             sensor.second = ((uint)*sensors->gps_time.time - sensor.hour * 10000 - sensor.minute * 100);
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_gps_time_formatted_t));
             buffer[3 + sizeof(crsf_sensor_gps_time_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_gps_time_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_gps_time_formatted_t) + 1);
             len = sizeof(crsf_sensor_gps_time_formatted_t) + 4;
             break;
         }
@@ -386,7 +415,7 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
             sensor.vDOP = *sensors->gps_extended.vdop * 10;
             memcpy(&buffer[3], &sensor, sizeof(crsf_sensor_gps_extended_formatted_t));
             buffer[3 + sizeof(crsf_sensor_gps_extended_formatted_t)] =
-                get_crc(&buffer[2], sizeof(crsf_sensor_gps_extended_formatted_t) + 1);
+                crc8_dvb_s2(0, &buffer[2], sizeof(crsf_sensor_gps_extended_formatted_t) + 1);
             len = sizeof(crsf_sensor_gps_extended_formatted_t) + 4;
             break;
         }
@@ -394,21 +423,60 @@ static uint8_t format_sensor(crsf_sensors_t *sensors, uint8_t type, uint8_t *buf
     return len;
 }
 
-static inline uint sensor_count(crsf_sensors_t *sensors) {
-    uint count = 0;
-    for (uint i = 0; i < MAX_SENSORS; i++)
-        if (sensors->enabled_sensors[i]) count++;
-    return count;
+static void add_slots(crsf_sensors_t *sensors) {
+    uint32_t now = time_us_32();
+    crsf_scheduler_init(&scheduler, CRSF_LINK_BYTES_PER_S, now);
+    rx_link = (crsf_link_t){.window_us = now};
+    for (uint type = 0; type < MAX_SENSORS; type++) {
+        if (!sensors->enabled_sensors[type]) continue;
+        int slot = crsf_scheduler_add(&scheduler, frame_interval_ms[type], frame_priority[type], now);
+        if (slot >= 0) slot_type[slot] = type;
+    }
+}
+
+static void read_frames(void) {
+    uint length = uart0_available();
+    if (!length) return;
+    uint8_t data[length];
+    uart0_read_bytes(data, length);
+    uint32_t now = time_us_32();
+    for (uint i = 0; i + 2 < length && data[i] == 0xC8; i += data[i + 1] + 2) {
+        if (data[i + 2] != CRSF_FRAMETYPE_RC_CHANNELS_PACKED) continue;
+        if (!rx_link.rc_frames++) rx_link.first_us = now;
+        rx_link.last_us = now;
+    }
+}
+
+/*
+   The receiver forwards rc frames at the link packet rate, so telemetry is budgeted per rc frame received. The rate
+   is measured between the first and last rc frame of the window, so a link coming up mid window is not under counted
+*/
+static void update_link_rate(void) {
+    uint32_t now = time_us_32();
+    if (now - rx_link.window_us < CRSF_LINK_WINDOW_MS * 1000) return;
+    if (!rx_link.rc_frames)
+        crsf_scheduler_set_rate(&scheduler, CRSF_LINK_BYTES_PER_S);
+    else if (rx_link.rc_frames > 1 && rx_link.last_us != rx_link.first_us)
+        crsf_scheduler_set_rate(&scheduler, (uint64_t)(rx_link.rc_frames - 1) * CRSF_BYTES_PER_RC_FRAME * 1000000 /
+                                                (rx_link.last_us - rx_link.first_us));
+    rx_link.rc_frames = 0;
+    rx_link.window_us = now;
 }
 
-static void send_packet(crsf_sensors_t *sensors) {
-    if (!sensor_count(sensors)) return;
-    static uint type = 0;
-    uint8_t buffer[64] = {0};
-    while (!sensors->enabled_sensors[type % MAX_SENSORS]) type++;
-    uint len = format_sensor(sensors, type % MAX_SENSORS, buffer);
+/* Due frames are packed back to back in one write */
+static void send_frames(crsf_sensors_t *sensors) {
+    sensor_registry_snapshot();
+    uint8_t buffer[2 * CRSF_FRAME_MAX] = {0};
+    uint32_t now = time_us_32();
+    uint len = 0;
+    int slot;
+    while (len + CRSF_FRAME_MAX <= sizeof(buffer) && (slot = crsf_scheduler_next(&scheduler, now)) >= 0) {
+        uint frame_len = format_sensor(sensors, slot_type[slot], buffer + len);
+        crsf_scheduler_sent(&scheduler, frame_len, now);
+        len += frame_len;
+    }
+    if (!len) return;
     uart0_write_bytes(buffer, len);
-    type++;
     debug("\nCRSF (%u) > ", uxTaskGetStackHighWaterMark(NULL));
     debug_buffer(buffer, len, "0x%X ");
 
@@ -416,528 +484,233 @@ static void send_packet(crsf_sensors_t *sensors) {
     vTaskResume(context.led_task_handle);
 }
 
-static uint8_t get_crc(const uint8_t *ptr, uint32_t len) {
-    uint8_t crc = 0;
-    for (uint32_t i = 0; i < len; i++) {
-        crc = crc8(crc, *ptr++);
-    }
-    return crc;
-}
-
-static uint8_t crc8(uint8_t crc, unsigned char a) {
-    crc ^= a;
-    for (int ii = 0; ii < 8; ++ii) {
-        if (crc & 0x80) {
-            crc = (crc << 1) ^ 0xD5;
-        } else {
-            crc = crc << 1;
-        }
-    }
-    return crc;
-}
-
 static void set_config(crsf_sensors_t *sensors) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
-    float *baro_temp = NULL, *baro_pressure = NULL;
+    sensor_values_t *values = sensor_registry_start(config);
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->rpm.rpm = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->rpm.rpm = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature_fet;
-        sensors->temperature.temperature[1] = parameter.temperature_bec;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
+        sensors->temperature.temperature[1] = &values->esc.temperature_bec;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature_fet;
-        sensors->temperature.temperature[1] = parameter.temperature_bec;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
+        sensors->temperature.temperature[1] = &values->esc.temperature_bec;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature_fet;
-        sensors->temperature.temperature[1] = parameter.temperature_bec;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
+        sensors->temperature.temperature[1] = &values->esc.temperature_bec;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_SMART) {
-        smart_esc_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temperature_fet = malloc(sizeof(float));
-        parameter.temperature_bec = malloc(sizeof(float));
-        parameter.voltage_bec = malloc(sizeof(float));
-        parameter.current_bec = malloc(sizeof(float));
-        parameter.temperature_bat = malloc(sizeof(float));
-        parameter.current_bat = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        for (uint i = 0; i < 18; i++) parameter.cell[i] = malloc(sizeof(float));
-        parameter.cells = malloc(sizeof(uint8_t));
-        parameter.cycles = malloc(sizeof(uint16_t));
-        xTaskCreate(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temperature_fet;
-        sensors->temperature.temperature[1] = parameter.temperature_bec;
-        sensors->temperature.temperature[2] = parameter.temperature_bat;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
+        sensors->temperature.temperature[1] = &values->esc.temperature_bec;
+        sensors->temperature.temperature[2] = &values->esc.temperature_bat;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = false;
-        sensors->cells.cell_count = parameter.cells;
-        for (uint i = 0; i < 18; i++) sensors->cells.cell[i] = parameter.cell[i];
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        for (uint i = 0; i < 18; i++) sensors->cells.cell[i] = &values->esc.cell[i];
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temp_esc;
-        sensors->temperature.temperature[1] = parameter.temp_motor;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
+        sensors->temperature.temperature[1] = &values->esc.temperature_motor;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_ztw_task, "esc_ztw_task", STACK_ESC_ZTW, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
+        sensors->battery.voltage = &values->esc.voltage;
+        sensors->battery.current = &values->esc.current;
+        sensors->battery.capacity = &values->esc.consumption;
 
         sensors->enabled_sensors[TYPE_RPM] = true;
-        sensors->rpm.rpm = parameter.rpm;
+        sensors->rpm.rpm = &values->esc.rpm;
 
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[0] = parameter.temp_esc;
-        sensors->temperature.temperature[1] = parameter.temp_motor;
+        sensors->temperature.temperature[0] = &values->esc.temperature_fet;
+        sensors->temperature.temperature[1] = &values->esc.temperature_motor;
 
         sensors->enabled_sensors[TYPE_CELLS] = true;
         sensors->cells.is_average = true;
-        sensors->cells.cell_count = parameter.cell_count;
-        sensors->cells.cell[0] = parameter.cell_voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->cells.cell_count = &values->esc.cell_count;
+        sensors->cells.cell[0] = &values->esc.cell_voltage;
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-
         sensors->enabled_sensors[TYPE_GPS] = true;
-        sensors->gps.latitude = parameter.lat;
-        sensors->gps.longitude = parameter.lon;
-        sensors->gps.groundspeed = parameter.spd_kmh;
-        sensors->gps.heading = parameter.cog;
-        sensors->gps.satellites = parameter.sat;
-        sensors->gps.altitude = parameter.alt;
+        sensors->gps.latitude = &values->gps.lat;
+        sensors->gps.longitude = &values->gps.lon;
+        sensors->gps.groundspeed = &values->gps.spd_kmh;
+        sensors->gps.heading = &values->gps.cog;
+        sensors->gps.satellites = &values->gps.sat;
+        sensors->gps.altitude = &values->gps.alt;
 
         /*sensors->enabled_sensors[TYPE_GPS_TIME] = true;
-        sensors->gps_time.date = parameter.date;
-        sensors->gps_time.time = parameter.time;
+        sensors->gps_time.date = &values->gps.date;
+        sensors->gps_time.time = &values->gps.time;
 
         sensors->enabled_sensors[TYPE_GPS_EXTENDED] = true;
-        sensors->gps_extended.hdop = parameter.hdop;
-        sensors->gps_extended.fix = parameter.fix;
-        sensors->gps_extended.vdop = parameter.vdop;
-        sensors->gps_extended.n_speed = parameter.n_vel;
-        sensors->gps_extended.e_speed = parameter.e_vel;
-        sensors->gps_extended.v_speed = parameter.v_vel;
-        sensors->gps_extended.h_speed_acc = parameter.h_acc;
-        sensors->gps_extended.track_acc = parameter.track_acc;
-        sensors->gps_extended.alt_ellipsoid = parameter.alt_elipsiod;
-        sensors->gps_extended.h_acc = parameter.h_acc;
-        sensors->gps_extended.v_acc = parameter.v_acc;*/
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->gps_extended.hdop = &values->gps.hdop;
+        sensors->gps_extended.fix = &values->gps.fix;
+        sensors->gps_extended.vdop = &values->gps.vdop;
+        sensors->gps_extended.n_speed = &values->gps.n_vel;
+        sensors->gps_extended.e_speed = &values->gps.e_vel;
+        sensors->gps_extended.v_speed = &values->gps.v_vel;
+        sensors->gps_extended.h_speed_acc = &values->gps.h_acc;
+        sensors->gps_extended.track_acc = &values->gps.track_acc;
+        sensors->gps_extended.alt_ellipsoid = &values->gps.alt_elipsiod;
+        sensors->gps_extended.h_acc = &values->gps.h_acc;
+        sensors->gps_extended.v_acc = &values->gps.v_acc;*/
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.voltage = parameter.voltage;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->battery.voltage = &values->analog.voltage;
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_BATERY] = true;
-        sensors->battery.current = parameter.current;
-        sensors->battery.capacity = parameter.consumption;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->battery.current = &values->analog.current;
+        sensors->battery.capacity = &values->analog.consumption;
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_TEMP] = true;
-        sensors->temperature.temperature[3] = parameter.ntc;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->temperature.temperature[3] = &values->analog.ntc;
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         sensors->enabled_sensors[TYPE_BARO] = true;
-        sensors->baro.altitude = parameter.altitude;
-        sensors->baro.vspeed = parameter.vspeed;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->baro.altitude = &values->baro.altitude;
+        sensors->baro.vspeed = &values->baro.vspeed;
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         sensors->enabled_sensors[TYPE_BARO] = true;
-        sensors->baro.altitude = parameter.altitude;
-        sensors->baro.vspeed = parameter.vspeed;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->baro.altitude = &values->baro.altitude;
+        sensors->baro.vspeed = &values->baro.vspeed;
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         sensors->enabled_sensors[TYPE_BARO] = true;
-        sensors->baro.altitude = parameter.altitude;
-        sensors->baro.vspeed = parameter.vspeed;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->baro.altitude = &values->baro.altitude;
+        sensors->baro.vspeed = &values->baro.vspeed;
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
         sensors->enabled_sensors[TYPE_AIRSPEED] = true;
-        sensors->airspeed.speed = parameter.airspeed;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        sensors->airspeed.speed = &values->analog.airspeed;
     }
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "crsf_scheduler.h"
+
+void crsf_scheduler_init(crsf_scheduler_t *scheduler, uint32_t bytes_per_s, uint32_t now_us) {
+    scheduler->count = 0;
+    scheduler->link_us = now_us;
+    crsf_scheduler_set_rate(scheduler, bytes_per_s);
+}
+
+/* Returns the slot index or -1 if the table is full */
+int crsf_scheduler_add(crsf_scheduler_t *scheduler, uint32_t interval_ms, uint8_t priority, uint32_t now_us) {
+    if (scheduler->count == CRSF_SCHEDULER_MAX_SLOTS) return -1;
+    uint8_t slot = scheduler->count++;
+    scheduler->interval_us[slot] = interval_ms ? interval_ms * 1000 : 1;
+    scheduler->due_us[slot] = now_us;
+    scheduler->priority[slot] = priority;
+    return slot;
+}
+
+void crsf_scheduler_set_rate(crsf_scheduler_t *scheduler, uint32_t bytes_per_s) {
+    scheduler->byte_us = 1000000 / (bytes_per_s ? bytes_per_s : 1);
+}
+
+/* Returns the slot to send at now_us and schedules its next deadline, or -1 if no slot is due or the link is busy */
+int crsf_scheduler_next(crsf_scheduler_t *scheduler, uint32_t now_us) {
+    if ((int32_t)(scheduler->link_us - now_us) > 0) return -1;
+    int slot = -1;
+    uint64_t max_score = 0;
+    for (uint8_t i = 0; i < scheduler->count; i++) {
+        int32_t late = (int32_t)(now_us - scheduler->due_us[i]);
+        if (late < 0) continue;
+        // lateness in intervals (1/65536), weighted by priority + 1
+        uint64_t score = (((uint64_t)late << 16) / scheduler->interval_us[i] + 1) * (scheduler->priority[i] + 1);
+        if (slot < 0 || score > max_score) {
+            max_score = score;
+            slot = i;
+        }
+    }
+    if (slot < 0) return -1;
+    scheduler->due_us[slot] += scheduler->interval_us[slot];
+    if ((int32_t)(now_us - scheduler->due_us[slot]) > 0) scheduler->due_us[slot] = now_us;
+    return slot;
+}
+
+/* Charges a sent frame to the link. An idle link keeps up to a burst of credit */
+void crsf_scheduler_sent(crsf_scheduler_t *scheduler, uint32_t length, uint32_t now_us) {
+    uint32_t burst_us = CRSF_SCHEDULER_BURST_BYTES * scheduler->byte_us;
+    if ((int32_t)(now_us - scheduler->link_us) > (int32_t)burst_us) scheduler->link_us = now_us - burst_us;
+    scheduler->link_us += length * scheduler->byte_us;
+}
+
+/* Time until a slot can be sent: its deadline or the link free, whichever is later. UINT32_MAX if there are no slots */
+uint32_t crsf_scheduler_wait_us(crsf_scheduler_t *scheduler, uint32_t now_us) {
+    if (!scheduler->count) return UINT32_MAX;
+    int32_t wait = INT32_MAX;
+    for (uint8_t i = 0; i < scheduler->count; i++) {
+        int32_t due = (int32_t)(scheduler->due_us[i] - now_us);
+        if (due < wait) wait = due;
+    }
+    int32_t link = (int32_t)(scheduler->link_us - now_us);
+    if (link > wait) wait = link;
+    return wait > 0 ? wait : 0;
+}
@@ -0,0 +1,35 @@
+#ifndef CRSF_SCHEDULER_H
+#define CRSF_SCHEDULER_H
+
+#include <stdint.h>
+
+/*
+   CRSF telemetry scheduler
+   Each frame type is a slot with a target interval and a priority. Among the due slots the one sent is the most
+   overdue in intervals, weighted by priority + 1, then its deadline moves one interval ahead. A slot that falls more
+   than one interval behind restarts from the send time. Sent bytes are paced to the link rate (bytes/s) with a burst
+   of up to CRSF_SCHEDULER_BURST_BYTES, so when the link can not carry every target rate all slots are slowed down,
+   the lowest priorities the most, but a waiting slot keeps gaining on the others and none starves. Hardware
+   independent (timestamps in us)
+*/
+
+#define CRSF_SCHEDULER_MAX_SLOTS 10
+#define CRSF_SCHEDULER_BURST_BYTES 64
+
+typedef struct crsf_scheduler_t {
+    uint32_t interval_us[CRSF_SCHEDULER_MAX_SLOTS];
+    uint32_t due_us[CRSF_SCHEDULER_MAX_SLOTS];
+    uint8_t priority[CRSF_SCHEDULER_MAX_SLOTS];
+    uint8_t count;
+    uint32_t byte_us;  // link time per byte
+    uint32_t link_us;  // time the link is free again
+} crsf_scheduler_t;
+
+void crsf_scheduler_init(crsf_scheduler_t *scheduler, uint32_t bytes_per_s, uint32_t now_us);
+int crsf_scheduler_add(crsf_scheduler_t *scheduler, uint32_t interval_ms, uint8_t priority, uint32_t now_us);
+void crsf_scheduler_set_rate(crsf_scheduler_t *scheduler, uint32_t bytes_per_s);
+int crsf_scheduler_next(crsf_scheduler_t *scheduler, uint32_t now_us);
+void crsf_scheduler_sent(crsf_scheduler_t *scheduler, uint32_t length, uint32_t now_us);
+uint32_t crsf_scheduler_wait_us(crsf_scheduler_t *scheduler, uint32_t now_us);
+
+#endif
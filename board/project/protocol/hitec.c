@@ -3,40 +3,25 @@
 #include <math.h>
 #include <stdio.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
-#include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_omp_m4.h"
-#include "esc_pwm.h"
-#include "esc_ztw.h"
-#include "gps.h"
+#include "format.h"
 #include "hardware/i2c.h"
 #include "hardware/irq.h"
 #include "i2c_multi.h"
-#include "ms5611.h"
-#include "ntc.h"
 #include "pico/stdlib.h"
-#include "pwm_out.h"
-#include "smart_esc.h"
+#include "pool.h"
+#include "sensor_registry.h"
 #include "stdlib.h"
 #include "uart.h"
 #include "uart_pio.h"
-#include "voltage.h"
 
 #define I2C_INTR_MASK_RD_REQ 0x00000020
 
 #define I2C_ADDRESS 0x08
 #define TIMEOUT 1000
 #define FRAME_LENGTH 7
+#define FRAME_COUNT 11
+#define FORMAT_INTERVAL_MS 20
 
 #define FRAME_0X11 0
 #define FRAME_0X12 1
@@ -76,8 +61,19 @@
 #define FRAME_0X1B_ALTU 0
 #define FRAME_0X1B_ALTF 1
 
+/*
+   Frames are formatted in the task and published to the i2c request irq with a double buffer, as in xbus.c. The irq
+   only selects the next enabled frame and its front buffer. The back buffer is rewritten every FORMAT_INTERVAL_MS, far
+   longer than an i2c frame transfer
+*/
+
+typedef struct hitec_frame_t {
+    uint8_t buffer[2][FRAME_LENGTH];
+    uint8_t front;
+} hitec_frame_t;
+
 typedef struct sensor_hitec_t {
-    bool is_enabled_frame[11];
+    bool is_enabled_frame[FRAME_COUNT];
     float *frame_0x11[1];
     float *frame_0x12[2];
     float *frame_0x13[2];
@@ -92,9 +88,11 @@ typedef struct sensor_hitec_t {
 } sensor_hitec_t;
 
 static sensor_hitec_t *sensor;
+static hitec_frame_t frames[FRAME_COUNT];
 
 static void i2c_request_handler(uint8_t address);
 static void i2c_stop_handler(uint8_t length);
+static void publish_frames(void);
 static void set_config(void);
 static int next_frame(void);
 static void format_packet(uint8_t frame, uint8_t *buffer);
@@ -102,7 +100,7 @@ static void format_packet(uint8_t frame, uint8_t *buffer);
 void hitec_i2c_handler(void) { i2c_request_handler(I2C_ADDRESS); }
 
 void hitec_task(void *parameters) {
-    sensor = malloc(sizeof(sensor_hitec_t));
+    sensor = pool_alloc(sizeof(sensor_hitec_t));
     *sensor =
         (sensor_hitec_t){{0}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}};
 
@@ -110,6 +108,7 @@ void hitec_task(void *parameters) {
     context.led_cycles = 1;
 
     set_config();
+    publish_frames();
 
     PIO pio = pio1;
     uint pin = I2C1_SDA_GPIO;
@@ -122,33 +121,46 @@ void hitec_task(void *parameters) {
     gpio_set_drive_strength(I2C1_SDA_GPIO + 1, GPIO_DRIVE_STRENGTH_12MA);
 
     debug("\nHitec init");
-    vTaskSuspend(NULL);
+
+    while (1) {
+        vTaskDelay(FORMAT_INTERVAL_MS / portTICK_PERIOD_MS);
+        publish_frames();
+    }
 }
 
 static void i2c_stop_handler(uint8_t length) { debug(" - STOP (%u)", length); }
 
 static void i2c_request_handler(uint8_t address) {
-    uint8_t buffer[7] = {0};
-    uint8_t frame = next_frame();
+    int frame = next_frame();
     if (frame < 0) return;
-    format_packet(frame, buffer);
+    uint8_t *buffer = frames[frame].buffer[__atomic_load_n(&frames[frame].front, __ATOMIC_ACQUIRE)];
     i2c_multi_set_write_buffer(buffer);
 
     // blink led
     vTaskResume(context.led_task_handle);
 
     debug("\nHitec (%u) > ", uxTaskGetStackHighWaterMark(context.receiver_task_handle));
-    debug_buffer(buffer, sizeof(buffer), "%X ");
+    debug_buffer(buffer, FRAME_LENGTH, "%X ");
+}
+
+static void publish_frames(void) {
+    sensor_registry_snapshot();
+    for (uint i = 0; i < FRAME_COUNT; i++) {
+        if (!sensor->is_enabled_frame[i]) continue;
+        uint8_t back = !frames[i].front;
+        format_packet(i, frames[i].buffer[back]);
+        __atomic_store_n(&frames[i].front, back, __ATOMIC_RELEASE);
+    }
 }
 
 static int next_frame(void) {
     static uint8_t frame = 0;
     uint cont = 0;
     frame++;
-    frame %= 11;
+    frame %= FRAME_COUNT;
     while (!sensor->is_enabled_frame[frame] && cont < 12) {
         frame++;
-        frame %= 11;
+        frame %= FRAME_COUNT;
         cont++;
     }
     if (cont == 12) return -1;
@@ -208,7 +220,7 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
                 buffer[4] = deg_min;
             }
             if (sensor->frame_0x13[FRAME_0X13_TEMP2]) {
-                valueU8 = round(*sensor->frame_0x13[FRAME_0X13_TEMP2] + 40);
+                valueU8 = format_round(*sensor->frame_0x13[FRAME_0X13_TEMP2] + 40, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             break;
@@ -219,23 +231,23 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
                 buffer[2] = valueU16;
             }
             if (sensor->frame_0x14[FRAME_0X14_GPS_ALT]) {
-                valueS16 = round(*sensor->frame_0x14[FRAME_0X14_GPS_ALT]);
+                valueS16 = format_round(*sensor->frame_0x14[FRAME_0X14_GPS_ALT], INT16_MIN, INT16_MAX);
                 buffer[3] = valueS16 >> 8;
                 buffer[4] = valueS16;
             }
             if (sensor->frame_0x14[FRAME_0X14_TEMP1]) {
-                valueU8 = round(*sensor->frame_0x14[FRAME_0X14_TEMP1] + 40);
+                valueU8 = format_round(*sensor->frame_0x14[FRAME_0X14_TEMP1] + 40, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             break;
         case FRAME_0X15:
             if (sensor->frame_0x15[FRAME_0X15_RPM1]) {
-                valueU16 = round(*sensor->frame_0x15[FRAME_0X15_RPM1]);
+                valueU16 = format_round(*sensor->frame_0x15[FRAME_0X15_RPM1], 0, UINT16_MAX);
                 buffer[2] = valueU16;
                 buffer[3] = valueU16 >> 8;
             }
             if (sensor->frame_0x15[FRAME_0X15_RPM2]) {
-                valueU16 = round(*sensor->frame_0x15[FRAME_0X15_RPM2]);
+                valueU16 = format_round(*sensor->frame_0x15[FRAME_0X15_RPM2], 0, UINT16_MAX);
                 buffer[4] = valueU16;
                 buffer[5] = valueU16 >> 8;
             }
@@ -255,7 +267,7 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
             break;
         case FRAME_0X17:
             if (sensor->frame_0x17[FRAME_0X17_COG]) {
-                valueU16 = round(*sensor->frame_0x17[FRAME_0X17_COG]);
+                valueU16 = format_round(*sensor->frame_0x17[FRAME_0X17_COG], 0, UINT16_MAX);
                 buffer[1] = valueU16 >> 8;
                 buffer[2] = valueU16;
             }
@@ -264,11 +276,11 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
                 buffer[3] = valueU8;
             }
             if (sensor->frame_0x17[FRAME_0X17_TEMP3]) {
-                valueU8 = round(*sensor->frame_0x17[FRAME_0X17_TEMP3] + 40);
+                valueU8 = format_round(*sensor->frame_0x17[FRAME_0X17_TEMP3] + 40, 0, UINT8_MAX);
                 buffer[4] = valueU8;
             }
             if (sensor->frame_0x17[FRAME_0X17_TEMP4]) {
-                valueU8 = round(*sensor->frame_0x17[FRAME_0X17_TEMP4] + 40);
+                valueU8 = format_round(*sensor->frame_0x17[FRAME_0X17_TEMP4] + 40, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             break;
@@ -283,7 +295,7 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
                 // valueU16 = (*sensor->frame_0x18[FRAME_0X18_AMP] + 114.875) * 1.441;
 
                 /* value for opentx transmitter  */
-                valueU16 = round(*sensor->frame_0x18[FRAME_0X18_AMP]);
+                valueU16 = format_round(*sensor->frame_0x18[FRAME_0X18_AMP], 0, UINT16_MAX);
 
                 buffer[3] = valueU16;
                 buffer[4] = valueU16 >> 8;
@@ -291,37 +303,37 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
             break;
         case FRAME_0X19:
             if (sensor->frame_0x19[FRAME_0X19_AMP1]) {
-                valueU8 = round(*sensor->frame_0x19[FRAME_0X19_AMP1] * 10);
+                valueU8 = format_round(*sensor->frame_0x19[FRAME_0X19_AMP1] * 10, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             if (sensor->frame_0x19[FRAME_0X19_AMP2]) {
-                valueU8 = round(*sensor->frame_0x19[FRAME_0X19_AMP2] * 10);
+                valueU8 = format_round(*sensor->frame_0x19[FRAME_0X19_AMP2] * 10, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             if (sensor->frame_0x19[FRAME_0X19_AMP3]) {
-                valueU8 = round(*sensor->frame_0x19[FRAME_0X19_AMP3] * 10);
+                valueU8 = format_round(*sensor->frame_0x19[FRAME_0X19_AMP3] * 10, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             if (sensor->frame_0x19[FRAME_0X19_AMP4]) {
-                valueU8 = round(*sensor->frame_0x19[FRAME_0X19_AMP4] * 10);
+                valueU8 = format_round(*sensor->frame_0x19[FRAME_0X19_AMP4] * 10, 0, UINT8_MAX);
                 buffer[5] = valueU8;
             }
             break;
         case FRAME_0X1A:
             if (sensor->frame_0x1A[FRAME_0X1A_ASPD]) {
-                valueU16 = round(*sensor->frame_0x1A[FRAME_0X1A_ASPD]);
+                valueU16 = format_round(*sensor->frame_0x1A[FRAME_0X1A_ASPD], 0, UINT16_MAX);
                 buffer[3] = valueU16 >> 8;
                 buffer[4] = valueU16;
             }
             break;
         case FRAME_0X1B:
             if (sensor->frame_0x1B[FRAME_0X1B_ALTU]) {
-                valueU16 = round(*sensor->frame_0x1B[FRAME_0X1B_ALTU]);
+                valueU16 = format_round(*sensor->frame_0x1B[FRAME_0X1B_ALTU], 0, UINT16_MAX);
                 buffer[1] = valueU16 >> 8;
                 buffer[2] = valueU16;
             }
             if (sensor->frame_0x1B[FRAME_0X1B_ALTF]) {
-                valueU16 = round(*sensor->frame_0x1B[FRAME_0X1B_ALTF]);
+                valueU16 = format_round(*sensor->frame_0x1B[FRAME_0X1B_ALTF], 0, UINT16_MAX);
                 buffer[3] = valueU16 >> 8;
                 buffer[4] = valueU16;
             }
@@ -331,416 +343,145 @@ static void format_packet(uint8_t frame, uint8_t *buffer) {
 
 static void set_config(void) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
+    sensor_values_t *values = sensor_registry_start(config);
     sensor_hitec_t *new_sensor;
-    float *baro_temp = NULL, *baro_pressure = NULL;
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
         sensor->is_enabled_frame[FRAME_0X15] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
         sensor->is_enabled_frame[FRAME_0X15] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature_fet;
-        sensor->frame_0x13[FRAME_0X13_TEMP2] = parameter.temperature_bec;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
+        sensor->frame_0x13[FRAME_0X13_TEMP2] = &values->esc.temperature_bec;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
         sensor->is_enabled_frame[FRAME_0X13] = true;
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature_fet;
-        sensor->frame_0x13[FRAME_0X13_TEMP2] = parameter.temperature_bec;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
+        sensor->frame_0x13[FRAME_0X13_TEMP2] = &values->esc.temperature_bec;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
         sensor->is_enabled_frame[FRAME_0X13] = true;
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
         sensor->is_enabled_frame[FRAME_0X13] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature_fet;
-        sensor->frame_0x13[FRAME_0X13_TEMP2] = parameter.temperature_bec;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
+        sensor->frame_0x13[FRAME_0X13_TEMP2] = &values->esc.temperature_bec;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
         sensor->is_enabled_frame[FRAME_0X13] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_SMART) {
-        smart_esc_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temperature_fet = malloc(sizeof(float));
-        parameter.temperature_bec = malloc(sizeof(float));
-        parameter.voltage_bec = malloc(sizeof(float));
-        parameter.current_bec = malloc(sizeof(float));
-        parameter.temperature_bat = malloc(sizeof(float));
-        parameter.current_bat = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        for (uint i = 0; i < 18; i++) parameter.cell[i] = malloc(sizeof(float));
-        parameter.cells = malloc(sizeof(uint8_t));
-        parameter.cycles = malloc(sizeof(uint16_t));
-        xTaskCreate(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temperature_fet;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temp_esc;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x15[FRAME_0X15_RPM1] = parameter.rpm;
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.temp_esc;
+        sensor->frame_0x15[FRAME_0X15_RPM1] = &values->esc.rpm;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->esc.voltage;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->esc.current;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->esc.temperature_fet;
         sensor->is_enabled_frame[FRAME_0X15] = true;
         sensor->is_enabled_frame[FRAME_0X18] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-
-        sensor->frame_0x17[FRAME_0X17_SATS] = parameter.sat;
-        sensor->frame_0x12[FRAME_0X12_GPS_LAT] = parameter.lat;
-        sensor->frame_0x13[FRAME_0X13_GPS_LON] = parameter.lon;
-        sensor->frame_0x14[FRAME_0X14_GPS_ALT] = parameter.alt;
-        sensor->frame_0x14[FRAME_0X14_GPS_SPD] = parameter.spd;
-        sensor->frame_0x17[FRAME_0X17_COG] = parameter.cog;
-        sensor->frame_0x16[FRAME_0X16_DATE] = parameter.date;
-        sensor->frame_0x16[FRAME_0X16_TIME] = parameter.time;
+        sensor->frame_0x17[FRAME_0X17_SATS] = &values->gps.sat;
+        sensor->frame_0x12[FRAME_0X12_GPS_LAT] = &values->gps.lat;
+        sensor->frame_0x13[FRAME_0X13_GPS_LON] = &values->gps.lon;
+        sensor->frame_0x14[FRAME_0X14_GPS_ALT] = &values->gps.alt;
+        sensor->frame_0x14[FRAME_0X14_GPS_SPD] = &values->gps.spd;
+        sensor->frame_0x17[FRAME_0X17_COG] = &values->gps.cog;
+        sensor->frame_0x16[FRAME_0X16_DATE] = &values->gps.date;
+        sensor->frame_0x16[FRAME_0X16_TIME] = &values->gps.time;
         sensor->is_enabled_frame[FRAME_0X17] = true;
         sensor->is_enabled_frame[FRAME_0X12] = true;
         sensor->is_enabled_frame[FRAME_0X13] = true;
         sensor->is_enabled_frame[FRAME_0X14] = true;
         sensor->is_enabled_frame[FRAME_0X16] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x18[FRAME_0X18_VOLT] = parameter.voltage;
+        sensor->frame_0x18[FRAME_0X18_VOLT] = &values->analog.voltage;
         sensor->is_enabled_frame[FRAME_0X18] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x18[FRAME_0X18_AMP] = parameter.current;
+        sensor->frame_0x18[FRAME_0X18_AMP] = &values->analog.current;
         sensor->is_enabled_frame[FRAME_0X18] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x14[FRAME_0X14_TEMP1] = parameter.ntc;
+        sensor->frame_0x14[FRAME_0X14_TEMP1] = &values->analog.ntc;
         sensor->is_enabled_frame[FRAME_0X14] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->frame_0x1B[FRAME_0X1B_ALTU] = parameter.altitude;
+        sensor->frame_0x1B[FRAME_0X1B_ALTU] = &values->baro.altitude;
         sensor->is_enabled_frame[FRAME_0X1B] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->frame_0x1B[FRAME_0X1B_ALTU] = parameter.altitude;
+        sensor->frame_0x1B[FRAME_0X1B_ALTU] = &values->baro.altitude;
         sensor->is_enabled_frame[FRAME_0X1B] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->frame_0x1B[FRAME_0X1B_ALTU] = parameter.altitude;
+        sensor->frame_0x1B[FRAME_0X1B_ALTU] = &values->baro.altitude;
         sensor->is_enabled_frame[FRAME_0X1B] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->frame_0x1A[FRAME_0X1A_ASPD] = parameter.airspeed;
+        sensor->frame_0x1A[FRAME_0X1A_ASPD] = &values->analog.airspeed;
         sensor->is_enabled_frame[FRAME_0X1A] = true;
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 }
@@ -5,38 +5,21 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "common.h"
 #include "config.h"
 #include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_omp_m4.h"
-#include "esc_pwm.h"
-#include "esc_ztw.h"
-#include "fuel_meter.h"
+#include "format.h"
 #include "gps.h"
 #include "hardware/i2c.h"
 #include "hardware/irq.h"
 #include "ibus.h"
-#include "ms5611.h"
-#include "ntc.h"
 #include "pico/stdlib.h"
-#include "pwm_out.h"
-#include "smart_esc.h"
+#include "sensor_registry.h"
 #include "stdlib.h"
 #include "string.h"
 #include "uart.h"
 #include "uart_pio.h"
 #include "voltage.h"
-#include "xgzp68xxd.h"
 
 #define HOTT_VARIO_MODULE_ID 0x89
 #define HOTT_GPS_MODULE_ID 0x8A
@@ -397,7 +380,6 @@ typedef struct hott_sensors_t {
 
 typedef struct vario_alarm_parameters_t {
     float *altitude;
-    float *vspd;
     float m1s;
     float m3s;
     float m10s;
@@ -440,6 +422,7 @@ static void process(hott_sensors_t *sensors) {
 }
 
 static void format_packet(hott_sensors_t *sensors, uint8_t address) {
+    sensor_registry_snapshot();
     // packet in little endian
     switch (address) {
         case HOTT_VARIO_MODULE_ID: {
@@ -560,14 +543,14 @@ static void format_packet(hott_sensors_t *sensors, uint8_t address) {
             packet.sensorTextID = HOTT_GPS_SENSOR_ID;
             packet.flightDirection = *sensors->gps[HOTT_GPS_DIRECTION] / 2;  // 0.5°
             packet.GPSSpeed = *sensors->gps[HOTT_GPS_SPEED];                 // km/h
-            packet.LatitudeNS = sensors->gps[HOTT_GPS_LATITUDE] > 0 ? 0 : 1;
-            float latitude = fabs(*sensors->gps[HOTT_GPS_LATITUDE]);
-            packet.LatitudeDegMin = (uint)latitude * 100 + (latitude - (uint)latitude) * 60;
-            packet.LatitudeSec = (latitude * 60 - (uint)(latitude * 60)) * 60;
-            packet.longitudeEW = sensors->gps[HOTT_GPS_LATITUDE] > 0 ? 0 : 1;
-            float longitude = fabs(*sensors->gps[HOTT_GPS_LONGITUDE]);
-            packet.longitudeDegMin = (uint)longitude * 100 + (longitude - (uint)longitude) * 60;
-            packet.longitudeSec = (longitude * 60 - (uint)(longitude * 60)) * 60;
+            packet.LatitudeNS = *sensors->gps[HOTT_GPS_LATITUDE] > 0 ? 0 : 1;
+            uint32_t latitude = format_minutes(*sensors->gps[HOTT_GPS_LATITUDE]);
+            packet.LatitudeDegMin = format_ddmm(latitude);
+            packet.LatitudeSec = latitude % 10000;  // 1/10000 minutes
+            packet.longitudeEW = *sensors->gps[HOTT_GPS_LONGITUDE] > 0 ? 0 : 1;
+            uint32_t longitude = format_minutes(*sensors->gps[HOTT_GPS_LONGITUDE]);
+            packet.longitudeDegMin = format_ddmm(longitude);
+            packet.longitudeSec = longitude % 10000;
             packet.distance = *sensors->gps[HOTT_GPS_DISTANCE];
             packet.altitude = *sensors->gps[HOTT_GPS_ALTITUDE];
             float climbrate = *sensors->gps[HOTT_GPS_CLIMBRATE] * 100 + 30000;
@@ -621,465 +604,197 @@ static uint8_t get_crc(const uint8_t *buffer, uint len) {
 
 static void set_config(hott_sensors_t *sensors) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
+    sensor_values_t *values = sensor_registry_start(config);
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature_fet;
-        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = parameter.temperature_bec;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = &values->esc.temperature_bec;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature_fet;
-        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = parameter.temperature_bec;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = parameter.voltage_bec;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_BEC_CURRENT] = parameter.current_bec;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
-        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = parameter.temperature_motor;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = &values->esc.temperature_bec;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = &values->esc.voltage_bec;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_BEC_CURRENT] = &values->esc.current_bec;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
+        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = &values->esc.temperature_motor;
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = parameter.voltage_bec;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_BEC_CURRENT] = parameter.current_bec;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
-        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = parameter.consumption;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = &values->esc.voltage_bec;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_BEC_CURRENT] = &values->esc.current_bec;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
+        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = &values->esc.consumption;
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature_fet;
-        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = parameter.temperature_bec;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = parameter.voltage_bec;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_BEC_CURRENT] = parameter.current_bec;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = &values->esc.temperature_bec;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = &values->esc.voltage_bec;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_BEC_CURRENT] = &values->esc.current_bec;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
     }
     if (config->esc_protocol == ESC_SMART) {
-        smart_esc_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temperature_fet = malloc(sizeof(float));
-        parameter.temperature_bec = malloc(sizeof(float));
-        parameter.voltage_bec = malloc(sizeof(float));
-        parameter.current_bec = malloc(sizeof(float));
-        parameter.temperature_bat = malloc(sizeof(float));
-        parameter.current_bat = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        for (uint i = 0; i < 18; i++) parameter.cell[i] = malloc(sizeof(float));
-        parameter.cells = malloc(sizeof(uint8_t));
-        parameter.cycles = malloc(sizeof(uint16_t));
-        xTaskCreate(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temperature_fet;
-        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = parameter.temperature_bec;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = parameter.voltage_bec;
-        sensors->esc[HOTT_ESC_BEC_CURRENT] = parameter.current_bec;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_BEC_TEMPERATURE] = &values->esc.temperature_bec;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_BEC_VOLTAGE] = &values->esc.voltage_bec;
+        sensors->esc[HOTT_ESC_BEC_CURRENT] = &values->esc.current_bec;
 
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_TEMP_1] = parameter.temperature_bat;
-        sensors->general_air[HOTT_GENERAL_CURRENT] = parameter.current_bat;
-        sensors->general_air[HOTT_GENERAL_CAPACITY] = parameter.consumption;
-        sensors->general_air[HOTT_GENERAL_CELL_1] = parameter.cell[0];
-        sensors->general_air[HOTT_GENERAL_CELL_2] = parameter.cell[1];
-        sensors->general_air[HOTT_GENERAL_CELL_3] = parameter.cell[2];
-        sensors->general_air[HOTT_GENERAL_CELL_4] = parameter.cell[3];
-        sensors->general_air[HOTT_GENERAL_CELL_5] = parameter.cell[4];
-        sensors->general_air[HOTT_GENERAL_CELL_6] = parameter.cell[5];
+        sensors->general_air[HOTT_GENERAL_TEMP_1] = &values->esc.temperature_bat;
+        sensors->general_air[HOTT_GENERAL_CURRENT] = &values->esc.current_bat;
+        sensors->general_air[HOTT_GENERAL_CAPACITY] = &values->esc.consumption;
+        sensors->general_air[HOTT_GENERAL_CELL_1] = &values->esc.cell[0];
+        sensors->general_air[HOTT_GENERAL_CELL_2] = &values->esc.cell[1];
+        sensors->general_air[HOTT_GENERAL_CELL_3] = &values->esc.cell[2];
+        sensors->general_air[HOTT_GENERAL_CELL_4] = &values->esc.cell[3];
+        sensors->general_air[HOTT_GENERAL_CELL_5] = &values->esc.cell[4];
+        sensors->general_air[HOTT_GENERAL_CELL_6] = &values->esc.cell[5];
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temp_esc;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
-        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = parameter.temp_motor;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
+        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = &values->esc.temperature_motor;
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_ztw_task", STACK_ESC_ZTW, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_RPM] = parameter.rpm;
-        sensors->esc[HOTT_ESC_TEMPERATURE] = parameter.temp_esc;
-        sensors->esc[HOTT_ESC_VOLTAGE] = parameter.voltage;
-        sensors->esc[HOTT_ESC_CURRENT] = parameter.current;
-        sensors->esc[HOTT_ESC_CAPACITY] = parameter.consumption;
-        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = parameter.temp_motor;
+        sensors->esc[HOTT_ESC_RPM] = &values->esc.rpm;
+        sensors->esc[HOTT_ESC_TEMPERATURE] = &values->esc.temperature_fet;
+        sensors->esc[HOTT_ESC_VOLTAGE] = &values->esc.voltage;
+        sensors->esc[HOTT_ESC_CURRENT] = &values->esc.current;
+        sensors->esc[HOTT_ESC_CAPACITY] = &values->esc.consumption;
+        sensors->esc[HOTT_ESC_EXT_TEMPERATURE] = &values->esc.temperature_motor;
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_GPS] = true;
-        sensors->gps[HOTT_GPS_LATITUDE] = parameter.lat;
-        sensors->gps[HOTT_GPS_LONGITUDE] = parameter.lon;
-        sensors->gps[HOTT_GPS_SATS] = parameter.sat;
-        sensors->gps[HOTT_GPS_FIX] = parameter.fix;
-        sensors->gps[HOTT_GPS_ALTITUDE] = parameter.alt;
-        sensors->gps[HOTT_GPS_SPEED] = parameter.spd_kmh;
-        sensors->gps[HOTT_GPS_DIRECTION] = parameter.cog;
-        sensors->gps[HOTT_GPS_DISTANCE] = parameter.dist;
-        sensors->gps[HOTT_GPS_CLIMBRATE] = parameter.vspeed;
-        sensors->gps[HOTT_GPS_TIME] = parameter.time;
-        sensors->gps[HOTT_GPS_TIME] = parameter.time;
-        sensors->gps[HOTT_GPS_TIME] = parameter.time;
+        sensors->gps[HOTT_GPS_LATITUDE] = &values->gps.lat;
+        sensors->gps[HOTT_GPS_LONGITUDE] = &values->gps.lon;
+        sensors->gps[HOTT_GPS_SATS] = &values->gps.sat;
+        sensors->gps[HOTT_GPS_FIX] = &values->gps.fix;
+        sensors->gps[HOTT_GPS_ALTITUDE] = &values->gps.alt;
+        sensors->gps[HOTT_GPS_SPEED] = &values->gps.spd_kmh;
+        sensors->gps[HOTT_GPS_DIRECTION] = &values->gps.cog;
+        sensors->gps[HOTT_GPS_DISTANCE] = &values->gps.dist;
+        sensors->gps[HOTT_GPS_CLIMBRATE] = &values->gps.vspeed;
+        sensors->gps[HOTT_GPS_TIME] = &values->gps.time;
+        sensors->gps[HOTT_GPS_TIME] = &values->gps.time;
+        sensors->gps[HOTT_GPS_TIME] = &values->gps.time;
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_BATTERY_1] = parameter.voltage;
+        sensors->general_air[HOTT_GENERAL_BATTERY_1] = &values->analog.voltage;
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_CURRENT] = parameter.current;
-        sensors->general_air[HOTT_GENERAL_CAPACITY] = parameter.consumption;
+        sensors->general_air[HOTT_GENERAL_CURRENT] = &values->analog.current;
+        sensors->general_air[HOTT_GENERAL_CAPACITY] = &values->analog.consumption;
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_TEMP_1] = parameter.ntc;
+        sensors->general_air[HOTT_GENERAL_TEMP_1] = &values->analog.ntc;
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_ESC] = true;
-        sensors->esc[HOTT_ESC_SPEED] = parameter.airspeed;
+        sensors->esc[HOTT_ESC_SPEED] = &values->analog.airspeed;
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         sensors->is_enabled[HOTT_TYPE_VARIO] = true;
-        sensors->vario[HOTT_VARIO_ALTITUDE] = parameter.altitude;
-        sensors->vario[HOTT_VARIO_M1S] = parameter.vspeed;
+        sensors->vario[HOTT_VARIO_ALTITUDE] = &values->baro.altitude;
+        sensors->vario[HOTT_VARIO_M1S] = &values->baro.vspeed;
         
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_ALTITUDE] = parameter.altitude;
-        sensors->general_air[HOTT_GENERAL_CLIMBRATE] = parameter.vspeed;
+        sensors->general_air[HOTT_GENERAL_ALTITUDE] = &values->baro.altitude;
+        sensors->general_air[HOTT_GENERAL_CLIMBRATE] = &values->baro.vspeed;
 
-        vario_alarm_parameters.altitude = parameter.altitude;
+        vario_alarm_parameters.altitude = &values->baro.altitude;
 
         add_alarm_in_ms(1000, interval_1000_callback, &vario_alarm_parameters, false);
         add_alarm_in_ms(3000, interval_3000_callback, &vario_alarm_parameters, false);
         add_alarm_in_ms(10000, interval_10000_callback, &vario_alarm_parameters, false);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         sensors->is_enabled[HOTT_TYPE_VARIO] = true;
-        sensors->vario[HOTT_VARIO_ALTITUDE] = parameter.altitude;
-        sensors->vario[HOTT_VARIO_M1S] = parameter.vspeed;
+        sensors->vario[HOTT_VARIO_ALTITUDE] = &values->baro.altitude;
+        sensors->vario[HOTT_VARIO_M1S] = &values->baro.vspeed;
         
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_ALTITUDE] = parameter.altitude;
-        sensors->general_air[HOTT_GENERAL_CLIMBRATE] = parameter.vspeed;
+        sensors->general_air[HOTT_GENERAL_ALTITUDE] = &values->baro.altitude;
+        sensors->general_air[HOTT_GENERAL_CLIMBRATE] = &values->baro.vspeed;
 
-        vario_alarm_parameters.altitude = parameter.altitude;
+        vario_alarm_parameters.altitude = &values->baro.altitude;
 
         add_alarm_in_ms(1000, interval_1000_callback, &vario_alarm_parameters, false);
         add_alarm_in_ms(3000, interval_3000_callback, &vario_alarm_parameters, false);
         add_alarm_in_ms(10000, interval_10000_callback, &vario_alarm_parameters, false);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         sensors->is_enabled[HOTT_TYPE_VARIO] = true;
-        sensors->vario[HOTT_VARIO_ALTITUDE] = parameter.altitude;
-        sensors->vario[HOTT_VARIO_M1S] = parameter.vspeed;
+        sensors->vario[HOTT_VARIO_ALTITUDE] = &values->baro.altitude;
+        sensors->vario[HOTT_VARIO_M1S] = &values->baro.vspeed;
         
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_ALTITUDE] = parameter.altitude;
-        sensors->general_air[HOTT_GENERAL_CLIMBRATE] = parameter.vspeed;
+        sensors->general_air[HOTT_GENERAL_ALTITUDE] = &values->baro.altitude;
+        sensors->general_air[HOTT_GENERAL_CLIMBRATE] = &values->baro.vspeed;
 
-        vario_alarm_parameters.altitude = parameter.altitude;
+        vario_alarm_parameters.altitude = &values->baro.altitude;
 
         add_alarm_in_ms(1000, interval_1000_callback, &vario_alarm_parameters, false);
         add_alarm_in_ms(3000, interval_3000_callback, &vario_alarm_parameters, false);
         add_alarm_in_ms(10000, interval_10000_callback, &vario_alarm_parameters, false);
     }
     if (config->enable_fuel_flow) {
-        fuel_meter_parameters_t parameter = {config->fuel_flow_ml_per_pulse, malloc(sizeof(float)),
-                                             malloc(sizeof(float))};
-        xTaskCreate(fuel_meter_task, "fuel_meter_task", STACK_FUEL_METER, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_FUEL] = parameter.consumption_total;
+        sensors->general_air[HOTT_GENERAL_FUEL] = &values->fuel.consumption_total;
     }
     if (config->enable_fuel_pressure) {
-        xgzp68xxd_parameters_t parameter = {config->xgzp68xxd_k, malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(xgzp68xxd_task, "fuel_pressure_task", STACK_FUEL_PRESSURE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         sensors->is_enabled[HOTT_TYPE_GENERAL] = true;
-        sensors->general_air[HOTT_GENERAL_PRESSURE] = parameter.pressure;
+        sensors->general_air[HOTT_GENERAL_PRESSURE] = &values->fuel.pressure;
     }
 }
 
@@ -1098,7 +813,6 @@ static int64_t interval_3000_callback(alarm_id_t id, void *parameters) {
     vario_alarm_parameters_t *parameter = (vario_alarm_parameters_t *)parameters;
     static float prev = 0;
     parameter->m3s = (*parameter->altitude - prev) * 100 + 30000;
-    *parameter->vspd = parameter->m3s / 3.0F;
 #ifdef SIM_SENSORS
     vario_alarm_parameters.m3s = 34 * 100 + 30000;
 #endif
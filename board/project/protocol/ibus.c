@@ -4,29 +4,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
 #include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_pwm.h"
-#include "ms5611.h"
-#include "gps.h"
-#include "ntc.h"
-#include "pwm_out.h"
+#include "pool.h"
+#include "sensor_registry.h"
 #include "uart.h"
 #include "uart_pio.h"
 #include "voltage.h"
-#include "smart_esc.h"
-#include "esc_omp_m4.h"
-#include "esc_ztw.h"
 
 /* Flysky IBUS Data Id */
 #define IBUS_ID_VOLTAGE 0x00       // Internal Voltage
@@ -150,6 +134,7 @@ static void process(sensor_ibus_t **sensor) {
 }
 
 static void send_packet(uint8_t command, uint8_t address, sensor_ibus_t *sensor) {
+    sensor_registry_snapshot();
     uint8_t *u8_p = NULL;
     uint16_t crc = 0;
     uint16_t type;
@@ -261,573 +246,326 @@ static void set_config(sensor_ibus_t **sensor, uint16_t sensormask) {
     - TODO: dinamically set the sensor address to allocate an additional sensor in receivers with only one sensor masked
    */
     config_t *config = config_read();
-    TaskHandle_t task_handle;
+    sensor_values_t *values = sensor_registry_start(config);
     sensor_ibus_t *new_sensor;
-    float *baro_temp = NULL, *baro_pressure = NULL;
-    new_sensor = malloc(sizeof(sensor_ibus_t));
+    new_sensor = pool_alloc(sizeof(sensor_ibus_t));
     *new_sensor = (sensor_ibus_t){IBUS_ID_END, 0, NULL};
     add_sensor(new_sensor, sensor, sensormask);
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
+        add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_bec};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
         add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_bec};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
         add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
         add_sensor(new_sensor, sensor, sensormask);
 
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.ripple_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.ripple_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage_bec};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current_bec};
         add_sensor(new_sensor, sensor, sensormask);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage_bec};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current_bec};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_bec};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_bec};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_SMART) {
-        smart_esc_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temperature_fet = malloc(sizeof(float));
-        parameter.temperature_bec = malloc(sizeof(float));
-        parameter.voltage_bec = malloc(sizeof(float));
-        parameter.current_bec = malloc(sizeof(float));
-        parameter.temperature_bat = malloc(sizeof(float));
-        parameter.current_bat = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        for (uint i = 0; i < 18; i++) parameter.cell[i] = malloc(sizeof(float));
-        parameter.cells = malloc(sizeof(uint8_t));
-        parameter.cycles = malloc(sizeof(uint16_t));
-        xTaskCreate(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage_bec};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current_bec};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_fet};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature_bec};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage_bec};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current_bec};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_bec};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
+        add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temp_esc};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temp_motor};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_motor};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
+        add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_ztw_task, "esc_ztw_task", STACK_ESC_ZTW, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, parameter.rpm};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temp_esc};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temp_motor};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, parameter.cell_voltage};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_MOT, IBUS_TYPE_U16, &values->esc.rpm};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->esc.voltage};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->esc.current};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_fet};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->esc.temperature_motor};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CELL_VOLTAGE, IBUS_TYPE_U16, &values->esc.cell_voltage};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->esc.consumption};
+        add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_STATUS, IBUS_TYPE_U16, parameter.sat};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_LAT, IBUS_TYPE_S32, parameter.lat};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_LON, IBUS_TYPE_S32, parameter.lon};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_ALT, IBUS_TYPE_S32, parameter.alt};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_SPE, IBUS_TYPE_U16, parameter.spd};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_COG, IBUS_TYPE_U16, parameter.cog};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, parameter.vspeed};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_DIST, IBUS_TYPE_U16, parameter.dist};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_STATUS, IBUS_TYPE_U16, &values->gps.sat};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_LAT, IBUS_TYPE_S32, &values->gps.lat};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_LON, IBUS_TYPE_S32, &values->gps.lon};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_ALT, IBUS_TYPE_S32, &values->gps.alt};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_SPE, IBUS_TYPE_U16, &values->gps.spd};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_COG, IBUS_TYPE_U16, &values->gps.cog};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, &values->gps.vspeed};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_GPS_DIST, IBUS_TYPE_U16, &values->gps.dist};
         add_sensor(new_sensor, sensor, sensormask);
         if (config->ibus_alternative_coordinates) {
-            new_sensor = malloc(sizeof(sensor_ibus_t));
-            *new_sensor = (sensor_ibus_t){IBUS_ID_S84, IBUS_TYPE_S32, parameter.lat};
+            new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+            *new_sensor = (sensor_ibus_t){IBUS_ID_S84, IBUS_TYPE_S32, &values->gps.lat};
             add_sensor(new_sensor, sensor, sensormask);
-            new_sensor = malloc(sizeof(sensor_ibus_t));
-            *new_sensor = (sensor_ibus_t){IBUS_ID_S85, IBUS_TYPE_S32, parameter.lon};
+            new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+            *new_sensor = (sensor_ibus_t){IBUS_ID_S85, IBUS_TYPE_S32, &values->gps.lon};
             add_sensor(new_sensor, sensor, sensormask);
         }
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, parameter.voltage};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_EXTV, IBUS_TYPE_U16, &values->analog.voltage};
+        add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, parameter.current};
-        add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, parameter.consumption};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_BAT_CURR, IBUS_TYPE_U16, &values->analog.current};
+        add_sensor(new_sensor, sensor, sensormask);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_FUEL, IBUS_TYPE_U16, &values->analog.consumption};
+        add_sensor(new_sensor, sensor, sensormask);
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.ntc};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->analog.ntc};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->baro.temperature};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_ALT, IBUS_TYPE_S32, parameter.altitude};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_ALT, IBUS_TYPE_S32, &values->baro.altitude};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, &values->baro.vspeed};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->baro.temperature};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_ALT, IBUS_TYPE_S32, parameter.altitude};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_ALT, IBUS_TYPE_S32, &values->baro.altitude};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, &values->baro.vspeed};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_TEMPERATURE, IBUS_TYPE_U16, &values->baro.temperature};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_ALT, IBUS_TYPE_S32, parameter.altitude};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_ALT, IBUS_TYPE_S32, &values->baro.altitude};
         add_sensor(new_sensor, sensor, sensormask);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_CLIMB_RATE, IBUS_TYPE_S16, &values->baro.vspeed};
         add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_ibus_t));
-        *new_sensor = (sensor_ibus_t){IBUS_ID_SPE, IBUS_TYPE_U16, parameter.airspeed};
-        add_sensor(new_sensor, sensor, sensormask);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        new_sensor = pool_alloc(sizeof(sensor_ibus_t));
+        *new_sensor = (sensor_ibus_t){IBUS_ID_SPE, IBUS_TYPE_U16, &values->analog.airspeed};
+        add_sensor(new_sensor, sensor, sensormask);
     }
 }
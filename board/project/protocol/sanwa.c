@@ -3,29 +3,14 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
 #include "crsf.h"
-#include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_pwm.h"
 #include "hardware/clocks.h"
 #include "hardware/pwm.h"
 #include "ibus.h"
-#include "ms5611.h"
-#include "ntc.h"
-#include "pwm_out.h"
+#include "sensor_registry.h"
 #include "uart.h"
 #include "uart_pio.h"
-#include "voltage.h"
 
 #define SANWA_TIMEOUT_US 500
 
@@ -102,6 +87,7 @@ static void process(float **sensors) {
 }
 
 static void send_packet(float **sensors) {
+    sensor_registry_snapshot();
     if (!sensors[TYPE_TEMP_MOTOR] && !sensors[TYPE_TEMP_ESC] && !sensors[TYPE_RPM1] && !sensors[TYPE_RPM2] &&
         !sensors[TYPE_VOLT])
         return;
@@ -171,160 +157,59 @@ static uint8_t get_crc(const uint8_t *buffer, uint len) {
 
 static void set_config(float **sensors) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
+    sensor_values_t *values = sensor_registry_start(config);
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_RPM1] = parameter.rpm;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        /*if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }*/
-        sensors[TYPE_TEMP_ESC] = parameter.temperature_fet;
-        sensors[TYPE_TEMP_MOTOR] = parameter.temperature_bec;  // note this is bec temp, not motor temp
-        sensors[TYPE_VOLT] = parameter.voltage;
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_TEMP_ESC] = &values->esc.temperature_fet;
+        sensors[TYPE_TEMP_MOTOR] = &values->esc.temperature_bec;  // note this is bec temp, not motor temp
+        sensors[TYPE_VOLT] = &values->esc.voltage;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_TEMP_ESC] = parameter.temperature_fet;
-        sensors[TYPE_TEMP_MOTOR] = parameter.temperature_bec;  // note this is bec temp, not motor temp
-        sensors[TYPE_VOLT] = parameter.voltage;
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_TEMP_ESC] = &values->esc.temperature_fet;
+        sensors[TYPE_TEMP_MOTOR] = &values->esc.temperature_bec;  // note this is bec temp, not motor temp
+        sensors[TYPE_VOLT] = &values->esc.voltage;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_TEMP_ESC] = parameter.temperature;
-        sensors[TYPE_VOLT] = parameter.voltage;
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_TEMP_ESC] = &values->esc.temperature_fet;
+        sensors[TYPE_VOLT] = &values->esc.voltage;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_TEMP_ESC] = parameter.temperature_fet;
-        sensors[TYPE_TEMP_MOTOR] = parameter.temperature_bec;  // note this is bec temp, not motor temp
-        sensors[TYPE_VOLT] = parameter.voltage;
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_TEMP_ESC] = &values->esc.temperature_fet;
+        sensors[TYPE_TEMP_MOTOR] = &values->esc.temperature_bec;  // note this is bec temp, not motor temp
+        sensors[TYPE_VOLT] = &values->esc.voltage;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_TEMP_ESC] = parameter.temperature;
-        sensors[TYPE_VOLT] = parameter.voltage;
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_TEMP_ESC] = &values->esc.temperature_fet;
+        sensors[TYPE_VOLT] = &values->esc.voltage;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_TEMP_ESC] = parameter.temperature;
-        sensors[TYPE_VOLT] = parameter.voltage;
-        sensors[TYPE_RPM1] = parameter.rpm;
-        sensors[TYPE_RPM2] = parameter.rpm;
+        sensors[TYPE_TEMP_ESC] = &values->esc.temperature_fet;
+        sensors[TYPE_VOLT] = &values->esc.voltage;
+        sensors[TYPE_RPM1] = &values->esc.rpm;
+        sensors[TYPE_RPM2] = &values->esc.rpm;
     }
 
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_VOLT] = parameter.voltage;
+        sensors[TYPE_VOLT] = &values->analog.voltage;
     }
 
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensors[TYPE_TEMP_MOTOR] = parameter.ntc;
+        sensors[TYPE_TEMP_MOTOR] = &values->analog.ntc;
     }
 }
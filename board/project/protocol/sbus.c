@@ -4,26 +4,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
 #include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_omp_m4.h"
-#include "esc_pwm.h"
-#include "esc_ztw.h"
-#include "gps.h"
-#include "ms5611.h"
-#include "ntc.h"
-#include "pwm_out.h"
-#include "smart_esc.h"
+#include "pool.h"
+#include "sensor_registry.h"
 #include "uart.h"
 #include "uart_pio.h"
 #include "voltage.h"
@@ -185,6 +169,7 @@ static int64_t send_slot_callback(alarm_id_t id, void *parameters) {
 }
 
 static inline void send_slot(uint8_t slot) {
+    sensor_registry_snapshot();
     debug(" (%u)", slot);
     uint16_t value = 0;
     if (sbus_sensor[slot]) {
@@ -284,567 +269,310 @@ static void add_sensor(uint8_t slot, sensor_sbus_t *new_sensor) { sbus_sensor[sl
 
 static void set_config(void) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
+    sensor_values_t *values = sensor_registry_start(config);
     sensor_sbus_t *new_sensor;
-    float *baro_temp = NULL, *baro_pressure = NULL;
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_bec};
         add_sensor(SLOT_TEMP2, new_sensor);
         // new_sensor = malloc(sizeof(sensor_sbus_t));
-        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, parameter.cell_voltage};
+        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, &values->esc.cell_voltage};
         // add_sensor(new_sensor);
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_bec};
         add_sensor(SLOT_TEMP2, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage_bec};
         add_sensor(SLOT_POWER_VOLT3, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current_bec};
         add_sensor(SLOT_POWER_CURR3, new_sensor);
         // new_sensor = malloc(sizeof(sensor_sbus_t));
-        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, parameter.cell_voltage};
+        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, &values->esc.cell_voltage};
         // add_sensor(new_sensor);
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage_bec};
         add_sensor(SLOT_POWER_VOLT3, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current_bec};
         add_sensor(SLOT_POWER_CURR3, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
         // new_sensor = malloc(sizeof(sensor_sbus_t));
-        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, parameter.cell_voltage};
+        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, &values->esc.cell_voltage};
         // add_sensor(new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage_bec};
         add_sensor(SLOT_POWER_VOLT3, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current_bec};
         add_sensor(SLOT_POWER_CURR3, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS3, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_bec};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_bec};
         add_sensor(SLOT_TEMP2, new_sensor);
         // new_sensor = malloc(sizeof(sensor_sbus_t));
-        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, parameter.cell_voltage};
+        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, &values->esc.cell_voltage};
         // add_sensor(new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
         // new_sensor = malloc(sizeof(sensor_sbus_t));
-        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, parameter.cell_voltage};
+        //*new_sensor = (sensor_sbus_t){AFHDS2A_ID_CELL_VOLTAGE, &values->esc.cell_voltage};
         // add_sensor(new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_SMART) {
-        smart_esc_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temperature_fet = malloc(sizeof(float));
-        parameter.temperature_bec = malloc(sizeof(float));
-        parameter.voltage_bec = malloc(sizeof(float));
-        parameter.current_bec = malloc(sizeof(float));
-        parameter.temperature_bat = malloc(sizeof(float));
-        parameter.current_bat = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        for (uint i = 0; i < 18; i++) parameter.cell[i] = malloc(sizeof(float));
-        parameter.cells = malloc(sizeof(uint8_t));
-        parameter.cycles = malloc(sizeof(uint16_t));
-        xTaskCreate(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temperature_fet};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temp_esc};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temp_motor};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_motor};
         add_sensor(SLOT_TEMP2, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_ztw_task, "esc_ztw_task", STACK_ESC_ZTW, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_RPM, parameter.rpm};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_RPM, &values->esc.rpm};
         add_sensor(SLOT_RPM, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, parameter.voltage};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, &values->esc.voltage};
         add_sensor(SLOT_POWER_VOLT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->esc.current};
         add_sensor(SLOT_POWER_CURR1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->esc.consumption};
         add_sensor(SLOT_POWER_CONS1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temp_esc};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_fet};
         add_sensor(SLOT_TEMP1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.temp_motor};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->esc.temperature_motor};
         add_sensor(SLOT_TEMP2, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_LATITUDE1, parameter.lat};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_LATITUDE1, &values->gps.lat};
         add_sensor(SLOT_GPS_LAT1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_LATITUDE2, parameter.lat};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_LATITUDE2, &values->gps.lat};
         add_sensor(SLOT_GPS_LAT2, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_LONGITUDE1, parameter.lon};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_LONGITUDE1, &values->gps.lon};
         add_sensor(SLOT_GPS_LON1, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_LONGITUDE2, parameter.lon};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_LONGITUDE2, &values->gps.lon};
         add_sensor(SLOT_GPS_LON2, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_ALTITUDE, parameter.alt};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_ALTITUDE, &values->gps.alt};
         add_sensor(SLOT_GPS_ALT, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_SPEED, parameter.spd};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_SPEED, &values->gps.spd};
         add_sensor(SLOT_GPS_SPD, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_VARIO_SPEED, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_VARIO_SPEED, &values->gps.vspeed};
         add_sensor(SLOT_GPS_VARIO, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_GPS_TIME, parameter.time};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_GPS_TIME, &values->gps.time};
         add_sensor(SLOT_GPS_TIME, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
         if (config->sbus_battery_slot) {
-            new_sensor = malloc(sizeof(sensor_sbus_t));
-            *new_sensor = (sensor_sbus_t){SBUS_VOLT_V1, parameter.voltage};
+            new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+            *new_sensor = (sensor_sbus_t){SBUS_VOLT_V1, &values->analog.voltage};
             add_sensor(SLOT_VOLT_V1, new_sensor);
 
-            new_sensor = malloc(sizeof(sensor_sbus_t));
+            new_sensor = pool_alloc(sizeof(sensor_sbus_t));
             *new_sensor = (sensor_sbus_t){SBUS_VOLT_V2, NULL};
             add_sensor(SLOT_VOLT_V2, new_sensor);
         } else {
-            new_sensor = malloc(sizeof(sensor_sbus_t));
+            new_sensor = pool_alloc(sizeof(sensor_sbus_t));
             *new_sensor = (sensor_sbus_t){SBUS_VOLT_V1, NULL};
             add_sensor(SLOT_VOLT_V1, new_sensor);
 
-            new_sensor = malloc(sizeof(sensor_sbus_t));
-            *new_sensor = (sensor_sbus_t){SBUS_VOLT_V2, parameter.voltage};
+            new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+            *new_sensor = (sensor_sbus_t){SBUS_VOLT_V2, &values->analog.voltage};
             add_sensor(SLOT_VOLT_V2, new_sensor);
         }
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, parameter.current};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CURR, &values->analog.current};
         add_sensor(SLOT_POWER_CURR2, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, parameter.consumption};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_POWER_CONS, &values->analog.consumption};
         add_sensor(SLOT_POWER_CONS2, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
         *new_sensor = (sensor_sbus_t){SBUS_POWER_VOLT, NULL};
         add_sensor(SLOT_POWER_VOLT2, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_TEMP, parameter.ntc};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_TEMP, &values->analog.ntc};
         add_sensor(SLOT_TEMP1, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_VARIO_ALT, parameter.altitude};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_VARIO_ALT, &values->baro.altitude};
         add_sensor(SLOT_VARIO_ALT, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_VARIO_SPEED, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_VARIO_SPEED, &values->baro.vspeed};
         add_sensor(SLOT_VARIO_SPEED, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_VARIO_ALT, parameter.altitude};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_VARIO_ALT, &values->baro.altitude};
         add_sensor(SLOT_VARIO_ALT, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_VARIO_SPEED, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_VARIO_SPEED, &values->baro.vspeed};
         add_sensor(SLOT_VARIO_SPEED, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_VARIO_ALT, parameter.altitude};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_VARIO_ALT, &values->baro.altitude};
         add_sensor(SLOT_VARIO_ALT, new_sensor);
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_VARIO_SPEED, parameter.vspeed};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_VARIO_SPEED, &values->baro.vspeed};
         add_sensor(SLOT_VARIO_SPEED, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        new_sensor = malloc(sizeof(sensor_sbus_t));
-        *new_sensor = (sensor_sbus_t){SBUS_AIR_SPEED, parameter.airspeed};
+        new_sensor = pool_alloc(sizeof(sensor_sbus_t));
+        *new_sensor = (sensor_sbus_t){SBUS_AIR_SPEED, &values->analog.airspeed};
         add_sensor(SLOT_AIR_SPEED, new_sensor);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 }
@@ -1,32 +1,23 @@
 #include "smartport.h"
 
 #include <math.h>
-#include <semphr.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "airspeed.h"
-#include "bmp180.h"
 #include "bmp280.h"
 #include "config.h"
+#include "crc.h"
 #include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
 #include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_omp_m4.h"
-#include "esc_pwm.h"
-#include "esc_ztw.h"
-#include "fuel_meter.h"
+#include "format.h"
+#include "frame_builder.h"
 #include "gpio.h"
 #include "gps.h"
-#include "ms5611.h"
-#include "ntc.h"
-#include "pwm_out.h"
+#include "pool.h"
+#include "sensor_registry.h"
 #include "smart_esc.h"
+#include "smartport_scheduler.h"
 #include "stdlib.h"
 #include "uart.h"
 #include "uart_pio.h"
@@ -190,10 +181,34 @@ typedef struct smartport_sensor_cell_parameters_t {
 
 typedef struct smartport_sensor_cell_individual_parameters_t {
     uint8_t *cell_count;
-    float *cell_voltage[18];
+    float *cell_voltage;
     uint16_t rate;
 } smartport_sensor_cell_individual_parameters_t;
 
+typedef enum smartport_sensor_type_t {
+    SMARTPORT_SENSOR,
+    SMARTPORT_SENSOR_GPIO,
+    SMARTPORT_SENSOR_DOUBLE,
+    SMARTPORT_SENSOR_COORDINATES,
+    SMARTPORT_SENSOR_DATETIME,
+    SMARTPORT_SENSOR_CELL,
+    SMARTPORT_SENSOR_CELL_INDIVIDUAL,
+} smartport_sensor_type_t;
+
+typedef struct smartport_sensor_t {
+    smartport_sensor_type_t type;
+    uint8_t index;
+    union {
+        smartport_sensor_parameters_t sensor;
+        smartport_sensor_gpio_parameters_t gpio;
+        smartport_sensor_double_parameters_t sensor_double;
+        smartport_sensor_coordinate_parameters_t coordinate;
+        smartport_sensor_datetime_parameters_t datetime;
+        smartport_sensor_cell_parameters_t cell;
+        smartport_sensor_cell_individual_parameters_t cell_individual;
+    } parameter;
+} smartport_sensor_t;
+
 typedef struct smartport_packet_parameters_t {
     uint16_t data_id;
     QueueHandle_t queue_handle;
@@ -205,7 +220,8 @@ typedef struct smartport_packet_t {
     uint32_t value;
 } smartport_packet_t;
 
-static SemaphoreHandle_t semaphore_sensor = NULL;
+static smartport_scheduler_t scheduler;
+static smartport_sensor_t sensors[SMARTPORT_SCHEDULER_MAX_SLOTS];
 static bool is_maintenance_mode = false;
 static const uint8_t sensor_id_matrix[29] = {0x00, 0xA1, 0x22, 0x83, 0xE4, 0x45, 0xC6, 0x67, 0x48, 0xE9,
                                              0x6A, 0xCB, 0xAC, 0xD,  0x8E, 0x2F, 0xD0, 0x71, 0xF2, 0x53,
@@ -214,12 +230,9 @@ static TaskHandle_t packet_task_handle;
 static QueueHandle_t packet_queue_handle;
 config_t *config_lua;
 
-static void sensor_task(void *parameters);
-static void sensor_void_task(void *parameters);
-static void sensor_double_task(void *parameters);
-static void sensor_coordinates_task(void *parameters);
-static void sensor_datetime_task(void *parameters);
-static void sensor_cell_task(void *parameters);
+static void add_sensor(smartport_sensor_type_t type, void *parameter);
+static void send_sensor_next(void);
+static bool send_sensor(smartport_sensor_t *sensor);
 static void packet_task(void *parameters);
 static void process(smartport_parameters_t *parameter);
 static void process_packet(smartport_parameters_t *parameter, uint8_t frame_id, uint16_t data_id, uint32_t value);
@@ -229,28 +242,26 @@ static uint32_t format_coordinate(coordinate_type_t type, float value);
 static uint32_t format_datetime(uint8_t type, uint32_t value);
 static uint32_t format_cell(uint8_t cell_index, float value);
 static void send_packet(uint8_t frame_id, uint16_t data_id, uint32_t value);
-static void send_byte(uint8_t c, uint16_t *crcp);
 static void set_config(smartport_parameters_t *parameter);
 static uint8_t sensor_id_to_crc(uint8_t sensor_id);
 static uint8_t sensor_crc_to_id(uint8_t sensor_id_crc);
 static uint8_t get_crc(uint8_t *data);
 static int64_t reboot_callback(alarm_id_t id, void *user_data);
+#ifdef SMARTPORT_POLL_LATENCY
+static void add_poll_latency(uint32_t latency);
+#endif
 
 void smartport_task(void *parameters) {
     smartport_parameters_t parameter;
     context.led_cycle_duration = 6;
     context.led_cycles = 1;
     uart0_begin(57600, UART_RECEIVER_TX, UART_RECEIVER_RX, TIMEOUT_US, 8, 1, UART_PARITY_NONE, true, true);
-    semaphore_sensor = xSemaphoreCreateBinary();
-    xSemaphoreTake(semaphore_sensor, 0);
+    smartport_scheduler_init(&scheduler);
     set_config(&parameter);
-    packet_queue_handle = xQueueCreate(32, sizeof(smartport_packet_t));
-    xTaskCreate(packet_task, "packet_task", STACK_SMARTPORT_PACKET_TASK, (void *)&parameter.data_id, 3,
-                &packet_task_handle);
+    packet_queue_handle = pool_queue_create(32, sizeof(smartport_packet_t));
+    pool_task_create(packet_task, "packet_task", STACK_SMARTPORT_PACKET_TASK, (void *)&parameter.data_id, 3,
+                     &packet_task_handle);
     xQueueSendToBack(context.tasks_queue_handle, packet_task_handle, 0);
-    // TaskHandle_t task_handle;
-    // xTaskCreate(sensor_void_task, "sensor_void_task", STACK_SMARTPORT_SENSOR_VOID_TASK, NULL, 2, &task_handle);
-    // xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
     debug("\nSmartport init");
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
@@ -274,9 +285,10 @@ static void process(smartport_parameters_t *parameter) {
                 if (/*is_maintenance_mode &&*/ uxQueueMessagesWaiting(packet_queue_handle)) {
                     xTaskNotifyGive(packet_task_handle);
                 } else if (!is_maintenance_mode) {
-                    xSemaphoreGive(semaphore_sensor);
-                    vTaskDelay(4 / portTICK_PERIOD_MS);
-                    xSemaphoreTake(semaphore_sensor, 0);
+#ifdef SMARTPORT_POLL_LATENCY
+                    add_poll_latency(uart0_get_time_elapsed());
+#endif
+                    send_sensor_next();
                 }
             } else if (lenght >= 10) {
                 uint8_t i;
@@ -904,127 +916,133 @@ static void process_packet(smartport_parameters_t *parameter, uint8_t frame_id,
 
 static int64_t reboot_callback(alarm_id_t id, void *user_data) { AIRCR_Register = 0x5FA0004; }
 
-static void sensor_task(void *parameters) {
-    smartport_sensor_parameters_t parameter = *(smartport_sensor_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        int32_t data_formatted = format(parameter.data_id, *parameter.value);
-        debug("\nSmartport. Sensor (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0x10, parameter.data_id, data_formatted);
-    }
-}
-
-static void sensor_gpio_task(void *parameters) {
-    smartport_sensor_gpio_parameters_t parameter = *(smartport_sensor_gpio_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    uint cont = 0;
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        if (parameter.gpio_mask) {
-            while (!(parameter.gpio_mask & (1 << cont))) {
-                cont++;
-                if (cont == 6) cont = 0;
-            }
-            float value = *parameter.value & (1 << cont) ? 1 : 0;
-            uint16_t data_id = parameter.data_id + 17 + cont;
-            int32_t data_formatted = format(data_id, value);
-            debug("\nSmartport. Sensor GPIO (%u) > GPIO: %u STATE: %u > ", uxTaskGetStackHighWaterMark(NULL), 17 + cont,
-                  (uint)value);
-            send_packet(0x10, data_id, data_formatted);
-            cont++;
-            if (cont == 6) cont = 0;
-        }
-    }
-}
-
-static void sensor_void_task(void *parameters) {
-    while (1) {
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        if (context.debug == 2) printf("\nSmartport. Sensor void (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0, 0, 0);
-    }
-}
-
-static void sensor_double_task(void *parameters) {
-    smartport_sensor_double_parameters_t parameter = *(smartport_sensor_double_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        uint32_t data_formatted = format_double(parameter.data_id, *parameter.value_l, *parameter.value_h);
-        debug("\nSmartport. Sensor double (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0x10, parameter.data_id, data_formatted);
-    }
-}
-
-static void sensor_coordinates_task(void *parameters) {
-    smartport_sensor_coordinate_parameters_t parameter = *(smartport_sensor_coordinate_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        uint32_t data_formatted;
-        if (parameter.type == SMARTPORT_LATITUDE)
-            data_formatted = format_coordinate(parameter.type, *parameter.latitude);
-        else
-            data_formatted = format_coordinate(parameter.type, *parameter.longitude);
-        parameter.type = !parameter.type;
-        debug("\nSmartport. Sensor coordinates (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0x10, GPS_LONG_LATI_FIRST_ID, data_formatted);
+static void add_sensor(smartport_sensor_type_t type, void *parameter) {
+    smartport_sensor_t sensor = {.type = type, .index = 0};
+    uint16_t rate = 0;
+    switch (type) {
+        case SMARTPORT_SENSOR:
+            sensor.parameter.sensor = *(smartport_sensor_parameters_t *)parameter;
+            rate = sensor.parameter.sensor.rate;
+            break;
+        case SMARTPORT_SENSOR_GPIO:
+            sensor.parameter.gpio = *(smartport_sensor_gpio_parameters_t *)parameter;
+            rate = sensor.parameter.gpio.rate;
+            break;
+        case SMARTPORT_SENSOR_DOUBLE:
+            sensor.parameter.sensor_double = *(smartport_sensor_double_parameters_t *)parameter;
+            rate = sensor.parameter.sensor_double.rate;
+            break;
+        case SMARTPORT_SENSOR_COORDINATES:
+            sensor.parameter.coordinate = *(smartport_sensor_coordinate_parameters_t *)parameter;
+            rate = sensor.parameter.coordinate.rate;
+            break;
+        case SMARTPORT_SENSOR_DATETIME:
+            sensor.parameter.datetime = *(smartport_sensor_datetime_parameters_t *)parameter;
+            rate = sensor.parameter.datetime.rate;
+            break;
+        case SMARTPORT_SENSOR_CELL:
+            sensor.parameter.cell = *(smartport_sensor_cell_parameters_t *)parameter;
+            rate = sensor.parameter.cell.rate;
+            break;
+        case SMARTPORT_SENSOR_CELL_INDIVIDUAL:
+            sensor.parameter.cell_individual = *(smartport_sensor_cell_individual_parameters_t *)parameter;
+            rate = sensor.parameter.cell_individual.rate;
+            break;
     }
-}
-
-static void sensor_datetime_task(void *parameters) {
-    smartport_sensor_datetime_parameters_t parameter = *(smartport_sensor_datetime_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        uint32_t data_formatted;
-        if (parameter.type == SMARTPORT_DATE)
-            data_formatted = format_datetime(parameter.type, *parameter.date);
-        else
-            data_formatted = format_datetime(parameter.type, *parameter.time);
-        parameter.type = !parameter.type;
-        debug("\nSmartport. Sensor datetime (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0x10, GPS_TIME_DATE_FIRST_ID, data_formatted);
+    int slot = smartport_scheduler_add(&scheduler, rate, time_us_32());
+    if (slot < 0) {
+        debug("\nSmartport. Sensor table full. Skip type %u", type);
+        return;
     }
+    sensors[slot] = sensor;
 }
 
-static void sensor_cell_task(void *parameters) {
-    smartport_sensor_cell_parameters_t parameter = *(smartport_sensor_cell_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    uint8_t cell_index = 0;
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        if (!*parameter.cell_count) return;
-        uint32_t data_formatted = format_cell(cell_index, *parameter.cell_voltage);
-        cell_index++;
-        if (cell_index > *parameter.cell_count - 1) cell_index = 0;
-        debug("\nSmartport. Sensor cell (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0x10, CELLS_FIRST_ID, data_formatted);
+static void send_sensor_next(void) {
+    sensor_registry_snapshot();
+    // a sensor with no data (e.g. no cells yet) gives the poll to the next overdue one
+    uint32_t now = time_us_32();
+    for (uint i = 0; i < scheduler.count; i++) {
+        int slot = smartport_scheduler_next(&scheduler, now);
+        if (slot < 0) return;
+        if (send_sensor(&sensors[slot])) return;
     }
 }
 
-static void sensor_cell_individual_task(void *parameters) {
-    smartport_sensor_cell_individual_parameters_t parameter =
-        *(smartport_sensor_cell_individual_parameters_t *)parameters;
-    xTaskNotifyGive(context.receiver_task_handle);
-    uint8_t cell_index = 0;
-    while (1) {
-        vTaskDelay(parameter.rate / portTICK_PERIOD_MS);
-        xSemaphoreTake(semaphore_sensor, portMAX_DELAY);
-        if (!*parameter.cell_count) return;
-        uint32_t data_formatted = format_cell(cell_index, *parameter.cell_voltage[cell_index]);
-        cell_index++;
-        if (cell_index > *parameter.cell_count - 1) cell_index = 0;
-        debug("\nSmartport. Sensor cell (%u) > ", uxTaskGetStackHighWaterMark(NULL));
-        send_packet(0x10, CELLS_FIRST_ID, data_formatted);
+static bool send_sensor(smartport_sensor_t *sensor) {
+    uint16_t data_id;
+    uint32_t data_formatted;
+    switch (sensor->type) {
+        case SMARTPORT_SENSOR: {
+            smartport_sensor_parameters_t *parameter = &sensor->parameter.sensor;
+            data_id = parameter->data_id;
+            data_formatted = format(data_id, *parameter->value);
+            break;
+        }
+        case SMARTPORT_SENSOR_GPIO: {
+            smartport_sensor_gpio_parameters_t *parameter = &sensor->parameter.gpio;
+            if (!(parameter->gpio_mask & 0b111111)) return false;
+            while (!(parameter->gpio_mask & (1 << sensor->index))) {
+                sensor->index++;
+                if (sensor->index == 6) sensor->index = 0;
+            }
+            float value = *parameter->value & (1 << sensor->index) ? 1 : 0;
+            data_id = parameter->data_id + 17 + sensor->index;
+            data_formatted = format(data_id, value);
+            sensor->index++;
+            if (sensor->index == 6) sensor->index = 0;
+            break;
+        }
+        case SMARTPORT_SENSOR_DOUBLE: {
+            smartport_sensor_double_parameters_t *parameter = &sensor->parameter.sensor_double;
+            data_id = parameter->data_id;
+            data_formatted = format_double(data_id, parameter->value_l ? *parameter->value_l : 0,
+                                           parameter->value_h ? *parameter->value_h : 0);
+            break;
+        }
+        case SMARTPORT_SENSOR_COORDINATES: {
+            smartport_sensor_coordinate_parameters_t *parameter = &sensor->parameter.coordinate;
+            data_id = GPS_LONG_LATI_FIRST_ID;
+            if (parameter->type == SMARTPORT_LATITUDE)
+                data_formatted = format_coordinate(parameter->type, *parameter->latitude);
+            else
+                data_formatted = format_coordinate(parameter->type, *parameter->longitude);
+            parameter->type = !parameter->type;
+            break;
+        }
+        case SMARTPORT_SENSOR_DATETIME: {
+            smartport_sensor_datetime_parameters_t *parameter = &sensor->parameter.datetime;
+            data_id = GPS_TIME_DATE_FIRST_ID;
+            if (parameter->type == SMARTPORT_DATE)
+                data_formatted = format_datetime(parameter->type, *parameter->date);
+            else
+                data_formatted = format_datetime(parameter->type, *parameter->time);
+            parameter->type = !parameter->type;
+            break;
+        }
+        case SMARTPORT_SENSOR_CELL: {
+            smartport_sensor_cell_parameters_t *parameter = &sensor->parameter.cell;
+            if (!*parameter->cell_count) return false;
+            if (sensor->index > *parameter->cell_count - 1) sensor->index = 0;
+            data_id = CELLS_FIRST_ID;
+            data_formatted = format_cell(sensor->index, *parameter->cell_voltage);
+            sensor->index++;
+            break;
+        }
+        case SMARTPORT_SENSOR_CELL_INDIVIDUAL: {
+            smartport_sensor_cell_individual_parameters_t *parameter = &sensor->parameter.cell_individual;
+            if (!*parameter->cell_count) return false;
+            if (sensor->index > *parameter->cell_count - 1) sensor->index = 0;
+            data_id = CELLS_FIRST_ID;
+            data_formatted = format_cell(sensor->index, parameter->cell_voltage[sensor->index]);
+            sensor->index++;
+            break;
+        }
+        default:
+            return false;
     }
+    debug("\nSmartport. Sensor 0x%X > ", data_id);
+    send_packet(0x10, data_id, data_formatted);
+    return true;
 }
 
 static void packet_task(void *parameters) {
@@ -1072,15 +1090,9 @@ static uint32_t format_double(uint16_t data_id, float value_l, float value_h) {
 }
 
 static uint32_t format_coordinate(coordinate_type_t type, float value) {
-    uint32_t data = 0;
-    if (value < 0) {
-        data |= (uint32_t)1 << 30;
-        value *= -1;
-    }
-    if (type == SMARTPORT_LONGITUDE) {
-        data |= (uint32_t)1 << 31;
-    }
-    data |= (uint32_t)(value * 60 * 10000);  // deg to min * 10000
+    uint32_t data = format_minutes(value);  // deg to min * 10000
+    if (value < 0) data |= (uint32_t)1 << 30;
+    if (type == SMARTPORT_LONGITUDE) data |= (uint32_t)1 << 31;
     return data;
 }
 
@@ -1096,924 +1108,457 @@ static uint32_t format_datetime(uint8_t type, uint32_t value) {
 
 static uint32_t format_cell(uint8_t cell_index, float value) { return cell_index | (uint16_t)round(value * 500) << 8; }
 
-static void send_byte(uint8_t c, uint16_t *crcp) {
-    if (crcp != NULL) {
-        uint16_t crc = *crcp;
-        crc += c;
-        crc += crc >> 8;
-        crc &= 0x00FF;
-        *crcp = crc;
-    }
-    if (c == 0x7D || c == 0x7E) {
-        uart0_write(c);
-        c ^= 0x20;
-    }
-    uart0_write(c);
-    debug("%X ", c);
-}
-
 static void send_packet(uint8_t frame_id, uint16_t data_id, uint32_t value) {
-    uint16_t crc = 0;
-    uint8_t *u8p;
-    // frame_id
-    send_byte(frame_id, &crc);
-    // data_id
-    u8p = (uint8_t *)&data_id;
-    send_byte(u8p[0], &crc);
-    send_byte(u8p[1], &crc);
-    // value
-    u8p = (uint8_t *)&value;
-    send_byte(u8p[0], &crc);
-    send_byte(u8p[1], &crc);
-    send_byte(u8p[2], &crc);
-    send_byte(u8p[3], &crc);
-    // crc
-    send_byte(0xFF - (uint8_t)crc, NULL);
+    uint8_t buffer[FRAME_BUILDER_SMARTPORT_MAX];
+    uint length = frame_builder_smartport(buffer, frame_id, data_id, value);
+    uart0_write_bytes(buffer, length);
+    debug_buffer(buffer, length, "%X ");
     // blink
     vTaskResume(context.led_task_handle);
 }
 
+#ifdef SMARTPORT_POLL_LATENCY
+/* Latency of the answers since the last poll byte, printed every SMARTPORT_POLL_LATENCY polls */
+static void add_poll_latency(uint32_t latency) {
+    static uint32_t min = UINT32_MAX, max = 0, count = 0;
+    static uint64_t sum = 0;
+    if (latency < min) min = latency;
+    if (latency > max) max = latency;
+    sum += latency;
+    if (++count < SMARTPORT_POLL_LATENCY) return;
+    debug("\nSmartport. Poll latency (us) min %u mean %u max %u jitter %u", min, (uint)(sum / count), max, max - min);
+    min = UINT32_MAX;
+    max = count = 0;
+    sum = 0;
+}
+#endif
+
 static void set_config(smartport_parameters_t *parameter) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
-    float *baro_temp = NULL, *baro_pressure = NULL;
+    sensor_values_t *values = sensor_registry_start(config);
     parameter->sensor_id = config->smartport_sensor_id;
     parameter->data_id = 0x5000;  // config->smartport_data_id;
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_double_parameters_t parameter_sensor_double;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
+        parameter_sensor_double.value_l = &values->esc.rpm;
         parameter_sensor_double.value_h = NULL;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_task", STACK_SENSOR_SMARTPORT_DOUBLE, (void *)&parameter_sensor_double,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_double_parameters_t parameter_sensor_double;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
+        parameter_sensor_double.value_l = &values->esc.rpm;
         parameter_sensor_double.value_h = NULL;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature_fet;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 1;
-        parameter_sensor.value = parameter.temperature_bec;
+        parameter_sensor.value = &values->esc.temperature_bec;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature_fet;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 1;
-        parameter_sensor.value = parameter.temperature_bec;
+        parameter_sensor.value = &values->esc.temperature_bec;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
 
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 2;
-        parameter_sensor.value = parameter.temperature_motor;
+        parameter_sensor.value = &values->esc.temperature_motor;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
 
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID + 1;
-        parameter_sensor_double.value_l = parameter.voltage_bec;
-        parameter_sensor_double.value_h = parameter.current_bec;
+        parameter_sensor_double.value_l = &values->esc.voltage_bec;
+        parameter_sensor_double.value_h = &values->esc.current_bec;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
 
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID + 1;
-        parameter_sensor_double.value_l = parameter.voltage_bec;
-        parameter_sensor_double.value_h = parameter.current_bec;
+        parameter_sensor_double.value_l = &values->esc.voltage_bec;
+        parameter_sensor_double.value_h = &values->esc.current_bec;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature_fet;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 1;
-        parameter_sensor.value = parameter.temperature_bec;
+        parameter_sensor.value = &values->esc.temperature_bec;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_SMART) {
-        smart_esc_parameters_t parameter;
-        parameter.calc_consumption = config->smart_esc_calc_consumption;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temperature_fet = malloc(sizeof(float));
-        parameter.temperature_bec = malloc(sizeof(float));
-        parameter.voltage_bec = malloc(sizeof(float));
-        parameter.current_bec = malloc(sizeof(float));
-        parameter.temperature_bat = malloc(sizeof(float));
-        parameter.current_bat = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        for (uint i = 0; i < 18; i++) parameter.cell[i] = malloc(sizeof(float));
-        parameter.cells = malloc(sizeof(uint8_t));
-        parameter.cycles = malloc(sizeof(uint16_t));
-        xTaskCreate(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_individual_parameters_t parameter_sensor_cell;
         // rpm & consumption
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         // voltage & current
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         // bec. voltage & current
         parameter_sensor_double.data_id = SBEC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage_bec;
-        parameter_sensor_double.value_h = parameter.current_bec;
+        parameter_sensor_double.value_l = &values->esc.voltage_bec;
+        parameter_sensor_double.value_h = &values->esc.current_bec;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         // temp_fet
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temperature_fet;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         // temp_bec
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 1;
-        parameter_sensor.value = parameter.temperature_bec;
+        parameter_sensor.value = &values->esc.temperature_bec;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         // temp_bat
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 2;
-        parameter_sensor.value = parameter.temperature_bat;
+        parameter_sensor.value = &values->esc.temperature_bat;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         // current_bat
         parameter_sensor.data_id = CURR_FIRST_ID + 1;
-        parameter_sensor.value = parameter.current_bat;
+        parameter_sensor.value = &values->esc.current_bat;
         parameter_sensor.rate = config->refresh_rate_current;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         // cells
-        parameter_sensor_cell.cell_count = parameter.cells;
-        for (uint i = 0; i < 18; i++) parameter_sensor_cell.cell_voltage[i] = parameter.cell[i];
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = values->esc.cell;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL_INDIVIDUAL, &parameter_sensor_cell);
         // cycles
         /*parameter_sensor.data_id = DIY_FIRST_ID + 100;
-        parameter_sensor.value = parameter.cycles;
+        parameter_sensor.value = &values->esc.cycles;
         parameter_sensor.rate = config->refresh_rate_default;
-        xTaskCreate(sensor_cell_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);*/
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor);*/
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temp_esc;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 2;
-        parameter_sensor.value = parameter.temp_motor;
+        parameter_sensor.value = &values->esc.temperature_motor;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_ztw_task, "esc_ztw_task", STACK_ESC_ZTW, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         smartport_sensor_double_parameters_t parameter_sensor_double;
         smartport_sensor_cell_parameters_t parameter_sensor_cell;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.rpm;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_l = &values->esc.rpm;
+        parameter_sensor_double.value_h = &values->esc.consumption;
         parameter_sensor_double.rate = config->refresh_rate_rpm;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor_double.data_id = ESC_POWER_FIRST_ID;
-        parameter_sensor_double.value_l = parameter.voltage;
-        parameter_sensor_double.value_h = parameter.current;
+        parameter_sensor_double.value_l = &values->esc.voltage;
+        parameter_sensor_double.value_h = &values->esc.current;
         parameter_sensor_double.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_double_task, "sensor_double_task", STACK_SENSOR_SMARTPORT_DOUBLE,
-                    (void *)&parameter_sensor_double, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.temp_esc;
+        parameter_sensor.value = &values->esc.temperature_fet;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID + 2;
-        parameter_sensor.value = parameter.temp_motor;
+        parameter_sensor.value = &values->esc.temperature_motor;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        parameter_sensor_cell.cell_count = parameter.cell_count;
-        parameter_sensor_cell.cell_voltage = parameter.cell_voltage;
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
+        parameter_sensor_cell.cell_count = &values->esc.cell_count;
+        parameter_sensor_cell.cell_voltage = &values->esc.cell_voltage;
         parameter_sensor_cell.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_cell_task, "sensor_cell_task", STACK_SENSOR_SMARTPORT_CELL, (void *)&parameter_sensor_cell,
-                    3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_CELL, &parameter_sensor_cell);
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_coordinate_parameters_t parameter_sensor_coordinate;
         parameter_sensor_coordinate.type = SMARTPORT_LATITUDE;
-        parameter_sensor_coordinate.latitude = parameter.lat;
-        parameter_sensor_coordinate.longitude = parameter.lon;
+        parameter_sensor_coordinate.latitude = &values->gps.lat;
+        parameter_sensor_coordinate.longitude = &values->gps.lon;
         parameter_sensor_coordinate.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_coordinates_task, "sensor_coordinates_task", STACK_SENSOR_SMARTPORT,
-                    (void *)&parameter_sensor_coordinate, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_COORDINATES, &parameter_sensor_coordinate);
 
         smartport_sensor_datetime_parameters_t parameter_sensor_datetime;
         parameter_sensor_datetime.type = SMARTPORT_DATE;
-        parameter_sensor_datetime.date = parameter.date;
-        parameter_sensor_datetime.time = parameter.time;
+        parameter_sensor_datetime.date = &values->gps.date;
+        parameter_sensor_datetime.time = &values->gps.time;
         parameter_sensor_datetime.rate = 1000;
-        xTaskCreate(sensor_datetime_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor_datetime, 3,
-                    &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DATETIME, &parameter_sensor_datetime);
 
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = GPS_ALT_FIRST_ID;
-        parameter_sensor.value = parameter.alt;
+        parameter_sensor.value = &values->gps.alt;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = GPS_SPEED_FIRST_ID;
-        parameter_sensor.value = parameter.spd;
+        parameter_sensor.value = &values->gps.spd;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = GPS_COURS_FIRST_ID;
-        parameter_sensor.value = parameter.cog;
+        parameter_sensor.value = &values->gps.cog;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = VARIO_FIRST_ID + 1;
-        parameter_sensor.value = parameter.vspeed;
+        parameter_sensor.value = &values->gps.vspeed;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = DIY_FIRST_ID + 3;
-        parameter_sensor.value = parameter.sat;
+        parameter_sensor.value = &values->gps.sat;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = DIY_FIRST_ID + 4;
-        parameter_sensor.value = parameter.dist;
+        parameter_sensor.value = &values->gps.dist;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = DIY_FIRST_ID + 5;
-        parameter_sensor.value = parameter.pdop;
+        parameter_sensor.value = &values->gps.pdop;
         parameter_sensor.rate = config->refresh_rate_gps;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = A3_FIRST_ID;
-        parameter_sensor.value = parameter.voltage;
+        parameter_sensor.value = &values->analog.voltage;
         parameter_sensor.rate = config->refresh_rate_voltage;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = CURR_FIRST_ID;
-        parameter_sensor.value = parameter.current;
+        parameter_sensor.value = &values->analog.current;
         parameter_sensor.rate = config->refresh_rate_current;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
 
         smartport_sensor_double_parameters_t parameter_sensor_double;
         parameter_sensor_double.data_id = ESC_RPM_CONS_FIRST_ID;
         parameter_sensor_double.value_l = NULL;
-        parameter_sensor_double.value_h = parameter.consumption;
+        parameter_sensor_double.value_h = &values->analog.consumption;
         parameter_sensor_double.rate = config->refresh_rate_current;
-        xTaskCreate(sensor_double_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor_double, 3,
-                    &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_DOUBLE, &parameter_sensor_double);
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = ALT_FIRST_ID;
-        parameter_sensor.value = parameter.altitude;
+        parameter_sensor.value = &values->baro.altitude;
         parameter_sensor.rate = config->refresh_rate_vario;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = VARIO_FIRST_ID;
-        parameter_sensor.value = parameter.vspeed;
+        parameter_sensor.value = &values->baro.vspeed;
         parameter_sensor.rate = config->refresh_rate_vario;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = ALT_FIRST_ID;
-        parameter_sensor.value = parameter.altitude;
+        parameter_sensor.value = &values->baro.altitude;
         parameter_sensor.rate = config->refresh_rate_vario;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = VARIO_FIRST_ID;
-        parameter_sensor.value = parameter.vspeed;
+        parameter_sensor.value = &values->baro.vspeed;
         parameter_sensor.rate = config->refresh_rate_vario;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = ALT_FIRST_ID;
-        parameter_sensor.value = parameter.altitude;
+        parameter_sensor.value = &values->baro.altitude;
         parameter_sensor.rate = config->refresh_rate_vario;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = VARIO_FIRST_ID;
-        parameter_sensor.value = parameter.vspeed;
+        parameter_sensor.value = &values->baro.vspeed;
         parameter_sensor.rate = config->refresh_rate_vario;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = ESC_TEMPERATURE_FIRST_ID;
-        parameter_sensor.value = parameter.ntc;
+        parameter_sensor.value = &values->analog.ntc;
         parameter_sensor.rate = config->refresh_rate_temperature;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = AIR_SPEED_FIRST_ID;
-        parameter_sensor.value = parameter.airspeed;
+        parameter_sensor.value = &values->analog.airspeed;
         parameter_sensor.rate = config->refresh_rate_airspeed;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->enable_fuel_flow) {
-        fuel_meter_parameters_t parameter = {config->fuel_flow_ml_per_pulse, malloc(sizeof(float)),
-                                             malloc(sizeof(float))};
-        xTaskCreate(fuel_meter_task, "fuel_meter_task", STACK_FUEL_METER, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         smartport_sensor_parameters_t parameter_sensor;
         parameter_sensor.data_id = GASSUIT_FLOW_FIRST_ID;
-        parameter_sensor.value = parameter.consumption_instant;
+        parameter_sensor.value = &values->fuel.consumption_instant;
         parameter_sensor.rate = config->refresh_rate_default;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
         parameter_sensor.data_id = GASSUIT_RES_VOL_FIRST_ID;
-        parameter_sensor.value = parameter.consumption_total;
+        parameter_sensor.value = &values->fuel.consumption_total;
         parameter_sensor.rate = config->refresh_rate_default;
-        xTaskCreate(sensor_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR, &parameter_sensor);
     }
     if (config->gpio_mask) {
-        gpio_parameters_t parameter = {config->gpio_mask, config->gpio_interval, malloc(sizeof(float))};
-        xTaskCreate(gpio_task, "gpio_task", STACK_GPIO, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
         smartport_sensor_gpio_parameters_t parameter_sensor;
         parameter_sensor.data_id = DIY_FIRST_ID;
-        parameter_sensor.value = parameter.value;
+        parameter_sensor.value = &values->gpio;
         parameter_sensor.rate = config->gpio_interval;
         parameter_sensor.gpio_mask = config->gpio_mask;
-        xTaskCreate(sensor_gpio_task, "sensor_task", STACK_SENSOR_SMARTPORT, (void *)&parameter_sensor, 3,
-                    &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        add_sensor(SMARTPORT_SENSOR_GPIO, &parameter_sensor);
     }
 }
 
@@ -2033,12 +1578,4 @@ static uint8_t sensor_crc_to_id(uint8_t sensor_id_crc) {
     return cont + 1;
 }
 
-static uint8_t get_crc(uint8_t *data) {
-    uint16_t crc = 0;
-    for (uint8_t i = 2; i < 9; i++) {
-        crc += data[i];
-        crc += crc >> 8;
-        crc &= 0x00FF;
-    }
-    return 0xFF - (uint8_t)crc;
-}
+static uint8_t get_crc(uint8_t *data) { return 0xFF - crc_smartport(0, &data[2], 7); }
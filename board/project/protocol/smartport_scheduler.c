@@ -0,0 +1,33 @@
+#include "smartport_scheduler.h"
+
+void smartport_scheduler_init(smartport_scheduler_t *scheduler) { scheduler->count = 0; }
+
+/* Returns the slot index or -1 if the table is full */
+int smartport_scheduler_add(smartport_scheduler_t *scheduler, uint32_t interval_ms, uint32_t now_us) {
+    if (scheduler->count == SMARTPORT_SCHEDULER_MAX_SLOTS) return -1;
+    uint8_t slot = scheduler->count++;
+    scheduler->interval_us[slot] = interval_ms ? interval_ms * 1000 : 1;
+    scheduler->due_us[slot] = now_us;
+    return slot;
+}
+
+/* Poll at now_us. Returns the most overdue slot, in intervals, and schedules its next deadline, or -1 if no slot is
+ * due */
+int smartport_scheduler_next(smartport_scheduler_t *scheduler, uint32_t now_us) {
+    int slot = -1;
+    uint64_t max_score = 0;
+    for (uint8_t i = 0; i < scheduler->count; i++) {
+        int32_t late = (int32_t)(now_us - scheduler->due_us[i]);
+        if (late < 0) continue;
+        // lateness in intervals (1/65536)
+        uint64_t score = ((uint64_t)late << 16) / scheduler->interval_us[i] + 1;
+        if (score > max_score) {
+            max_score = score;
+            slot = i;
+        }
+    }
+    if (slot < 0) return -1;
+    scheduler->due_us[slot] += scheduler->interval_us[slot];
+    if ((int32_t)(now_us - scheduler->due_us[slot]) > 0) scheduler->due_us[slot] = now_us;
+    return slot;
+}
@@ -0,0 +1,26 @@
+#ifndef SMARTPORT_SCHEDULER_H
+#define SMARTPORT_SCHEDULER_H
+
+#include <stdint.h>
+
+/*
+   Smartport poll scheduler
+   Each poll answers the most overdue slot, its lateness counted in refresh intervals, then its deadline moves one
+   interval ahead. A slot that falls more than one interval behind restarts from the poll time. On an overloaded bus
+   the lateness of every slot grows in proportion to its refresh rate, so each one keeps its share of the polls in
+   proportion to its rate. Hardware independent (timestamps in us)
+*/
+
+#define SMARTPORT_SCHEDULER_MAX_SLOTS 48
+
+typedef struct smartport_scheduler_t {
+    uint32_t interval_us[SMARTPORT_SCHEDULER_MAX_SLOTS];
+    uint32_t due_us[SMARTPORT_SCHEDULER_MAX_SLOTS];
+    uint8_t count;
+} smartport_scheduler_t;
+
+void smartport_scheduler_init(smartport_scheduler_t *scheduler);
+int smartport_scheduler_add(smartport_scheduler_t *scheduler, uint32_t interval_ms, uint32_t now_us);
+int smartport_scheduler_next(smartport_scheduler_t *scheduler, uint32_t now_us);
+
+#endif
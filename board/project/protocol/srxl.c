@@ -3,35 +3,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
-#include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_pwm.h"
+#include "crc.h"
+#include "gps.h"
 #include "hardware/i2c.h"
 #include "hardware/irq.h"
 #include "i2c_multi.h"
-#include "ms5611.h"
-#include "gps.h"
-#include "ntc.h"
 #include "pico/stdlib.h"
-#include "pwm_out.h"
+#include "pool.h"
+#include "sensor_registry.h"
 #include "string.h"
 #include "uart.h"
 #include "uart_pio.h"
-#include "voltage.h"
-#include "fuel_meter.h"
-#include "xgzp68xxd.h"
-#include "esc_omp_m4.h"
-#include "esc_ztw.h"
 
 #define SRXL_HEADER 0xA5
 #define SRXL_FRAMELEN 18
@@ -42,9 +25,9 @@ static void send_packet(void);
 static void set_config(void);
 
 void srxl_task(void *parameters) {
-    sensor = malloc(sizeof(xbus_sensor_t));
+    sensor = pool_alloc(sizeof(xbus_sensor_t));
     *sensor = (xbus_sensor_t){{0}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}};
-    sensor_formatted = malloc(sizeof(xbus_sensor_formatted_t));
+    sensor_formatted = pool_alloc(sizeof(xbus_sensor_formatted_t));
     *sensor_formatted = (xbus_sensor_formatted_t){NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
 
     context.led_cycle_duration = 6;
@@ -60,25 +43,6 @@ void srxl_task(void *parameters) {
     }
 }
 
-uint16_t srxl_get_crc(uint8_t *buffer, uint8_t length) {
-    uint16_t crc = 0;
-    for (uint8_t i = 0; i < length; ++i) {
-        crc = srxl_crc16(crc, buffer[i]);
-    }
-    return crc;
-}
-
-uint16_t srxl_crc16(uint16_t crc, uint8_t data) {
-    crc = crc ^ ((uint16_t)data << 8);
-    for (int i = 0; i < 8; ++i) {
-        if (crc & 0x8000)
-            crc = (crc << 1) ^ 0x1021;
-        else
-            crc = crc << 1;
-    }
-    return crc;
-}
-
 uint srxl_sensors_count(void) {
     uint count = 0;
     for (uint i = 0; i <= XBUS_STRU_TELE_DIGITAL_AIR; i++) {
@@ -108,6 +72,7 @@ static void process(void) {
 }
 
 static void send_packet(void) {
+    sensor_registry_snapshot();
     static uint cont = 0;
     if (!srxl_sensors_count()) return;
     while (!sensor->is_enabled[cont]) {
@@ -115,60 +80,77 @@ static void send_packet(void) {
         if (cont > XBUS_ENERGY) cont = 0;
     }
     uint8_t buffer[3] = {SRXL_HEADER, 0x80, 0x15};
+    uint8_t *payload = NULL;
+    uint length = 0;
     uart0_write_bytes(buffer, 3);
     debug("\nSRXL (%u) > %X %X %X", uxTaskGetStackHighWaterMark(NULL), buffer[0], buffer[1], buffer[2]);
     switch (cont) {
         case XBUS_AIRSPEED:
             xbus_format_sensor(XBUS_AIRSPEED_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->airspeed, sizeof(xbus_airspeed_t));
+            payload = (uint8_t *)sensor_formatted->airspeed;
+            length = sizeof(xbus_airspeed_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->airspeed, sizeof(xbus_airspeed_t), "0x%X ");
             break;
         case XBUS_BATTERY:
-            xbus_format_sensor(XBUS_AIRSPEED_ID);
+            xbus_format_sensor(XBUS_BATTERY_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->battery, sizeof(xbus_battery_t));
+            payload = (uint8_t *)sensor_formatted->battery;
+            length = sizeof(xbus_battery_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->battery, sizeof(xbus_battery_t), "0x%X ");
             break;
         case XBUS_ESC:
             xbus_format_sensor(XBUS_ESC_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->esc, sizeof(xbus_esc_t));
+            payload = (uint8_t *)sensor_formatted->esc;
+            length = sizeof(xbus_esc_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->esc, sizeof(xbus_esc_t), "0x%X ");
             break;
         case XBUS_GPS_LOC:
             xbus_format_sensor(XBUS_GPS_LOC_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->gps_loc, sizeof(xbus_gps_loc_t));
+            payload = (uint8_t *)sensor_formatted->gps_loc;
+            length = sizeof(xbus_gps_loc_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->gps_loc, sizeof(xbus_gps_loc_t), "0x%X ");
             break;
         case XBUS_GPS_STAT:
             xbus_format_sensor(XBUS_GPS_STAT_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->gps_stat, sizeof(xbus_gps_stat_t));
+            payload = (uint8_t *)sensor_formatted->gps_stat;
+            length = sizeof(xbus_gps_stat_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->gps_stat, sizeof(xbus_gps_stat_t), "0x%X ");
             break;
         case XBUS_RPMVOLTTEMP:
             xbus_format_sensor(XBUS_RPMVOLTTEMP_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->rpm_volt_temp, sizeof(xbus_rpm_volt_temp_t));
+            payload = (uint8_t *)sensor_formatted->rpm_volt_temp;
+            length = sizeof(xbus_rpm_volt_temp_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->rpm_volt_temp, sizeof(xbus_rpm_volt_temp_t), "0x%X ");
             break;
         case XBUS_FUEL_FLOW:
             xbus_format_sensor(XBUS_FUEL_FLOW_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->fuel_flow, sizeof(xbus_fuel_flow_t));
+            payload = (uint8_t *)sensor_formatted->fuel_flow;
+            length = sizeof(xbus_fuel_flow_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->fuel_flow, sizeof(xbus_fuel_flow_t), "0x%X ");
             break;
         case XBUS_STRU_TELE_DIGITAL_AIR:
             xbus_format_sensor(XBUS_STRU_TELE_DIGITAL_AIR_ID);
             uart0_write_bytes((uint8_t *)sensor_formatted->stru_tele_digital_air, sizeof(xbus_stru_tele_digital_air_t));
+            payload = (uint8_t *)sensor_formatted->stru_tele_digital_air;
+            length = sizeof(xbus_stru_tele_digital_air_t);
             debug("\nSRXL (%u) < ", uxTaskGetStackHighWaterMark(NULL));
             debug_buffer((uint8_t *)sensor_formatted->stru_tele_digital_air, sizeof(xbus_stru_tele_digital_air_t), "0x%X ");
             break;
     }
-    uint16_t crc;
-    crc = __builtin_bswap16(srxl_get_crc(buffer, 19));  // all bytes, including header
+    uint16_t crc = __builtin_bswap16(crc16_srxl(crc16_srxl(0, buffer, 3), payload, length));  // including header
     uart0_write_bytes((uint8_t *)&crc, 2);
     debug("%X ", crc);
     cont++;
@@ -177,398 +159,165 @@ static void send_packet(void) {
 
 static void set_config(void) {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
-    float *baro_temp = NULL, *baro_pressure = NULL;
+    sensor_values_t *values = sensor_registry_start(config);
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature_fet;
-        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = parameter.temperature_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = &values->esc.temperature_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature_fet;
-        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = parameter.temperature_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = &values->esc.temperature_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature_fet;
-        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = parameter.temperature_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = &values->esc.temperature_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temp_esc;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_ZTW) {
-        esc_ztw_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.bec_voltage = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_ztw_task, "esc_omp_m4_task", STACK_ESC_ZTW, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temp_esc;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = malloc(sizeof(xbus_esc_t));
+        sensor_formatted->esc = pool_alloc(sizeof(xbus_esc_t));
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-        sensor->gps_loc[XBUS_GPS_LOC_ALTITUDE] = parameter.alt;
-        sensor->gps_loc[XBUS_GPS_LOC_LATITUDE] = parameter.lat;
-        sensor->gps_loc[XBUS_GPS_LOC_LONGITUDE] = parameter.lon;
-        sensor->gps_loc[XBUS_GPS_LOC_COURSE] = parameter.cog;
-        sensor->gps_loc[XBUS_GPS_LOC_HDOP] = parameter.hdop;
-        sensor->gps_stat[XBUS_GPS_STAT_SPEED] = parameter.spd;
-        sensor->gps_stat[XBUS_GPS_STAT_TIME] = parameter.time;
-        sensor->gps_stat[XBUS_GPS_STAT_SATS] = parameter.sat;
-        sensor->gps_stat[XBUS_GPS_STAT_ALTITUDE] = parameter.alt;
+        sensor->gps_loc[XBUS_GPS_LOC_ALTITUDE] = &values->gps.alt;
+        sensor->gps_loc[XBUS_GPS_LOC_LATITUDE] = &values->gps.lat;
+        sensor->gps_loc[XBUS_GPS_LOC_LONGITUDE] = &values->gps.lon;
+        sensor->gps_loc[XBUS_GPS_LOC_COURSE] = &values->gps.cog;
+        sensor->gps_loc[XBUS_GPS_LOC_HDOP] = &values->gps.hdop;
+        sensor->gps_stat[XBUS_GPS_STAT_SPEED] = &values->gps.spd;
+        sensor->gps_stat[XBUS_GPS_STAT_TIME] = &values->gps.time;
+        sensor->gps_stat[XBUS_GPS_STAT_SATS] = &values->gps.sat;
+        sensor->gps_stat[XBUS_GPS_STAT_ALTITUDE] = &values->gps.alt;
         sensor->is_enabled[XBUS_GPS_LOC] = true;
         sensor->is_enabled[XBUS_GPS_STAT] = true;
-        sensor_formatted->gps_loc = malloc(sizeof(xbus_gps_loc_t));
+        sensor_formatted->gps_loc = pool_alloc(sizeof(xbus_gps_loc_t));
         *sensor_formatted->gps_loc = (xbus_gps_loc_t){XBUS_GPS_LOC_ID, 0, 0, 0, 0, 0, 0, 0};
-        sensor_formatted->gps_stat = malloc(sizeof(xbus_gps_stat_t));
+        sensor_formatted->gps_stat = pool_alloc(sizeof(xbus_gps_stat_t));
         *sensor_formatted->gps_stat = (xbus_gps_stat_t){XBUS_GPS_STAT_ID, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_VOLT] = parameter.voltage;
+        sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_VOLT] = &values->analog.voltage;
         sensor->is_enabled[XBUS_RPMVOLTTEMP] = true;
-        sensor_formatted->rpm_volt_temp = malloc(sizeof(xbus_rpm_volt_temp_t));
+        sensor_formatted->rpm_volt_temp = pool_alloc(sizeof(xbus_rpm_volt_temp_t));
         *sensor_formatted->rpm_volt_temp = (xbus_rpm_volt_temp_t){XBUS_RPMVOLTTEMP_ID, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
+        sensor->battery[XBUS_BATTERY_CURRENT1] = &values->analog.current;
         sensor->is_enabled[XBUS_BATTERY] = true;
-        sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
+        sensor_formatted->battery = pool_alloc(sizeof(xbus_battery_t));
         *sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_TEMP] = parameter.ntc;
+        sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_TEMP] = &values->analog.ntc;
         sensor->is_enabled[XBUS_RPMVOLTTEMP] = true;
-        sensor_formatted->rpm_volt_temp = malloc(sizeof(xbus_rpm_volt_temp_t));
+        sensor_formatted->rpm_volt_temp = pool_alloc(sizeof(xbus_rpm_volt_temp_t));
         *sensor_formatted->rpm_volt_temp = (xbus_rpm_volt_temp_t){XBUS_RPMVOLTTEMP_ID, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->vario[XBUS_VARIO_ALTITUDE] = parameter.altitude;
+        sensor->vario[XBUS_VARIO_ALTITUDE] = &values->baro.altitude;
         sensor->is_enabled[XBUS_VARIO] = true;
-        sensor_formatted->vario = malloc(sizeof(xbus_vario_t));
+        sensor_formatted->vario = pool_alloc(sizeof(xbus_vario_t));
         *sensor_formatted->vario = (xbus_vario_t){XBUS_VARIO_ID, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->vario[XBUS_VARIO_ALTITUDE] = parameter.altitude;
+        sensor->vario[XBUS_VARIO_ALTITUDE] = &values->baro.altitude;
         sensor->is_enabled[XBUS_VARIO] = true;
-        sensor_formatted->vario = malloc(sizeof(xbus_vario_t));
+        sensor_formatted->vario = pool_alloc(sizeof(xbus_vario_t));
         *sensor_formatted->vario = (xbus_vario_t){XBUS_VARIO_ID, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->vario[XBUS_VARIO_ALTITUDE] = parameter.altitude;
+        sensor->vario[XBUS_VARIO_ALTITUDE] = &values->baro.altitude;
         sensor->is_enabled[XBUS_VARIO] = true;
-        sensor_formatted->vario = malloc(sizeof(xbus_vario_t));
+        sensor_formatted->vario = pool_alloc(sizeof(xbus_vario_t));
         *sensor_formatted->vario = (xbus_vario_t){XBUS_VARIO_ID, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->airspeed[XBUS_AIRSPEED_AIRSPEED] = parameter.airspeed;
+        sensor->airspeed[XBUS_AIRSPEED_AIRSPEED] = &values->analog.airspeed;
         sensor->is_enabled[XBUS_AIRSPEED] = true;
-        sensor_formatted->airspeed = malloc(sizeof(xbus_airspeed_t));
+        sensor_formatted->airspeed = pool_alloc(sizeof(xbus_airspeed_t));
         *sensor_formatted->airspeed = (xbus_airspeed_t){XBUS_AIRSPEED_ID, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_fuel_flow) {
-        fuel_meter_parameters_t parameter = {config->fuel_flow_ml_per_pulse, malloc(sizeof(float)),
-                                             malloc(sizeof(float))};
-        xTaskCreate(fuel_meter_task, "fuel_meter_task", STACK_FUEL_METER, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->fuel_flow[XBUS_FUEL_FLOW_RATE] = parameter.consumption_instant;
-        sensor->fuel_flow[XBUS_FUEL_FLOW_CONSUMED] = parameter.consumption_total;
+        sensor->fuel_flow[XBUS_FUEL_FLOW_RATE] = &values->fuel.consumption_instant;
+        sensor->fuel_flow[XBUS_FUEL_FLOW_CONSUMED] = &values->fuel.consumption_total;
         sensor->is_enabled[XBUS_FUEL_FLOW] = true;
-        sensor_formatted->fuel_flow = calloc(1, 16);
+        sensor_formatted->fuel_flow = pool_alloc(16);
         *sensor_formatted->fuel_flow = (xbus_fuel_flow_t){XBUS_FUEL_FLOW_ID, 0, 0, 0, 0, 0, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_fuel_pressure) {
-        xgzp68xxd_parameters_t parameter = {config->xgzp68xxd_k, malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(xgzp68xxd_task, "fuel_pressure_task", STACK_FUEL_PRESSURE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->stru_tele_digital_air[XBUS_FUEL_PRESSURE] = parameter.pressure;
+        sensor->stru_tele_digital_air[XBUS_FUEL_PRESSURE] = &values->fuel.pressure;
         sensor->is_enabled[XBUS_STRU_TELE_DIGITAL_AIR] = true;
-        sensor_formatted->stru_tele_digital_air = calloc(1, 16);
+        sensor_formatted->stru_tele_digital_air = pool_alloc(16);
         *sensor_formatted->stru_tele_digital_air =
             (xbus_stru_tele_digital_air_t){XBUS_STRU_TELE_DIGITAL_AIR_ID, 0, 0, 0};
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 }
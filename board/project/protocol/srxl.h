@@ -9,8 +9,6 @@ extern xbus_sensor_t *sensor;
 extern xbus_sensor_formatted_t *sensor_formatted;
 
 void srxl_task(void *parameters);
-uint16_t srxl_get_crc(uint8_t *buffer, uint8_t length);
-uint16_t srxl_crc16(uint16_t crc, uint8_t data);
 uint srxl_sensors_count(void);
 
 #endif
\ No newline at end of file
@@ -3,41 +3,46 @@
 #include <math.h>
 #include <stdio.h>
 
-#include "airspeed.h"
-#include "bmp180.h"
-#include "bmp280.h"
 #include "config.h"
 #include "current.h"
-#include "esc_apd_f.h"
-#include "esc_apd_hv.h"
-#include "esc_castle.h"
-#include "esc_hw3.h"
-#include "esc_hw4.h"
-#include "esc_hw5.h"
-#include "esc_kontronik.h"
-#include "esc_pwm.h"
-#include "fuel_meter.h"
+#include "format.h"
+#include "gps.h"
 #include "hardware/i2c.h"
 #include "hardware/irq.h"
 #include "i2c_multi.h"
-#include "ms5611.h"
-#include "gps.h"
-#include "ntc.h"
 #include "pico/stdlib.h"
-#include "pwm_out.h"
+#include "pool.h"
+#include "sensor_registry.h"
 #include "stdlib.h"
 #include "string.h"
 #include "uart.h"
 #include "uart_pio.h"
 #include "voltage.h"
-#include "xgzp68xxd.h"
-#include "esc_omp_m4.h"
-#include "esc_ztw.h"
+
+#define XBUS_FRAME_LENGTH 16
+#define XBUS_FORMAT_INTERVAL_MS 20
+
+/*
+   Frames are formatted in the task and published to the i2c request irq with a double buffer. The irq only selects the
+   front buffer. The back buffer is rewritten every XBUS_FORMAT_INTERVAL_MS, far longer than an i2c frame transfer
+*/
+
+typedef struct xbus_frame_t {
+    uint8_t buffer[2][XBUS_FRAME_LENGTH];
+    uint8_t front;
+} xbus_frame_t;
 
 xbus_sensor_t *sensor;
 xbus_sensor_formatted_t *sensor_formatted;
 
+static const uint8_t address_list[] = {XBUS_AIRSPEED_ID, XBUS_ALTIMETER_ID, XBUS_GPS_LOC_ID, XBUS_GPS_STAT_ID,
+                                       XBUS_ESC_ID, XBUS_BATTERY_ID, XBUS_VARIO_ID, XBUS_RPMVOLTTEMP_ID,
+                                       XBUS_ENERGY_ID, XBUS_FUEL_FLOW_ID, XBUS_STRU_TELE_DIGITAL_AIR_ID};
+static xbus_frame_t frame[XBUS_STRU_TELE_DIGITAL_AIR + 1];
+
 static void i2c_request_handler(uint8_t address);
+static void publish_frames(void);
+static uint8_t *get_formatted(xbus_sensors_t index);
 static void set_config();
 static uint8_t bcd8(float value, uint8_t precision);
 static uint16_t bcd16(float value, uint8_t precision);
@@ -52,9 +57,9 @@ static int64_t interval_3000_callback(alarm_id_t id, void *parameters);
 void xbus_i2c_handler(uint8_t address) { i2c_request_handler(address); }
 
 void xbus_task(void *parameters) {
-    sensor = malloc(sizeof(xbus_sensor_t));
+    sensor = pool_alloc(sizeof(xbus_sensor_t));
     *sensor = (xbus_sensor_t){{0}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}, {NULL}};
-    sensor_formatted = malloc(sizeof(xbus_sensor_formatted_t));
+    sensor_formatted = pool_alloc(sizeof(xbus_sensor_formatted_t));
     *sensor_formatted = (xbus_sensor_formatted_t){NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL};
 
     context.led_cycle_duration = 6;
@@ -64,15 +69,17 @@ void xbus_task(void *parameters) {
     uint pin = I2C1_SDA_GPIO;
 
     i2c_multi_init(pio, pin);
-    i2c_multi_set_request_handler(i2c_request_handler);
 
     set_config();
+    publish_frames();
+    i2c_multi_set_request_handler(i2c_request_handler);
 
     debug("\nXBUS init");
 
-    vTaskSuspend(NULL);
-    free(sensor);
-    vTaskDelete(NULL);
+    while (1) {
+        vTaskDelay(XBUS_FORMAT_INTERVAL_MS / portTICK_PERIOD_MS);
+        publish_frames();
+    }
 }
 
 void xbus_format_sensor(uint8_t address) {
@@ -217,545 +224,296 @@ void xbus_format_sensor(uint8_t address) {
 }
 
 static void i2c_request_handler(uint8_t address) {
-    uint8_t buffer[64];
-
     debug("\nXBUS (%u) Address: %X Packet: ", uxTaskGetStackHighWaterMark(context.receiver_task_handle), address);
 
-    switch (address) {
-        case XBUS_AIRSPEED_ID:
-            if (!sensor->is_enabled[XBUS_AIRSPEED]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->airspeed);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->airspeed, sizeof(xbus_airspeed_t), "0x%X ");
-            break;
-        case XBUS_ALTIMETER_ID:
-            if (!sensor->is_enabled[XBUS_ALTIMETER]) break;
-            break;
-        case XBUS_GPS_LOC_ID:
-            if (!sensor->is_enabled[XBUS_GPS_LOC]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->gps_loc);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->gps_loc, sizeof(xbus_gps_loc_t), "0x%X ");
-            break;
-        case XBUS_GPS_STAT_ID:
-            if (!sensor->is_enabled[XBUS_GPS_STAT]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->gps_stat);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->gps_stat, sizeof(xbus_gps_stat_t), "0x%X ");
-            break;
-        case XBUS_ENERGY_ID:
-            if (!sensor->is_enabled[XBUS_ENERGY]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->energy);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->airspeed, sizeof(xbus_energy_t), "0x%X ");
-            break;
-        case XBUS_ESC_ID:
-            if (!sensor->is_enabled[XBUS_ESC]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->esc);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->esc, sizeof(xbus_esc_t), "0x%X ");
-            break;
-        case XBUS_BATTERY_ID:
-            if (!sensor->is_enabled[XBUS_BATTERY]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->battery);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->battery, sizeof(xbus_battery_t), "0x%X ");
-            break;
-        case XBUS_VARIO_ID:
-            if (!sensor->is_enabled[XBUS_VARIO]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->vario);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->vario, sizeof(xbus_vario_t), "0x%X ");
-            break;
-        case XBUS_RPMVOLTTEMP_ID:
-            if (!sensor->is_enabled[XBUS_RPMVOLTTEMP]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->rpm_volt_temp);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->rpm_volt_temp, sizeof(xbus_rpm_volt_temp_t), "0x%X ");
-            break;
-        case XBUS_FUEL_FLOW_ID:
-            if (!sensor->is_enabled[XBUS_FUEL_FLOW]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->fuel_flow);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->fuel_flow, sizeof(xbus_fuel_flow_t), "0x%X ");
-            break;
-        case XBUS_STRU_TELE_DIGITAL_AIR_ID:
-            if (!sensor->is_enabled[XBUS_STRU_TELE_DIGITAL_AIR]) break;
-            xbus_format_sensor(address);
-            i2c_multi_set_write_buffer((uint8_t *)sensor_formatted->stru_tele_digital_air);
-            vTaskResume(context.led_task_handle);
-            debug_buffer((uint8_t *)sensor_formatted->stru_tele_digital_air, sizeof(xbus_stru_tele_digital_air_t), "0x%X ");
-            break;
+    for (uint i = 0; i < sizeof(address_list); i++) {
+        if (address_list[i] != address) continue;
+        if (!sensor->is_enabled[i] || i == XBUS_ALTIMETER) return;
+        uint8_t *buffer = frame[i].buffer[__atomic_load_n(&frame[i].front, __ATOMIC_ACQUIRE)];
+        i2c_multi_set_write_buffer(buffer);
+        vTaskResume(context.led_task_handle);
+        debug_buffer(buffer, XBUS_FRAME_LENGTH, "0x%X ");
+        return;
+    }
+}
+
+static void publish_frames(void) {
+    sensor_registry_snapshot();
+    for (uint i = 0; i < sizeof(address_list); i++) {
+        uint8_t *formatted = get_formatted(i);
+        if (!sensor->is_enabled[i] || !formatted) continue;
+        uint8_t back = !frame[i].front;
+        xbus_format_sensor(address_list[i]);
+        memcpy(frame[i].buffer[back], formatted, XBUS_FRAME_LENGTH);
+        __atomic_store_n(&frame[i].front, back, __ATOMIC_RELEASE);
+    }
+}
+
+static uint8_t *get_formatted(xbus_sensors_t index) {
+    switch (index) {
+        case XBUS_AIRSPEED:
+            return (uint8_t *)sensor_formatted->airspeed;
+        case XBUS_GPS_LOC:
+            return (uint8_t *)sensor_formatted->gps_loc;
+        case XBUS_GPS_STAT:
+            return (uint8_t *)sensor_formatted->gps_stat;
+        case XBUS_ESC:
+            return (uint8_t *)sensor_formatted->esc;
+        case XBUS_BATTERY:
+            return (uint8_t *)sensor_formatted->battery;
+        case XBUS_VARIO:
+            return (uint8_t *)sensor_formatted->vario;
+        case XBUS_RPMVOLTTEMP:
+            return (uint8_t *)sensor_formatted->rpm_volt_temp;
+        case XBUS_ENERGY:
+            return (uint8_t *)sensor_formatted->energy;
+        case XBUS_FUEL_FLOW:
+            return (uint8_t *)sensor_formatted->fuel_flow;
+        case XBUS_STRU_TELE_DIGITAL_AIR:
+            return (uint8_t *)sensor_formatted->stru_tele_digital_air;
+        default:
+            return NULL;
     }
 }
 
 static void set_config() {
     config_t *config = config_read();
-    TaskHandle_t task_handle;
-    float *baro_temp = NULL, *baro_pressure = NULL;
+    sensor_values_t *values = sensor_registry_start(config);
     if (config->esc_protocol == ESC_PWM) {
-        esc_pwm_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW3) {
-        esc_hw3_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm, malloc(sizeof(float))};
-        xTaskCreate(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_HW4) {
-        esc_hw4_parameters_t parameter = {config->rpm_multiplier,
-                                          config->enable_pwm_out,
-                                          config->enable_esc_hw4_init_delay,
-                                          config->alpha_rpm,
-                                          config->alpha_voltage,
-                                          config->alpha_current,
-                                          config->alpha_temperature,
-                                          config->esc_hw4_divisor,
-                                          config->esc_hw4_current_multiplier,
-                                          config->esc_hw4_current_thresold,
-                                          config->esc_hw4_current_max,
-                                          config->esc_hw4_is_manual_offset,
-                                          config->esc_hw4_offset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        if (config->enable_pwm_out) {
-            xTaskCreate(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)parameter.rpm, 2, &task_handle);
-            context.pwm_out_task_handle = task_handle;
-            xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        }
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature_fet;
-        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = parameter.temperature_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = &values->esc.temperature_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
     }
     if (config->esc_protocol == ESC_HW5) {
-        esc_hw5_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature_fet;
-        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = parameter.temperature_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = &values->esc.temperature_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
     }
     if (config->esc_protocol == ESC_CASTLE) {
-        esc_castle_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                             config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                             malloc(sizeof(float)),  malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature;
-        sensor->esc[XBUS_ESC_CURRENT_BEC] = parameter.current_bec;
-        sensor->esc[XBUS_ESC_VOLTAGE_BEC] = parameter.voltage_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_CURRENT_BEC] = &values->esc.current_bec;
+        sensor->esc[XBUS_ESC_VOLTAGE_BEC] = &values->esc.voltage_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_KONTRONIK) {
-        esc_kontronik_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage,  config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)),  malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature_fet;
-        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = parameter.temperature_bec;
-        sensor->esc[XBUS_ESC_CURRENT_BEC] = parameter.current_bec;
-        sensor->esc[XBUS_ESC_VOLTAGE_BEC] = parameter.voltage_bec;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
+        sensor->esc[XBUS_ESC_TEMPERATURE_BEC] = &values->esc.temperature_bec;
+        sensor->esc[XBUS_ESC_CURRENT_BEC] = &values->esc.current_bec;
+        sensor->esc[XBUS_ESC_VOLTAGE_BEC] = &values->esc.voltage_bec;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_F) {
-        esc_apd_f_parameters_t parameter = {config->rpm_multiplier, config->alpha_rpm,         config->alpha_voltage,
-                                            config->alpha_current,  config->alpha_temperature, malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(float)),
-                                            malloc(sizeof(float)),  malloc(sizeof(float)),     malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_APD_HV) {
-        esc_apd_hv_parameters_t parameter = {
-            config->rpm_multiplier,    config->alpha_rpm,     config->alpha_voltage, config->alpha_current,
-            config->alpha_temperature, malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(float)),
-            malloc(sizeof(float)),     malloc(sizeof(float)), malloc(sizeof(float)), malloc(sizeof(uint8_t))};
-        xTaskCreate(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temperature;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temp_esc;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->esc_protocol == ESC_OMP_M4) {
-        esc_omp_m4_parameters_t parameter;
-        parameter.rpm_multiplier = config->rpm_multiplier;
-        parameter.alpha_rpm = config->alpha_rpm;
-        parameter.alpha_voltage = config->alpha_voltage;
-        parameter.alpha_current = config->alpha_current;
-        parameter.alpha_temperature = config->alpha_temperature;
-        parameter.rpm = malloc(sizeof(float));
-        parameter.voltage = malloc(sizeof(float));
-        parameter.current = malloc(sizeof(float));
-        parameter.temp_esc = malloc(sizeof(float));
-        parameter.temp_motor = malloc(sizeof(float));
-        parameter.cell_voltage = malloc(sizeof(float));
-        parameter.consumption = malloc(sizeof(float));
-        parameter.cell_count = malloc(sizeof(uint8_t));
-        xTaskCreate(esc_ztw_task, "esc_ztw_task", STACK_ESC_OMP_M4, (void *)&parameter, 2, &task_handle);
-        context.uart1_notify_task_handle = task_handle;
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->esc[XBUS_ESC_RPM] = parameter.rpm;
-        sensor->esc[XBUS_ESC_VOLTAGE] = parameter.voltage;
-        sensor->esc[XBUS_ESC_CURRENT] = parameter.current;
-        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = parameter.temp_esc;
+        sensor->esc[XBUS_ESC_RPM] = &values->esc.rpm;
+        sensor->esc[XBUS_ESC_VOLTAGE] = &values->esc.voltage;
+        sensor->esc[XBUS_ESC_CURRENT] = &values->esc.current;
+        sensor->esc[XBUS_ESC_TEMPERATURE_FET] = &values->esc.temperature_fet;
         sensor->is_enabled[XBUS_ESC] = true;
-        sensor_formatted->esc = calloc(1, 16);
+        sensor_formatted->esc = pool_alloc(16);
         *sensor_formatted->esc = (xbus_esc_t){XBUS_ESC_ID, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_ESC_ID);
-        // sensor->battery[XBUS_BATTERY_CURRENT1] = parameter.current;
-        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = parameter.consumption;
+        // sensor->battery[XBUS_BATTERY_CURRENT1] = &values->esc.current;
+        // sensor->battery[XBUS_BATTERY_CONSUMPTION1] = &values->esc.consumption;
         // sensor->is_enabled[XBUS_BATTERY] = true;
         // sensor_formatted->battery = malloc(sizeof(xbus_battery_t));
         //*sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0, 0, 0};
         // i2c_multi_enable_address(XBUS_BATTERY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_gps) {
-        gps_parameters_t parameter;
-        parameter.protocol = config->gps_protocol;
-        parameter.baudrate = config->gps_baudrate;
-        parameter.rate = config->gps_rate;
-        parameter.lat = malloc(sizeof(double));
-        parameter.lon = malloc(sizeof(double));
-        parameter.alt = malloc(sizeof(float));
-        parameter.spd = malloc(sizeof(float));
-        parameter.cog = malloc(sizeof(float));
-        parameter.hdop = malloc(sizeof(float));
-        parameter.sat = malloc(sizeof(float));
-        parameter.time = malloc(sizeof(float));
-        parameter.date = malloc(sizeof(float));
-        parameter.vspeed = malloc(sizeof(float));
-        parameter.dist = malloc(sizeof(float));
-        parameter.spd_kmh = malloc(sizeof(float));
-        parameter.fix = malloc(sizeof(float));
-        parameter.vdop = malloc(sizeof(float));
-        parameter.speed_acc = malloc(sizeof(float));
-        parameter.h_acc = malloc(sizeof(float));
-        parameter.v_acc = malloc(sizeof(float));
-        parameter.track_acc = malloc(sizeof(float));
-        parameter.n_vel = malloc(sizeof(float));
-        parameter.e_vel = malloc(sizeof(float));
-        parameter.v_vel = malloc(sizeof(float));
-        parameter.alt_elipsiod = malloc(sizeof(float));
-        parameter.pdop = malloc(sizeof(float));
-        xTaskCreate(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, &task_handle);
-        context.uart_pio_notify_task_handle = task_handle;
-
-        sensor->gps_loc[XBUS_GPS_LOC_ALTITUDE] = parameter.alt;
-        sensor->gps_loc[XBUS_GPS_LOC_LATITUDE] = parameter.lat;
-        sensor->gps_loc[XBUS_GPS_LOC_LONGITUDE] = parameter.lon;
-        sensor->gps_loc[XBUS_GPS_LOC_COURSE] = parameter.cog;
-        sensor->gps_loc[XBUS_GPS_LOC_HDOP] = parameter.hdop;
-        sensor->gps_stat[XBUS_GPS_STAT_SPEED] = parameter.spd;
-        sensor->gps_stat[XBUS_GPS_STAT_TIME] = parameter.time;
-        sensor->gps_stat[XBUS_GPS_STAT_SATS] = parameter.sat;
-        sensor->gps_stat[XBUS_GPS_STAT_ALTITUDE] = parameter.alt;
+        sensor->gps_loc[XBUS_GPS_LOC_ALTITUDE] = &values->gps.alt;
+        sensor->gps_loc[XBUS_GPS_LOC_LATITUDE] = &values->gps.lat;
+        sensor->gps_loc[XBUS_GPS_LOC_LONGITUDE] = &values->gps.lon;
+        sensor->gps_loc[XBUS_GPS_LOC_COURSE] = &values->gps.cog;
+        sensor->gps_loc[XBUS_GPS_LOC_HDOP] = &values->gps.hdop;
+        sensor->gps_stat[XBUS_GPS_STAT_SPEED] = &values->gps.spd;
+        sensor->gps_stat[XBUS_GPS_STAT_TIME] = &values->gps.time;
+        sensor->gps_stat[XBUS_GPS_STAT_SATS] = &values->gps.sat;
+        sensor->gps_stat[XBUS_GPS_STAT_ALTITUDE] = &values->gps.alt;
         sensor->is_enabled[XBUS_GPS_LOC] = true;
         sensor->is_enabled[XBUS_GPS_STAT] = true;
-        sensor_formatted->gps_loc = calloc(1, 16);
+        sensor_formatted->gps_loc = pool_alloc(16);
         *sensor_formatted->gps_loc = (xbus_gps_loc_t){XBUS_GPS_LOC_ID, 0, 0, 0, 0, 0, 0, 0};
-        sensor_formatted->gps_stat = calloc(1, 16);
+        sensor_formatted->gps_stat = pool_alloc(16);
         *sensor_formatted->gps_stat = (xbus_gps_stat_t){XBUS_GPS_STAT_ID, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_GPS_LOC_ID);
         i2c_multi_enable_address(XBUS_GPS_STAT_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_voltage) {
-        voltage_parameters_t parameter = {0, config->analog_rate, config->alpha_voltage,
-                                          config->analog_voltage_multiplier, malloc(sizeof(float))};
-        xTaskCreate(voltage_task, "voltage_task", STACK_VOLTAGE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
         if (!config->xbus_use_alternative_volt_temp) {
-            sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_VOLT] = parameter.voltage;
+            sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_VOLT] = &values->analog.voltage;
             sensor->is_enabled[XBUS_RPMVOLTTEMP] = true;
-            sensor_formatted->rpm_volt_temp = calloc(1, 16);
+            sensor_formatted->rpm_volt_temp = pool_alloc(16);
             *sensor_formatted->rpm_volt_temp = (xbus_rpm_volt_temp_t){XBUS_RPMVOLTTEMP_ID, 0, 0, 0, 0};
             i2c_multi_enable_address(XBUS_RPMVOLTTEMP_ID);
         } else {
-            sensor->energy[XBUS_ENERGY_VOLTAGE1] = parameter.voltage;
+            sensor->energy[XBUS_ENERGY_VOLTAGE1] = &values->analog.voltage;
             sensor->is_enabled[XBUS_ENERGY] = true;
-            sensor_formatted->energy = calloc(1, 16);
+            sensor_formatted->energy = pool_alloc(16);
             *sensor_formatted->energy = (xbus_energy_t){XBUS_ENERGY_ID, 0, 0, 0, 0, 0, 0};
             i2c_multi_enable_address(XBUS_ENERGY_ID);
         }
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_current) {
-        current_parameters_t parameter = {1,
-                                          config->analog_rate,
-                                          config->alpha_current,
-                                          config->analog_current_multiplier,
-                                          config->analog_current_offset,
-                                          config->analog_current_autoffset,
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float)),
-                                          malloc(sizeof(float))};
-        xTaskCreate(current_task, "current_task", STACK_CURRENT, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->energy[XBUS_ENERGY_CURRENT1] = parameter.current;
-        sensor->energy[XBUS_ENERGY_CONSUMPTION1] = parameter.consumption;
+        sensor->energy[XBUS_ENERGY_CURRENT1] = &values->analog.current;
+        sensor->energy[XBUS_ENERGY_CONSUMPTION1] = &values->analog.consumption;
         if (!sensor->is_enabled[XBUS_ENERGY]) {
             sensor->is_enabled[XBUS_ENERGY] = true;
-            sensor_formatted->energy = calloc(1, 16);
+            sensor_formatted->energy = pool_alloc(16);
             *sensor_formatted->energy = (xbus_energy_t){XBUS_ENERGY_ID, 0, 0, 0, 0, 0, 0};
         }
         i2c_multi_enable_address(XBUS_ENERGY_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_ntc) {
-        ntc_parameters_t parameter = {2, config->analog_rate, config->alpha_temperature, malloc(sizeof(float))};
-        xTaskCreate(ntc_task, "ntc_task", STACK_NTC, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
         if (!config->xbus_use_alternative_volt_temp) {
-            sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_TEMP] = parameter.ntc;
+            sensor->rpm_volt_temp[XBUS_RPMVOLTTEMP_TEMP] = &values->analog.ntc;
             sensor->is_enabled[XBUS_RPMVOLTTEMP] = true;
-            sensor_formatted->rpm_volt_temp = calloc(1, 16);
+            sensor_formatted->rpm_volt_temp = pool_alloc(16);
             *sensor_formatted->rpm_volt_temp = (xbus_rpm_volt_temp_t){XBUS_RPMVOLTTEMP_ID, 0, 0, 0, 0};
             i2c_multi_enable_address(XBUS_RPMVOLTTEMP_ID);
         } else {
-            sensor->battery[XBUS_BATTERY_TEMP1] = parameter.ntc;
+            sensor->battery[XBUS_BATTERY_TEMP1] = &values->analog.ntc;
             sensor->is_enabled[XBUS_BATTERY] = true;
-            sensor_formatted->battery = calloc(1, 16);
+            sensor_formatted->battery = pool_alloc(16);
             *sensor_formatted->battery = (xbus_battery_t){XBUS_BATTERY_ID, 0, 0, 0, 0};
             i2c_multi_enable_address(XBUS_BATTERY_ID);
         }
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP280) {
-        bmp280_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         config->bmp280_filter, malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float)), malloc(sizeof(float))};
-        xTaskCreate(bmp280_task, "bmp280_task", STACK_BMP280, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         add_alarm_in_ms(250, interval_250_callback, NULL, false);
         add_alarm_in_ms(500, interval_500_callback, NULL, false);
         add_alarm_in_ms(1000, interval_1000_callback, NULL, false);
         add_alarm_in_ms(1500, interval_1500_callback, NULL, false);
         add_alarm_in_ms(2000, interval_2000_callback, NULL, false);
         add_alarm_in_ms(3000, interval_3000_callback, NULL, false);
-        sensor->vario[XBUS_VARIO_ALTITUDE] = parameter.altitude;
+        sensor->vario[XBUS_VARIO_ALTITUDE] = &values->baro.altitude;
         sensor->is_enabled[XBUS_VARIO] = true;
-        sensor_formatted->vario = calloc(1, 16);
+        sensor_formatted->vario = pool_alloc(16);
         *sensor_formatted->vario = (xbus_vario_t){XBUS_VARIO_ID, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_VARIO_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_MS5611) {
-        ms5611_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(ms5611_task, "ms5611_task", STACK_MS5611, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
         add_alarm_in_ms(250, interval_250_callback, NULL, false);
         add_alarm_in_ms(500, interval_500_callback, NULL, false);
         add_alarm_in_ms(1000, interval_1000_callback, NULL, false);
         add_alarm_in_ms(1500, interval_1500_callback, NULL, false);
         add_alarm_in_ms(2000, interval_2000_callback, NULL, false);
         add_alarm_in_ms(3000, interval_3000_callback, NULL, false);
-        sensor->vario[XBUS_VARIO_ALTITUDE] = parameter.altitude;
+        sensor->vario[XBUS_VARIO_ALTITUDE] = &values->baro.altitude;
         sensor->is_enabled[XBUS_VARIO] = true;
-        sensor_formatted->vario = calloc(1, 16);
+        sensor_formatted->vario = pool_alloc(16);
         *sensor_formatted->vario = (xbus_vario_t){XBUS_VARIO_ID, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_VARIO_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->i2c_module == I2C_BMP180) {
-        bmp180_parameters_t parameter = {config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
-                                         malloc(sizeof(float)), malloc(sizeof(float)),     malloc(sizeof(float)),
-                                         malloc(sizeof(float))};
-        xTaskCreate(bmp180_task, "bmp180_task", STACK_BMP180, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
         add_alarm_in_ms(250, interval_250_callback, NULL, false);
         add_alarm_in_ms(500, interval_500_callback, NULL, false);
         add_alarm_in_ms(1000, interval_1000_callback, NULL, false);
@@ -763,67 +521,33 @@ static void set_config() {
         add_alarm_in_ms(2000, interval_2000_callback, NULL, false);
         add_alarm_in_ms(3000, interval_3000_callback, NULL, false);
 
-        if (config->enable_analog_airspeed) {
-            baro_temp = parameter.temperature;
-            baro_pressure = parameter.pressure;
-        }
-
-        sensor->vario[XBUS_VARIO_ALTITUDE] = parameter.altitude;
+        sensor->vario[XBUS_VARIO_ALTITUDE] = &values->baro.altitude;
         sensor->is_enabled[XBUS_VARIO] = true;
-        sensor_formatted->vario = calloc(1, 16);
+        sensor_formatted->vario = pool_alloc(16);
         *sensor_formatted->vario = (xbus_vario_t){XBUS_VARIO_ID, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_VARIO_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_analog_airspeed) {
-        airspeed_parameters_t parameter = {3,
-                                           config->analog_rate,
-                                           config->alpha_airspeed,
-                                           (float)config->airspeed_offset / 100,
-                                           (float)config->airspeed_slope / 100,
-                                           baro_temp,
-                                           baro_pressure,
-                                           malloc(sizeof(float))};
-        xTaskCreate(airspeed_task, "airspeed_task", STACK_AIRSPEED, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->airspeed[XBUS_AIRSPEED_AIRSPEED] = parameter.airspeed;
+        sensor->airspeed[XBUS_AIRSPEED_AIRSPEED] = &values->analog.airspeed;
         sensor->is_enabled[XBUS_AIRSPEED] = true;
-        sensor_formatted->airspeed = calloc(1, 16);
+        sensor_formatted->airspeed = pool_alloc(16);
         *sensor_formatted->airspeed = (xbus_airspeed_t){XBUS_AIRSPEED_ID, 0, 0, 0};
         i2c_multi_enable_address(XBUS_AIRSPEED_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_fuel_flow) {
-        fuel_meter_parameters_t parameter = {config->fuel_flow_ml_per_pulse, malloc(sizeof(float)),
-                                             malloc(sizeof(float))};
-        xTaskCreate(fuel_meter_task, "fuel_meter_task", STACK_FUEL_METER, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->fuel_flow[XBUS_FUEL_FLOW_RATE] = parameter.consumption_instant;
-        sensor->fuel_flow[XBUS_FUEL_FLOW_CONSUMED] = parameter.consumption_total;
+        sensor->fuel_flow[XBUS_FUEL_FLOW_RATE] = &values->fuel.consumption_instant;
+        sensor->fuel_flow[XBUS_FUEL_FLOW_CONSUMED] = &values->fuel.consumption_total;
         sensor->is_enabled[XBUS_FUEL_FLOW] = true;
-        sensor_formatted->fuel_flow = calloc(1, 16);
+        sensor_formatted->fuel_flow = pool_alloc(16);
         *sensor_formatted->fuel_flow = (xbus_fuel_flow_t){XBUS_FUEL_FLOW_ID, 0, 0, 0, 0, 0, 0, 0, 0};
         i2c_multi_enable_address(XBUS_FUEL_FLOW_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
     if (config->enable_fuel_pressure) {
-        xgzp68xxd_parameters_t parameter = {config->xgzp68xxd_k, malloc(sizeof(float)),
-                                             malloc(sizeof(float))};
-        xTaskCreate(xgzp68xxd_task, "fuel_pressure_task", STACK_FUEL_PRESSURE, (void *)&parameter, 2, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
-
-        sensor->stru_tele_digital_air[XBUS_FUEL_PRESSURE] = parameter.pressure;
+        sensor->stru_tele_digital_air[XBUS_FUEL_PRESSURE] = &values->fuel.pressure;
         sensor->is_enabled[XBUS_STRU_TELE_DIGITAL_AIR] = true;
-        sensor_formatted->stru_tele_digital_air = calloc(1, 16);
+        sensor_formatted->stru_tele_digital_air = pool_alloc(16);
         *sensor_formatted->stru_tele_digital_air = (xbus_stru_tele_digital_air_t){XBUS_STRU_TELE_DIGITAL_AIR_ID, 0, 0 ,0};
         i2c_multi_enable_address(XBUS_STRU_TELE_DIGITAL_AIR_ID);
-
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 
     if (config->xbus_clock_stretch) {
@@ -833,30 +557,18 @@ static void set_config() {
 }
 
 static uint8_t bcd8(float value, uint8_t precision) {
-    char buf[10] = {0};
-    uint8_t output = 0;
     for (int i = 0; i < precision; i++) value = value * 10;
-    sprintf(buf, "%02i", (uint8_t)value);
-    for (int i = 0; i < 2; i++) output |= (buf[i] - 48) << ((1 - i) * 4);
-    return output;
+    return format_bcd((uint8_t)value, 2);
 }
 
 static uint16_t bcd16(float value, uint8_t precision) {
-    char buf[10] = {0};
-    uint16_t output = 0;
     for (int i = 0; i < precision; i++) value = value * 10;
-    sprintf(buf, "%04i", (uint16_t)value);
-    for (int i = 0; i < 4; i++) output |= (uint16_t)(buf[i] - 48) << ((3 - i) * 4);
-    return output;
+    return format_bcd((uint16_t)value, 4);
 }
 
 static uint32_t bcd32(float value, uint8_t precision) {
-    char buf[10] = {0};
-    uint32_t output = 0;
     for (int i = 0; i < precision; i++) value = value * 10;
-    sprintf(buf, "%08li", (uint32_t)value);
-    for (int i = 0; i < 8; i++) output |= (uint32_t)(buf[i] - 48) << ((7 - i) * 4);
-    return output;
+    return format_bcd((uint32_t)value, 8);
 }
 
 static int64_t interval_250_callback(alarm_id_t id, void *parameters) {
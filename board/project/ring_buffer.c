@@ -0,0 +1,106 @@
+#include "ring_buffer.h"
+
+#include <string.h>
+
+#define load_acquire(VAR) __atomic_load_n(&(VAR), __ATOMIC_ACQUIRE)
+#define store_release(VAR, VALUE) __atomic_store_n(&(VAR), (VALUE), __ATOMIC_RELEASE)
+
+static inline uint32_t get_tail(ring_buffer_t *ring);
+static inline uint32_t get_free(ring_buffer_t *ring);
+
+void ring_buffer_init(ring_buffer_t *ring, uint8_t *buffer, uint32_t size) {
+    ring->buffer = buffer;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->reset_head = 0;
+    ring->reset_count = 0;
+    ring->reset_ack = 0;
+}
+
+/* Producer */
+
+void ring_buffer_reset(ring_buffer_t *ring) {
+    ring->reset_head = ring->head;
+    store_release(ring->reset_count, ring->reset_count + 1);
+}
+
+uint32_t ring_buffer_free(ring_buffer_t *ring) { return get_free(ring); }
+
+bool ring_buffer_put(ring_buffer_t *ring, uint8_t data) {
+    if (!get_free(ring)) return false;
+    uint32_t head = ring->head;
+    ring->buffer[head & ring->mask] = data;
+    store_release(ring->head, head + 1);
+    return true;
+}
+
+uint32_t ring_buffer_put_bytes(ring_buffer_t *ring, const uint8_t *data, uint32_t length) {
+    uint32_t free = get_free(ring);
+    if (length > free) length = free;
+    uint32_t head = ring->head;
+    uint32_t index = head & ring->mask;
+    uint32_t span = ring->mask + 1 - index;
+    if (span > length) span = length;
+    memcpy(ring->buffer + index, data, span);
+    memcpy(ring->buffer, data + span, length - span);
+    store_release(ring->head, head + length);
+    return length;
+}
+
+/* Consumer */
+
+uint32_t ring_buffer_available(ring_buffer_t *ring) { return load_acquire(ring->head) - get_tail(ring); }
+
+bool ring_buffer_get(ring_buffer_t *ring, uint8_t *data) {
+    uint32_t tail = get_tail(ring);
+    if (load_acquire(ring->head) == tail) return false;
+    *data = ring->buffer[tail & ring->mask];
+    store_release(ring->tail, tail + 1);
+    return true;
+}
+
+uint32_t ring_buffer_get_bytes(ring_buffer_t *ring, uint8_t *data, uint32_t length) {
+    uint32_t tail = get_tail(ring);
+    uint32_t available = load_acquire(ring->head) - tail;
+    if (length > available) length = available;
+    uint32_t index = tail & ring->mask;
+    uint32_t span = ring->mask + 1 - index;
+    if (span > length) span = length;
+    memcpy(data, ring->buffer + index, span);
+    memcpy(data + span, ring->buffer, length - span);
+    store_release(ring->tail, tail + length);
+    return length;
+}
+
+/* Returns the contiguous span readable in place. Release it with ring_buffer_consume() */
+uint32_t ring_buffer_peek(ring_buffer_t *ring, uint8_t **data) {
+    uint32_t tail = get_tail(ring);
+    uint32_t available = load_acquire(ring->head) - tail;
+    uint32_t index = tail & ring->mask;
+    uint32_t span = ring->mask + 1 - index;
+    *data = ring->buffer + index;
+    return available < span ? available : span;
+}
+
+void ring_buffer_consume(ring_buffer_t *ring, uint32_t length) {
+    uint32_t tail = get_tail(ring);
+    uint32_t available = load_acquire(ring->head) - tail;
+    if (length > available) length = available;
+    store_release(ring->tail, tail + length);
+}
+
+/* Apply a pending producer reset. Tail is updated before the ack so the producer never sees a stale free space */
+static inline uint32_t get_tail(ring_buffer_t *ring) {
+    uint32_t reset_count = load_acquire(ring->reset_count);
+    if (reset_count != ring->reset_ack) {
+        store_release(ring->tail, ring->reset_head);
+        store_release(ring->reset_ack, reset_count);
+    }
+    return ring->tail;
+}
+
+static inline uint32_t get_free(ring_buffer_t *ring) {
+    uint32_t tail = load_acquire(ring->reset_ack) != ring->reset_count ? ring->reset_head : load_acquire(ring->tail);
+    return ring->mask + 1 - (ring->head - tail);
+}
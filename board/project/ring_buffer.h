@@ -0,0 +1,32 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+   Lock free single producer / single consumer byte ring
+   Producer (ISR) owns head, consumer (task) owns tail. Size must be a power of 2
+   ring_buffer_reset() is called from the producer side and is applied by the consumer on its next access
+*/
+
+typedef struct ring_buffer_t {
+    uint8_t *buffer;
+    uint32_t mask;
+    volatile uint32_t head, tail;
+    volatile uint32_t reset_head, reset_count;
+    uint32_t reset_ack;
+} ring_buffer_t;
+
+void ring_buffer_init(ring_buffer_t *ring, uint8_t *buffer, uint32_t size);
+void ring_buffer_reset(ring_buffer_t *ring);
+uint32_t ring_buffer_free(ring_buffer_t *ring);
+bool ring_buffer_put(ring_buffer_t *ring, uint8_t data);
+uint32_t ring_buffer_put_bytes(ring_buffer_t *ring, const uint8_t *data, uint32_t length);
+uint32_t ring_buffer_available(ring_buffer_t *ring);
+bool ring_buffer_get(ring_buffer_t *ring, uint8_t *data);
+uint32_t ring_buffer_get_bytes(ring_buffer_t *ring, uint8_t *data, uint32_t length);
+uint32_t ring_buffer_peek(ring_buffer_t *ring, uint8_t **data);
+void ring_buffer_consume(ring_buffer_t *ring, uint32_t length);
+
+#endif
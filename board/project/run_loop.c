@@ -0,0 +1,101 @@
+#include "run_loop.h"
+
+#include <string.h>
+
+#include "pool.h"
+
+typedef struct run_loop_entry_t {
+    run_loop_job_t job;
+    void *parameters;
+    uint32_t due_ms, delay_ms;
+    bool is_used;
+} run_loop_entry_t;
+
+static run_loop_entry_t entries[RUN_LOOP_MAX_JOBS];
+static bool is_started;
+
+static uint32_t now_ms(void);
+static uint32_t run_due(void);
+#ifndef RUN_LOOP
+static void job_task(void *parameters);
+#endif
+
+void run_loop_start(run_loop_job_t job, const void *parameters, size_t size, uint32_t delay_ms, const char *name,
+                    uint stack, UBaseType_t priority) {
+    void *copy = pool_alloc(size);
+    memcpy(copy, parameters, size);
+#ifdef RUN_LOOP
+    uint i = 0;
+    bool is_first;
+    taskENTER_CRITICAL();
+    while (i < RUN_LOOP_MAX_JOBS && entries[i].is_used) i++;
+    if (i < RUN_LOOP_MAX_JOBS) entries[i] = (run_loop_entry_t){job, copy, now_ms() + delay_ms, delay_ms, true};
+    is_first = !is_started;
+    is_started = true;
+    taskEXIT_CRITICAL();
+    if (i == RUN_LOOP_MAX_JOBS) {
+        debug("\nRun loop. Full, %s not started", name);
+        return;
+    }
+    // The task is created with the first job, so configurations without jobs do not take its stack
+    if (is_first)
+        pool_task_create_on_core(run_loop_task, "run_loop_task", STACK_RUN_LOOP, NULL, 2, CORE_SENSOR,
+                                 &context.run_loop_task_handle);
+    else if (context.run_loop_task_handle)
+        xTaskNotifyGive(context.run_loop_task_handle);
+#else
+    run_loop_entry_t *entry = pool_alloc(sizeof(run_loop_entry_t));
+    *entry = (run_loop_entry_t){job, copy, 0, delay_ms, true};
+    pool_task_create_on_core(job_task, name, stack, entry, priority, CORE_SENSOR, NULL);
+#endif
+}
+
+void run_loop_task(void *parameters) {
+    while (1) {
+        uint32_t wait_ms = run_due();
+        ulTaskNotifyTake(pdTRUE, wait_ms == UINT32_MAX ? portMAX_DELAY
+                                                        : (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS);
+    }
+}
+
+void run_loop_reset(void) {
+    memset(entries, 0, sizeof(entries));
+    is_started = false;
+}
+
+static uint32_t now_ms(void) { return to_ms_since_boot(get_absolute_time()); }
+
+/* Runs the due jobs and returns the ms to the next one */
+static uint32_t run_due(void) {
+    uint32_t wait_ms = UINT32_MAX;
+    for (uint i = 0; i < RUN_LOOP_MAX_JOBS; i++) {
+        run_loop_entry_t *entry = &entries[i];
+        if (!entry->is_used) continue;
+        int32_t remaining_ms = entry->due_ms - now_ms();
+        if (remaining_ms <= 0) {
+            uint32_t delay_ms = entry->job(entry->parameters);
+            if (!delay_ms) {
+                entry->is_used = false;
+                continue;
+            }
+            entry->due_ms = now_ms() + delay_ms;
+            remaining_ms = delay_ms;
+        }
+        if ((uint32_t)remaining_ms < wait_ms) wait_ms = remaining_ms;
+    }
+    return wait_ms;
+}
+
+#ifndef RUN_LOOP
+/* One task per job */
+static void job_task(void *parameters) {
+    run_loop_entry_t *entry = parameters;
+    uint32_t delay_ms = entry->delay_ms;
+    do {
+        vTaskDelay(delay_ms / portTICK_PERIOD_MS);
+        delay_ms = entry->job(entry->parameters);
+    } while (delay_ms);
+    entry->is_used = false;
+    vTaskDelete(NULL);
+}
+#endif
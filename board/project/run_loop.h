@@ -0,0 +1,25 @@
+#ifndef RUN_LOOP_H
+#define RUN_LOOP_H
+
+#include "common.h"
+
+/*
+   Run loop
+   Light periodic jobs (cell count, auto offsets, vspeed) are callbacks that return the delay to their next
+   run in ms, or 0 when they are done. run_loop_start() copies the parameters and, with RUN_LOOP (common.h), adds the
+   job to the table of the single run loop task, created with the first job, which sleeps until the earliest job is
+   due. Without RUN_LOOP each job gets its own task, as before. Jobs share the run loop stack and must not block
+*/
+
+#define RUN_LOOP_MAX_JOBS 8
+
+typedef uint32_t (*run_loop_job_t)(void *parameters);
+
+extern context_t context;
+
+void run_loop_start(run_loop_job_t job, const void *parameters, size_t size, uint32_t delay_ms, const char *name,
+                    uint stack, UBaseType_t priority);
+void run_loop_task(void *parameters);
+void run_loop_reset(void);
+
+#endif
@@ -3,7 +3,7 @@
 #include <math.h>
 #include <stdio.h>
 
-#include "hardware/adc.h"
+#include "adc_sampler.h"
 #include "pico/stdlib.h"
 
 /* If there is not barometer sensor installed, values used to calculate air density are:
@@ -16,9 +16,7 @@
 
 void airspeed_task(void *parameters) {
     airspeed_parameters_t parameter = *(airspeed_parameters_t *)parameters;
-    adc_init();
-    adc_gpio_init(parameter.adc_num + 26);
-    //gpio_pull_down(parameter.adc_num + 26);
+    adc_sampler_add(parameter.adc_num);
     *parameter.airspeed = 0;
     xTaskNotifyGive(context.receiver_task_handle);
     float temperature, pressure, delta_pressure, air_density, airspeed;
@@ -4,19 +4,16 @@
 
 #include "pico/stdlib.h"
 
-void auto_offset_float_task(void *parameters) {
-    auto_offset_float_parameters_t parameter = *(auto_offset_float_parameters_t *)parameters;
-    vTaskDelay(parameter.delay / portTICK_PERIOD_MS);
-    *parameter.offset = *parameter.value;
-    debug("\nAuto offset float (%u): %.2f", uxTaskGetStackHighWaterMark(NULL), *parameter.offset);
-    vTaskDelete(NULL);
+uint32_t auto_offset_float_job(void *parameters) {
+    auto_offset_float_parameters_t *parameter = (auto_offset_float_parameters_t *)parameters;
+    *parameter->offset = *parameter->value;
+    debug("\nAuto offset float (%u): %.2f", uxTaskGetStackHighWaterMark(NULL), *parameter->offset);
+    return 0;
 }
 
-void auto_offset_int_task(void *parameters) {
-    auto_offset_int_parameters_t parameter = *(auto_offset_int_parameters_t *)parameters;
-    vTaskDelay(parameter.delay / portTICK_PERIOD_MS);
-    *parameter.offset = *parameter.value;
-    int val = *parameter.value;
+uint32_t auto_offset_int_job(void *parameters) {
+    auto_offset_int_parameters_t *parameter = (auto_offset_int_parameters_t *)parameters;
+    *parameter->offset = *parameter->value;
     debug("\nAuto offset int (%u)", uxTaskGetStackHighWaterMark(NULL));
-    vTaskDelete(NULL);
+    return 0;
 }
\ No newline at end of file
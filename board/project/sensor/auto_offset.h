@@ -4,14 +4,12 @@
 #include "common.h"
 
 typedef struct auto_offset_float_parameters_t {
-    uint delay;
     float *value;
     float *offset;
 
 } auto_offset_float_parameters_t;
 
 typedef struct auto_offset_int_parameters_t {
-    uint delay;
     int *value;
     int *offset;
 
@@ -19,7 +17,7 @@ typedef struct auto_offset_int_parameters_t {
 
 extern context_t context;
 
-void auto_offset_float_task(void *parameters);
-void auto_offset_int_task(void *parameters);
+uint32_t auto_offset_float_job(void *parameters);
+uint32_t auto_offset_int_job(void *parameters);
 
 #endif
\ No newline at end of file
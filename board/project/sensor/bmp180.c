@@ -110,10 +110,12 @@ static void read(bmp180_parameters_t *parameter, bmp180_calibration_t *calibrati
     X2 = (-7357 * p) >> 16;
     p = p + ((X1 + X2 + 3791) >> 4);
 
+    seqlock_write_begin(parameter->lock);
     *parameter->pressure = p;  // Pa    calcAverage((float)alphaVario_ / 100, pressure_, p);
     if (pressure_initial == 0 && discard_readings == 0) pressure_initial = *parameter->pressure;
     *parameter->altitude = get_altitude(*parameter->pressure, *parameter->temperature, pressure_initial);
     get_vspeed(parameter->vspeed, *parameter->altitude, VSPEED_INTERVAL_MS);
+    seqlock_write_end(parameter->lock);
     if (discard_readings > 0) discard_readings--;
     debug("\nBMP180 P0: %.0f", pressure_initial);
 #ifdef SIM_SENSORS
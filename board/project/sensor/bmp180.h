@@ -2,12 +2,14 @@
 #define BMP180_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct bmp180_parameters_t {
     float alpha_vario;
     bool auto_offset;
     uint8_t address;
     float *temperature, *pressure, *altitude, *vspeed;
+    seqlock_t *lock;
 } bmp180_parameters_t;
 
 typedef struct bmp180_calibration_t {
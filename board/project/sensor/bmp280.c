@@ -115,6 +115,7 @@ static void read(bmp280_parameters_t *parameter, bmp280_calibration_t *calibrati
     var1 = ((var1 * var1 * (int64_t)calibration->P3) >> 8) + ((var1 * (int64_t)calibration->P2) << 12);
     var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)calibration->P1) >> 33;
 
+    seqlock_write_begin(parameter->lock);
     if (var1 != 0) {
         p = 1048576 - adc_P;
         p = (((p << 31) - var2) * 3125) / var1;
@@ -128,6 +129,7 @@ static void read(bmp280_parameters_t *parameter, bmp280_calibration_t *calibrati
     if (pressure_initial == 0 && discard_readings == 0) pressure_initial = *parameter->pressure;
     *parameter->altitude = get_altitude(*parameter->pressure, *parameter->temperature, pressure_initial);
     get_vspeed(parameter->vspeed, *parameter->altitude, VSPEED_INTERVAL_MS);
+    seqlock_write_end(parameter->lock);
     if (discard_readings > 0) discard_readings--;
     debug("\nBMP280 P0: %.0f", pressure_initial);
 #ifdef SIM_SENSORS
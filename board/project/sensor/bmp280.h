@@ -2,6 +2,7 @@
 #define BMP280_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct bmp280_parameters_t {
     float alpha_vario;
@@ -9,6 +10,7 @@ typedef struct bmp280_parameters_t {
     uint8_t address;
     uint8_t filter;
     float *temperature, *pressure, *altitude, *vspeed;
+    seqlock_t *lock;
 } bmp280_parameters_t;
 
 typedef struct bmp280_calibration_t {
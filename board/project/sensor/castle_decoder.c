@@ -0,0 +1,47 @@
+#include "castle_decoder.h"
+
+#define CASTLE_DECODER_RATIO_MAX (1UL << 20)  // garbage widths, keeps ratio * 1021 in 32 bits
+
+static const float scaler[CASTLE_LINK_PULSES] = {0, 20, 4, 50, 1, 0.2502, 20416.7, 4, 4, 30, 63.8125};
+
+static uint32_t get_ratio(uint16_t value, uint32_t calibration);
+
+/* ntc 10k beta 3455 with 10k2 in series */
+void castle_decoder_init(castle_decoder_t *decoder) {
+    thermistor_init_beta(&decoder->thermistor, 3455, 10000, 25, 10200);
+}
+
+bool castle_decoder_decode(const castle_decoder_t *decoder, const castle_link_frame_t *frame,
+                           castle_link_telemetry_t *packet) {
+    const uint16_t *value = frame->value;
+    uint32_t calibration;
+    packet->is_temp_ntc = value[9] < value[10];
+    if (packet->is_temp_ntc) {
+        calibration = value[0] / 2 + value[9];
+        if (!calibration) return false;
+        // ntc voltage over 255, 63.8125 / 255 = 1021 / 4080
+        uint32_t ratio = get_ratio(value[10], calibration) * 1021 / 4080;
+        packet->temperature = ratio ? thermistor_temperature(&decoder->thermistor, ratio) : 0;
+    } else {
+        calibration = value[0] / 2 + value[10];
+        if (!calibration) return false;
+        packet->temperature = get_ratio(value[9], calibration) * scaler[9] / 65536;
+    }
+    packet->voltage = get_ratio(value[1], calibration) * scaler[1] / 65536;
+    packet->ripple_voltage = get_ratio(value[2], calibration) * scaler[2] / 65536;
+    packet->current = get_ratio(value[3], calibration) * scaler[3] / 65536;
+    packet->thr = get_ratio(value[4], calibration) * scaler[4] / 65536;
+    packet->output = get_ratio(value[5], calibration) * scaler[5] / 65536;
+    packet->rpm = get_ratio(value[6], calibration) * scaler[6] / 65536;
+    packet->voltage_bec = get_ratio(value[7], calibration) * scaler[7] / 65536;
+    packet->current_bec = get_ratio(value[8], calibration) * scaler[8] / 65536;
+    if (packet->temperature < 0) packet->temperature = 0;
+    return true;
+}
+
+/* (value - calibration / 2) / calibration in 1/65536, 0 if negative */
+static uint32_t get_ratio(uint16_t value, uint32_t calibration) {
+    if (value <= calibration / 2) return 0;
+    uint32_t ratio = ((uint32_t)(value - calibration / 2) << 16) / calibration;
+    return ratio < CASTLE_DECODER_RATIO_MAX ? ratio : CASTLE_DECODER_RATIO_MAX;
+}
@@ -0,0 +1,44 @@
+#ifndef CASTLE_DECODER_H
+#define CASTLE_DECODER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "thermistor.h"
+
+/*
+   Castle link decoder
+   Converts a frame of the raw pulse widths captured by castle_link.c (pio counter units) into telemetry. Each value is
+   offset by half the 1000us calibration pulse and divided by the calibration as an integer 1/65536 ratio, then
+   multiplied by its scaler. The temperature is either linear or the ntc of the esc, whichever of values 9 and 10 is
+   not the 500us calibration. Runs in a task, not in the pio irq
+*/
+
+#define CASTLE_LINK_PULSES 11
+
+typedef struct castle_link_frame_t {
+    uint16_t value[CASTLE_LINK_PULSES];  // the sync is not included
+} castle_link_frame_t;
+
+typedef struct castle_link_telemetry_t {
+    float voltage;
+    float ripple_voltage;
+    float current;
+    float thr;
+    float output;
+    float rpm;
+    float voltage_bec;
+    float current_bec;
+    float temperature;
+    bool is_temp_ntc;
+} castle_link_telemetry_t;
+
+typedef struct castle_decoder_t {
+    thermistor_t thermistor;
+} castle_decoder_t;
+
+void castle_decoder_init(castle_decoder_t *decoder);
+bool castle_decoder_decode(const castle_decoder_t *decoder, const castle_link_frame_t *frame,
+                           castle_link_telemetry_t *packet);
+
+#endif
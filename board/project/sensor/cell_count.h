@@ -4,13 +4,12 @@
 #include "common.h"
 
 typedef struct cell_count_parameters_t {
-    uint delay;
     float *voltage;
     uint8_t *cell_count;
 } cell_count_parameters_t;
 
 extern context_t context;
 
-void cell_count_task(void *parameters);
+uint32_t cell_count_job(void *parameters);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "coulomb.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "common.h"
+
+#define COULOMB_CURRENT_MAX 2000  // A, keeps uA in 32 bits
+
+static bool start(coulomb_t *coulomb, float current, uint32_t now, int32_t *current_ua, uint32_t *interval);
+
+void coulomb_init(coulomb_t *coulomb, float current_max, uint8_t source) {
+    memset(coulomb, 0, sizeof(coulomb_t));
+    if (current_max > 0 && current_max < COULOMB_CURRENT_MAX) coulomb->current_max = current_max * 1000000;
+#ifdef CONSUMPTION_LOG
+    coulomb_log_init(&coulomb->log, source, &coulomb->charge);
+    coulomb->logged = coulomb->charge;
+#endif
+}
+
+void coulomb_sample(coulomb_t *coulomb, float current, uint32_t now) {
+    int32_t current_ua;
+    uint32_t interval;
+    if (!start(coulomb, current, now, &current_ua, &interval)) return;
+    coulomb->charge += ((int64_t)coulomb->current + current_ua) * interval / 2;
+    coulomb->current = current_ua;
+}
+
+void coulomb_mean(coulomb_t *coulomb, float current, uint32_t now) {
+    int32_t current_ua;
+    uint32_t interval;
+    if (!start(coulomb, current, now, &current_ua, &interval)) return;
+    coulomb->charge += (int64_t)current_ua * interval;
+    coulomb->current = current_ua;
+}
+
+void coulomb_checkpoint(coulomb_t *coulomb) {
+#ifdef CONSUMPTION_LOG
+    if (!coulomb->is_started || coulomb->current > COULOMB_LOG_IDLE_UA || coulomb->current < -COULOMB_LOG_IDLE_UA ||
+        coulomb->timestamp - coulomb->logged_timestamp < COULOMB_LOG_INTERVAL_US ||
+        coulomb->charge - coulomb->logged < COULOMB_UA_US_PER_MAH)
+        return;
+    coulomb->logged_timestamp = coulomb->timestamp;
+    if (coulomb_log_write(&coulomb->log, coulomb->charge)) coulomb->logged = coulomb->charge;
+#endif
+}
+
+/* Integer nAh first, a float would lose the low digits of a large charge */
+float coulomb_get(const coulomb_t *coulomb) { return (coulomb->charge / (COULOMB_UA_US_PER_MAH / 1000000)) / 1e6F; }
+
+/* False if there is nothing to integrate: glitch, first sample or gap */
+static bool start(coulomb_t *coulomb, float current, uint32_t now, int32_t *current_ua, uint32_t *interval) {
+    if (isnan(current) || fabsf(current) > COULOMB_CURRENT_MAX) return false;
+    *current_ua = current * 1000000;
+    if (coulomb->current_max && *current_ua > coulomb->current_max) return false;
+    *interval = now - coulomb->timestamp;
+    if (!coulomb->is_started || *interval > COULOMB_GAP_US) {
+        coulomb->current = *current_ua;
+        coulomb->timestamp = now;
+        if (!coulomb->is_started) coulomb->logged_timestamp = now;
+        coulomb->is_started = true;
+        return false;
+    }
+    coulomb->timestamp = now;
+    return true;
+}
+
@@ -0,0 +1,43 @@
+#ifndef COULOMB_H
+#define COULOMB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "coulomb_log.h"
+
+/*
+   Coulomb counter
+   Integrates the current of a source in uA us with a 64 bit accumulator, so the resolution does not drop as the
+   consumption grows. coulomb_sample() takes a current measured at an instant (esc telemetry) and adds the trapezoid
+   since the previous sample. coulomb_mean() takes the mean current since the previous call (adc_sampler_total()), so
+   every adc sample is integrated. Times are time_us_32(). A gap over COULOMB_GAP_US means the source was lost, it is
+   not integrated and the next sample starts again. A sample over current_max (A, 0 none) is a glitch and is skipped,
+   the next one integrates across it. With CONSUMPTION_LOG (common.h) the charge is restored at init and
+   coulomb_checkpoint() writes it to flash (coulomb_log.h) at most every COULOMB_LOG_INTERVAL_US, once it grew by 1 mAh
+   and only while the last current is within COULOMB_LOG_IDLE_UA (motor stopped), as the write stalls both cores.
+   Call it out of the seqlock write of the sensor values, so the readers do not spin on it
+*/
+
+#define COULOMB_GAP_US 2000000
+#define COULOMB_UA_US_PER_MAH 3600000000000LL
+#define COULOMB_LOG_INTERVAL_US 10000000
+#define COULOMB_LOG_IDLE_UA 1000000
+
+typedef struct coulomb_t {
+    int64_t charge;   // uA us
+    int64_t logged;   // charge of the last checkpoint
+    int32_t current;  // uA, last sample
+    int32_t current_max;
+    uint32_t timestamp, logged_timestamp;
+    bool is_started;
+    coulomb_log_t log;
+} coulomb_t;
+
+void coulomb_init(coulomb_t *coulomb, float current_max, uint8_t source);
+void coulomb_sample(coulomb_t *coulomb, float current, uint32_t now);
+void coulomb_mean(coulomb_t *coulomb, float current, uint32_t now);
+void coulomb_checkpoint(coulomb_t *coulomb);
+float coulomb_get(const coulomb_t *coulomb);  // mAh
+
+#endif
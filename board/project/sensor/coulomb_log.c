@@ -0,0 +1,98 @@
+#include "coulomb_log.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "crc.h"
+#include "hardware/regs/addressmap.h"
+#include "pico/flash.h"
+
+#define COULOMB_LOG_SECTORS 2
+
+typedef struct coulomb_log_page_t {
+    uint32_t offset;
+    uint8_t data[FLASH_PAGE_SIZE];
+} coulomb_log_page_t;
+
+static const coulomb_log_record_t *get_record(const coulomb_log_t *log, uint16_t index);
+static bool is_valid(const coulomb_log_record_t *record, uint8_t source);
+static bool is_erased(const coulomb_log_record_t *record);
+static uint16_t get_crc(const coulomb_log_record_t *record);
+static void erase_flash(void *data);
+static void write_flash(void *data);
+
+bool coulomb_log_init(coulomb_log_t *log, uint8_t source, int64_t *charge) {
+    bool is_found = false;
+    log->offset = COULOMB_LOG_FLASH_OFFSET + source * COULOMB_LOG_SECTORS * FLASH_SECTOR_SIZE;
+    log->source = source;
+    log->sequence = 0;
+    log->index = 0;
+    for (uint16_t i = 0; i < COULOMB_LOG_SECTORS * COULOMB_LOG_RECORDS; i++) {
+        const coulomb_log_record_t *record = get_record(log, i);
+        if (!is_valid(record, source) || (is_found && record->sequence < log->sequence)) continue;
+        *charge = record->charge;
+        log->sequence = record->sequence + 1;
+        log->index = (i + 1) % (COULOMB_LOG_SECTORS * COULOMB_LOG_RECORDS);
+        is_found = true;
+    }
+    // the sector the log moves into next never holds the last record
+    uint16_t spare = (log->index / COULOMB_LOG_RECORDS + (log->index % COULOMB_LOG_RECORDS ? 1 : 0)) %
+                     COULOMB_LOG_SECTORS;
+    log->is_spare_erased = true;
+    for (uint16_t i = spare * COULOMB_LOG_RECORDS; i < (spare + 1) * COULOMB_LOG_RECORDS; i++)
+        if (!is_erased(get_record(log, i))) log->is_spare_erased = false;
+    if (!log->is_spare_erased) {
+        uint32_t offset = log->offset + spare * FLASH_SECTOR_SIZE;
+        log->is_spare_erased = !flash_safe_execute(erase_flash, &offset, UINT32_MAX);
+    }
+    return is_found;
+}
+
+bool coulomb_log_write(coulomb_log_t *log, int64_t charge) {
+    coulomb_log_page_t page;
+    uint16_t index = log->index;
+    // a record torn by a reset is not programmed again, unless its sector is erased first
+    while (index % COULOMB_LOG_RECORDS && !is_erased(get_record(log, index)))
+        index = (index + 1) % (COULOMB_LOG_SECTORS * COULOMB_LOG_RECORDS);
+    // moving into the other sector: only if coulomb_log_init() erased it, otherwise the log is full until next start
+    bool is_new_sector = !(index % COULOMB_LOG_RECORDS);
+    if (is_new_sector && !log->is_spare_erased) return false;
+    coulomb_log_record_t record = {.charge = charge, .sequence = log->sequence, .source = log->source};
+    record.crc = get_crc(&record);
+    uint32_t offset = index * sizeof(coulomb_log_record_t);
+    page.offset = log->offset + offset / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+    memset(page.data, 0xFF, FLASH_PAGE_SIZE);
+    memcpy(&page.data[offset % FLASH_PAGE_SIZE], &record, sizeof(coulomb_log_record_t));
+    if (flash_safe_execute(write_flash, &page, UINT32_MAX)) return false;
+    if (is_new_sector) log->is_spare_erased = false;
+    log->sequence++;
+    log->index = (index + 1) % (COULOMB_LOG_SECTORS * COULOMB_LOG_RECORDS);
+    return true;
+}
+
+static const coulomb_log_record_t *get_record(const coulomb_log_t *log, uint16_t index) {
+    return (const coulomb_log_record_t *)(XIP_BASE + log->offset) + index;
+}
+
+static bool is_valid(const coulomb_log_record_t *record, uint8_t source) {
+    return record->sequence != UINT32_MAX && record->source == source && record->crc == get_crc(record);
+}
+
+static bool is_erased(const coulomb_log_record_t *record) {
+    const uint8_t *data = (const uint8_t *)record;
+    for (uint i = 0; i < sizeof(coulomb_log_record_t); i++)
+        if (data[i] != 0xFF) return false;
+    return true;
+}
+
+static uint16_t get_crc(const coulomb_log_record_t *record) {
+    return crc16_srxl(0xFFFF, (const uint8_t *)record, offsetof(coulomb_log_record_t, crc));
+}
+
+static void erase_flash(void *data) { flash_range_erase(*(uint32_t *)data, FLASH_SECTOR_SIZE); }
+
+/* Other bytes of the page are 0xFF, programming them leaves the records already there */
+static void write_flash(void *data) {
+    coulomb_log_page_t *page = data;
+    flash_range_program(page->offset, page->data, FLASH_PAGE_SIZE);
+}
@@ -0,0 +1,45 @@
+#ifndef COULOMB_LOG_H
+#define COULOMB_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hardware/flash.h"
+
+/*
+   Coulomb log
+   Wear levelled checkpoints of a consumption in flash. Each source owns two sectors after the config sector, filled
+   with 16 byte records in turn: a checkpoint programs the next free record only (one page write, the other bytes of
+   the page are left erased). coulomb_log_init() restores the record with the highest sequence and a valid crc, so a
+   reset during a write or an erase falls back to the previous checkpoint, then erases the sector the log moves into
+   next, which does not hold the last record. Flash is written with both cores stalled: the erase (45-50 ms) is only
+   done there, at start, and a checkpoint costs one page program (about 1 ms). From a start, the log takes the rest of
+   its sector and COULOMB_LOG_RECORDS more, then coulomb_log_write() fails until the next start
+*/
+
+#define COULOMB_LOG_FLASH_OFFSET (512 * 1024 + FLASH_SECTOR_SIZE)  // after the config sector (config.c)
+#define COULOMB_LOG_RECORDS (FLASH_SECTOR_SIZE / sizeof(coulomb_log_record_t))  // per sector
+
+#define COULOMB_SOURCE_ESC 0
+#define COULOMB_SOURCE_CURRENT 1
+#define COULOMB_LOG_SOURCES 2
+
+typedef struct coulomb_log_record_t {
+    int64_t charge;
+    uint32_t sequence;
+    uint16_t source;
+    uint16_t crc;
+} coulomb_log_record_t;
+
+typedef struct coulomb_log_t {
+    uint32_t offset;    // first sector
+    uint32_t sequence;  // of the next record
+    uint16_t index;     // next record, 0 to 2 * COULOMB_LOG_RECORDS - 1
+    uint8_t source;
+    bool is_spare_erased;  // the sector the log moves into next
+} coulomb_log_t;
+
+bool coulomb_log_init(coulomb_log_t *log, uint8_t source, int64_t *charge);  // false if there is no checkpoint
+bool coulomb_log_write(coulomb_log_t *log, int64_t charge);
+
+#endif
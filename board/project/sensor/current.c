@@ -4,25 +4,26 @@
 #include <stdio.h>
 
 #include "auto_offset.h"
-#include "hardware/adc.h"
+#include "adc_sampler.h"
+#include "coulomb.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
 
 void current_task(void *parameters) {
-    static uint32_t timestamp = 0;
+    coulomb_t coulomb;
     current_parameters_t parameter = *(current_parameters_t *)parameters;
+    coulomb_init(&coulomb, 0, COULOMB_SOURCE_CURRENT);
     *parameter.voltage = 0;
     *parameter.current = 0;
-    *parameter.consumption = 0;
+    *parameter.consumption = coulomb_get(&coulomb);
     xTaskNotifyGive(context.receiver_task_handle);
-    adc_init();
-    adc_gpio_init(parameter.adc_num + 26);
-    //gpio_pull_down(parameter.adc_num + 26);
+    adc_sampler_add(parameter.adc_num);
+    adc_decimator_total_t last = adc_sampler_total(parameter.adc_num);
     if (parameter.auto_offset) {
         parameter.offset = -1;
-        auto_offset_float_parameters_t parameter_auto_offset = {5000, parameter.voltage, &parameter.offset};
-        TaskHandle_t task_handle;
-        xTaskCreate(auto_offset_float_task, "analog_current_auto_offset_task", STACK_AUTO_OFFSET,
-                    &parameter_auto_offset, 2, &task_handle);
+        auto_offset_float_parameters_t parameter_auto_offset = {parameter.voltage, &parameter.offset};
+        run_loop_start(auto_offset_float_job, &parameter_auto_offset, sizeof(parameter_auto_offset), 5000,
+                       "analog_current_auto_offset_task", STACK_AUTO_OFFSET, 2);
     }
 
     while (1) {
@@ -31,9 +32,15 @@ void current_task(void *parameters) {
             *parameter.current = get_average(parameter.alpha, *parameter.current,
                                              (*parameter.voltage - parameter.offset) * parameter.multiplier);
 
-        if (time_us_32() > 6000000) {
-            *parameter.consumption += get_consumption(*parameter.current, 0, &timestamp);
+        // mean of all the samples since the previous loop, once the offset is known
+        adc_decimator_total_t total = adc_sampler_total(parameter.adc_num);
+        if (parameter.offset != -1 && total.samples != last.samples) {
+            float voltage = (float)(total.sum - last.sum) / (total.samples - last.samples) * BOARD_VCC / ADC_RESOLUTION;
+            coulomb_mean(&coulomb, (voltage - parameter.offset) * parameter.multiplier, time_us_32());
+            *parameter.consumption = coulomb_get(&coulomb);
+            coulomb_checkpoint(&coulomb);
         }
+        last = total;
 #ifdef SIM_SENSORS
         *parameter.current = 12.34;
         *parameter.consumption = 120.34;
@@ -46,6 +53,5 @@ void current_task(void *parameters) {
 }
 
 float current_read(uint8_t adc_num) {
-    adc_select_input(adc_num);
-    return adc_read() * BOARD_VCC / ADC_RESOLUTION;
+    return adc_sampler_read(adc_num) * BOARD_VCC / (ADC_RESOLUTION << ADC_DECIMATOR_EXTRA_BITS);
 }
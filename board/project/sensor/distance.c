@@ -1,51 +1,86 @@
 #include "distance.h"
 
 #include <math.h>
-#include <stdio.h>
+#include <string.h>
 
-#include "pico/stdlib.h"
+#define HOME_SAT_MIN 4
+#define EARTH_RADIUS_M 6371000.0F
+#define PI_F 3.14159265F
+#define RADIANS_PER_E7 (PI_F / 180 / 1e7F)
+#define METERS_PER_E7 (EARTH_RADIUS_M * RADIANS_PER_E7)
 
-#define INIT_DELAY_MS 1000
-#define INTERVAL_MS 500
+static int32_t delta_lon(int32_t lon, int32_t lon_from);
+static float ground_step(const distance_t *distance, int32_t lat, int32_t lon, int32_t lat_from, int32_t lon_from,
+                         float *dx, float *dy);
+static float haversine(int32_t lat, int32_t lon, int32_t lat_home, int32_t lon_home, float *bearing);
+static float to_bearing(float radians);
 
-static float degrees_to_radians(float degrees);
-static float get_distance_to_home(float lat, float lon, float alt, float lat_init, float lon_init, float alt_init);
+void distance_init(distance_t *distance) { memset(distance, 0, sizeof(distance_t)); }
 
-void distance_task(void *parameters) {
-    distance_parameters_t parameter = *(distance_parameters_t *)parameters;
-    *parameter.distance = 0;
-    while (*parameter.sat < 4) {
-        vTaskDelay(INIT_DELAY_MS / portTICK_PERIOD_MS);
+void distance_update(distance_t *distance, const gps_fix_t *fix) {
+    if (fix->sat < HOME_SAT_MIN) return;
+    if (!distance->is_home_set) {
+        distance->lat_home = fix->lat;
+        distance->lon_home = fix->lon;
+        distance->alt_home = fix->alt;
+        distance->cos_lat_home = cosf(fix->lat * RADIANS_PER_E7);
+        distance->sin_lat_home = sinf(fix->lat * RADIANS_PER_E7);
+        distance->lat_odometer = fix->lat;
+        distance->lon_odometer = fix->lon;
+        distance->is_home_set = true;
     }
-    float latitude_init = *parameter.latitude;
-    float longitude_init = *parameter.longitude;
-    float altitude_init = *parameter.altitude;
-    while (1) {
-        if (*parameter.sat >= 4)
-            *parameter.distance =
-                get_distance_to_home(*parameter.latitude, *parameter.longitude, *parameter.altitude, latitude_init,
-                                     longitude_init, altitude_init);
-#ifdef SIM_SENSORS
-        *parameter.distance = 1234.56;
-#endif
-        debug("\nDistance (%u): %.2f", uxTaskGetStackHighWaterMark(NULL), *parameter.distance);
-        vTaskDelay(INTERVAL_MS / portTICK_PERIOD_MS);
+    float ground = distance_to_home(distance, fix->lat, fix->lon, &distance->bearing);
+    float height = (fix->alt - distance->alt_home) / 1000.0F;
+    distance->distance = sqrtf(ground * ground + height * height);
+    float dx, dy;
+    float step = ground_step(distance, fix->lat, fix->lon, distance->lat_odometer, distance->lon_odometer, &dx, &dy);
+    if (step >= DISTANCE_ODOMETER_STEP_M) {
+        distance->odometer += step;
+        distance->lat_odometer = fix->lat;
+        distance->lon_odometer = fix->lon;
     }
 }
 
-static float degrees_to_radians(float degrees) {
-    return degrees * 3.1416 / 180;  // TODO: fix PI
+/* Ground distance (m) from lat, lon (deg * 1e7) to home, and the bearing to home if not NULL */
+float distance_to_home(const distance_t *distance, int32_t lat, int32_t lon, float *bearing) {
+    float dx, dy;
+    float ground = ground_step(distance, distance->lat_home, distance->lon_home, lat, lon, &dx, &dy);
+    if (ground > DISTANCE_EQUIRECTANGULAR_MAX_M)
+        return haversine(lat, lon, distance->lat_home, distance->lon_home, bearing);
+    if (bearing) *bearing = ground ? to_bearing(atan2f(dx, dy)) : 0;
+    return ground;
 }
 
-static float get_distance_to_home(float lat, float lon, float alt, float lat_init, float lon_init, float alt_init) {
-    uint16_t earth_radius_km = 6371;
-    float rad_lat_init = degrees_to_radians(lat_init);
-    float rad_lat_delta = degrees_to_radians(lat_init - lat);
-    float rad_lon_delta = degrees_to_radians(lon_init - lon);
-    float rad_lat = degrees_to_radians(lat);
-    float a = sin(rad_lat_delta / 2) * sin(rad_lat_delta / 2) +
-              sin(rad_lon_delta / 2) * sin(rad_lon_delta / 2) * cos(rad_lat) * cos(rad_lat_init);
-    float c = 2 * atan2(sqrt(a), sqrt(1 - a));
-    float distance_on_ground = earth_radius_km * c * 1000;
-    return sqrt(distance_on_ground * distance_on_ground + (alt - alt_init) * (alt - alt_init));  // meters
+/* Shortest way round, so the antimeridian does not overflow */
+static int32_t delta_lon(int32_t lon, int32_t lon_from) {
+    int64_t delta = (int64_t)lon - lon_from;
+    if (delta > 1800000000) delta -= 3600000000LL;
+    if (delta < -1800000000) delta += 3600000000LL;
+    return delta;
+}
+
+/* Equirectangular, x east and y north (m). cos(mean lat) ~ cos(home) - sin(home) * (mean lat - home) */
+static float ground_step(const distance_t *distance, int32_t lat, int32_t lon, int32_t lat_from, int32_t lon_from,
+                         float *dx, float *dy) {
+    float lat_mean = ((lat - distance->lat_home) + (float)(lat_from - distance->lat_home)) / 2 * RADIANS_PER_E7;
+    *dx = delta_lon(lon, lon_from) * METERS_PER_E7 * (distance->cos_lat_home - distance->sin_lat_home * lat_mean);
+    *dy = (lat - lat_from) * METERS_PER_E7;
+    return sqrtf(*dx * *dx + *dy * *dy);
+}
+
+static float haversine(int32_t lat, int32_t lon, int32_t lat_home, int32_t lon_home, float *bearing) {
+    float phi = lat * RADIANS_PER_E7, phi_home = lat_home * RADIANS_PER_E7;
+    float delta_lambda = delta_lon(lon_home, lon) * RADIANS_PER_E7;
+    float sin_phi = sinf((phi_home - phi) / 2), sin_lambda = sinf(delta_lambda / 2);
+    float cos_phi = cosf(phi), cos_phi_home = cosf(phi_home);
+    float a = sin_phi * sin_phi + cos_phi * cos_phi_home * sin_lambda * sin_lambda;
+    if (bearing)
+        *bearing = to_bearing(atan2f(sinf(delta_lambda) * cos_phi_home,
+                                     cos_phi * sinf(phi_home) - sinf(phi) * cos_phi_home * cosf(delta_lambda)));
+    return 2 * EARTH_RADIUS_M * asinf(sqrtf(a < 1 ? a : 1));
+}
+
+static float to_bearing(float radians) {
+    float degrees = radians * 180 / PI_F;
+    return degrees < 0 ? degrees + 360 : degrees;
 }
@@ -2,14 +2,33 @@
 #define DISTANCE_H
 
 #include "common.h"
+#include "gps_parser.h"
 
-typedef struct distance_parameters_t {
-    float *distance, *latitude, *longitude, *altitude, *sat;
+/*
+   Distance to home
+   Updated by gps.c at each published epoch. Home is the first position with 4 or more satellites, its sine and cosine
+   are cached. Up to DISTANCE_EQUIRECTANGULAR_MAX_M the ground distance and the bearing come from an equirectangular
+   projection on the integer coordinate deltas, scaled by the cosine of the mean latitude from the first order
+   expansion around home (one sqrtf and one atan2f), further away from haversine. All float math.
+   distance is 3D, bearing is from the model to home (deg, 0 = north) and odometer adds the ground track in steps of
+   DISTANCE_ODOMETER_STEP_M, so the position noise of a stopped model does not add up
+*/
 
-} distance_parameters_t;
+#define DISTANCE_EQUIRECTANGULAR_MAX_M 20000
+#define DISTANCE_ODOMETER_STEP_M 3
+
+typedef struct distance_t {
+    int32_t lat_home, lon_home, alt_home;  // deg * 1e7, mm
+    float cos_lat_home, sin_lat_home;
+    int32_t lat_odometer, lon_odometer;  // last position added to the odometer
+    bool is_home_set;
+    float distance, bearing, odometer;  // m, deg, m
+} distance_t;
 
 extern context_t context;
 
-void distance_task(void *parameters);
+void distance_init(distance_t *distance);
+void distance_update(distance_t *distance, const gps_fix_t *fix);
+float distance_to_home(const distance_t *distance, int32_t lat, int32_t lon, float *bearing);
 
-#endif
\ No newline at end of file
+#endif
@@ -3,7 +3,9 @@
 #include <stdio.h>
 
 #include "cell_count.h"
+#include "crc.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
 #include "uart.h"
 
 #define APD_F_TIMEOUT_US 1000
@@ -11,8 +13,6 @@
 #define KISS_PACKET_LENGHT 10
 
 static void process(esc_apd_f_parameters_t *parameter);
-static uint8_t update_crc8(uint8_t crc, uint8_t crc_seed);
-static uint8_t get_crc8(uint8_t *buffer, uint8_t lenght);
 
 void esc_apd_f_task(void *parameters) {
     esc_apd_f_parameters_t parameter = *(esc_apd_f_parameters_t *)parameters;
@@ -33,17 +33,18 @@ void esc_apd_f_task(void *parameters) {
     *parameter.cell_voltage = 3.75;
 #endif
 
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
     uart1_begin(115200, UART1_TX_GPIO, UART_ESC_RX, APD_F_TIMEOUT_US, 8, 1, UART_PARITY_NONE, false, false);
 
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter);
+        seqlock_write_end(parameter.lock);
     }
 }
 
@@ -53,7 +54,7 @@ static void process(esc_apd_f_parameters_t *parameter) {
     if (lenght == APD_F_PACKET_LENGHT || lenght == KISS_PACKET_LENGHT) {
         uint8_t data[KISS_PACKET_LENGHT];
         uart1_read_bytes(data, KISS_PACKET_LENGHT);
-        if (get_crc8(data, KISS_PACKET_LENGHT - 1) == data[9]) {
+        if (crc8_jeti(0, data, KISS_PACKET_LENGHT - 1) == data[9]) {
             float temperature = data[0];
             float voltage = ((uint16_t)data[1] << 8 | data[2]) / 100.0;
             float current = ((uint16_t)data[3] << 8 | data[4]) / 100.0;
@@ -72,17 +73,3 @@ static void process(esc_apd_f_parameters_t *parameter) {
         }
     }
 }
-
-static uint8_t update_crc8(uint8_t crc, uint8_t crc_seed) {
-    uint8_t crc_u, i;
-    crc_u = crc;
-    crc_u ^= crc_seed;
-    for (i = 0; i < 8; i++) crc_u = (crc_u & 0x80) ? 0x7 ^ (crc_u << 1) : (crc_u << 1);
-    return (crc_u);
-}
-
-static uint8_t get_crc8(uint8_t *buffer, uint8_t lenght) {
-    uint8_t crc = 0, i;
-    for (i = 0; i < lenght; i++) crc = update_crc8(buffer[i], crc);
-    return crc;
-}
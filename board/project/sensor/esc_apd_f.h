@@ -2,12 +2,14 @@
 #define ESC_APD_F_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct esc_apd_f_parameters_t {
     float rpm_multiplier;
     float alpha_rpm, alpha_voltage, alpha_current, alpha_temperature;
     float *rpm, *voltage, *current, *temperature, *cell_voltage, *consumption;
     uint8_t *cell_count;
+    seqlock_t *lock;
 } esc_apd_f_parameters_t;
 
 extern context_t context;
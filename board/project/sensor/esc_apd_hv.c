@@ -1,28 +1,35 @@
 #include "esc_apd_hv.h"
 
-#include <math.h>
 #include <stdio.h>
 
 #include "cell_count.h"
+#include "coulomb.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
+#include "thermistor.h"
 #include "uart.h"
 
 #define ESC_KISS_PACKET_LENGHT 10
 #define ESC_APD_HV_TIMEOUT_US 1000
 #define ESC_APD_HV_PACKET_LENGHT 22
 
+static thermistor_t thermistor;
+static coulomb_t coulomb;
+
 static void process(esc_apd_hv_parameters_t *parameter);
 static float get_temperature(uint16_t raw);
 static uint16_t get_crc16(uint8_t *buffer);
 
 void esc_apd_hv_task(void *parameters) {
     esc_apd_hv_parameters_t parameter = *(esc_apd_hv_parameters_t *)parameters;
+    thermistor_init_beta(&thermistor, 3455, 10000, 25, 10000);
     *parameter.rpm = 0;
     *parameter.voltage = 0;
     *parameter.current = 0;
     *parameter.temperature = 0;
     *parameter.cell_voltage = 0;
-    *parameter.consumption = 0;
+    coulomb_init(&coulomb, 0, COULOMB_SOURCE_ESC);
+    *parameter.consumption = coulomb_get(&coulomb);
     *parameter.cell_count = 1;
     xTaskNotifyGive(context.receiver_task_handle);
 #ifdef SIM_SENSORS
@@ -34,22 +41,23 @@ void esc_apd_hv_task(void *parameters) {
     *parameter.cell_voltage = 3.75;
 #endif
 
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
     uart1_begin(115200, UART1_TX_GPIO, UART_ESC_RX, ESC_APD_HV_TIMEOUT_US, 8, 1, UART_PARITY_NONE, false, false);
 
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter);
+        seqlock_write_end(parameter.lock);
+        coulomb_checkpoint(&coulomb);
     }
 }
 
 static void process(esc_apd_hv_parameters_t *parameter) {
-    static uint32_t timestamp = 0;
     if (uart1_available() == ESC_APD_HV_PACKET_LENGHT) {
         uint8_t data[ESC_APD_HV_PACKET_LENGHT];
         uart1_read_bytes(data, ESC_APD_HV_PACKET_LENGHT);
@@ -63,7 +71,8 @@ static void process(esc_apd_hv_parameters_t *parameter) {
             *parameter->voltage = get_average(parameter->alpha_voltage, *parameter->voltage, voltage);
             *parameter->current = get_average(parameter->alpha_current, *parameter->current, current);
             *parameter->rpm = get_average(parameter->alpha_rpm, *parameter->rpm, rpm);
-            *parameter->consumption += get_consumption(*parameter->current, 0, &timestamp);
+            coulomb_sample(&coulomb, current, time_us_32());
+            *parameter->consumption = coulomb_get(&coulomb);
             *parameter->cell_voltage = *parameter->voltage / *parameter->cell_count;
             debug("\nApd HV (%u) < Rpm: %.0f Volt: %0.2f Curr: %.2f Temp: %.0f Cons: %.0f CellV: %.2f",
                   uxTaskGetStackHighWaterMark(NULL), *parameter->rpm, *parameter->voltage, *parameter->current,
@@ -72,26 +81,8 @@ static void process(esc_apd_hv_parameters_t *parameter) {
     }
 }
 
-static float get_temperature(uint16_t raw) {
-    uint16_t SERIESRESISTOR = 10000;
-    uint16_t NOMINAL_RESISTANCE = 10000;
-    uint8_t NOMINAL_TEMPERATURE = 25;
-    uint16_t BCOEFFICIENT = 3455;
-
-    // convert value to resistance
-    float Rntc = (4096 / (float)raw) - 1;
-    Rntc = SERIESRESISTOR / Rntc;
-
-    // Get the temperature
-    float temperature = Rntc / (float)NOMINAL_RESISTANCE;  // (R/Ro)
-    temperature = (float)log(temperature);                 // ln(R/Ro)
-    temperature /= BCOEFFICIENT;                           // 1/B * ln(R/Ro)
-
-    temperature += (float)1.0 / ((float)NOMINAL_TEMPERATURE + (float)273.15);  // + (1/To)
-    temperature = (float)1.0 / temperature;                                    // Invert
-    temperature -= (float)273.15;
-    return temperature;
-}
+/* 12 bit, ntc 10k beta 3455 with 10k in series */
+static float get_temperature(uint16_t raw) { return thermistor_temperature(&thermistor, (uint32_t)raw << 4); }
 
 static uint16_t get_crc16(uint8_t *buffer) {
     uint16_t fCCRC16;
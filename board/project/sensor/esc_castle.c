@@ -8,10 +8,14 @@
 #include "hardware/irq.h"
 #include "hardware/pio.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
 
 static volatile esc_castle_parameters_t parameter;
+static castle_decoder_t decoder;
+static TaskHandle_t task_handle;
 
-static void castle_link_handler(castle_link_telemetry_t packet);
+static void castle_link_handler(void);
+static void process(const castle_link_telemetry_t *packet);
 
 void esc_castle_task(void *parameters) {
     parameter = *(esc_castle_parameters_t *)parameters;
@@ -43,33 +47,47 @@ void esc_castle_task(void *parameters) {
     *parameter.cell_voltage = 3.75;
 #endif
 
+    castle_decoder_init(&decoder);
+    task_handle = xTaskGetCurrentTaskHandle();
     castle_link_init(pio0, CASTLE_PWM_GPIO, PIO0_IRQ_0);
     castle_link_set_handler(castle_link_handler);
     debug("\nCastle init");
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
-    vTaskSuspend(NULL);
-    vTaskDelete(NULL);
+    while (1) {
+        castle_link_frame_t frame;
+        castle_link_telemetry_t packet;
+        ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        if (castle_link_read(&frame) && castle_decoder_decode(&decoder, &frame, &packet)) process(&packet);
+    }
 }
 
-static void castle_link_handler(castle_link_telemetry_t packet) {
-    *parameter.voltage = packet.voltage;
-    *parameter.ripple_voltage = packet.ripple_voltage;
-    *parameter.current = packet.current;
-    *parameter.thr = packet.thr;
-    *parameter.output = packet.output;
-    *parameter.rpm = packet.rpm * parameter.rpm_multiplier;
-    *parameter.voltage_bec = packet.voltage_bec;
-    *parameter.current_bec = packet.current_bec;
-    *parameter.temperature = packet.temperature;
+/* pio irq, a frame is complete */
+static void castle_link_handler(void) {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR(task_handle, 1, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void process(const castle_link_telemetry_t *packet) {
+    seqlock_write_begin(parameter.lock);
+    *parameter.voltage = packet->voltage;
+    *parameter.ripple_voltage = packet->ripple_voltage;
+    *parameter.current = packet->current;
+    *parameter.thr = packet->thr;
+    *parameter.output = packet->output;
+    *parameter.rpm = packet->rpm * parameter.rpm_multiplier;
+    *parameter.voltage_bec = packet->voltage_bec;
+    *parameter.current_bec = packet->current_bec;
+    *parameter.temperature = packet->temperature;
+    seqlock_write_end(parameter.lock);
     debug(
         "\nCastle (%u) < Volt(V): %.2f Ripple volt(V): %.2f Curr(A): %.2f Thr: %.0f Out: %.0f Rpm: %.0f Bec volt(V): "
         "%.2f Bec curr(A): %.2f Temp(C): %.0f %s",
-        uxTaskGetStackHighWaterMark(NULL), packet.voltage, packet.ripple_voltage, packet.current, packet.thr,
-        packet.output, packet.rpm, packet.voltage_bec, packet.current_bec, packet.temperature,
-        packet.is_temp_ntc ? " NTC" : " Linear");
+        uxTaskGetStackHighWaterMark(NULL), packet->voltage, packet->ripple_voltage, packet->current, packet->thr,
+        packet->output, packet->rpm, packet->voltage_bec, packet->current_bec, packet->temperature,
+        packet->is_temp_ntc ? " NTC" : " Linear");
 }
@@ -3,6 +3,7 @@
 
 #include "castle_link.h"
 #include "common.h"
+#include "seqlock.h"
 
 /* castleTelemetry:
     index   element                          scaler
@@ -25,6 +26,7 @@ typedef struct esc_castle_parameters_t {
     float *voltage, *ripple_voltage, *current, *thr, *output, *rpm, *consumption, *voltage_bec, *current_bec,
         *temperature, *cell_voltage;
     uint8_t *cell_count;
+    seqlock_t *lock;
 } esc_castle_parameters_t;
 
 extern context_t context;
@@ -1,11 +1,13 @@
 #include "esc_hw4.h"
 
-#include <math.h>
 #include <stdio.h>
 
 #include "auto_offset.h"
 #include "cell_count.h"
+#include "coulomb.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
+#include "thermistor.h"
 #include "uart.h"
 #include "uart_pio.h"
 
@@ -21,6 +23,8 @@
 #define ADC_RES 4096.0
 
 float current_offset_ = -1;
+static thermistor_t thermistor;
+static coulomb_t coulomb;
 
 static void process(esc_hw4_parameters_t *parameter, int current_raw_offset, uint *current_raw);
 float get_voltage(uint16_t voltage_raw, esc_hw4_parameters_t *parameter);
@@ -29,13 +33,15 @@ float get_current(uint raw, int offset, float multiplier);
 
 void esc_hw4_task(void *parameters) {
     esc_hw4_parameters_t parameter = *(esc_hw4_parameters_t *)parameters;
+    thermistor_init_beta(&thermistor, NTC_BETA, NTC_R_REF, 25, NTC_R1);
     *parameter.rpm = 0;
     *parameter.voltage = 0;
     *parameter.current = 0;
     *parameter.temperature_fet = 0;
     *parameter.temperature_bec = 0;
     *parameter.cell_voltage = 0;
-    *parameter.consumption = 0;
+    coulomb_init(&coulomb, parameter.current_max, COULOMB_SOURCE_ESC);
+    *parameter.consumption = coulomb_get(&coulomb);
     *parameter.cell_count = 1;
     xTaskNotifyGive(context.receiver_task_handle);
 #ifdef SIM_SENSORS
@@ -50,11 +56,10 @@ void esc_hw4_task(void *parameters) {
 
     if (parameter.init_delay) vTaskDelay(15000 / portTICK_PERIOD_MS);
 
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
     int current_raw_offset = -1;
     uint current_raw = 0;
@@ -63,23 +68,24 @@ void esc_hw4_task(void *parameters) {
         if (current_raw_offset > ADC_RES) current_raw_offset = ADC_RES;
     } else {
         uint current_delay = 15000;
-        auto_offset_int_parameters_t current_offset_parameters = {current_delay, &current_raw, &current_raw_offset};
-        xTaskCreate(auto_offset_int_task, "esc_hw4_current_offset_task", STACK_AUTO_OFFSET, &current_offset_parameters,
-                    1, &task_handle);
-        xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+        auto_offset_int_parameters_t current_offset_parameters = {&current_raw, &current_raw_offset};
+        run_loop_start(auto_offset_int_job, &current_offset_parameters, sizeof(current_offset_parameters),
+                       current_delay, "esc_hw4_current_offset_task", STACK_AUTO_OFFSET, 1);
     }
 
     uart1_begin(19200, UART1_TX_GPIO, UART_ESC_RX, TIMEOUT_US, 8, 1, UART_PARITY_NONE, false, false);
 
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter, current_raw_offset, &current_raw);
+        seqlock_write_end(parameter.lock);
+        coulomb_checkpoint(&coulomb);
     }
 }
 
 static void process(esc_hw4_parameters_t *parameter, int current_raw_offset, uint *current_raw) {
     uint16_t pwm, throttle;
-    static uint32_t timestamp = 0;
     uint8_t lenght = uart1_available();
     if (lenght == PACKET_LENGHT || lenght == PACKET_LENGHT + 1) {
         uint8_t data[PACKET_LENGHT];
@@ -102,8 +108,10 @@ static void process(esc_hw4_parameters_t *parameter, int current_raw_offset, uin
             rpm *= parameter->rpm_multiplier;
             if (parameter->pwm_out) xTaskNotifyGive(context.pwm_out_task_handle);
             *parameter->rpm = get_average(parameter->alpha_rpm, *parameter->rpm, rpm);
-            if (current_raw_offset != -1)
-                *parameter->consumption += get_consumption(*parameter->current, parameter->current_max, &timestamp);
+            if (current_raw_offset != -1) {
+                coulomb_sample(&coulomb, current, time_us_32());
+                *parameter->consumption = coulomb_get(&coulomb);
+            }
             *parameter->voltage = get_average(parameter->alpha_voltage, *parameter->voltage, voltage);
             *parameter->current = get_average(parameter->alpha_current, *parameter->current, current);
             *parameter->temperature_fet =
@@ -130,10 +138,8 @@ float get_voltage(uint16_t voltage_raw, esc_hw4_parameters_t *parameter) {
 }
 
 float get_temperature(uint16_t temperature_raw) {
-    float voltage = temperature_raw * V_REF / ADC_RES;
-    float ntcR_Rref = (voltage * NTC_R1 / (V_REF - voltage)) / NTC_R_REF;
-    if (ntcR_Rref < 0.001) return 0;
-    float temperature = 1 / (log(ntcR_Rref) / NTC_BETA + 1 / 298.15) - 273.15;
+    if (temperature_raw * NTC_R1 < (ADC_RES - temperature_raw) * NTC_R_REF * 0.001) return 0;  // under 47 ohm
+    float temperature = thermistor_temperature(&thermistor, (uint32_t)temperature_raw << 4);
     if (temperature < 0) return 0;
     return temperature;
 }
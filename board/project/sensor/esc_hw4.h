@@ -2,6 +2,7 @@
 #define ESC_HW4_H
 
 #include "common.h"
+#include "seqlock.h"
 
 /* ESCHW4_DIVISOR and ESCHW4_AMPGAIN values
 
@@ -38,6 +39,7 @@ typedef struct esc_hw4_parameters_t {
     float current_offset;
     float *rpm, *voltage, *current, *temperature_fet, *temperature_bec, *cell_voltage, *consumption;
     uint8_t *cell_count;
+    seqlock_t *lock;
 } esc_hw4_parameters_t;
 
 extern context_t context;
@@ -4,7 +4,9 @@
 
 #include "auto_offset.h"
 #include "cell_count.h"
+#include "coulomb.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
 #include "uart.h"
 #include "uart_pio.h"
 
@@ -12,6 +14,7 @@
 #define PACKET_LENGHT 32
 
 static uint8_t *CRCH_, *CRCL_;
+static coulomb_t coulomb;
 static void process(esc_hw5_parameters_t *parameter);
 static uint16_t calculate_crc16(uint8_t const *buffer, uint lenght);
 
@@ -26,7 +29,8 @@ void esc_hw5_task(void *parameters) {
     *parameter.voltage_bec = 0;
     *parameter.current_bec = 0;
     *parameter.cell_voltage = 0;
-    *parameter.consumption = 0;
+    coulomb_init(&coulomb, 0, COULOMB_SOURCE_ESC);
+    *parameter.consumption = coulomb_get(&coulomb);
     *parameter.cell_count = 1;
     xTaskNotifyGive(context.receiver_task_handle);
     uint8_t CRCH[] = {0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
@@ -73,22 +77,23 @@ void esc_hw5_task(void *parameters) {
     *parameter.cell_voltage = 3.75;
 #endif
 
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
     uart1_begin(115200, UART1_TX_GPIO, UART_ESC_RX, TIMEOUT_US, 8, 1, UART_PARITY_NONE, false, false);
 
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter);
+        seqlock_write_end(parameter.lock);
+        coulomb_checkpoint(&coulomb);
     }
 }
 
 static void process(esc_hw5_parameters_t *parameter) {
-    static uint32_t timestamp = 0;
     uint8_t lenght = uart1_available();
     if (lenght) {
         uint8_t data[lenght];
@@ -108,7 +113,8 @@ static void process(esc_hw5_parameters_t *parameter) {
                 if (data[7 + 15] != 0xFF) *parameter->voltage_bec = data[7 + 15];
                 if (data[7 + 16] != 0xFF) *parameter->current_bec = data[7 + 16];
                 *parameter->cell_voltage = *parameter->voltage / *parameter->cell_count;
-                *parameter->consumption += get_consumption(*parameter->current, 0, &timestamp);
+                coulomb_sample(&coulomb, *parameter->current, time_us_32());
+                *parameter->consumption = coulomb_get(&coulomb);
 
                 debug(
                     "\nEsc VBAR (%u) < Rpm: %.0f Volt: %0.2f Curr: %.2f TempFet: %.0f TempBec: %.0f TempMotor: %.0f "
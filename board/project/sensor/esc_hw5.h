@@ -2,6 +2,7 @@
 #define ESC_HW5_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct esc_hw5_parameters_t {
     float rpm_multiplier;
@@ -9,6 +10,7 @@ typedef struct esc_hw5_parameters_t {
     float *rpm, *voltage, *current, *temperature_fet, *temperature_bec, *temperature_motor, *voltage_bec, *current_bec,
         *cell_voltage, *consumption;
     uint8_t *cell_count;
+    seqlock_t *lock;
 } esc_hw5_parameters_t;
 
 extern context_t context;
@@ -3,12 +3,16 @@
 #include <stdio.h>
 
 #include "cell_count.h"
+#include "coulomb.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
 #include "uart.h"
 
 #define TIMEOUT_US 1000
 #define PACKET_LENGHT 35
 
+static coulomb_t coulomb;
+
 static void process(esc_kontronik_parameters_t *parameter);
 
 void esc_kontronik_task(void *parameters) {
@@ -21,7 +25,8 @@ void esc_kontronik_task(void *parameters) {
     *parameter.temperature_fet = 0;
     *parameter.temperature_bec = 0;
     *parameter.cell_voltage = 0;
-    *parameter.consumption = 0;
+    coulomb_init(&coulomb, 0, COULOMB_SOURCE_ESC);
+    *parameter.consumption = coulomb_get(&coulomb);
     *parameter.cell_count = 1;
     xTaskNotifyGive(context.receiver_task_handle);
 #ifdef SIM_SENSORS
@@ -34,21 +39,22 @@ void esc_kontronik_task(void *parameters) {
     *parameter.cell_voltage = 3.75;
 #endif
 
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
     uart1_begin(115200, UART1_TX_GPIO, UART_ESC_RX, TIMEOUT_US, 8, 1, UART_PARITY_EVEN, false, false);
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter);
+        seqlock_write_end(parameter.lock);
+        coulomb_checkpoint(&coulomb);
     }
 }
 
 static void process(esc_kontronik_parameters_t *parameter) {
-    static uint32_t timestamp = 0;
     if (uart1_available() == PACKET_LENGHT) {
         uint8_t data[PACKET_LENGHT];
         uart1_read_bytes(data, PACKET_LENGHT);
@@ -62,7 +68,8 @@ static void process(esc_kontronik_parameters_t *parameter) {
             float temperature_fet = data[26];
             float temperature_bec = data[27];
             *parameter->rpm = get_average(parameter->alpha_rpm, *parameter->rpm, rpm);
-            *parameter->consumption += get_consumption(*parameter->current, 0, &timestamp);
+            coulomb_sample(&coulomb, current, time_us_32());
+            *parameter->consumption = coulomb_get(&coulomb);
             *parameter->voltage = get_average(parameter->alpha_voltage, *parameter->voltage, voltage);
             *parameter->current = get_average(parameter->alpha_current, *parameter->current, current);
             *parameter->voltage_bec = get_average(parameter->alpha_voltage, *parameter->voltage_bec, voltage_bec);
@@ -2,6 +2,7 @@
 #define ESC_KONTRONIK_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct esc_kontronik_parameters_t {
     float rpm_multiplier;
@@ -9,6 +10,7 @@ typedef struct esc_kontronik_parameters_t {
     float *rpm, *voltage, *current, *voltage_bec, *current_bec, *temperature_fet, *temperature_bec, *cell_voltage,
         *consumption;
     uint8_t *cell_count;
+    seqlock_t *lock;
 } esc_kontronik_parameters_t;
 
 extern context_t context;
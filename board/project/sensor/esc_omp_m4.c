@@ -4,6 +4,7 @@
 
 #include "cell_count.h"
 #include "pico/stdlib.h"
+#include "run_loop.h"
 #include "uart.h"
 
 #define OMP_M4_TIMEOUT_US 1000
@@ -49,17 +50,18 @@ void esc_omp_m4_task(void *parameters) {
     *parameter.cell_voltage = 3.75;
 #endif
 
-    TaskHandle_t task_handle;
     uint cell_count_delay = 15000;
-    cell_count_parameters_t cell_count_parameters = {cell_count_delay, parameter.voltage, parameter.cell_count};
-    xTaskCreate(cell_count_task, "cell_count_task", STACK_CELL_COUNT, (void *)&cell_count_parameters, 1, &task_handle);
-    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    cell_count_parameters_t cell_count_parameters = {parameter.voltage, parameter.cell_count};
+    run_loop_start(cell_count_job, &cell_count_parameters, sizeof(cell_count_parameters), cell_count_delay,
+                   "cell_count_task", STACK_CELL_COUNT, 1);
 
     uart1_begin(115200, UART1_TX_GPIO, UART_ESC_RX, OMP_M4_TIMEOUT_US, 8, 1, UART_PARITY_NONE, false, false);
 
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter);
+        seqlock_write_end(parameter.lock);
     }
 }
 
@@ -7,18 +7,19 @@
 #include "hardware/clocks.h"
 #include "hardware/irq.h"
 #include "hardware/pio.h"
+#include "period_filter.h"
 #include "pico/stdlib.h"
 
 #define SIGNAL_TIMEOUT_MS 1000
 #define INTERVAL_MS 100
+#define DRAIN_MS 5  // up to 50k edges/s with the capture ring
 #define CLOCK_DIV 1
 
-static volatile bool is_timedout = false;
-static volatile uint pwm_cycles = 0;
+static bool is_timedout = true;
+static period_filter_t filter;
 
 static void read(esc_pwm_parameters_t *parameter);
 static void capture_pin_0_handler(uint counter, edge_type_t edge);
-static int64_t timeout_callback(alarm_id_t id, void *user_data);
 
 void esc_pwm_task(void *parameters) {
     esc_pwm_parameters_t parameter = *(esc_pwm_parameters_t *)parameters;
@@ -27,13 +28,26 @@ void esc_pwm_task(void *parameters) {
 
     gpio_pull_up(PWM_CAPTURE_GPIO);
     
-    capture_edge_init(pio0, PWM_CAPTURE_GPIO, 1, CLOCK_DIV, PIO0_IRQ_0);
+    period_filter_reset(&filter);
+    capture_edge_init_batch(pio0, PWM_CAPTURE_GPIO, 1, CLOCK_DIV);
     capture_edge_set_handler(0, capture_pin_0_handler);
 
+    uint idle_ms = 0, read_ms = 0;
     while (1) {
-        read(&parameter);
-        debug("\nEsc PWM (%u) < Rpm: %.0f", uxTaskGetStackHighWaterMark(NULL), *parameter.rpm);
-        vTaskDelay(INTERVAL_MS / portTICK_PERIOD_MS);
+        if (capture_edge_drain()) {
+            idle_ms = 0;
+            is_timedout = false;
+        } else if (!is_timedout && (idle_ms += DRAIN_MS) >= SIGNAL_TIMEOUT_MS) {
+            is_timedout = true;
+            period_filter_reset(&filter);
+            debug("\nEsc PWM signal timeout. Rpm: 0");
+        }
+        if ((read_ms += DRAIN_MS) >= INTERVAL_MS) {
+            read_ms = 0;
+            read(&parameter);
+            debug("\nEsc PWM (%u) < Rpm: %.0f", uxTaskGetStackHighWaterMark(NULL), *parameter.rpm);
+        }
+        vTaskDelay(DRAIN_MS / portTICK_PERIOD_MS);
     }
 }
 
@@ -42,8 +56,9 @@ static void read(esc_pwm_parameters_t *parameter) {
         *parameter->rpm = 0;
         return;
     }
+    float pwm_cycles = period_filter_get(&filter);
     if (pwm_cycles > 1) {
-        float pwm_duration = (float)pwm_cycles / clock_get_hz(clk_sys) * CLOCK_DIV * COUNTER_CYCLES;  // seconds
+        float pwm_duration = pwm_cycles / clock_get_hz(clk_sys) * CLOCK_DIV * COUNTER_CYCLES;  // seconds
         float rpm = 60 / pwm_duration * parameter->multiplier;
         *parameter->rpm = rpm;  // get_average(parameter->alpha / 100.0F, *parameter->rpm, rpm);
     }
@@ -52,22 +67,7 @@ static void read(esc_pwm_parameters_t *parameter) {
 #endif
 }
 
+/* From capture_edge_drain(), in the task */
 static void capture_pin_0_handler(uint counter, edge_type_t edge) {
-    static uint counter_edge_rise = 0, counter_previous = 0;
-    static alarm_id_t timeout_alarm_id = 0;
-    if (timeout_alarm_id) cancel_alarm(timeout_alarm_id);
-    is_timedout = false;
-
-    if (edge == EDGE_RISE) {
-        pwm_cycles = counter - counter_edge_rise;
-        counter_edge_rise = counter;
-        // printf("\nPwm cycles: %u", pwm_cycles);
-    }
-    timeout_alarm_id = add_alarm_in_ms(SIGNAL_TIMEOUT_MS, timeout_callback, NULL, false);
-}
-
-static int64_t timeout_callback(alarm_id_t id, void *parameters) {
-    is_timedout = true;
-    debug("\nEsc PWM signal timeout. Rpm: 0");
-    return 0;
+    if (edge == EDGE_RISE) period_filter_rise(&filter, counter);
 }
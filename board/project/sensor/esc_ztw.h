@@ -2,12 +2,14 @@
 #define ESC_ZTW_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct esc_ztw_parameters_t {
     float rpm_multiplier;
     float alpha_rpm, alpha_voltage, alpha_current, alpha_temperature;
     float *rpm, *voltage, *current, *temp_esc, *temp_motor, *bec_voltage, *cell_voltage, *consumption;
     uint8_t *cell_count;
+    seqlock_t *lock;
 } esc_ztw_parameters_t;
 
 extern context_t context;
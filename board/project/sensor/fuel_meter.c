@@ -11,8 +11,8 @@
 #define INSTANT_INTERVAL_MS 100
 #define CLOCK_DIV 5
 
-static volatile uint pwm_cycles_instant = 0;
-static volatile uint pwm_cycles_total = 0;
+static uint pwm_cycles_instant = 0;
+static uint pwm_cycles_total = 0;
 
 static void read(fuel_meter_parameters_t *parameter);
 static void capture_pin_0_handler(uint counter, edge_type_t edge);
@@ -25,10 +25,11 @@ void fuel_meter_task(void *parameters) {
 
     gpio_pull_up(FUELMETER_CAPTURE_GPIO);
 
-    capture_edge_init(pio0, FUELMETER_CAPTURE_GPIO, 1, CLOCK_DIV, PIO0_IRQ_0);
+    capture_edge_init_batch(pio0, FUELMETER_CAPTURE_GPIO, 1, CLOCK_DIV);
     capture_edge_set_handler(0, capture_pin_0_handler);
 
     while (1) {
+        capture_edge_drain();
         read(&parameter);
         debug("\nFuel sensor (%u) < ml/min %.3f ml %.3f ml/pulse %.3f pulses %u", uxTaskGetStackHighWaterMark(NULL), *parameter.consumption_instant,
               *parameter.consumption_total, parameter.ml_per_pulse, pwm_cycles_total);
@@ -47,6 +48,7 @@ static void read(fuel_meter_parameters_t *parameter) {
 #endif
 }
 
+/* From capture_edge_drain(), in the task */
 static void capture_pin_0_handler(uint counter, edge_type_t edge) {
     if (edge == EDGE_RISE) {
         pwm_cycles_total++;
@@ -5,91 +5,17 @@
 #include <string.h>
 
 #include "distance.h"
+#include "gps_parser.h"
 #include "pico/stdlib.h"
-#include "stdlib.h"
 #include "uart_pio.h"
 #include "vspeed.h"
 
-#define COMMAND_GGA 0
-#define COMMAND_RMC 1
-#define COMMAND_UNK 2
-
-#define COMMAND_VTG 4
-#define COMMAND_GLL 5
-
-#define NMEA_LON 1
-#define NMEA_ALT 2
-#define NMEA_SPD 3
-#define NMEA_COG 4
-#define NMEA_FIX 5
-#define NMEA_SAT 6
-#define NMEA_DATE 7
-#define NMEA_TIME 8
-#define NMEA_LAT_SIGN 9
-#define NMEA_LON_SIGN 10
-#define NMEA_HDOP 11
-#define NMEA_END 12
-#define NMEA_LAT 13
-
 #define TIMEOUT_US 5000
 #define VSPEED_INTERVAL_MS 2000
-
-typedef struct ublox_msg_info_t {
-    uint8_t class;
-    uint8_t id;
-    uint16_t len;
-} __attribute__((packed)) ublox_msg_info_t;
-
-typedef struct ublox_navpvt_t {
-    uint32_t iTOW;
-    uint16_t year;
-    uint8_t month;
-    uint8_t day;
-    uint8_t hour;
-    uint8_t min;
-    uint8_t sec;
-    uint8_t valid;
-    uint32_t tAcc;
-    int32_t nano;
-    uint8_t fixType;
-    uint8_t flags;
-    uint8_t flags2;
-    uint8_t numSV;
-    int32_t lon;
-    int32_t lat;
-    int32_t height;  // mm
-    int32_t hMSL;
-    uint32_t hAcc;   // mm
-    uint32_t vAcc;   // mm
-    int32_t velN;    // mm/s
-    int32_t velE;    // mm/s
-    int32_t velD;    // mm/s
-    int32_t gSpeed;  // mm/s
-    int32_t headMot;
-    uint32_t sAcc;     // mm
-    uint32_t headAcc;  // deg * 10000
-    uint16_t pDOP;
-    uint16_t flags3;
-    uint32_t reserved1;
-    int32_t headVeh;
-    int16_t magDec;
-    uint16_t magAcc;
-    uint8_t crc_a;
-    uint8_t crc_b;
-} __attribute__((packed)) ublox_navpvt_t;
-
-typedef struct ublox_navdop_t {
-    uint32_t iTOW;
-    uint16_t gDOP;  // DOP * 100
-    uint16_t pDOP;  // DOP * 100
-    uint16_t tDOP;  // DOP * 100
-    uint16_t vDOP;  // DOP * 100
-    uint16_t hDOP;  // DOP * 100
-    uint16_t nDOP;  // DOP * 100
-    uint16_t eDOP;  // DOP * 100
-    uint8_t crc_a;
-    uint8_t crc_b;
-} __attribute__((packed)) ublox_navdop_t;
+#define HIGH_RATE_MIN 10  // u-blox rate (Hz) from which the baudrate is negotiated and NAV-DOP is sent once a second
+#define PROBE_MS 250
+#define EPOCH_BYTES 126  // NAV-PVT and NAV-DOP with headers
+#define RATE_WINDOW_US 1000000
 
 typedef struct alarm_parameters_t {
     bool is_ublox;
@@ -99,14 +25,24 @@ typedef struct alarm_parameters_t {
 // static alarm_id_t alarm_id_ublox = 0, alarm_id_nmea = 0;
 // static alarm_parameters_t alarm_parameters;
 
+static gps_parser_t gps_parser;
+static distance_t distance;
+static const uint baudrates[] = {921600, 460800, 230400, 115200, 57600, 38400, 9600};
+static uint baudrate_current;
+static float epoch_rate;
+
 static void process(gps_parameters_t *parameter);
-static void parser(uint8_t nmea_cmd, uint8_t cmd_field, uint8_t *buffer, gps_parameters_t *parameter);
+static void publish(gps_parameters_t *parameter, const gps_fix_t *fix);
+static void update_rate(void);
 static void send_ublox_message(uint8_t *buf, uint len);
-static void set_baudrate(uint16_t baudrate);
+static void set_baudrate(uint baudrate);
+static void send_baudrate(uint current, uint baudrate);
+static uint negotiate_baudrate(uint baudrate);
+static bool probe(uint baudrate);
 static void set_nmea_config(uint rate);
 static void set_ublox_config(uint rate);
 static void nmea_msg(char *cmd, bool enable);
-static void ubx_cfg_msg(uint8_t class, uint8_t id, bool enable);
+static void ubx_cfg_msg(uint8_t class, uint8_t id, uint8_t rate);
 static void ubx_cfg_rate(uint16_t rate);
 static void ubx_cfg_cfg(void);
 // static int64_t alarm_nmea_timeout(alarm_id_t id, void *parameters);
@@ -127,6 +63,8 @@ void gps_task(void *parameters) {
     *parameter.date = 0;
     *parameter.vspeed = 0;
     *parameter.dist = 0;
+    *parameter.bearing = 0;
+    *parameter.odometer = 0;
     *parameter.spd_kmh = 0;
     *parameter.fix = 0;
 
@@ -151,17 +89,20 @@ void gps_task(void *parameters) {
     *parameter.dist = 1000;
     *parameter.spd_kmh = 123;
 #endif
-    TaskHandle_t task_handle;
-
-    distance_parameters_t parameters_distance = {parameter.dist, parameter.alt, parameter.sat, parameter.lat,
-                                                 parameter.lon};
-    xTaskCreate(distance_task, "distance_task", STACK_DISTANCE, (void *)&parameters_distance, 2, &task_handle);
-    // xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    distance_init(&distance);
 
     /* Change GPS config. For ublox compatible devices */
 
-    set_baudrate(parameter.baudrate);
-    uart_pio_begin(parameter.baudrate, UART_TX_PIO_GPIO, UART_RX_PIO_GPIO, TIMEOUT_US, pio0, PIO0_IRQ_1);
+    if (parameter.protocol == UBLOX && parameter.rate >= HIGH_RATE_MIN) {
+        baudrate_current = negotiate_baudrate(parameter.baudrate);
+        // a slow module would fall behind and the uart buffer would overflow, keep the line under 75 %
+        uint rate_max = baudrate_current / 10 * 3 / 4 / EPOCH_BYTES;
+        if (parameter.rate > rate_max) parameter.rate = rate_max ? rate_max : 1;
+    } else {
+        set_baudrate(parameter.baudrate);
+        baudrate_current = parameter.baudrate;
+    }
+    uart_pio_begin(baudrate_current, UART_TX_PIO_GPIO, UART_RX_PIO_GPIO, TIMEOUT_US, pio0, PIO0_IRQ_1);
     if (parameter.protocol == UBLOX)
         set_ublox_config(parameter.rate);
     else
@@ -170,157 +111,79 @@ void gps_task(void *parameters) {
     // alarm_parameters.is_ublox = true;
     // alarm_id_ublox = add_alarm_in_ms(20 * 1000L, alarm_ublox_timeout, &alarm_parameters, false);
 
+    gps_parser_init(&gps_parser);
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
         process(&parameter);
     }
 }
 
+/* Both protocols go through the parser, whatever the configuration */
 static void process(gps_parameters_t *parameter) {
-    static char buffer[20] = {0};
-    if (parameter->protocol == NMEA) {
-        static uint8_t nmea_cmd = 0;
-        static uint8_t cmd_field = 0;
-        while (uart_pio_available()) {
-            static uint8_t data_pos = 0;
-            char data = uart_pio_read();
-            switch (data) {
-                case '$':
-                    cmd_field = 0;
-                    data_pos = 0;
-                    nmea_cmd = COMMAND_UNK;
-                    break;
-                case '\r':
-                case ',':
-                    if (cmd_field == 0) {
-                        if (memcmp(buffer + 2, "GGA", 3) == 0) {
-                            nmea_cmd = COMMAND_GGA;
-                        } else if (memcmp(buffer + 2, "RMC", 3) == 0) {
-                            nmea_cmd = COMMAND_RMC;
-                        }
-                        if (nmea_cmd != COMMAND_UNK) {
-                            // cancel_alarm(alarm_id_nmea);
-                            // alarm_id_nmea = add_alarm_in_ms(2000, alarm_nmea_timeout, &alarm_parameters, false);
-                            debug("\nGPS (%u) < %s(%i): ", uxTaskGetStackHighWaterMark(NULL), buffer + 2, nmea_cmd);
-                        }
-                    } else {
-                        if (nmea_cmd != COMMAND_UNK) parser(nmea_cmd, cmd_field, buffer, parameter);
-                    }
+    uint8_t data[64];
+    uint8_t length;
+    while ((length = uart_pio_available())) {
+        if (length > sizeof(data)) length = sizeof(data);
+        uart_pio_read_bytes(data, length);
+        for (uint i = 0; i < length; i++)
+            if (gps_parser_feed(&gps_parser, data[i])) publish(parameter, &gps_parser.fix);
+    }
+}
 
-                    cmd_field++;
-                    data_pos = 0;
-                    buffer[0] = 0;
-                    break;
-                case '\n':
-                    break;
-                default:
-                    if (data_pos < 19) {
-                        buffer[data_pos] = data;
-                        data_pos++;
-                        buffer[data_pos] = 0;
-                    }
-            }
-        }
+/* Once per navigation epoch */
+static void publish(gps_parameters_t *parameter, const gps_fix_t *fix) {
+    seqlock_write_begin(parameter->lock);
+    *parameter->lat = fix->lat * 1.0e-7;
+    *parameter->lon = fix->lon * 1.0e-7;
+    *parameter->alt = fix->alt / 1000.0F;
+    *parameter->cog = fix->cog / 100000.0F;
+    *parameter->sat = fix->sat;
+    *parameter->fix = fix->fix;
+    *parameter->time = fix->time;
+    *parameter->date = fix->date;
+    *parameter->spd_kmh = fix->speed * 3600L / 1000000.0F;
+    *parameter->spd = fix->speed * 3600L / 1852000.0F;  // kts
+    *parameter->hdop = fix->hdop / 100.0F;
+    if (fix->is_ubx) {
+        *parameter->vspeed = fix->vel_d / 1000.0F;
+        *parameter->n_vel = fix->vel_n / 1000.0F;
+        *parameter->e_vel = fix->vel_e / 1000.0F;
+        *parameter->v_vel = fix->vel_d / 1000.0F;
+        *parameter->speed_acc = fix->speed_acc / 1000.0F;
+        *parameter->track_acc = fix->track_acc / 1000.0F;
+        *parameter->alt_elipsiod = fix->alt_elipsiod / 1000.0F;
+        *parameter->h_acc = fix->h_acc / 1000.0F;
+        *parameter->v_acc = fix->v_acc / 1000.0F;
+        *parameter->pdop = fix->pdop / 100.0F;
+        *parameter->vdop = fix->vdop / 100.0F;
     } else {
-        while (uart_pio_available()) {
-            while (uart_pio_available() && uart_pio_read() != 0xB5)
-                ;
-            while (uart_pio_available() && uart_pio_read() != 0x62)
-                ;
-            if (uart_pio_available() < sizeof(ublox_msg_info_t)) return;
-            ublox_msg_info_t msg_info;
-            uart_pio_read_bytes((uint8_t *)&msg_info, sizeof(ublox_msg_info_t));
-            debug("\nGPS UBLOX MSG. Class: %u Id: %u Len: %u Avail: %u", msg_info.class, msg_info.id, msg_info.len,
-                  uart_pio_available());
-            if (uart_pio_available() < msg_info.len + 2) return;
-            if (msg_info.class == 0x01 && msg_info.id == 0x07 && msg_info.len == sizeof(ublox_navpvt_t) - 2) {
-                // cancel_alarm(alarm_id_ublox);
-                // alarm_id_ublox = add_alarm_in_ms(2000, alarm_ublox_timeout, &alarm_parameters, false);
-                ublox_navpvt_t navpvt;
-                uart_pio_read_bytes((uint8_t *)&navpvt, sizeof(ublox_navpvt_t));
-                *parameter->alt = navpvt.hMSL / 1000.0F;
-                *parameter->lat = navpvt.lat * 1.0e-7;
-                *parameter->lon = navpvt.lon * 1.0e-7;
-                *parameter->alt = navpvt.hMSL / 1000.0F;
-                *parameter->cog = navpvt.headMot / 100000.0F;
-                *parameter->sat = navpvt.numSV;
-                *parameter->time = navpvt.hour * 10000L + navpvt.min * 100 + navpvt.sec;
-                *parameter->date = navpvt.day * 10000L + navpvt.month * 100 + (navpvt.year - 2000);
-                *parameter->vspeed = navpvt.velD / 1000.0F;
-                *parameter->spd_kmh = navpvt.gSpeed * 3600L / 1000000.0F;
-                *parameter->spd = 0.5144444F * navpvt.gSpeed * 3600L / 1000000.0F;
-                *parameter->fix = navpvt.fixType;
-                *parameter->n_vel = navpvt.velN / 1000.0F;
-                *parameter->e_vel = navpvt.velE / 1000.0F;
-                *parameter->v_vel = navpvt.velD / 1000.0F;
-                *parameter->speed_acc = navpvt.sAcc / 1000.0F;
-                *parameter->track_acc = navpvt.headAcc / 1000.0F;
-                *parameter->alt_elipsiod = navpvt.height / 1000.0F;
-                *parameter->h_acc = navpvt.hAcc / 1000.0F;
-                *parameter->v_acc = navpvt.vAcc / 1000.0F;
-                *parameter->pdop = navpvt.pDOP / 100.0F;
-                debug(
-                    "\nGPS (%u) < NAV-PTV: Date: %.0f Time: %.0f Fix: %.0f Sat: %.0f Lon: %.5f Lat: %.5f Alt: %.2f "
-                    "Vspeed: %.2f Speed: mm/s %i knots %.2f kmh %.2f Pdop: %.2f",
-                    uxTaskGetStackHighWaterMark(NULL), *parameter->date, *parameter->time, *parameter->fix,
-                    *parameter->sat, *parameter->lon, *parameter->lat, *parameter->alt, *parameter->vspeed,
-                    navpvt.gSpeed, *parameter->spd, *parameter->spd_kmh, *parameter->pdop);
-            } else if (msg_info.class == 0x01 && msg_info.id == 0x04 && msg_info.len == sizeof(ublox_navdop_t) - 2) {
-                // cancel_alarm(alarm_id_ublox);
-                // alarm_id_ublox = add_alarm_in_ms(2000, alarm_ublox_timeout, &alarm_parameters, false);
-                ublox_navdop_t navdop;
-                uart_pio_read_bytes((uint8_t *)&navdop, sizeof(ublox_navpvt_t));
-                *parameter->hdop = navdop.hDOP / 100.0F;
-                *parameter->vdop = navdop.vDOP / 100.0F;
-                debug("\nGPS (%u) < NAV-DOP: h: %.2f v: %.2f", uxTaskGetStackHighWaterMark(NULL), *parameter->hdop,
-                      *parameter->vdop);
-            }
-        }
+        get_vspeed_gps(parameter->vspeed, *parameter->alt, VSPEED_INTERVAL_MS);
     }
+    distance_update(&distance, fix);
+    *parameter->dist = distance.distance;
+    *parameter->bearing = distance.bearing;
+    *parameter->odometer = distance.odometer;
+    seqlock_write_end(parameter->lock);
+    update_rate();
+    debug(
+        "\nGPS (%u) < %s Date: %.0f Time: %.0f Fix: %.0f Sats: %.0f Lon: %.5f Lat: %.5f Alt: %.1f Vspeed: %.2f "
+        "Spd: %.1f HDOP: %.2f Dist: %.1f Bearing: %.0f Odometer: %.0f Errors: %u Baudrate: %u Rate: %.1f Hz "
+        "Incomplete: %u Dropped: %u",
+        uxTaskGetStackHighWaterMark(NULL), fix->is_ubx ? "UBX" : "NMEA", *parameter->date, *parameter->time,
+        *parameter->fix, *parameter->sat, *parameter->lon, *parameter->lat, *parameter->alt, *parameter->vspeed,
+        *parameter->spd, *parameter->hdop, *parameter->dist, *parameter->bearing, *parameter->odometer,
+        gps_parser.checksum_errors, baudrate_current, epoch_rate, gps_parser.incomplete_epochs, uart_pio_dropped());
 }
 
-static void parser(uint8_t nmea_cmd, uint8_t cmd_field, uint8_t *buffer, gps_parameters_t *parameter) {
-    uint8_t nmea_field[2][17] = {{0, 0, 0, 0, 0, 0, 0, NMEA_SAT, NMEA_HDOP, NMEA_ALT, 0, 0, 0, 0, 0, 0, 0},  // GGA
-                                 {0, NMEA_TIME, 0, NMEA_LAT, NMEA_LAT_SIGN, NMEA_LON, NMEA_LON_SIGN, NMEA_SPD, NMEA_COG,
-                                  NMEA_DATE, 0, 0, 0, 0, 0, 0, 0}};  // RMC
-    static int8_t lat_dir = 1, lon_dir = 1;
-    static uint32_t timestamp_vspeed = 0, timestamp_dist = 0;
-    if (strlen(buffer)) {
-        if (nmea_field[nmea_cmd][cmd_field] == NMEA_TIME) {
-            *parameter->time = atof(buffer);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_LAT) {
-            char degrees[3] = {0};
-            double minutes;
-            strncpy(degrees, buffer, 2);
-            minutes = atof(buffer + 2);
-            *parameter->lat = lat_dir * (atoi(degrees) + minutes / 60);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_LON) {
-            char degrees[4] = {0};
-            double minutes;
-            strncpy(degrees, buffer, 3);
-            minutes = atof(buffer + 3);
-            *parameter->lon = lon_dir * (atoi(degrees) + minutes / 60);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_ALT) {
-            *parameter->alt = atof(buffer);
-            get_vspeed_gps(parameter->vspeed, *parameter->alt, VSPEED_INTERVAL_MS);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_SPD) {
-            *parameter->spd = atof(buffer);
-            *parameter->spd_kmh = *parameter->spd * 1.852;
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_COG) {
-            *parameter->cog = atof(buffer);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_DATE) {
-            *parameter->date = atof(buffer);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_SAT) {
-            *parameter->sat = atof(buffer);
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_LAT_SIGN) {
-            lat_dir = (buffer[0] == 'N') ? 1 : -1;
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_LON_SIGN) {
-            lon_dir = (buffer[0] == 'E') ? 1 : -1;
-        } else if (nmea_field[nmea_cmd][cmd_field] == NMEA_HDOP) {
-            *parameter->hdop = atof(buffer);
-        }
-        debug("%s(%i),", buffer, nmea_field[nmea_cmd][cmd_field]);
-    }
+/* Achieved epochs per second, over windows of RATE_WINDOW_US */
+static void update_rate(void) {
+    static uint32_t window_start = 0, window_epochs = 0;
+    uint32_t now = time_us_32();
+    window_epochs++;
+    if (now - window_start < RATE_WINDOW_US) return;
+    if (window_start) epoch_rate = window_epochs * 1000000.0F / (now - window_start);
+    window_start = now;
+    window_epochs = 0;
 }
 
 static void set_ublox_config(uint rate) {
@@ -331,10 +194,10 @@ static void set_ublox_config(uint rate) {
     nmea_msg("ZDA", false);
     nmea_msg("GGA", false);
     nmea_msg("RMC", false);
-    ubx_cfg_msg(0x01, 0x07, true);  // Enable message UBX-NAV-PVT
-    ubx_cfg_msg(0x01, 0x04, true);  // Enable message UBX-NAV-DOP
-    ubx_cfg_rate(rate);             // Set messages rate (UBX-CFG-RATE (0x06 0x08))
-    ubx_cfg_cfg();                  // Save changes
+    ubx_cfg_msg(0x01, 0x07, 1);                               // Enable message UBX-NAV-PVT
+    ubx_cfg_msg(0x01, 0x04, rate < HIGH_RATE_MIN ? 1 : rate);  // Enable message UBX-NAV-DOP, once a second at high rate
+    ubx_cfg_rate(rate);                                        // Set messages rate (UBX-CFG-RATE (0x06 0x08))
+    ubx_cfg_cfg();                                             // Save changes
 }
 
 static void set_nmea_config(uint rate) {
@@ -345,23 +208,60 @@ static void set_nmea_config(uint rate) {
     nmea_msg("ZDA", false);
     nmea_msg("GGA", true);
     nmea_msg("RMC", true);
-    ubx_cfg_msg(0x01, 0x07, false);  // Disable message UBX-NAV-PVT
-    ubx_cfg_msg(0x01, 0x04, false);  // Disable message UBX-NAV-DOP
+    ubx_cfg_msg(0x01, 0x07, 0);  // Disable message UBX-NAV-PVT
+    ubx_cfg_msg(0x01, 0x04, 0);  // Disable message UBX-NAV-DOP
     ubx_cfg_rate(rate);              // Set messages rate (UBX-CFG-RATE (0x06 0x08))
     ubx_cfg_cfg();                   // Save changes
 }
 
-static void set_baudrate(uint16_t baudrate) {
+/* The module may be at any baudrate, a previous high rate configuration is saved too */
+static void set_baudrate(uint baudrate) {
+    for (uint i = 0; i < sizeof(baudrates) / sizeof(uint); i++) send_baudrate(baudrates[i], baudrate);
+}
+
+static void send_baudrate(uint current, uint baudrate) {
     char msg[300];
-    uint baudrates[] = {115200, 57600, 38400, 9600};
-    for (uint i = 0; i < sizeof(baudrates) / sizeof(uint); i++) {
-        uart_pio_begin(baudrates[i], UART_TX_PIO_GPIO, UART_RX_PIO_GPIO, TIMEOUT_US, pio0, PIO0_IRQ_1);
-        vTaskDelay(10 / portTICK_PERIOD_MS);
-        sprintf(msg, "$PUBX,41,1,3,3,%i,0\r\n", baudrate);
-        uart_pio_write_bytes(msg, strlen(msg));
-        vTaskDelay(200 / portTICK_PERIOD_MS);
-        uart_pio_remove();
+    uart_pio_begin(current, UART_TX_PIO_GPIO, UART_RX_PIO_GPIO, TIMEOUT_US, pio0, PIO0_IRQ_1);
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+    sprintf(msg, "$PUBX,41,1,3,3,%u,0\r\n", baudrate);
+    uart_pio_write_bytes((uint8_t *)msg, strlen(msg));
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    uart_pio_remove();
+}
+
+/*
+   Highest baudrate, above the configured one, the module answers a NAV-PVT poll at. The current baudrate is found
+   first, so each step up is a single $PUBX,41. A module out of reach falls back to the sweep of set_baudrate()
+*/
+static uint negotiate_baudrate(uint baudrate) {
+    uint current = 0;
+    for (uint i = 0; i < sizeof(baudrates) / sizeof(uint) && !current; i++)
+        if (probe(baudrates[i])) current = baudrates[i];
+    for (uint i = 0; current && i < sizeof(baudrates) / sizeof(uint) && baudrates[i] > baudrate; i++) {
+        if (baudrates[i] == current) return current;
+        send_baudrate(current, baudrates[i]);
+        if (probe(baudrates[i])) return baudrates[i];
+    }
+    set_baudrate(baudrate);
+    return baudrate;
+}
+
+static bool probe(uint baudrate) {
+    uint8_t msg[] = {0x01, 0x07, 0x00, 0x00};
+    uint8_t data[64];
+    uint8_t length;
+    uart_pio_begin(baudrate, UART_TX_PIO_GPIO, UART_RX_PIO_GPIO, TIMEOUT_US, pio0, PIO0_IRQ_1);
+    gps_parser_init(&gps_parser);
+    send_ublox_message(msg, sizeof(msg));
+    vTaskDelay(PROBE_MS / portTICK_PERIOD_MS);
+    while ((length = uart_pio_available())) {
+        if (length > sizeof(data)) length = sizeof(data);
+        uart_pio_read_bytes(data, length);
+        for (uint i = 0; i < length; i++) gps_parser_feed(&gps_parser, data[i]);
     }
+    uart_pio_remove();
+    debug("\nGPS. Baudrate %u: %s", baudrate, gps_parser.messages ? "ok" : "no answer");
+    return gps_parser.messages > 0;
 }
 
 static void nmea_msg(char *cmd, bool enable) {
@@ -370,8 +270,9 @@ static void nmea_msg(char *cmd, bool enable) {
     uart_pio_write_bytes(msg, strlen(msg));
 }
 
-static void ubx_cfg_msg(uint8_t class, uint8_t id, bool enable) {
-    uint8_t msg[] = {0x06, 0x01, 0x03, 0x00, class, id, enable};
+/* Rate 0 disables the message, n sends it every n navigation solutions */
+static void ubx_cfg_msg(uint8_t class, uint8_t id, uint8_t rate) {
+    uint8_t msg[] = {0x06, 0x01, 0x03, 0x00, class, id, rate};
     send_ublox_message(msg, sizeof(msg));
 }
 
@@ -0,0 +1,328 @@
+#include "gps_parser.h"
+
+#include <string.h>
+
+#define UBX_SYNC_1 0xB5
+#define UBX_SYNC_2 0x62
+#define UBX_CLASS_NAV 0x01
+#define UBX_NAV_DOP 0x04
+#define UBX_NAV_PVT 0x07
+#define UBX_NAV_DOP_LENGTH 18
+#define UBX_NAV_PVT_LENGTH 92
+
+#define NMEA_GGA 0
+#define NMEA_RMC 1
+#define NMEA_UNKNOWN 0xFF
+#define NMEA_RECEIVED_ALL ((1 << NMEA_GGA) | (1 << NMEA_RMC))
+
+typedef enum gps_parser_state_t {
+    STATE_IDLE,
+    STATE_UBX_SYNC_2,
+    STATE_UBX_CLASS,
+    STATE_UBX_ID,
+    STATE_UBX_LENGTH_1,
+    STATE_UBX_LENGTH_2,
+    STATE_UBX_PAYLOAD,
+    STATE_UBX_CK_A,
+    STATE_UBX_CK_B,
+    STATE_NMEA_FIELD,
+    STATE_NMEA_CHECKSUM_1,
+    STATE_NMEA_CHECKSUM_2
+} gps_parser_state_t;
+
+static inline void ubx_checksum(gps_parser_t *parser, uint8_t data);
+static bool ubx_message(gps_parser_t *parser);
+static void nmea_start(gps_parser_t *parser);
+static void nmea_field(gps_parser_t *parser);
+static bool nmea_sentence(gps_parser_t *parser);
+static bool publish(gps_parser_t *parser);
+static int64_t parse_fixed(const char *field, uint8_t decimals);
+static int32_t parse_coordinate(const char *field);
+static int hex_value(uint8_t data);
+static inline uint16_t get_u16(const uint8_t *data);
+static inline int32_t get_i32(const uint8_t *data);
+
+void gps_parser_init(gps_parser_t *parser) { memset(parser, 0, sizeof(gps_parser_t)); }
+
+bool gps_parser_feed(gps_parser_t *parser, uint8_t data) {
+    // a sync byte restarts the parser unless it is inside an ubx message, where any byte value is valid
+    if (parser->state <= STATE_UBX_SYNC_2 || parser->state >= STATE_NMEA_FIELD) {
+        if (data == '$') {
+            nmea_start(parser);
+            return false;
+        }
+        if (data == UBX_SYNC_1) {
+            parser->state = STATE_UBX_SYNC_2;
+            return false;
+        }
+    }
+    switch (parser->state) {
+        case STATE_UBX_SYNC_2:
+            parser->state = data == UBX_SYNC_2 ? STATE_UBX_CLASS : STATE_IDLE;
+            break;
+        case STATE_UBX_CLASS:
+            parser->ubx_class = data;
+            parser->ubx_ck_a = 0;
+            parser->ubx_ck_b = 0;
+            ubx_checksum(parser, data);
+            parser->state = STATE_UBX_ID;
+            break;
+        case STATE_UBX_ID:
+            parser->ubx_id = data;
+            ubx_checksum(parser, data);
+            parser->state = STATE_UBX_LENGTH_1;
+            break;
+        case STATE_UBX_LENGTH_1:
+            parser->ubx_length = data;
+            ubx_checksum(parser, data);
+            parser->state = STATE_UBX_LENGTH_2;
+            break;
+        case STATE_UBX_LENGTH_2:
+            parser->ubx_length |= (uint16_t)data << 8;
+            ubx_checksum(parser, data);
+            parser->ubx_index = 0;
+            // longer messages are not parsed, resync instead of skipping a length that may be corrupt
+            if (parser->ubx_length > GPS_PARSER_PAYLOAD_MAX)
+                parser->state = STATE_IDLE;
+            else
+                parser->state = parser->ubx_length ? STATE_UBX_PAYLOAD : STATE_UBX_CK_A;
+            break;
+        case STATE_UBX_PAYLOAD:
+            parser->payload[parser->ubx_index++] = data;
+            ubx_checksum(parser, data);
+            if (parser->ubx_index == parser->ubx_length) parser->state = STATE_UBX_CK_A;
+            break;
+        case STATE_UBX_CK_A:
+            if (data == parser->ubx_ck_a) {
+                parser->state = STATE_UBX_CK_B;
+            } else {
+                parser->checksum_errors++;
+                parser->state = STATE_IDLE;
+            }
+            break;
+        case STATE_UBX_CK_B:
+            parser->state = STATE_IDLE;
+            if (data == parser->ubx_ck_b) {
+                parser->messages++;
+                return ubx_message(parser);
+            }
+            parser->checksum_errors++;
+            break;
+        case STATE_NMEA_FIELD:
+            if (data == '*') {
+                nmea_field(parser);
+                parser->state = STATE_NMEA_CHECKSUM_1;
+                break;
+            }
+            // a sentence ending without checksum is dropped
+            if (data < ' ' || data > '~') {
+                parser->state = STATE_IDLE;
+                break;
+            }
+            parser->nmea_checksum ^= data;
+            if (data == ',') {
+                nmea_field(parser);
+            } else if (parser->field_length < GPS_PARSER_FIELD_MAX - 1) {
+                parser->field[parser->field_length++] = data;
+            }
+            break;
+        case STATE_NMEA_CHECKSUM_1:
+            if (hex_value(data) < 0) {
+                parser->state = STATE_IDLE;
+                break;
+            }
+            parser->nmea_checksum_rx = hex_value(data) << 4;
+            parser->state = STATE_NMEA_CHECKSUM_2;
+            break;
+        case STATE_NMEA_CHECKSUM_2:
+            parser->state = STATE_IDLE;
+            if (hex_value(data) < 0) break;
+            parser->nmea_checksum_rx |= hex_value(data);
+            if (parser->nmea_checksum_rx == parser->nmea_checksum) {
+                parser->messages++;
+                return nmea_sentence(parser);
+            }
+            parser->checksum_errors++;
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+static inline void ubx_checksum(gps_parser_t *parser, uint8_t data) {
+    parser->ubx_ck_a += data;
+    parser->ubx_ck_b += parser->ubx_ck_a;
+}
+
+static bool ubx_message(gps_parser_t *parser) {
+    const uint8_t *payload = parser->payload;
+    gps_fix_t *epoch = &parser->epoch;
+    if (parser->ubx_class != UBX_CLASS_NAV) return false;
+    if (parser->ubx_id == UBX_NAV_DOP && parser->ubx_length == UBX_NAV_DOP_LENGTH) {
+        epoch->vdop = get_u16(payload + 10);
+        epoch->hdop = get_u16(payload + 12);
+        return false;
+    }
+    if (parser->ubx_id != UBX_NAV_PVT || parser->ubx_length != UBX_NAV_PVT_LENGTH) return false;
+    epoch->date = payload[7] * 10000L + payload[6] * 100 + (get_u16(payload + 4) - 2000);
+    epoch->time = payload[8] * 10000L + payload[9] * 100 + payload[10];
+    epoch->fix = payload[20];
+    epoch->sat = payload[23];
+    epoch->lon = get_i32(payload + 24);
+    epoch->lat = get_i32(payload + 28);
+    epoch->alt_elipsiod = get_i32(payload + 32);
+    epoch->alt = get_i32(payload + 36);
+    epoch->h_acc = get_i32(payload + 40);
+    epoch->v_acc = get_i32(payload + 44);
+    epoch->vel_n = get_i32(payload + 48);
+    epoch->vel_e = get_i32(payload + 52);
+    epoch->vel_d = get_i32(payload + 56);
+    epoch->speed = get_i32(payload + 60);
+    epoch->cog = get_i32(payload + 64);
+    epoch->speed_acc = get_i32(payload + 68);
+    epoch->track_acc = get_i32(payload + 72);
+    epoch->pdop = get_u16(payload + 76);
+    epoch->is_ubx = true;
+    return publish(parser);
+}
+
+static void nmea_start(gps_parser_t *parser) {
+    parser->state = STATE_NMEA_FIELD;
+    parser->nmea_sentence = NMEA_UNKNOWN;
+    parser->nmea_field = 0;
+    parser->nmea_checksum = 0;
+    parser->field_length = 0;
+    parser->is_lat = false;
+    parser->is_lon = false;
+    parser->sentence = parser->epoch;
+    parser->sentence_time = parser->epoch_time;
+}
+
+/* Field indexes count the sentence id as 0 */
+static void nmea_field(gps_parser_t *parser) {
+    static const uint8_t fields[2][10] = {
+        {0, 'T', 'Y', 'y', 'X', 'x', 'F', 'S', 'H', 'A'},  // GGA
+        {0, 'T', 0, 'Y', 'y', 'X', 'x', 'V', 'C', 'D'}};   // RMC
+    char *field = parser->field;
+    gps_fix_t *sentence = &parser->sentence;
+    uint8_t index = parser->nmea_field++;
+    field[parser->field_length] = 0;
+    parser->field_length = 0;
+    if (index == 0) {
+        if (!strcmp(field + 2, "GGA"))
+            parser->nmea_sentence = NMEA_GGA;
+        else if (!strcmp(field + 2, "RMC"))
+            parser->nmea_sentence = NMEA_RMC;
+        return;
+    }
+    if (parser->nmea_sentence == NMEA_UNKNOWN || index >= sizeof(fields[0]) || !field[0]) return;
+    switch (fields[parser->nmea_sentence][index]) {
+        case 'T':
+            parser->sentence_time = parse_fixed(field, 2);
+            sentence->time = parser->sentence_time / 100;
+            break;
+        case 'Y':
+            sentence->lat = parse_coordinate(field);
+            parser->is_lat = true;
+            break;
+        case 'y':
+            if (parser->is_lat && field[0] == 'S') sentence->lat = -sentence->lat;
+            break;
+        case 'X':
+            sentence->lon = parse_coordinate(field);
+            parser->is_lon = true;
+            break;
+        case 'x':
+            if (parser->is_lon && field[0] == 'W') sentence->lon = -sentence->lon;
+            break;
+        case 'F':
+            sentence->fix = parse_fixed(field, 0) ? 3 : 0;
+            break;
+        case 'S':
+            sentence->sat = parse_fixed(field, 0);
+            break;
+        case 'H':
+            sentence->hdop = parse_fixed(field, 2);
+            break;
+        case 'A':
+            sentence->alt = parse_fixed(field, 3);
+            break;
+        case 'V':
+            // knots to mm/s
+            sentence->speed = (uint64_t)parse_fixed(field, 3) * 1852 / 3600;
+            break;
+        case 'C':
+            sentence->cog = parse_fixed(field, 5);
+            break;
+        case 'D':
+            sentence->date = parse_fixed(field, 0);
+            break;
+    }
+}
+
+static bool nmea_sentence(gps_parser_t *parser) {
+    if (parser->nmea_sentence == NMEA_UNKNOWN) return false;
+    uint8_t received = 1 << parser->nmea_sentence;
+    // a sentence of a new epoch before the previous one completed: that one lost a sentence and would mix the fields
+    // of two epochs, drop it
+    if (parser->nmea_received &&
+        (parser->nmea_received & received || parser->sentence_time != parser->epoch_time)) {
+        parser->nmea_received = 0;
+        parser->incomplete_epochs++;
+    }
+    parser->epoch = parser->sentence;
+    parser->epoch_time = parser->sentence_time;
+    parser->epoch.is_ubx = false;
+    parser->nmea_received |= received;
+    if (parser->nmea_received == NMEA_RECEIVED_ALL) return publish(parser);
+    return false;
+}
+
+static bool publish(gps_parser_t *parser) {
+    parser->fix = parser->epoch;
+    parser->nmea_received = 0;
+    parser->epochs++;
+    return true;
+}
+
+/* "-12.3456" with 2 decimals is -1234. Extra decimals are truncated. Unsigned math, so garbage can not overflow */
+static int64_t parse_fixed(const char *field, uint8_t decimals) {
+    uint64_t value = 0;
+    int decimal = -1;
+    bool is_negative = false;
+    for (; *field; field++) {
+        if (*field == '-') {
+            is_negative = true;
+        } else if (*field == '.') {
+            if (decimal < 0) decimal = 0;
+        } else if (*field >= '0' && *field <= '9') {
+            if (decimal >= decimals) continue;
+            if (decimal >= 0) decimal++;
+            value = value * 10 + (*field - '0');
+        }
+    }
+    for (decimal = decimal < 0 ? 0 : decimal; decimal < decimals; decimal++) value *= 10;
+    return (int64_t)(is_negative ? -value : value);
+}
+
+/* [d]ddmm.mmmmmmm to deg * 1e7 */
+static int32_t parse_coordinate(const char *field) {
+    int64_t value = parse_fixed(field, 7);
+    int64_t degrees = value / 1000000000;
+    int64_t minutes = value % 1000000000;
+    return degrees * 10000000 + (minutes + 30) / 60;
+}
+
+static int hex_value(uint8_t data) {
+    if (data >= '0' && data <= '9') return data - '0';
+    if (data >= 'A' && data <= 'F') return data - 'A' + 10;
+    if (data >= 'a' && data <= 'f') return data - 'a' + 10;
+    return -1;
+}
+
+static inline uint16_t get_u16(const uint8_t *data) { return data[0] | (uint16_t)data[1] << 8; }
+
+static inline int32_t get_i32(const uint8_t *data) {
+    return (int32_t)(data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24);
+}
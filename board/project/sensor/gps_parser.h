@@ -0,0 +1,53 @@
+#ifndef GPS_PARSER_H
+#define GPS_PARSER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+   GPS stream parser
+   Incremental state machine for u-blox UBX (NAV-PVT, NAV-DOP) and NMEA (GGA, RMC) fed one byte at a time. Checksums
+   are verified as the bytes arrive and a message only updates the epoch once its checksum matches. Fields are
+   converted with integer math to the fixed point units of NAV-PVT. gps_parser_feed() returns true when an epoch is
+   complete and copied to fix: at NAV-PVT for UBX (NAV-DOP of the same epoch comes before it, the last one received is
+   kept if it is lost or sent at a lower rate), once GGA and RMC with the same time are received for NMEA. An NMEA
+   epoch that lost one of them is dropped and counted in incomplete_epochs. No allocations, no floats
+*/
+
+#define GPS_PARSER_PAYLOAD_MAX 92  // NAV-PVT
+#define GPS_PARSER_FIELD_MAX 16
+
+typedef struct gps_fix_t {
+    int32_t lat, lon;                             // deg * 1e7
+    int32_t alt, alt_elipsiod;                    // mm
+    int32_t speed, vel_n, vel_e, vel_d;           // mm/s
+    int32_t cog;                                  // deg * 1e5
+    uint32_t h_acc, v_acc, speed_acc, track_acc;  // mm, mm, mm/s, deg * 1e5
+    uint32_t time, date;                          // hhmmss, ddmmyy
+    uint16_t hdop, vdop, pdop;                    // dop * 100
+    uint8_t sat, fix;
+    bool is_ubx;  // velocities and accuracies are only in NAV-PVT
+} gps_fix_t;
+
+typedef struct gps_parser_t {
+    uint8_t state;
+    // ubx
+    uint8_t ubx_class, ubx_id, ubx_ck_a, ubx_ck_b;
+    uint16_t ubx_length, ubx_index;
+    uint8_t payload[GPS_PARSER_PAYLOAD_MAX];
+    // nmea
+    uint8_t nmea_sentence, nmea_field, nmea_checksum, nmea_checksum_rx, field_length;
+    char field[GPS_PARSER_FIELD_MAX];
+    bool is_lat, is_lon;
+    uint8_t nmea_received;
+    uint32_t sentence_time, epoch_time;  // hhmmss * 100 + hundredths, several epochs a second share hhmmss
+    gps_fix_t sentence, epoch;
+    gps_fix_t fix;
+    uint32_t epochs, incomplete_epochs;  // published, dropped (nmea)
+    uint32_t messages, checksum_errors;  // messages with a valid checksum, of any type
+} gps_parser_t;
+
+void gps_parser_init(gps_parser_t *parser);
+bool gps_parser_feed(gps_parser_t *parser, uint8_t data);
+
+#endif
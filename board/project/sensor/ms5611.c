@@ -99,11 +99,13 @@ static void read(ms5611_parameters_t *parameter, ms5611_calibration_t *calibrati
     OFF = OFF - OFF2;
     SENS = SENS - SENS2;
     int32_t P = (((D1 * SENS) >> 21) - OFF) >> 15;
+    seqlock_write_begin(parameter->lock);
     *parameter->temperature = (float)TEMP / 100;  // °C
     *parameter->pressure = (float)P;              // Pa
     if (pressure_initial == 0 && discard_readings == 0) pressure_initial = *parameter->pressure;
     *parameter->altitude = get_altitude(*parameter->pressure, *parameter->temperature, pressure_initial);
     get_vspeed(parameter->vspeed, *parameter->altitude, VSPEED_INTERVAL_MS);
+    seqlock_write_end(parameter->lock);
     if (discard_readings > 0) discard_readings--;
     debug("\nMS5611 P0: %.0f", pressure_initial);
 #ifdef SIM_SENSORS
@@ -2,12 +2,14 @@
 #define MS5611_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct ms5611_parameters_t {
     float alpha_vario;
     bool auto_offset;
     uint8_t address;
     float *temperature, *pressure, *altitude, *vspeed;
+    seqlock_t *lock;
 } ms5611_parameters_t;
 
 typedef struct ms5611_calibration_t {
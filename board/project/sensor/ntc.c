@@ -1,9 +1,9 @@
 #include "ntc.h"
 
-#include <math.h>
 #include <stdio.h>
 
-#include "hardware/adc.h"
+#include "adc_sampler.h"
+#include "thermistor.h"
 
 // Thermistors (NTC 100k, R1 10k)
 #define NTC_R_REF 100000UL
@@ -14,18 +14,22 @@
 // #define NTC_C1 3.41E-06
 // #define NTC_D1 1.03E-07
 
+static thermistor_t thermistor;
+
 void ntc_task(void *parameters) {
     ntc_parameters_t parameter = *(ntc_parameters_t *)parameters;
-    adc_init();
-    adc_gpio_init(parameter.adc_num + 26);
-    //gpio_pull_down(parameter.adc_num + 26);
+    adc_sampler_add(parameter.adc_num);
+#ifdef NTC_A1
+    thermistor_init_steinhart(&thermistor, NTC_A1, NTC_B1, NTC_C1, NTC_D1, NTC_R_REF, NTC_R1);
+#else
+    thermistor_init_beta(&thermistor, NTC_BETA, NTC_R_REF, 25, NTC_R1);
+#endif
     *parameter.ntc = 0;
     xTaskNotifyGive(context.receiver_task_handle);
     while (1) {
-        float voltage = voltage_read(parameter.adc_num);
-        float ntcR_Rref = (voltage * NTC_R1 / (BOARD_VCC - voltage)) / NTC_R_REF;
-        if (ntcR_Rref < 0.0001) ntcR_Rref = 0.0001;
-        float temperature = 1 / (log(ntcR_Rref) / NTC_BETA + 1 / 298.15) - 273.15;
+        uint32_t ratio =
+            (uint32_t)adc_sampler_read(parameter.adc_num) * 65536 / (ADC_RESOLUTION << ADC_DECIMATOR_EXTRA_BITS);
+        float temperature = thermistor_temperature(&thermistor, ratio);
         *parameter.ntc = get_average(parameter.alpha, *parameter.ntc, temperature);
 #ifdef SIM_SENSORS
         *parameter.ntc = 12.34;
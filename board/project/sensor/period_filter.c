@@ -0,0 +1,35 @@
+#include "period_filter.h"
+
+#include <string.h>
+
+void period_filter_reset(period_filter_t *filter) { memset(filter, 0, sizeof(period_filter_t)); }
+
+void period_filter_rise(period_filter_t *filter, uint32_t counter) {
+    if (filter->is_last_set) {
+        filter->period[filter->index] = counter - filter->last;
+        filter->index = (filter->index + 1) % PERIOD_FILTER_SAMPLES;
+        if (filter->count < PERIOD_FILTER_SAMPLES) filter->count++;
+    }
+    filter->last = counter;
+    filter->is_last_set = true;
+}
+
+float period_filter_get(const period_filter_t *filter) {
+    uint32_t sorted[PERIOD_FILTER_SAMPLES];
+    uint8_t count = filter->count;
+    if (count < 2) return 0;
+    // insertion sort, at most 16
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t period = filter->period[i];
+        int8_t j = i - 1;
+        while (j >= 0 && sorted[j] > period) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = period;
+    }
+    uint8_t trim = count / 4;
+    uint64_t sum = 0;
+    for (uint8_t i = trim; i < count - trim; i++) sum += sorted[i];
+    return (float)sum / (count - 2 * trim);
+}
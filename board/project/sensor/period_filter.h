@@ -0,0 +1,27 @@
+#ifndef PERIOD_FILTER_H
+#define PERIOD_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+   Period filter
+   Keeps the last PERIOD_FILTER_SAMPLES periods between rising edges (counter units, wrapping) and returns their
+   trimmed mean: sorted, a quarter is dropped at each end, so jitter is averaged and a glitch or a missed edge is
+   ignored. Reset it when the signal times out, the first edge after a reset does not make a period
+*/
+
+#define PERIOD_FILTER_SAMPLES 16
+
+typedef struct period_filter_t {
+    uint32_t period[PERIOD_FILTER_SAMPLES];
+    uint32_t last;
+    uint8_t index, count;
+    bool is_last_set;
+} period_filter_t;
+
+void period_filter_reset(period_filter_t *filter);
+void period_filter_rise(period_filter_t *filter, uint32_t counter);
+float period_filter_get(const period_filter_t *filter);  // 0 until two periods
+
+#endif
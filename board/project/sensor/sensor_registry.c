@@ -0,0 +1,430 @@
+#include "sensor_registry.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "airspeed.h"
+#include "bmp180.h"
+#include "bmp280.h"
+#include "current.h"
+#include "esc_apd_f.h"
+#include "esc_apd_hv.h"
+#include "esc_castle.h"
+#include "esc_hw3.h"
+#include "esc_hw4.h"
+#include "esc_hw5.h"
+#include "esc_kontronik.h"
+#include "esc_omp_m4.h"
+#include "esc_pwm.h"
+#include "esc_ztw.h"
+#include "fuel_meter.h"
+#include "gpio.h"
+#include "gps.h"
+#include "ms5611.h"
+#include "ntc.h"
+#include "pool.h"
+#include "pwm_out.h"
+#include "seqlock.h"
+#include "smart_esc.h"
+#include "voltage.h"
+#include "xgzp68xxd.h"
+
+static sensor_values_t values, snapshot;
+static seqlock_t lock_esc, lock_gps, lock_baro;
+static bool is_started = false;
+
+static void start_esc(config_t *config);
+static void start_gps(config_t *config);
+static void start_analog(config_t *config);
+static void start_baro(config_t *config);
+static void start_fuel(config_t *config);
+static void start_gpio(config_t *config);
+static void start_task(TaskFunction_t task, const char *name, uint stack, void *parameters, bool is_uart1);
+static void copy_group(seqlock_t *lock, void *copy, const void *group, uint size);
+
+sensor_values_t *sensor_registry_start(config_t *config) {
+    if (is_started) return &snapshot;
+    is_started = true;
+    start_esc(config);
+    start_gps(config);
+    start_analog(config);
+    start_baro(config);
+    start_fuel(config);
+    start_gpio(config);
+    return &snapshot;
+}
+
+sensor_values_t *sensor_registry_values(void) { return &values; }
+
+void sensor_registry_snapshot(void) {
+    copy_group(&lock_esc, &snapshot.esc, &values.esc, sizeof(sensor_esc_t));
+    copy_group(&lock_gps, &snapshot.gps, &values.gps, sizeof(sensor_gps_t));
+    copy_group(&lock_baro, &snapshot.baro, &values.baro, sizeof(sensor_baro_t));
+    snapshot.analog = values.analog;
+    snapshot.fuel = values.fuel;
+    snapshot.gpio = values.gpio;
+}
+
+/* Host runs start again from an empty table */
+void sensor_registry_reset(void) {
+    memset(&values, 0, sizeof(values));
+    memset(&snapshot, 0, sizeof(snapshot));
+    lock_esc = lock_gps = lock_baro = (seqlock_t){0};
+    is_started = false;
+}
+
+static void start_esc(config_t *config) {
+    sensor_esc_t *esc = &values.esc;
+    switch (config->esc_protocol) {
+        case ESC_PWM: {
+            static esc_pwm_parameters_t parameter;
+            parameter = (esc_pwm_parameters_t){config->rpm_multiplier, config->alpha_rpm, &esc->rpm};
+            start_task(esc_pwm_task, "esc_pwm_task", STACK_ESC_PWM, &parameter, false);
+            break;
+        }
+        case ESC_HW3: {
+            static esc_hw3_parameters_t parameter;
+            parameter = (esc_hw3_parameters_t){config->rpm_multiplier, config->alpha_rpm, &esc->rpm};
+            start_task(esc_hw3_task, "esc_hw3_task", STACK_ESC_HW3, &parameter, true);
+            break;
+        }
+        case ESC_HW4: {
+            static esc_hw4_parameters_t parameter;
+            parameter = (esc_hw4_parameters_t){config->rpm_multiplier,
+                                               config->enable_pwm_out,
+                                               config->enable_esc_hw4_init_delay,
+                                               config->alpha_rpm,
+                                               config->alpha_voltage,
+                                               config->alpha_current,
+                                               config->alpha_temperature,
+                                               config->esc_hw4_divisor,
+                                               config->esc_hw4_current_multiplier,
+                                               config->esc_hw4_current_thresold,
+                                               config->esc_hw4_current_max,
+                                               config->esc_hw4_is_manual_offset,
+                                               config->esc_hw4_offset,
+                                               &esc->rpm,
+                                               &esc->voltage,
+                                               &esc->current,
+                                               &esc->temperature_fet,
+                                               &esc->temperature_bec,
+                                               &esc->cell_voltage,
+                                               &esc->consumption,
+                                               &esc->cell_count,
+                                               &lock_esc};
+            start_task(esc_hw4_task, "esc_hw4_task", STACK_ESC_HW4, &parameter, true);
+            if (config->enable_pwm_out) {
+                TaskHandle_t task_handle;
+                pool_task_create_on_core(pwm_out_task, "pwm_out", STACK_PWM_OUT, (void *)&esc->rpm, 2, CORE_SENSOR,
+                                         &task_handle);
+                context.pwm_out_task_handle = task_handle;
+                xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            break;
+        }
+        case ESC_HW5: {
+            static esc_hw5_parameters_t parameter;
+            parameter = (esc_hw5_parameters_t){config->rpm_multiplier,
+                                               config->alpha_rpm,
+                                               config->alpha_voltage,
+                                               config->alpha_current,
+                                               config->alpha_temperature,
+                                               &esc->rpm,
+                                               &esc->voltage,
+                                               &esc->current,
+                                               &esc->temperature_fet,
+                                               &esc->temperature_bec,
+                                               &esc->temperature_motor,
+                                               &esc->voltage_bec,
+                                               &esc->current_bec,
+                                               &esc->cell_voltage,
+                                               &esc->consumption,
+                                               &esc->cell_count,
+                                               &lock_esc};
+            start_task(esc_hw5_task, "esc_hw5_task", STACK_ESC_HW5, &parameter, true);
+            break;
+        }
+        case ESC_CASTLE: {
+            static esc_castle_parameters_t parameter;
+            parameter = (esc_castle_parameters_t){config->rpm_multiplier,
+                                                  config->alpha_rpm,
+                                                  config->alpha_voltage,
+                                                  config->alpha_current,
+                                                  config->alpha_temperature,
+                                                  &esc->voltage,
+                                                  &esc->ripple_voltage,
+                                                  &esc->current,
+                                                  &esc->thr,
+                                                  &esc->output,
+                                                  &esc->rpm,
+                                                  &esc->consumption,
+                                                  &esc->voltage_bec,
+                                                  &esc->current_bec,
+                                                  &esc->temperature_fet,
+                                                  &esc->cell_voltage,
+                                                  &esc->cell_count,
+                                                  &lock_esc};
+            start_task(esc_castle_task, "esc_castle_task", STACK_ESC_CASTLE, &parameter, false);
+            break;
+        }
+        case ESC_KONTRONIK: {
+            static esc_kontronik_parameters_t parameter;
+            parameter = (esc_kontronik_parameters_t){config->rpm_multiplier,
+                                                     config->alpha_rpm,
+                                                     config->alpha_voltage,
+                                                     config->alpha_current,
+                                                     config->alpha_temperature,
+                                                     &esc->rpm,
+                                                     &esc->voltage,
+                                                     &esc->current,
+                                                     &esc->voltage_bec,
+                                                     &esc->current_bec,
+                                                     &esc->temperature_fet,
+                                                     &esc->temperature_bec,
+                                                     &esc->cell_voltage,
+                                                     &esc->consumption,
+                                                     &esc->cell_count,
+                                                     &lock_esc};
+            start_task(esc_kontronik_task, "esc_kontronik_task", STACK_ESC_KONTRONIK, &parameter, true);
+            break;
+        }
+        case ESC_APD_F: {
+            static esc_apd_f_parameters_t parameter;
+            parameter = (esc_apd_f_parameters_t){config->rpm_multiplier, config->alpha_rpm,    config->alpha_voltage,
+                                                 config->alpha_current,  config->alpha_temperature, &esc->rpm,
+                                                 &esc->voltage,          &esc->current,        &esc->temperature_fet,
+                                                 &esc->cell_voltage,     &esc->consumption,    &esc->cell_count,
+                                                 &lock_esc};
+            start_task(esc_apd_f_task, "esc_apd_f_task", STACK_ESC_APD_F, &parameter, true);
+            break;
+        }
+        case ESC_APD_HV: {
+            static esc_apd_hv_parameters_t parameter;
+            parameter = (esc_apd_hv_parameters_t){config->rpm_multiplier, config->alpha_rpm,    config->alpha_voltage,
+                                                  config->alpha_current,  config->alpha_temperature, &esc->rpm,
+                                                  &esc->voltage,          &esc->current,        &esc->temperature_fet,
+                                                  &esc->cell_voltage,     &esc->consumption,    &esc->cell_count,
+                                                  &lock_esc};
+            start_task(esc_apd_hv_task, "esc_apd_hv_task", STACK_ESC_APD_HV, &parameter, true);
+            break;
+        }
+        case ESC_SMART: {
+            static smart_esc_parameters_t parameter;
+            parameter.calc_consumption = config->smart_esc_calc_consumption;
+            parameter.rpm_multiplier = config->rpm_multiplier;
+            parameter.alpha_rpm = config->alpha_rpm;
+            parameter.alpha_voltage = config->alpha_voltage;
+            parameter.alpha_current = config->alpha_current;
+            parameter.alpha_temperature = config->alpha_temperature;
+            parameter.rpm = &esc->rpm;
+            parameter.voltage = &esc->voltage;
+            parameter.current = &esc->current;
+            parameter.temperature_fet = &esc->temperature_fet;
+            parameter.temperature_bec = &esc->temperature_bec;
+            parameter.voltage_bec = &esc->voltage_bec;
+            parameter.current_bec = &esc->current_bec;
+            parameter.temperature_bat = &esc->temperature_bat;
+            parameter.current_bat = &esc->current_bat;
+            parameter.consumption = &esc->consumption;
+            for (uint i = 0; i < SENSOR_ESC_MAX_CELLS; i++) parameter.cell[i] = &esc->cell[i];
+            parameter.cells = &esc->cell_count;
+            parameter.cycles = &esc->cycles;
+            parameter.lock = &lock_esc;
+            start_task(smart_esc_task, "smart_esc_task", STACK_SMART_ESC, &parameter, true);
+            break;
+        }
+        case ESC_OMP_M4: {
+            static esc_omp_m4_parameters_t parameter;
+            parameter.rpm_multiplier = config->rpm_multiplier;
+            parameter.alpha_rpm = config->alpha_rpm;
+            parameter.alpha_voltage = config->alpha_voltage;
+            parameter.alpha_current = config->alpha_current;
+            parameter.alpha_temperature = config->alpha_temperature;
+            parameter.rpm = &esc->rpm;
+            parameter.voltage = &esc->voltage;
+            parameter.current = &esc->current;
+            parameter.temp_esc = &esc->temperature_fet;
+            parameter.temp_motor = &esc->temperature_motor;
+            parameter.cell_voltage = &esc->cell_voltage;
+            parameter.consumption = &esc->consumption;
+            parameter.cell_count = &esc->cell_count;
+            parameter.lock = &lock_esc;
+            start_task(esc_omp_m4_task, "esc_omp_m4_task", STACK_ESC_OMP_M4, &parameter, true);
+            break;
+        }
+        case ESC_ZTW: {
+            static esc_ztw_parameters_t parameter;
+            parameter.rpm_multiplier = config->rpm_multiplier;
+            parameter.alpha_rpm = config->alpha_rpm;
+            parameter.alpha_voltage = config->alpha_voltage;
+            parameter.alpha_current = config->alpha_current;
+            parameter.alpha_temperature = config->alpha_temperature;
+            parameter.rpm = &esc->rpm;
+            parameter.voltage = &esc->voltage;
+            parameter.current = &esc->current;
+            parameter.temp_esc = &esc->temperature_fet;
+            parameter.temp_motor = &esc->temperature_motor;
+            parameter.bec_voltage = &esc->voltage_bec;
+            parameter.cell_voltage = &esc->cell_voltage;
+            parameter.consumption = &esc->consumption;
+            parameter.cell_count = &esc->cell_count;
+            parameter.lock = &lock_esc;
+            start_task(esc_ztw_task, "esc_ztw_task", STACK_ESC_ZTW, &parameter, true);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+static void start_gps(config_t *config) {
+    if (!config->enable_gps) return;
+    sensor_gps_t *gps = &values.gps;
+    static gps_parameters_t parameter;
+    parameter.protocol = config->gps_protocol;
+    parameter.baudrate = config->gps_baudrate;
+    parameter.rate = config->gps_rate;
+    parameter.lat = &gps->lat;
+    parameter.lon = &gps->lon;
+    parameter.alt = &gps->alt;
+    parameter.spd = &gps->spd;
+    parameter.cog = &gps->cog;
+    parameter.hdop = &gps->hdop;
+    parameter.sat = &gps->sat;
+    parameter.time = &gps->time;
+    parameter.date = &gps->date;
+    parameter.vspeed = &gps->vspeed;
+    parameter.dist = &gps->dist;
+    parameter.spd_kmh = &gps->spd_kmh;
+    parameter.fix = &gps->fix;
+    parameter.vdop = &gps->vdop;
+    parameter.speed_acc = &gps->speed_acc;
+    parameter.h_acc = &gps->h_acc;
+    parameter.v_acc = &gps->v_acc;
+    parameter.track_acc = &gps->track_acc;
+    parameter.n_vel = &gps->n_vel;
+    parameter.e_vel = &gps->e_vel;
+    parameter.v_vel = &gps->v_vel;
+    parameter.alt_elipsiod = &gps->alt_elipsiod;
+    parameter.pdop = &gps->pdop;
+    parameter.bearing = &gps->bearing;
+    parameter.odometer = &gps->odometer;
+    parameter.lock = &lock_gps;
+    TaskHandle_t task_handle;
+    pool_task_create_on_core(gps_task, "gps_task", STACK_GPS, (void *)&parameter, 2, CORE_SENSOR, &task_handle);
+    context.uart_pio_notify_task_handle = task_handle;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+static void start_analog(config_t *config) {
+    sensor_analog_t *analog = &values.analog;
+    if (config->enable_analog_voltage) {
+        static voltage_parameters_t parameter;
+        parameter = (voltage_parameters_t){0, config->analog_rate, config->alpha_voltage,
+                                           config->analog_voltage_multiplier, &analog->voltage};
+        start_task(voltage_task, "voltage_task", STACK_VOLTAGE, &parameter, false);
+    }
+    if (config->enable_analog_current) {
+        static current_parameters_t parameter;
+        parameter = (current_parameters_t){1,
+                                           config->analog_rate,
+                                           config->alpha_current,
+                                           config->analog_current_multiplier,
+                                           config->analog_current_offset,
+                                           config->analog_current_autoffset,
+                                           &analog->current,
+                                           &analog->consumption,
+                                           &analog->current_voltage};
+        start_task(current_task, "current_task", STACK_CURRENT, &parameter, false);
+    }
+    if (config->enable_analog_ntc) {
+        static ntc_parameters_t parameter;
+        parameter = (ntc_parameters_t){2, config->analog_rate, config->alpha_temperature, &analog->ntc};
+        start_task(ntc_task, "ntc_task", STACK_NTC, &parameter, false);
+    }
+}
+
+static void start_baro(config_t *config) {
+    sensor_baro_t *baro = &values.baro;
+    if (config->i2c_module == I2C_BMP280) {
+        static bmp280_parameters_t parameter;
+        parameter = (bmp280_parameters_t){config->alpha_vario,   config->vario_auto_offset, config->i2c_address,
+                                          config->bmp280_filter, &baro->temperature,         &baro->pressure,
+                                          &baro->altitude,       &baro->vspeed,                &lock_baro};
+        start_task(bmp280_task, "bmp280_task", STACK_BMP280, &parameter, false);
+    }
+    if (config->i2c_module == I2C_MS5611) {
+        static ms5611_parameters_t parameter;
+        parameter = (ms5611_parameters_t){config->alpha_vario, config->vario_auto_offset, config->i2c_address,
+                                          &baro->temperature,  &baro->pressure,           &baro->altitude,
+                                          &baro->vspeed,       &lock_baro};
+        start_task(ms5611_task, "ms5611_task", STACK_MS5611, &parameter, false);
+    }
+    if (config->i2c_module == I2C_BMP180) {
+        static bmp180_parameters_t parameter;
+        parameter = (bmp180_parameters_t){config->alpha_vario, config->vario_auto_offset, config->i2c_address,
+                                          &baro->temperature,  &baro->pressure,           &baro->altitude,
+                                          &baro->vspeed,       &lock_baro};
+        start_task(bmp180_task, "bmp180_task", STACK_BMP180, &parameter, false);
+    }
+    if (config->enable_analog_airspeed) {
+        // air temperature and pressure from the baro, if any
+        bool is_baro = config->i2c_module != I2C_NONE;
+        static airspeed_parameters_t parameter;
+        parameter = (airspeed_parameters_t){3,
+                                            config->analog_rate,
+                                            config->alpha_airspeed,
+                                            (float)config->airspeed_offset / 100,
+                                            (float)config->airspeed_slope / 100,
+                                            is_baro ? &baro->temperature : NULL,
+                                            is_baro ? &baro->pressure : NULL,
+                                            &values.analog.airspeed};
+        start_task(airspeed_task, "airspeed_task", STACK_AIRSPEED, &parameter, false);
+    }
+}
+
+static void start_fuel(config_t *config) {
+    sensor_fuel_t *fuel = &values.fuel;
+    if (config->enable_fuel_flow) {
+        static fuel_meter_parameters_t parameter;
+        parameter = (fuel_meter_parameters_t){config->fuel_flow_ml_per_pulse, &fuel->consumption_instant,
+                                              &fuel->consumption_total};
+        start_task(fuel_meter_task, "fuel_meter_task", STACK_FUEL_METER, &parameter, false);
+    }
+    if (config->enable_fuel_pressure) {
+        static xgzp68xxd_parameters_t parameter;
+        parameter = (xgzp68xxd_parameters_t){config->xgzp68xxd_k, &fuel->temperature, &fuel->pressure};
+        start_task(xgzp68xxd_task, "fuel_pressure_task", STACK_FUEL_PRESSURE, &parameter, false);
+    }
+}
+
+static void start_gpio(config_t *config) {
+    if (!config->gpio_mask) return;
+    static gpio_parameters_t parameter;
+    parameter = (gpio_parameters_t){config->gpio_mask, config->gpio_interval, &values.gpio};
+    start_task(gpio_task, "gpio_task", STACK_GPIO, &parameter, false);
+}
+
+static void start_task(TaskFunction_t task, const char *name, uint stack, void *parameters, bool is_uart1) {
+    TaskHandle_t task_handle;
+    pool_task_create_on_core(task, name, stack, parameters, 2, CORE_SENSOR, &task_handle);
+    if (is_uart1) context.uart1_notify_task_handle = task_handle;
+    xQueueSendToBack(context.tasks_queue_handle, task_handle, 0);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+/* A group still being written after the retries keeps its previous copy */
+static void copy_group(seqlock_t *lock, void *copy, const void *group, uint size) {
+    static union {
+        sensor_esc_t esc;
+        sensor_gps_t gps;
+        sensor_baro_t baro;
+    } buffer;
+    for (uint i = 0; i < SENSOR_REGISTRY_SNAPSHOT_RETRIES; i++) {
+        if (seqlock_read(lock, &buffer, group, size)) {
+            memcpy(copy, &buffer, size);
+            return;
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include "common.h"
+
+/*
+   Sensor registry
+   Starts the sensor tasks enabled in config_t once and owns their outputs in a single static value table.
+   Protocols only map the table slots to their wire ids
+   Sensor tasks write the live table, the esc, gps and baro groups under a seqlock. sensor_registry_start() returns a
+   snapshot of the table that the protocol refreshes with sensor_registry_snapshot() before it encodes, from one
+   context at a time, so a frame never mixes values of two sensor updates
+*/
+
+#define SENSOR_ESC_MAX_CELLS 18
+#define SENSOR_REGISTRY_SNAPSHOT_RETRIES 4
+
+typedef struct sensor_esc_t {
+    float rpm, voltage, current, consumption, cell_voltage;
+    float temperature_fet, temperature_bec, temperature_motor, temperature_bat;
+    float voltage_bec, current_bec, current_bat, ripple_voltage, thr, output;
+    float cell[SENSOR_ESC_MAX_CELLS];
+    uint16_t cycles;
+    uint8_t cell_count;
+} sensor_esc_t;
+
+typedef struct sensor_gps_t {
+    float lat, lon, alt, spd, cog, hdop, sat, time, date, vspeed, dist, spd_kmh, fix, vdop, speed_acc, h_acc, v_acc,
+        track_acc, n_vel, e_vel, v_vel, alt_elipsiod, pdop, bearing, odometer;
+} sensor_gps_t;
+
+typedef struct sensor_baro_t {
+    float temperature, pressure, altitude, vspeed;
+} sensor_baro_t;
+
+typedef struct sensor_analog_t {
+    float voltage, current, consumption, current_voltage, ntc, airspeed;
+} sensor_analog_t;
+
+typedef struct sensor_fuel_t {
+    float consumption_instant, consumption_total, temperature, pressure;
+} sensor_fuel_t;
+
+typedef struct sensor_values_t {
+    sensor_esc_t esc;
+    sensor_gps_t gps;
+    sensor_baro_t baro;
+    sensor_analog_t analog;
+    sensor_fuel_t fuel;
+    uint8_t gpio;
+} sensor_values_t;
+
+extern context_t context;
+
+sensor_values_t *sensor_registry_start(config_t *config);
+sensor_values_t *sensor_registry_values(void);
+void sensor_registry_snapshot(void);
+void sensor_registry_reset(void);
+
+#endif
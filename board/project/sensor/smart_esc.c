@@ -5,6 +5,8 @@
 #include "auto_offset.h"
 #include "capture_edge.h"
 #include "cell_count.h"
+#include "coulomb.h"
+#include "crc.h"
 #include "hardware/clocks.h"
 #include "pico/stdlib.h"
 #include "srxl.h"
@@ -127,6 +129,7 @@ typedef struct srxl2_control_packet_t {
 #define SRXL2_CONTROL_LEN_CHANNEL (5 + sizeof(srxl2_channel_data_t) + 2)  // header + channel data + crc
 
 static volatile uint8_t esc_id = 0, esc_priority = 10;
+static coulomb_t coulomb;
 static volatile uint16_t throttle = 0, reverse = 0;
 static volatile bool packet_pending = false;
 
@@ -149,7 +152,8 @@ void smart_esc_task(void *parameters) {
     *parameter.voltage_bec = 0;
     *parameter.current_bec = 0;
     *parameter.current_bat = 0;
-    *parameter.consumption = 0;
+    coulomb_init(&coulomb, 0, COULOMB_SOURCE_ESC);
+    *parameter.consumption = coulomb_get(&coulomb);
     xTaskNotifyGive(context.receiver_task_handle);
 #ifdef SIM_SENSORS
     *parameter.rpm = 12345.67;
@@ -169,7 +173,10 @@ void smart_esc_task(void *parameters) {
 
     while (1) {
         ulTaskNotifyTakeIndexed(1, pdTRUE, portMAX_DELAY);
+        seqlock_write_begin(parameter.lock);
         process(&parameter);
+        seqlock_write_end(parameter.lock);
+        coulomb_checkpoint(&coulomb);
         if (packet_pending) {
             packet_pending = false;
             send_packet();
@@ -185,7 +192,7 @@ static void process(smart_esc_parameters_t *parameter) {
         uart1_read_bytes(data, length);
         debug("\nSmart ESC (%u) < ", uxTaskGetStackHighWaterMark(NULL));
         debug_buffer(data, length, " 0x%X");
-        uint16_t crc = srxl_get_crc(data, length - 2);
+        uint16_t crc = crc16_srxl(0, data, length - 2);
         if ((crc >> 8) != data[length - 2] || (crc & 0xFF) != data[length - 1]) {
             debug(" -> BAD CRC 0x%X", crc);
             return;
@@ -218,7 +225,6 @@ static void process(smart_esc_parameters_t *parameter) {
 static void read_packet(uint8_t *buffer, smart_esc_parameters_t *parameter) {
     if (buffer[0] == XBUS_ESC_ID) {
         xbus_esc_t esc;
-        static uint32_t timestamp = 0;
         memcpy(&esc, buffer, sizeof(xbus_esc_t));
         *parameter->rpm = swap_16(esc.rpm) * 10 * parameter->rpm_multiplier;
         *parameter->voltage = swap_16(esc.volts_input) / 100.0;
@@ -227,7 +233,10 @@ static void read_packet(uint8_t *buffer, smart_esc_parameters_t *parameter) {
         *parameter->current_bec = esc.current_bec == 0xFF ? 0 : esc.current_bec / 100.0;
         *parameter->temperature_fet = esc.temp_fet == 0xFFFF ? 0 : (swap_16(esc.temp_fet) / 10.0);
         *parameter->temperature_bec = esc.temp_bec == 0xFFFF ? 0 : swap_16(esc.temp_bec) / 10.0;
-        if (parameter->calc_consumption) *parameter->consumption += get_consumption(*parameter->current, 0, &timestamp);
+        if (parameter->calc_consumption) {
+            coulomb_sample(&coulomb, *parameter->current, time_us_32());
+            *parameter->consumption = coulomb_get(&coulomb);
+        }
         debug("\nSmart ESC (%u) < Rpm: %.0f Volt: %0.2f Curr: %.2f TempFet: %.0f TempBec: %.0f Vbec: %.1f Cbec: %.1f ",
               uxTaskGetStackHighWaterMark(NULL), *parameter->rpm, *parameter->voltage, *parameter->current,
               *parameter->temperature_fet, *parameter->temperature_bec, *parameter->voltage_bec,
@@ -329,7 +338,7 @@ static void send_packet(void) {
         channel_data.channel_data_ch1 = throttle;
         channel_data.channel_data_ch7 = reverse;
         packet.channel_data = channel_data;
-        uint16_t crc = srxl_get_crc((uint8_t *)&packet, sizeof(packet) - 2);
+        uint16_t crc = crc16_srxl(0, (uint8_t *)&packet, sizeof(packet) - 2);
         packet.crc = swap_16(crc);
         uart1_write_bytes((uint8_t *)&packet, sizeof(packet));
         cont++;
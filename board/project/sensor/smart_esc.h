@@ -2,6 +2,7 @@
 #define SMART_ESC_H
 
 #include "common.h"
+#include "seqlock.h"
 
 typedef struct smart_esc_parameters_t {
     bool calc_consumption;
@@ -13,6 +14,7 @@ typedef struct smart_esc_parameters_t {
     float *cell[18];                                     // cells
     uint8_t *cells;                                      // bat id
     uint16_t *cycles;                                    // bat id
+    seqlock_t *lock;
 } smart_esc_parameters_t;
 
 extern context_t context;
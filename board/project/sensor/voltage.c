@@ -2,14 +2,12 @@
 
 #include <stdio.h>
 
-#include "hardware/adc.h"
+#include "adc_sampler.h"
 #include "pico/stdlib.h"
 
 void voltage_task(void *parameters) {
     voltage_parameters_t parameter = *(voltage_parameters_t *)parameters;
-    adc_init();
-    adc_gpio_init(parameter.adc_num + 26);
-    //gpio_pull_down(parameter.adc_num + 26);
+    adc_sampler_add(parameter.adc_num);
     *parameter.voltage = 0;
     xTaskNotifyGive(context.receiver_task_handle);
     while (1) {
@@ -5,21 +5,19 @@
 #include "common.h"
 #include "pico/stdlib.h"
 
-#define VSPEED_INIT_DELAY_MS 5000
 #define VSPEED_INTERVAL_MS 1000
 
-void vspeed_task(void *parameters) {
+uint32_t vspeed_job(void *parameters) {
     vspeed_parameters_t *parameter = (vspeed_parameters_t *)parameters;
-    *parameter->vspeed = 0;
-    vTaskDelay(VSPEED_INIT_DELAY_MS / portTICK_PERIOD_MS);
-    float altitude = *parameter->altitude;
-    while (1) {
-        *parameter->vspeed = (*parameter->altitude - altitude) / VSPEED_INTERVAL_MS * 1000;
-        altitude = *parameter->altitude;
+    if (!parameter->is_started) {
+        parameter->altitude_prev = *parameter->altitude;
+        parameter->is_started = true;
+    }
+    *parameter->vspeed = (*parameter->altitude - parameter->altitude_prev) / VSPEED_INTERVAL_MS * 1000;
+    parameter->altitude_prev = *parameter->altitude;
 #ifdef SIM_SENSORS
-        *parameter->vspeed = 12.34;
+    *parameter->vspeed = 12.34;
 #endif
-        debug("\nVspeed (%u): %.2f", uxTaskGetStackHighWaterMark(NULL), *parameter->vspeed);
-        vTaskDelay(parameter->interval / portTICK_PERIOD_MS);
-    }
+    debug("\nVspeed (%u): %.2f", uxTaskGetStackHighWaterMark(NULL), *parameter->vspeed);
+    return parameter->interval;
 }
\ No newline at end of file
@@ -3,13 +3,17 @@
 
 #include "common.h"
 
+#define VSPEED_INIT_DELAY_MS 5000
+
 typedef struct vspeed_parameters_t {
     uint interval;
     float *altitude, *vspeed;
+    float altitude_prev;
+    bool is_started;
 } vspeed_parameters_t;
 
 extern context_t context;
 
-void vspeed_task(void *parameters);
+uint32_t vspeed_job(void *parameters);
 
 #endif
\ No newline at end of file
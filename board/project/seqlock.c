@@ -0,0 +1,33 @@
+#include "seqlock.h"
+
+#include <string.h>
+
+#define load_acquire(VAR) __atomic_load_n(&(VAR), __ATOMIC_ACQUIRE)
+#define load_relaxed(VAR) __atomic_load_n(&(VAR), __ATOMIC_RELAXED)
+#define store_release(VAR, VALUE) __atomic_store_n(&(VAR), (VALUE), __ATOMIC_RELEASE)
+#define store_relaxed(VAR, VALUE) __atomic_store_n(&(VAR), (VALUE), __ATOMIC_RELAXED)
+
+/* Writer */
+
+void seqlock_write_begin(seqlock_t *lock) {
+    if (!lock) return;
+    store_relaxed(lock->sequence, lock->sequence + 1);
+    // the odd sequence is visible before any of the values
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void seqlock_write_end(seqlock_t *lock) {
+    if (!lock) return;
+    store_release(lock->sequence, lock->sequence + 1);
+}
+
+/* Reader */
+
+bool seqlock_read(seqlock_t *lock, void *copy, const void *values, uint32_t size) {
+    uint32_t sequence = load_acquire(lock->sequence);
+    if (sequence & 1) return false;
+    memcpy(copy, values, size);
+    // the copy completes before the sequence is checked again
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return load_relaxed(lock->sequence) == sequence;
+}
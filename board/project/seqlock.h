@@ -0,0 +1,23 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+   Sequence lock for a group of values with a single writer
+   The writer brackets its updates with seqlock_write_begin() and seqlock_write_end(), which leave the sequence odd
+   while the group is being written. seqlock_read() copies the group and returns false if a write was in progress or
+   completed during the copy, so the reader can retry or keep its previous copy. Neither side blocks, so readers can
+   run in tasks or irqs on either core. A NULL lock is allowed for values without readers
+*/
+
+typedef struct seqlock_t {
+    volatile uint32_t sequence;
+} seqlock_t;
+
+void seqlock_write_begin(seqlock_t *lock);
+void seqlock_write_end(seqlock_t *lock);
+bool seqlock_read(seqlock_t *lock, void *copy, const void *values, uint32_t size);
+
+#endif
@@ -3,6 +3,7 @@
 #include <stdio.h>
 
 #include "config.h"
+#include "crc.h"
 #include "hitec.h"
 #include "uart.h"
 #include "xbus.h"
@@ -14,22 +15,19 @@
 #define IBUS_COMMAND_MEASURE 0xA
 
 static uint8_t sim_rx_status = 0;
-static QueueHandle_t uart_queue_handle;
+static ring_buffer_t *uart_rx_ring;
 
 static void process(rx_protocol_t rx_protocol);
 static void ibus_send_data(uint8_t command, uint8_t address);
 static void ibus_send_byte(uint8_t c, uint16_t *crcP);
-static uint16_t jetiex_crc16(uint8_t *p, uint16_t len);
-static uint16_t jetiex_update_crc16(uint16_t crc, uint8_t data);
-static uint8_t smartport_get_crc(uint8_t *data);
 
 void sim_rx_task(void *parameters) {
     sim_rx_parameters_t *parameter = (sim_rx_parameters_t *)parameters;
     vTaskDelay(2000 / portTICK_PERIOD_MS);
     if (UART_RECEIVER == uart0)
-        uart_queue_handle = context.uart0_queue_handle;
+        uart_rx_ring = context.uart0_rx_ring;
     else
-        uart_queue_handle = context.uart1_queue_handle;
+        uart_rx_ring = context.uart1_rx_ring;
     debug("\nSim Rx init");
     while (1) {
         vTaskDelay(SIM_RX_INTERVAL_MS / portTICK_PERIOD_MS);
@@ -40,14 +38,14 @@ void sim_rx_task(void *parameters) {
 static void process(rx_protocol_t rx_protocol) {
 #ifdef SIM_RX
     // printf("\nSim (%u) < ", uxTaskGetStackHighWaterMark(NULL));
-    xQueueReset(uart_queue_handle);
+    ring_buffer_reset(uart_rx_ring);
     if (rx_protocol == RX_SMARTPORT) {
         vTaskResume(context.led_task_handle);
         uint8_t c[10] = {0};
         c[0] = 0x7E;
         c[1] = 0x71;  // sensor id 18 = 0x71 (10 = 0xE9)
-        xQueueSendToBack(uart_queue_handle, &c[0], 0);
-        xQueueSendToBack(uart_queue_handle, &c[1], 0);
+        ring_buffer_put(uart_rx_ring, c[0]);
+        ring_buffer_put(uart_rx_ring, c[1]);
 #ifdef SIM_SMARTPORT_SEND_CONFIG_LUA
         if (sim_rx_status == 0)  // maintenance mode on
         {
@@ -58,8 +56,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         } else if (sim_rx_status == 1)  // request config
         {
             c[2] = 0x30;  // type_id
@@ -69,8 +67,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         } else if (sim_rx_status == 6)  // maintenance mode off
         {
             c[2] = 0x20;  // type_id
@@ -80,8 +78,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         sim_rx_status++;
 #endif
@@ -95,8 +93,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         if (sim_rx_status == 1)  // packet 1
         {
@@ -107,8 +105,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         if (sim_rx_status == 2)  // packet 2
         {
@@ -119,8 +117,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         if (sim_rx_status == 3)  // packet 3
         {
@@ -131,8 +129,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         if (sim_rx_status == 5)  // maintenance mode off
         {
@@ -143,8 +141,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         sim_rx_status++;
 #endif
@@ -158,8 +156,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         } else if (sim_rx_status == 1)  // request sensor id
         {
             c[2] = 0x30;  // type_id
@@ -169,8 +167,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         } else if (sim_rx_status == 3)  // maintenance mode off
         {
             c[2] = 0x20;  // type_id
@@ -180,8 +178,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         sim_rx_status++;
 #endif
@@ -195,8 +193,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         } else if (sim_rx_status == 1)  // change sensor id
         {
             c[2] = 0x31;  // type_id
@@ -206,8 +204,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 10 - 1;  // sensor id = 10 -> lua sensor id = 9
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         } else if (sim_rx_status == 3)  // maintenance mode off
         {
             c[2] = 0x20;  // type_id
@@ -217,8 +215,8 @@ static void process(rx_protocol_t rx_protocol) {
             c[6] = 0x00;
             c[7] = 0x00;
             c[8] = 0x00;
-            c[9] = smartport_get_crc(c);
-            for (uint i = 2; i < 10; i++) xQueueSendToBack(uart_queue_handle, &c[i], 0);
+            c[9] = 0xFF - crc_smartport(0, &c[2], 7);
+            for (uint i = 2; i < 10; i++) ring_buffer_put(uart_rx_ring, c[i]);
         }
         sim_rx_status++;
 #endif
@@ -238,7 +236,7 @@ static void process(rx_protocol_t rx_protocol) {
         static uint8_t data[] = {0xA5, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
                                  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
         for (uint8_t i = 0; i < sizeof(data); i++) {
-            xQueueSendToBack(uart_queue_handle, &data[i], 0);
+            ring_buffer_put(uart_rx_ring, data[i]);
         }
     }
 
@@ -250,12 +248,12 @@ static void process(rx_protocol_t rx_protocol) {
                                               0x0,  0x0,  0x60, 0x80, 0x0,  0x80, 0x0, 0x80, 0xB2, 0xA0};
         if (status < 10) {
             for (uint8_t i = 0; i < sizeof(handshake_request); i++) {
-                xQueueSendToBack(uart_queue_handle, &handshake_request[i], 0);
+                ring_buffer_put(uart_rx_ring, handshake_request[i]);
             }
             status++;
         } else if (status == 10) {
             for (uint8_t i = 0; i < sizeof(telemetry_request); i++) {
-                xQueueSendToBack(uart_queue_handle, &telemetry_request[i], 0);
+                ring_buffer_put(uart_rx_ring, telemetry_request[i]);
             }
         }
     }
@@ -279,7 +277,7 @@ static void process(rx_protocol_t rx_protocol) {
         static uint8_t data[] = {0x0F, 0x0F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
                                  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x04};
         for (uint8_t i = 0; i < sizeof(data); i++) {
-            xQueueSendToBack(uart_queue_handle, &data[i], 0);
+            ring_buffer_put(uart_rx_ring, data[i]);
         }
         data[24] += 0x10;
         if (data[24] == 0x44) data[24] = 0x04;
@@ -287,7 +285,7 @@ static void process(rx_protocol_t rx_protocol) {
 
     else if (rx_protocol == RX_MULTIPLEX) {
         static uint8_t cont = 0;
-        xQueueSendToBack(uart_queue_handle, &cont, 0);
+        ring_buffer_put(uart_rx_ring, cont);
         cont++;
         cont = cont % 16;
     }
@@ -298,7 +296,7 @@ static void process(rx_protocol_t rx_protocol) {
                           0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E, 0xE0, 0x2E,
                           0xE0, 0x2E, 0xC5, 0xFE, 0x3D, 0x1,  0x8,  0x2,  0x3A, 0x0,  0xF9, 0xE2};
         for (uint8_t i = 0; i < sizeof(data); i++) {
-            xQueueSendToBack(uart_queue_handle, &data[i], 0);
+            ring_buffer_put(uart_rx_ring, data[i]);
         }
     }
 
@@ -315,7 +313,7 @@ static void process(rx_protocol_t rx_protocol) {
                           0xC8, 0x18, 0x16, 0xDB, 0xE3, 0x62, 0xF9, 0xB6, 0xF7, 0x8B, 0xF2, 0x95, 0xAF, 0x7C,
                           0xE5, 0x2B, 0x5F, 0xF9, 0xCA, 0x7,  0x0,  0x0,  0x4C, 0x7C, 0xE2, 0xA7};*/
         for (uint8_t i = 0; i < sizeof(data); i++) {
-            xQueueSendToBack(uart_queue_handle, &data[i], 0);
+            ring_buffer_put(uart_rx_ring, data[i]);
         }
     }
 
@@ -326,7 +324,7 @@ static void process(rx_protocol_t rx_protocol) {
                                             {0x1, 0x1, 0x31, 0x4, 0xA7, 0x0, 0x3, 0x3, 0xFF, 0xE3},
                                             {0x1, 0x1, 0x30, 0x4, 0xA7, 0x3, 0xFF, 0x3, 0xFF, 0xE1},
                                             {0x1, 0x1, 0x31, 0x4, 0xA8, 0x0, 0x3, 0x3, 0xFF, 0xE4}};
-        for (uint8_t i = 0; i < sizeof(data[type % 5]); i++) xQueueSendToBack(uart_queue_handle, &data[type % 5][i], 0);
+        for (uint8_t i = 0; i < sizeof(data[type % 5]); i++) ring_buffer_put(uart_rx_ring, data[type % 5][i]);
         type++;
     }
 
@@ -334,14 +332,14 @@ static void process(rx_protocol_t rx_protocol) {
         uint8_t address[5] = {0x89, 0x8A, 0x8C, 0x8D, 0x8E};
         static uint index = 0;
         uint8_t type = 0x80;
-        xQueueSendToBack(uart_queue_handle, &type, 0);
-        xQueueSendToBack(uart_queue_handle, &address[index % 5], 0);
+        ring_buffer_put(uart_rx_ring, type);
+        ring_buffer_put(uart_rx_ring, address[index % 5]);
         index++;
     }
 
     else if (rx_protocol == RX_JR_PROPO) {
         static uint address = 0;
-        xQueueSendToBack(uart_queue_handle, &address, 0);
+        ring_buffer_put(uart_rx_ring, address);
         address++;
         if (address > 10) address = 0;
     }
@@ -375,32 +373,5 @@ void ibus_send_byte(uint8_t c, uint16_t *crcP) {
         crc += c;
         *crcP = crc;
     }
-    xQueueSendToBack(uart_queue_handle, &c, 0);
-}
-
-static uint16_t jetiex_crc16(uint8_t *p, uint16_t len) {
-    uint16_t crc16_data = 0;
-    while (len--) {
-        crc16_data = jetiex_update_crc16(crc16_data, p[0]);
-        p++;
-    }
-    return (crc16_data);
-}
-
-static uint16_t jetiex_update_crc16(uint16_t crc, uint8_t data) {
-    uint16_t ret_val;
-    data ^= (uint8_t)(crc) & (uint8_t)(0xFF);
-    data ^= data << 4;
-    ret_val = ((((uint16_t)data << 8) | ((crc & 0xFF00) >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
-    return ret_val;
-}
-
-static uint8_t smartport_get_crc(uint8_t *data) {
-    uint16_t crc = 0;
-    for (uint8_t i = 2; i < 9; i++) {
-        crc += data[i];
-        crc += crc >> 8;
-        crc &= 0x00FF;
-    }
-    return 0xFF - (uint8_t)crc;
+    ring_buffer_put(uart_rx_ring, c);
 }
\ No newline at end of file
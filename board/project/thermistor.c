@@ -0,0 +1,44 @@
+#include "thermistor.h"
+
+#include <math.h>
+
+#define THERMISTOR_KELVIN 273.15
+
+static void build(thermistor_t *thermistor, const float *coefficients, float r0, float r1);
+
+void thermistor_init_beta(thermistor_t *thermistor, float beta, float r0, float t0, float r1) {
+    const float coefficients[4] = {1 / (t0 + THERMISTOR_KELVIN), 1 / beta, 0, 0};
+    build(thermistor, coefficients, r0, r1);
+}
+
+void thermistor_init_steinhart(thermistor_t *thermistor, float a, float b, float c, float d, float r0, float r1) {
+    const float coefficients[4] = {a, b, c, d};
+    build(thermistor, coefficients, r0, r1);
+}
+
+float thermistor_temperature(const thermistor_t *thermistor, uint32_t ratio) {
+    if (ratio >= 1 << 16) return thermistor->table[THERMISTOR_SEGMENTS] / 100.0F;
+    uint32_t index = ratio >> (16 - THERMISTOR_SEGMENTS_LOG2);
+    int32_t fraction = ratio & ((1 << (16 - THERMISTOR_SEGMENTS_LOG2)) - 1);
+    int32_t from = thermistor->table[index], to = thermistor->table[index + 1];
+    return (from + (((to - from) * fraction) >> (16 - THERMISTOR_SEGMENTS_LOG2))) / 100.0F;
+}
+
+/* Only at init, in double for the ends of the table */
+static void build(thermistor_t *thermistor, const float *coefficients, float r0, float r1) {
+    for (uint32_t i = 0; i <= THERMISTOR_SEGMENTS; i++) {
+        double temperature = THERMISTOR_MAX;
+        if (i == THERMISTOR_SEGMENTS) {
+            temperature = THERMISTOR_MIN;
+        } else if (i > 0) {
+            double ratio = (double)i / THERMISTOR_SEGMENTS;
+            double ln = log(ratio * r1 / (1 - ratio) / r0);
+            double inverse =
+                coefficients[0] + ln * (coefficients[1] + ln * (coefficients[2] + ln * coefficients[3]));
+            if (inverse > 0) temperature = 1 / inverse - THERMISTOR_KELVIN;
+        }
+        if (temperature > THERMISTOR_MAX) temperature = THERMISTOR_MAX;
+        if (temperature < THERMISTOR_MIN) temperature = THERMISTOR_MIN;
+        thermistor->table[i] = lround(temperature * 100);
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef THERMISTOR_H
+#define THERMISTOR_H
+
+#include <stdint.h>
+
+/*
+   Thermistor lookup
+   NTC to ground with r1 to the reference voltage. The table holds the temperature at THERMISTOR_SEGMENTS + 1 evenly
+   spaced divider ratios and is built once, with the beta or the Steinhart-Hart equation, so thermistor_temperature()
+   is an integer interpolation without log(), safe in an irq. ratio is the ntc voltage over the reference voltage in
+   1/65536 (the adc value shifted to 16 bits). Temperatures are clamped to THERMISTOR_MIN..THERMISTOR_MAX
+*/
+
+#define THERMISTOR_SEGMENTS_LOG2 8
+#define THERMISTOR_SEGMENTS (1 << THERMISTOR_SEGMENTS_LOG2)
+#define THERMISTOR_MIN -55
+#define THERMISTOR_MAX 300
+
+typedef struct thermistor_t {
+    int16_t table[THERMISTOR_SEGMENTS + 1];  // deg C * 100
+} thermistor_t;
+
+/* r0 at t0 (deg C) */
+void thermistor_init_beta(thermistor_t *thermistor, float beta, float r0, float t0, float r1);
+/* 1/T = a + b ln(R/r0) + c ln(R/r0)^2 + d ln(R/r0)^3, T in K */
+void thermistor_init_steinhart(thermistor_t *thermistor, float a, float b, float c, float d, float r0, float r1);
+float thermistor_temperature(const thermistor_t *thermistor, uint32_t ratio);
+
+#endif
@@ -0,0 +1,237 @@
+#include "trace.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "common.h"
+#include "hardware/sync.h"
+
+#define TRACE_BUFFER_SIZE 4096  // power of 2
+#define TRACE_RECORD_MAX 160
+#define TRACE_STRING_MAX 32
+#define TRACE_SPEC_MAX 16
+#define TRACE_INTERVAL_MS 20
+
+typedef enum trace_type_t { TRACE_PRINTF, TRACE_BUFFER } trace_type_t;
+
+typedef enum trace_arg_t {
+    TRACE_ARG_NONE,
+    TRACE_ARG_INT,
+    TRACE_ARG_LONG,
+    TRACE_ARG_LONG_LONG,
+    TRACE_ARG_SIZE,
+    TRACE_ARG_DOUBLE,
+    TRACE_ARG_POINTER,
+    TRACE_ARG_STRING
+} trace_arg_t;
+
+typedef struct trace_header_t {
+    const char *format;
+    uint8_t type, length, element_size;
+} trace_header_t;
+
+typedef union trace_value_t {
+    int i;
+    long l;
+    long long ll;
+    size_t z;
+    double d;
+    void *p;
+} trace_value_t;
+
+static uint8_t buffer[TRACE_BUFFER_SIZE];
+static ring_buffer_t ring = {buffer, TRACE_BUFFER_SIZE - 1};
+static volatile uint32_t dropped;
+static spin_lock_t *lock;
+
+static const uint8_t arg_size[] = {0, sizeof(int), sizeof(long), sizeof(long long), sizeof(size_t), sizeof(double),
+                                   sizeof(void *), 0};
+
+static const char *parse_spec(const char *format, trace_arg_t *arg);
+static uint32_t put_arg(uint8_t *record, uint32_t length, trace_arg_t arg, va_list *args);
+static void put_record(uint8_t *record, uint32_t length, trace_header_t header);
+static void render_printf(const char *format, const uint8_t *payload, uint32_t length);
+static void render_buffer(const char *format, const uint8_t *payload, uint32_t length, uint32_t element_size);
+
+void trace_init(void) { lock = spin_lock_init(spin_lock_claim_unused(true)); }
+
+void trace_printf(const char *format, ...) {
+    uint8_t record[TRACE_RECORD_MAX];
+    uint32_t length = sizeof(trace_header_t);
+    trace_arg_t arg;
+    va_list args;
+    va_start(args, format);
+    for (const char *spec = strchr(format, '%'); spec; spec = strchr(spec, '%')) {
+        spec = parse_spec(spec, &arg);
+        length = put_arg(record, length, arg, &args);
+    }
+    va_end(args);
+    put_record(record, length, (trace_header_t){format, TRACE_PRINTF, length, 0});
+}
+
+void trace_buffer(const char *format, const void *data, uint32_t length, uint32_t element_size) {
+    uint8_t record[TRACE_RECORD_MAX];
+    uint32_t size = length * element_size;
+    if (size > TRACE_RECORD_MAX - sizeof(trace_header_t))
+        size = (TRACE_RECORD_MAX - sizeof(trace_header_t)) / element_size * element_size;
+    memcpy(record + sizeof(trace_header_t), data, size);
+    size += sizeof(trace_header_t);
+    put_record(record, size, (trace_header_t){format, TRACE_BUFFER, size, element_size});
+}
+
+void trace_task(void *parameters) {
+    while (1) {
+        trace_flush();
+        vTaskDelay(TRACE_INTERVAL_MS / portTICK_PERIOD_MS);
+    }
+}
+
+/* Consumer. Called by trace_task() or, when the scheduler is stopped, by a fatal handler */
+void trace_flush(void) {
+    static uint32_t dropped_reported;
+    uint8_t record[TRACE_RECORD_MAX];
+    trace_header_t header;
+    while (ring_buffer_available(&ring) >= sizeof(trace_header_t)) {
+        ring_buffer_get_bytes(&ring, (uint8_t *)&header, sizeof(trace_header_t));
+        uint32_t length = ring_buffer_get_bytes(&ring, record, header.length - sizeof(trace_header_t));
+        if (header.type == TRACE_PRINTF)
+            render_printf(header.format, record, length);
+        else
+            render_buffer(header.format, record, length, header.element_size);
+    }
+    if (dropped != dropped_reported) {
+        printf("\nTrace. Dropped %u", (uint)(dropped - dropped_reported));
+        dropped_reported = dropped;
+    }
+}
+
+/* Returns the end of the conversion at format (a '%') and the type of its argument */
+static const char *parse_spec(const char *format, trace_arg_t *arg) {
+    static const trace_arg_t integer[] = {TRACE_ARG_INT, TRACE_ARG_LONG, TRACE_ARG_LONG_LONG, TRACE_ARG_SIZE};
+    uint length = 0;
+    format++;
+    while (*format && strchr("-+ #0123456789.", *format)) format++;
+    while (*format && strchr("hlzjt", *format)) {
+        if (*format == 'l') length++;
+        if (*format == 'z') length = 3;
+        format++;
+    }
+    *arg = TRACE_ARG_NONE;
+    if (!*format) return format;
+    if (strchr("diuxXoc", *format))
+        *arg = integer[length > 3 ? 3 : length];
+    else if (strchr("fFeEgG", *format))
+        *arg = TRACE_ARG_DOUBLE;
+    else if (*format == 'p')
+        *arg = TRACE_ARG_POINTER;
+    else if (*format == 's')
+        *arg = TRACE_ARG_STRING;
+    return format + 1;
+}
+
+static uint32_t put_arg(uint8_t *record, uint32_t length, trace_arg_t arg, va_list *args) {
+    trace_value_t value;
+    switch (arg) {
+        case TRACE_ARG_INT:
+            value.i = va_arg(*args, int);
+            break;
+        case TRACE_ARG_LONG:
+            value.l = va_arg(*args, long);
+            break;
+        case TRACE_ARG_LONG_LONG:
+            value.ll = va_arg(*args, long long);
+            break;
+        case TRACE_ARG_SIZE:
+            value.z = va_arg(*args, size_t);
+            break;
+        case TRACE_ARG_DOUBLE:
+            value.d = va_arg(*args, double);
+            break;
+        case TRACE_ARG_POINTER:
+            value.p = va_arg(*args, void *);
+            break;
+        case TRACE_ARG_STRING: {
+            const char *string = va_arg(*args, const char *);
+            uint32_t size = string ? strnlen(string, TRACE_STRING_MAX) : 0;
+            if (length + size + 1 > TRACE_RECORD_MAX) return length;
+            memcpy(record + length, string, size);
+            record[length + size] = 0;
+            return length + size + 1;
+        }
+        default:
+            return length;
+    }
+    if (length + arg_size[arg] > TRACE_RECORD_MAX) return length;
+    memcpy(record + length, &value, arg_size[arg]);
+    return length + arg_size[arg];
+}
+
+/* Producers are tasks and irq handlers of both cores, so the record is copied with interrupts masked and the spin
+   lock taken */
+static void put_record(uint8_t *record, uint32_t length, trace_header_t header) {
+    memcpy(record, &header, sizeof(header));
+    uint32_t status = spin_lock_blocking(lock);
+    if (ring_buffer_free(&ring) >= length)
+        ring_buffer_put_bytes(&ring, record, length);
+    else
+        dropped++;
+    spin_unlock(lock, status);
+}
+
+static void render_printf(const char *format, const uint8_t *payload, uint32_t length) {
+    char spec[TRACE_SPEC_MAX];
+    const uint8_t *end = payload + length;
+    const char *text = format;
+    trace_arg_t arg;
+    trace_value_t value;
+    for (const char *start = strchr(text, '%'); start; start = strchr(text, '%')) {
+        printf("%.*s", (int)(start - text), text);
+        text = parse_spec(start, &arg);
+        uint32_t spec_length = text - start < TRACE_SPEC_MAX ? text - start : TRACE_SPEC_MAX - 1;
+        memcpy(spec, start, spec_length);
+        spec[spec_length] = 0;
+        if (arg == TRACE_ARG_STRING) {
+            const char *string = payload < end ? (const char *)payload : "";
+            printf(spec, string);
+            payload += payload < end ? strlen(string) + 1 : 0;
+            continue;
+        }
+        memset(&value, 0, sizeof(value));
+        if (payload + arg_size[arg] <= end) {
+            memcpy(&value, payload, arg_size[arg]);
+            payload += arg_size[arg];
+        }
+        switch (arg) {
+            case TRACE_ARG_INT:
+                printf(spec, value.i);
+                break;
+            case TRACE_ARG_LONG:
+                printf(spec, value.l);
+                break;
+            case TRACE_ARG_LONG_LONG:
+                printf(spec, value.ll);
+                break;
+            case TRACE_ARG_SIZE:
+                printf(spec, value.z);
+                break;
+            case TRACE_ARG_DOUBLE:
+                printf(spec, value.d);
+                break;
+            case TRACE_ARG_POINTER:
+                printf(spec, value.p);
+                break;
+            default:
+                printf("%s", spec[1] == '%' ? "%" : spec);
+        }
+    }
+    printf("%s", text);
+}
+
+static void render_buffer(const char *format, const uint8_t *payload, uint32_t length, uint32_t element_size) {
+    for (uint32_t i = 0; i + element_size <= length; i += element_size) {
+        uint32_t value = 0;
+        memcpy(&value, payload + i, element_size < sizeof(value) ? element_size : sizeof(value));
+        printf(format, value);
+    }
+}
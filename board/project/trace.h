@@ -0,0 +1,20 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/*
+   Deferred debug trace
+   debug() and debug_buffer() record the format string address and the raw arguments in a ring instead of calling
+   printf, so they are safe in irq handlers and cost a copy instead of the float formatting. trace_task() renders the
+   records with printf at low priority. Strings (%s) are copied, up to TRACE_STRING_MAX. Records that do not fit are
+   dropped and counted. trace_init() claims the spin lock that serializes the producers of both cores, call it first
+*/
+
+void trace_init(void);
+void trace_printf(const char *format, ...);
+void trace_buffer(const char *format, const void *buffer, uint32_t length, uint32_t element_size);
+void trace_task(void *parameters);
+void trace_flush(void);
+
+#endif
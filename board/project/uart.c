@@ -4,6 +4,8 @@
 
 #include "hardware/irq.h"
 #include "hardware/uart.h"
+#include "ring_buffer.h"
+#include "uart_frame.h"
 
 #define UART0_BUFFER_SIZE 512
 #define UART1_BUFFER_SIZE 512
@@ -11,6 +13,8 @@
 #define enable_rx(UART) hw_set_bits(&uart_get_hw(UART)->cr, 0x00000200)
 #define disable_rx(UART) hw_clear_bits(&uart_get_hw(UART)->cr, 0x00000200)
 
+static uint8_t uart0_buffer[UART0_BUFFER_SIZE], uart1_buffer[UART1_BUFFER_SIZE];
+static ring_buffer_t uart0_ring, uart1_ring;
 static volatile uint uart0_timeout, uart1_timeout, uart0_timestamp, uart1_timestamp;
 static volatile bool uart0_is_timedout = true, uart1_is_timedout = true;
 static bool half_duplex0, half_duplex1, inverted0, inverted1;
@@ -19,6 +23,13 @@ static int64_t uart0_timeout_callback(alarm_id_t id, void *user_data);
 static int64_t uart1_timeout_callback(alarm_id_t id, void *user_data);
 static void uart0_rx_handler();
 static void uart1_rx_handler();
+#ifdef UART0_RX_IDLE_FRAME
+static uart_frame_t uart0_frame;
+static alarm_id_t uart0_frame_alarm_id = 0;
+static void uart0_rx_frame_handler();
+static int64_t uart0_frame_callback(alarm_id_t id, void *user_data);
+static inline void uart0_frame_notify(void);
+#endif
 
 void uart0_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint databits, uint stopbits,
                  uart_parity_t parity, bool inverted, bool half_duplex) {
@@ -41,10 +52,24 @@ void uart0_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint d
         gpio_set_inover(gpio_rx, GPIO_OVERRIDE_INVERT);
     }
     uart_set_format(uart0, databits, stopbits, parity);
+    uart0_timeout = timeout;
+    ring_buffer_init(&uart0_ring, uart0_buffer, UART0_BUFFER_SIZE);
+    context.uart0_rx_ring = &uart0_ring;
+#ifdef UART0_RX_IDLE_FRAME
+    if (timeout) {
+        // fifo + rx timeout irq: one irq per UART0_RX_FIFO_LEVEL bytes and one at frame end
+        uart_frame_init(&uart0_frame, timeout, UART0_RX_FIFO_LEVEL);
+        uart_set_fifo_enabled(uart0, true);
+        irq_set_exclusive_handler(UART0_IRQ, uart0_rx_frame_handler);
+        irq_set_enabled(UART0_IRQ, true);
+        uart_set_irq_enables(uart0, true, false);
+        hw_write_masked(&uart_get_hw(uart0)->ifls, UART0_RX_FIFO_LEVEL << UART_UARTIFLS_RXIFLSEL_LSB,
+                        UART_UARTIFLS_RXIFLSEL_BITS);
+        return;
+    }
+#endif
     irq_set_exclusive_handler(UART0_IRQ, uart0_rx_handler);
     irq_set_enabled(UART0_IRQ, true);
-    uart0_timeout = timeout;
-    context.uart0_queue_handle = xQueueCreate(UART0_BUFFER_SIZE, sizeof(uint8_t));
     uart_set_irq_enables(uart0, true, false);
 }
 
@@ -73,7 +98,8 @@ void uart1_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint d
     irq_set_exclusive_handler(UART1_IRQ, uart1_rx_handler);
     irq_set_enabled(UART1_IRQ, true);
     uart1_timeout = timeout;
-    context.uart1_queue_handle = xQueueCreate(UART1_BUFFER_SIZE, sizeof(uint8_t));
+    ring_buffer_init(&uart1_ring, uart1_buffer, UART1_BUFFER_SIZE);
+    context.uart1_rx_ring = &uart1_ring;
     uart_set_irq_enables(uart1, true, false);
 }
 
@@ -98,13 +124,13 @@ static void uart0_rx_handler() {
     static alarm_id_t uart0_timeout_alarm_id = 0;
     if (uart0_timeout_alarm_id) alarm_pool_cancel_alarm(context.uart_alarm_pool, uart0_timeout_alarm_id);
     if (uart0_is_timedout) {
-        xQueueReset(context.uart0_queue_handle);
+        ring_buffer_reset(&uart0_ring);
         uart0_is_timedout = false;
     }
     while (uart_is_readable(uart0)) {
         uint8_t data = uart_getc(uart0);
         // debug("-%X-", data);
-        xQueueSendToBackFromISR(context.uart0_queue_handle, &data, &xHigherPriorityTaskWoken);
+        ring_buffer_put(&uart0_ring, data);
         if (uart0_timeout == 0) {
             BaseType_t xHigherPriorityTaskWoken = pdFALSE;
             vTaskNotifyGiveIndexedFromISR(context.uart0_notify_task_handle, 1, &xHigherPriorityTaskWoken);
@@ -126,13 +152,13 @@ static void uart1_rx_handler() {
         alarm_pool_cancel_alarm(context.uart_alarm_pool, uart1_timeout_alarm_id);
     }
     if (uart1_is_timedout) {
-        xQueueReset(context.uart1_queue_handle);
+        ring_buffer_reset(&uart1_ring);
         uart1_is_timedout = false;
     }
     while (uart_is_readable(uart1)) {
         uint8_t data = uart_getc(uart1);
         // debug("%X ", data);
-        xQueueSendToBackFromISR(context.uart1_queue_handle, &data, &xHigherPriorityTaskWoken);
+        ring_buffer_put(&uart1_ring, data);
         if (uart1_timeout == 0) {
             BaseType_t xHigherPriorityTaskWoken = pdFALSE;
             vTaskNotifyGiveIndexedFromISR(context.uart1_notify_task_handle, 1, &xHigherPriorityTaskWoken);
@@ -147,25 +173,66 @@ static void uart1_rx_handler() {
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
+#ifdef UART0_RX_IDLE_FRAME
+static void uart0_rx_frame_handler() {
+    uint32_t now = time_us_32();
+    uint32_t remaining;
+    bool is_timeout = uart_get_hw(uart0)->mis & UART_UARTMIS_RTMIS_BITS, is_new_frame;
+    uint32_t reads = uart_frame_irq(&uart0_frame, now, is_timeout, &is_new_frame);
+    if (is_new_frame) ring_buffer_reset(&uart0_ring);
+    while (reads-- && uart_is_readable(uart0)) ring_buffer_put(&uart0_ring, uart_getc(uart0));
+    uart_frame_event_t event = uart_frame_irq_end(&uart0_frame, now, is_timeout, &remaining);
+    uart0_timestamp = now;
+    if (event == UART_FRAME_NONE) return;
+    if (uart0_frame_alarm_id) {
+        alarm_pool_cancel_alarm(context.uart_alarm_pool, uart0_frame_alarm_id);
+        uart0_frame_alarm_id = 0;
+    }
+    if (event == UART_FRAME_COMPLETE)
+        uart0_frame_notify();
+    else
+        uart0_frame_alarm_id =
+            alarm_pool_add_alarm_in_us(context.uart_alarm_pool, remaining, uart0_frame_callback, NULL, true);
+}
+
+static int64_t uart0_frame_callback(alarm_id_t id, void *user_data) {
+    uint32_t remaining;
+    uart_frame_event_t event = uart_frame_alarm(&uart0_frame, time_us_32(), uart_is_readable(uart0), &remaining);
+    if (event == UART_FRAME_COMPLETE) uart0_frame_notify();
+    if (event != UART_FRAME_WAIT) uart0_frame_alarm_id = 0;
+    return -(int64_t)remaining;
+}
+
+static inline void uart0_frame_notify(void) {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR(context.uart0_notify_task_handle, 1, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
+
 uint8_t uart0_read() {
     uint8_t value = 0;
-    xQueueReceive(context.uart0_queue_handle, &value, 0);
+    ring_buffer_get(&uart0_ring, &value);
     return value;
 }
 
 uint8_t uart1_read() {
     uint8_t value = 0;
-    xQueueReceive(context.uart1_queue_handle, &value, 0);
+    ring_buffer_get(&uart1_ring, &value);
     return value;
 }
 
-void uart0_read_bytes(uint8_t *data, uint8_t lenght) {
-    for (uint8_t i = 0; i < lenght; i++) xQueueReceive(context.uart0_queue_handle, data + i, 0);
-}
+void uart0_read_bytes(uint8_t *data, uint8_t lenght) { ring_buffer_get_bytes(&uart0_ring, data, lenght); }
 
-void uart1_read_bytes(uint8_t *data, uint8_t lenght) {
-    for (uint8_t i = 0; i < lenght; i++) xQueueReceive(context.uart1_queue_handle, data + i, 0);
-}
+uint uart0_peek(uint8_t **data) { return ring_buffer_peek(&uart0_ring, data); }
+
+void uart0_consume(uint lenght) { ring_buffer_consume(&uart0_ring, lenght); }
+
+void uart1_read_bytes(uint8_t *data, uint8_t lenght) { ring_buffer_get_bytes(&uart1_ring, data, lenght); }
+
+uint uart1_peek(uint8_t **data) { return ring_buffer_peek(&uart1_ring, data); }
+
+void uart1_consume(uint lenght) { ring_buffer_consume(&uart1_ring, lenght); }
 
 void uart0_write(uint8_t data) {
     if (half_duplex0) {
@@ -223,9 +290,16 @@ void uart1_write_bytes(uint8_t *data, uint8_t lenght) {
     }
 }
 
-uint8_t uart0_available() { return uxQueueMessagesWaiting(context.uart0_queue_handle); }
+/* Saturated instead of truncated, the buffer holds more than 255 bytes */
+uint8_t uart0_available() {
+    uint32_t available = ring_buffer_available(&uart0_ring);
+    return available > UINT8_MAX ? UINT8_MAX : available;
+}
 
-uint8_t uart1_available() { return uxQueueMessagesWaiting(context.uart1_queue_handle); }
+uint8_t uart1_available() {
+    uint32_t available = ring_buffer_available(&uart1_ring);
+    return available > UINT8_MAX ? UINT8_MAX : available;
+}
 
 uint uart0_get_time_elapsed() { return time_us_32() - uart0_timestamp; }
 
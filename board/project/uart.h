@@ -9,6 +9,8 @@ void uart0_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint d
                  bool inverted, bool half_duplex);
 uint8_t uart0_read();
 void uart0_read_bytes(uint8_t *data, uint8_t lenght);
+uint uart0_peek(uint8_t **data);
+void uart0_consume(uint lenght);
 uint8_t uart0_available();
 uint uart0_get_time_elapsed();
 void uart0_write(uint8_t data);
@@ -18,6 +20,8 @@ void uart1_begin(uint baudrate, uint gpio_tx, uint gpio_rx, uint timeout, uint d
                  bool inverted, bool half_duplex);
 uint8_t uart1_read();
 void uart1_read_bytes(uint8_t *data, uint8_t lenght);
+uint uart1_peek(uint8_t **data);
+void uart1_consume(uint lenght);
 uint8_t uart1_available();
 uint uart1_get_time_elapsed();
 void uart1_write(uint8_t data);
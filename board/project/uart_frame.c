@@ -0,0 +1,55 @@
+#include "uart_frame.h"
+
+static bool rx(uart_frame_t *frame, uint32_t now_us);
+static bool check(uart_frame_t *frame, uint32_t now_us, uint32_t *remaining_us);
+
+void uart_frame_init(uart_frame_t *frame, uint32_t timeout_us, uint8_t fifo_level) {
+    frame->timeout_us = timeout_us;
+    frame->last_rx_us = 0;
+    frame->fifo_level = fifo_level;
+    frame->is_receiving = false;
+}
+
+/* Rx irq at now_us, is_timeout if it is the receive timeout irq. Returns the bytes to read from the fifo and
+ * is_new_frame if they start a new frame. A level irq leaves one byte in the fifo, so the receive timeout irq still
+ * fires at the frame end. fifo_level is the irq level (UARTIFLS RXIFLSEL): 1/8, 1/4, 1/2, 3/4 or 7/8 of the fifo */
+uint32_t uart_frame_irq(uart_frame_t *frame, uint32_t now_us, bool is_timeout, bool *is_new_frame) {
+    static const uint8_t level_bytes[] = {4, 8, 16, 24, 28};
+    *is_new_frame = rx(frame, now_us);
+    return is_timeout ? UART_FRAME_FIFO_SIZE : level_bytes[frame->fifo_level] - 1;
+}
+
+/* The irq read the fifo. After a receive timeout irq the protocol gap is counted from the irq, now_us */
+uart_frame_event_t uart_frame_irq_end(uart_frame_t *frame, uint32_t now_us, bool is_timeout, uint32_t *remaining_us) {
+    *remaining_us = 0;
+    if (!is_timeout) return UART_FRAME_NONE;
+    return check(frame, now_us, remaining_us) ? UART_FRAME_COMPLETE : UART_FRAME_WAIT;
+}
+
+/* Alarm at now_us. Bytes below the fifo level arrived after the idle event (is_readable): not idle yet, and their
+ * receive timeout irq is due, so the alarm stops and that irq waits for the gap again */
+uart_frame_event_t uart_frame_alarm(uart_frame_t *frame, uint32_t now_us, bool is_readable, uint32_t *remaining_us) {
+    *remaining_us = 0;
+    if (is_readable) return UART_FRAME_NONE;
+    if (check(frame, now_us, remaining_us)) return UART_FRAME_COMPLETE;
+    return *remaining_us ? UART_FRAME_WAIT : UART_FRAME_NONE;
+}
+
+static bool rx(uart_frame_t *frame, uint32_t now_us) {
+    bool is_new_frame = !frame->is_receiving;
+    frame->is_receiving = true;
+    frame->last_rx_us = now_us;
+    return is_new_frame;
+}
+
+static bool check(uart_frame_t *frame, uint32_t now_us, uint32_t *remaining_us) {
+    *remaining_us = 0;
+    if (!frame->is_receiving) return false;
+    uint32_t elapsed = now_us - frame->last_rx_us;
+    if (elapsed < frame->timeout_us) {
+        *remaining_us = frame->timeout_us - elapsed;
+        return false;
+    }
+    frame->is_receiving = false;
+    return true;
+}
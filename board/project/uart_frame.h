@@ -0,0 +1,38 @@
+#ifndef UART_FRAME_H
+#define UART_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+   Idle line frame delimiter
+   Hardware independent: fed with rx bursts and idle events with their timestamps (us), so it can be run on the host
+   with synthetic byte streams. The idle event is the uart receive timeout interrupt, raised after
+   UART_FRAME_IDLE_BITS bit periods without data while the fifo is not empty. A byte may arrive while it waits to be
+   served and is read with the others, so the protocol gap is counted from the idle event: the remaining time is
+   returned to be waited with one alarm per idle event, and the frame end comes up to UART_FRAME_IDLE_BITS bit periods
+   later than with a timeout re-armed per byte. The irq and the alarm of uart.c only act on the events returned here
+*/
+
+#define UART_FRAME_FIFO_SIZE 32
+#define UART_FRAME_IDLE_BITS 32
+
+/* What the irq or the alarm has to do next. Complete and wait replace the pending alarm, if any */
+typedef enum uart_frame_event_t {
+    UART_FRAME_NONE,      // irq: keep the alarm. Alarm: stop it
+    UART_FRAME_COMPLETE,  // notify the task, no alarm
+    UART_FRAME_WAIT       // (re)arm the alarm in remaining_us
+} uart_frame_event_t;
+
+typedef struct uart_frame_t {
+    uint32_t timeout_us, last_rx_us;
+    uint8_t fifo_level;
+    bool is_receiving;
+} uart_frame_t;
+
+void uart_frame_init(uart_frame_t *frame, uint32_t timeout_us, uint8_t fifo_level);
+uint32_t uart_frame_irq(uart_frame_t *frame, uint32_t now_us, bool is_timeout, bool *is_new_frame);
+uart_frame_event_t uart_frame_irq_end(uart_frame_t *frame, uint32_t now_us, bool is_timeout, uint32_t *remaining_us);
+uart_frame_event_t uart_frame_alarm(uart_frame_t *frame, uint32_t now_us, bool is_readable, uint32_t *remaining_us);
+
+#endif
@@ -5,10 +5,14 @@
 #include "common.h"
 #include "hardware/irq.h"
 #include "hardware/pio.h"
+#include "ring_buffer.h"
 
-static volatile uint uart_pio_timeout, uart_pio_timestamp;
+static uint8_t uart_pio_buffer[UART_PIO_BUFFER_SIZE];
+static ring_buffer_t uart_pio_ring;
+static volatile uint uart_pio_timeout, uart_pio_timestamp, uart_pio_dropped_count;
 static volatile bool uart_pio_is_timedout = true;
 static uint uart_pio_sm;
+static alarm_id_t uart_pio_timeout_alarm_id;
 
 static int64_t uart_pio_timeout_callback(alarm_id_t id, void *user_data);
 static void uart_pio_handler(uint8_t data);
@@ -19,12 +23,13 @@ void uart_pio_begin(uint baudrate, int gpio_tx, int gpio_rx, uint timeout, PIO p
         uart_pio_sm = uart_rx_init(pio, gpio_rx, baudrate, irq);
         uart_rx_set_handler(uart_pio_handler);
         uart_pio_timeout = timeout;
-        context.uart_rx_pio_queue_handle = xQueueCreate(UART_PIO_BUFFER_SIZE, sizeof(uint8_t));
-    }
-    if (gpio_tx != UART_GPIO_NONE) {
-        uart_pio_sm = uart_tx_init(pio, gpio_tx, baudrate);
-        context.uart_rx_pio_queue_handle = xQueueCreate(UART_PIO_BUFFER_SIZE, sizeof(uint8_t));
+        uart_pio_timeout_alarm_id = 0;
+        uart_pio_is_timedout = true;
     }
+    if (gpio_tx != UART_GPIO_NONE) uart_pio_sm = uart_tx_init(pio, gpio_tx, baudrate);
+    ring_buffer_init(&uart_pio_ring, uart_pio_buffer, UART_PIO_BUFFER_SIZE);
+    context.uart_pio_rx_ring = &uart_pio_ring;
+    uart_pio_dropped_count = 0;
 }
 
 static int64_t uart_pio_timeout_callback(alarm_id_t id, void *user_data) {
@@ -38,15 +43,17 @@ static int64_t uart_pio_timeout_callback(alarm_id_t id, void *user_data) {
 
 static void uart_pio_handler(uint8_t data) {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    static alarm_id_t uart_pio_timeout_alarm_id = 0;
     if (uart_pio_timeout_alarm_id) alarm_pool_cancel_alarm(context.uart_alarm_pool, uart_pio_timeout_alarm_id);
     if (uart_pio_is_timedout) {
-        xQueueReset(context.uart_rx_pio_queue_handle);
+        // bytes of the previous burst not read yet are discarded
+        uart_pio_dropped_count += UART_PIO_BUFFER_SIZE - ring_buffer_free(&uart_pio_ring);
+        ring_buffer_reset(&uart_pio_ring);
         uart_pio_is_timedout = false;
     }
     // debug("-%X-", data);
-    xQueueSendToBackFromISR(context.uart_rx_pio_queue_handle, &data, &xHigherPriorityTaskWoken);
-    if (uart_pio_timeout == 0) {
+    if (!ring_buffer_put(&uart_pio_ring, data)) uart_pio_dropped_count++;
+    // a stream without idle gaps never times out, it is also handed over every UART_PIO_NOTIFY_BYTES
+    if (uart_pio_timeout == 0 || ring_buffer_free(&uart_pio_ring) % UART_PIO_NOTIFY_BYTES == 0) {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         vTaskNotifyGiveIndexedFromISR(context.uart_pio_notify_task_handle, 1, &xHigherPriorityTaskWoken);
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
@@ -61,26 +68,25 @@ static void uart_pio_handler(uint8_t data) {
 
 uint8_t uart_pio_read(void) {
     uint8_t value = 0;
-    xQueueReceive(context.uart_rx_pio_queue_handle, &value, 0);
+    ring_buffer_get(&uart_pio_ring, &value);
     return value;
 }
 
-void uart_pio_read_bytes(uint8_t *data, uint8_t lenght) {
-    for (uint8_t i = 0; i < lenght; i++) {
-        xQueueReceive(context.uart_rx_pio_queue_handle, data + i, 0);
-    }
-}
+void uart_pio_read_bytes(uint8_t *data, uint8_t lenght) { ring_buffer_get_bytes(&uart_pio_ring, data, lenght); }
 
 void uart_pio_write(uint8_t c) { uart_tx_write(c); }
 
 void uart_pio_write_bytes(uint8_t *data, uint8_t lenght) { uart_tx_write_bytes(data, lenght); }
 
-uint8_t uart_pio_available(void) { return uxQueueMessagesWaiting(context.uart_rx_pio_queue_handle); }
-
-uint8_t uart_pio_tx_available(void) {
-    return UART_PIO_BUFFER_SIZE - uxQueueMessagesWaiting(context.uart_rx_pio_queue_handle);
+/* Saturated instead of truncated, the buffer holds more than 255 bytes */
+uint8_t uart_pio_available(void) {
+    uint32_t available = ring_buffer_available(&uart_pio_ring);
+    return available > UINT8_MAX ? UINT8_MAX : available;
 }
 
+/* Bytes lost to a full buffer or discarded unread at the start of a burst since uart_pio_begin() */
+uint uart_pio_dropped(void) { return uart_pio_dropped_count; }
+
 uint uart_pio_get_time_elapsed(void) { return time_us_32() - uart_pio_timestamp; }
 
 void uart_pio_remove(void) {
@@ -5,7 +5,9 @@
 #include "uart_rx.h"
 #include "uart_tx.h"
 
+/* Power of 2. Holds the unconfigured NMEA output of a gps at boot and 16 NAV-PVT epochs of the high rate mode */
 #define UART_PIO_BUFFER_SIZE 2048
+#define UART_PIO_NOTIFY_BYTES 256
 #define UART_GPIO_NONE -1
 
 extern context_t context;
@@ -16,7 +18,7 @@ void uart_pio_read_bytes(uint8_t *data, uint8_t lenght);
 void uart_pio_write(uint8_t c);
 void uart_pio_write_bytes(uint8_t *data, uint8_t lenght);
 uint8_t uart_pio_available(void);
-uint8_t uart_pio_tx_available(void);
+uint uart_pio_dropped(void);
 void uart_pio_remove(void);
 
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <stdio.h>
 
 #include "config.h"
+#include "pool.h"
 #include "pico/stdlib.h"
 #include "string.h"
 
@@ -22,6 +23,7 @@ void usb_task() {
         int length = read_usb();
         if (length) process_usb(length);
         debug("\nUSB (%u)", uxTaskGetStackHighWaterMark(NULL));
+        pool_report();
         vTaskDelay(USB_INTERVAL_MS / portTICK_PERIOD_MS);
     }
 }